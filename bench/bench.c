@@ -0,0 +1,397 @@
+/*
+ * Host benchmark for the page parse and render paths.
+ *
+ * Runs each stage over every page of the corpus (bench/corpus by default,
+ * or the files and directories given) and reports, per page and stage:
+ *
+ *   MB/s     input bytes per second over warm passes (state reused the
+ *            way the browsers reuse it between pages)
+ *   allocs   heap allocations made by one cold pass (fresh state)
+ *   peak KB  most heap in use at once during that cold pass
+ *
+ * Stages:
+ *   strip    html_scan_strip over the whole page (browser-test render)
+ *   doc      html_doc_parse: links, forms, tables
+ *   url      url_parse over every link on the page, made absolute
+ *   render   html_stream fed in 1460-byte reads into a text arena, then
+ *            the pager's line index over all of it (browser.c render)
+ *
+ * Allocation counts come from malloc/calloc/realloc/free being wrapped
+ * at link time (-Wl,--wrap, see the Makefile); glibc only.
+ *
+ * Usage: bench [--ms=<per stage>] [--kernel=scalar|swar|sse2|avx2|neon] [paths]
+ */
+
+#include <dirent.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "html_doc.h"
+#include "html_scan.h"
+#include "html_stream.h"
+#include "page_arena.h"
+#include "pager.h"
+#include "scan_kernel.h"
+#include "url.h"
+
+#define BENCH_MAX_PAGES  64
+#define BENCH_DEFAULT_MS 200
+#define BENCH_READ_SIZE  1460        /* one TCP segment per html_stream_feed */
+
+/* ------------------------------------------------------------------------
+ * Heap accounting
+ * ------------------------------------------------------------------------ */
+
+void *__real_malloc(size_t n);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *p, size_t n);
+void __real_free(void *p);
+
+static long g_allocs = 0;
+static size_t g_live = 0;
+static size_t g_peak = 0;
+
+static void bench_note_alloc(void *p)
+{
+    g_allocs++;
+    g_live += malloc_usable_size(p);
+    if (g_live > g_peak) g_peak = g_live;
+}
+
+void *__wrap_malloc(size_t n)
+{
+    void *p = __real_malloc(n);
+    if (p) bench_note_alloc(p);
+    return p;
+}
+
+void *__wrap_calloc(size_t n, size_t size)
+{
+    void *p = __real_calloc(n, size);
+    if (p) bench_note_alloc(p);
+    return p;
+}
+
+void *__wrap_realloc(void *p, size_t n)
+{
+    size_t old = p ? malloc_usable_size(p) : 0;
+    void *q = __real_realloc(p, n);
+    if (q) {
+        g_live -= old;
+        bench_note_alloc(q);
+    } else if (n == 0) {
+        g_live -= old;
+    }
+    return q;
+}
+
+void __wrap_free(void *p)
+{
+    if (p) g_live -= malloc_usable_size(p);
+    __real_free(p);
+}
+
+/* ------------------------------------------------------------------------
+ * Corpus
+ * ------------------------------------------------------------------------ */
+
+typedef struct {
+    char name[64];
+    page_arena_t page;
+    char **urls;               /* absolute form of every link, for "url" */
+    int num_urls;
+    long url_bytes;
+} bench_page_t;
+
+static bench_page_t g_pages[BENCH_MAX_PAGES];
+static int g_num_pages = 0;
+
+static void bench_collect_urls(bench_page_t *bp)
+{
+    html_doc_t doc;
+    int n = 0;
+
+    html_doc_init(&doc);
+    html_doc_parse(&doc, &bp->page);
+    bp->urls = (char**)malloc((doc.num_links + 1) * sizeof(char*));
+    for (int i = 0; i < doc.num_links; ++i) {
+        char link[512], abs[600];
+        page_arena_copy(&bp->page, html_doc_link(&doc, i)->url, link, sizeof(link));
+        if (strncmp(link, "http://", 7) == 0 || strncmp(link, "https://", 8) == 0) {
+            snprintf(abs, sizeof(abs), "%s", link);
+        } else {
+            snprintf(abs, sizeof(abs), "http://example.com%s%s", link[0] == '/' ? "" : "/", link);
+        }
+        bp->urls[n] = (char*)malloc(strlen(abs) + 1);
+        strcpy(bp->urls[n], abs);
+        bp->url_bytes += (long)strlen(abs);
+        n++;
+    }
+    bp->num_urls = n;
+    html_doc_free(&doc);
+}
+
+static void bench_load(const char *path)
+{
+    FILE *f;
+    char buf[8192];
+    size_t n;
+    bench_page_t *bp;
+    const char *slash = strrchr(path, '/');
+
+    if (g_num_pages == BENCH_MAX_PAGES) return;
+    f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "bench: cannot open %s\n", path);
+        return;
+    }
+    bp = &g_pages[g_num_pages++];
+    memset(bp, 0, sizeof(*bp));
+    snprintf(bp->name, sizeof(bp->name), "%s", slash ? slash + 1 : path);
+    page_arena_init(&bp->page, PAGE_ARENA_MAX_BYTES);
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        page_arena_append(&bp->page, buf, (int)n);
+    }
+    fclose(f);
+    bench_collect_urls(bp);
+}
+
+static int bench_name_cmp(const void *a, const void *b)
+{
+    return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+/* Loads a file, or every *.html / *.htm file in a directory (sorted). */
+static void bench_load_path(const char *path)
+{
+    struct stat st;
+    DIR *dir;
+    struct dirent *de;
+    char *names[BENCH_MAX_PAGES];
+    int n = 0;
+
+    if (stat(path, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        bench_load(path);
+        return;
+    }
+    dir = opendir(path);
+    if (!dir) return;
+    while ((de = readdir(dir)) != NULL && n < BENCH_MAX_PAGES) {
+        const char *dot = strrchr(de->d_name, '.');
+        if (dot && (strcmp(dot, ".html") == 0 || strcmp(dot, ".htm") == 0)) {
+            names[n] = (char*)malloc(strlen(path) + strlen(de->d_name) + 2);
+            sprintf(names[n], "%s/%s", path, de->d_name);
+            n++;
+        }
+    }
+    closedir(dir);
+    qsort(names, n, sizeof(names[0]), bench_name_cmp);
+    for (int i = 0; i < n; ++i) {
+        bench_load(names[i]);
+        free(names[i]);
+    }
+}
+
+/* ------------------------------------------------------------------------
+ * Stages
+ * ------------------------------------------------------------------------ */
+
+/* Per-stage state that survives between passes, as in the browsers. */
+typedef struct {
+    page_arena_t text;
+    html_doc_t doc;
+    pager_t pager;
+    volatile long sink;        /* keeps results observable */
+} bench_state_t;
+
+typedef struct {
+    const char *name;
+    long (*input_bytes)(const bench_page_t *bp);
+    void (*run)(bench_state_t *st, const bench_page_t *bp);
+} bench_stage_t;
+
+static void bench_state_init(bench_state_t *st)
+{
+    memset(st, 0, sizeof(*st));
+    page_arena_init(&st->text, PAGE_ARENA_MAX_BYTES);
+    html_doc_init(&st->doc);
+    pager_init(&st->pager, PAGER_DEFAULT_ROWS, PAGER_DEFAULT_COLS);
+}
+
+static void bench_state_free(bench_state_t *st)
+{
+    page_arena_free(&st->text);
+    html_doc_free(&st->doc);
+    pager_free(&st->pager);
+}
+
+static long bench_page_bytes(const bench_page_t *bp)
+{
+    return bp->page.len;
+}
+
+static long bench_url_bytes(const bench_page_t *bp)
+{
+    return bp->url_bytes;
+}
+
+static void bench_strip(bench_state_t *st, const bench_page_t *bp)
+{
+    page_arena_reset(&st->text);
+    html_scan_strip(bp->page.data, 0, bp->page.len, 0, NULL, &st->text);
+    st->sink += st->text.len;
+}
+
+static void bench_doc(bench_state_t *st, const bench_page_t *bp)
+{
+    html_doc_parse(&st->doc, &bp->page);
+    st->sink += st->doc.num_links + st->doc.num_forms + st->doc.num_tables;
+}
+
+static void bench_url(bench_state_t *st, const bench_page_t *bp)
+{
+    for (int i = 0; i < bp->num_urls; ++i) {
+        net_scheme_t scheme;
+        char host[256], path[512];
+        unsigned short port;
+        if (url_parse(bp->urls[i], &scheme, host, sizeof(host), path, sizeof(path), &port) == 0) {
+            st->sink += port + host[0];
+        }
+    }
+}
+
+static void bench_text_run(void *user, const char *text, int len)
+{
+    page_arena_append((page_arena_t*)user, text, len);
+}
+
+static void bench_render(bench_state_t *st, const bench_page_t *bp)
+{
+    html_stream_t stream;
+
+    page_arena_reset(&st->text);
+    html_stream_init(&stream, 0, bench_text_run, &st->text);
+    for (long off = 0; off < bp->page.len; off += BENCH_READ_SIZE) {
+        long n = bp->page.len - off;
+        html_stream_feed(&stream, bp->page.data + off, (int)(n < BENCH_READ_SIZE ? n : BENCH_READ_SIZE));
+    }
+    pager_open(&st->pager, &st->text, NULL, NULL);
+    st->sink += pager_count_lines(&st->pager);
+}
+
+static const bench_stage_t g_stages[] = {
+    { "strip",  bench_page_bytes, bench_strip },
+    { "doc",    bench_page_bytes, bench_doc },
+    { "url",    bench_url_bytes,  bench_url },
+    { "render", bench_page_bytes, bench_render },
+};
+#define BENCH_NUM_STAGES ((int)(sizeof(g_stages) / sizeof(g_stages[0])))
+
+/* ------------------------------------------------------------------------
+ * Driver
+ * ------------------------------------------------------------------------ */
+
+static double bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+typedef struct {
+    double secs;
+    long bytes;
+} bench_total_t;
+
+static void bench_run(const bench_stage_t *stage, const bench_page_t *bp, int ms,
+                      bench_total_t *total)
+{
+    bench_state_t st;
+    long allocs;
+    size_t base, peak;
+    long passes = 0;
+    double start, secs;
+    long in = stage->input_bytes(bp);
+
+    /* Cold pass: what the page costs from nothing. */
+    bench_state_init(&st);
+    allocs = g_allocs;
+    base = g_peak = g_live;
+    stage->run(&st, bp);
+    allocs = g_allocs - allocs;
+    peak = g_peak - base;
+
+    /* Warm passes, at least three and at least ms milliseconds. */
+    start = bench_now();
+    do {
+        stage->run(&st, bp);
+        passes++;
+        secs = bench_now() - start;
+    } while (passes < 3 || secs * 1000.0 < ms);
+    bench_state_free(&st);
+
+    total->secs += secs;
+    total->bytes += in * passes;
+    printf("%-28s %6ld  %-7s %9.1f %8ld %8.1f\n", bp->name, in / 1024, stage->name,
+           secs > 0 ? (double)in * passes / secs / 1e6 : 0.0, allocs, peak / 1024.0);
+}
+
+static int bench_kernel(const char *name)
+{
+    for (int k = SCAN_KERNEL_SCALAR; k <= SCAN_KERNEL_NEON; ++k) {
+        if (strcmp(name, scan_kernel_name((scan_kernel_t)k)) == 0) {
+            scan_kernel_t got = scan_kernel_force((scan_kernel_t)k);
+            if (got != (scan_kernel_t)k) {
+                fprintf(stderr, "bench: %s kernel not available, using %s\n",
+                        name, scan_kernel_name(got));
+            }
+            return 0;
+        }
+    }
+    fprintf(stderr, "bench: unknown kernel %s\n", name);
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    int ms = BENCH_DEFAULT_MS;
+    int paths = 0;
+    bench_total_t totals[BENCH_NUM_STAGES];
+
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--ms=", 5) == 0) {
+            ms = atoi(argv[i] + 5);
+        } else if (strncmp(argv[i], "--kernel=", 9) == 0) {
+            if (bench_kernel(argv[i] + 9) != 0) return 2;
+        } else {
+            bench_load_path(argv[i]);
+            paths++;
+        }
+    }
+    if (!paths) bench_load_path("bench/corpus");
+    if (g_num_pages == 0) {
+        fprintf(stderr, "bench: no pages (run from the repository root or pass a corpus path)\n");
+        return 1;
+    }
+
+    printf("scan kernel: %s, %d ms per stage and page\n\n",
+           scan_kernel_name(scan_kernel_active()), ms);
+    printf("%-28s %6s  %-7s %9s %8s %8s\n", "page", "KB", "stage", "MB/s", "allocs", "peak KB");
+    memset(totals, 0, sizeof(totals));
+    for (int p = 0; p < g_num_pages; ++p) {
+        for (int s = 0; s < BENCH_NUM_STAGES; ++s) {
+            bench_run(&g_stages[s], &g_pages[p], ms, &totals[s]);
+        }
+    }
+
+    printf("\n");
+    for (int s = 0; s < BENCH_NUM_STAGES; ++s) {
+        printf("%-28s %6s  %-7s %9.1f\n", "all pages", "", g_stages[s].name,
+               totals[s].secs > 0 ? totals[s].bytes / totals[s].secs / 1e6 : 0.0);
+    }
+    return 0;
+}
@@ -0,0 +1,673 @@
+/*
+ * Host checks for the streaming decoders: make check.
+ *
+ * A streaming path must not care where its input is cut. Each check runs
+ * one over every page of the corpus (bench/corpus by default, or the files
+ * and directories given) in pieces of many sizes and compares the output
+ * with the same path run over the whole page at once:
+ *
+ *   charset   charset_conv between UTF-8, Shift_JIS and EUC-JP, cut at
+ *             1 to 4096 bytes, over each page and over a page holding
+ *             every double-byte JIS code; once a page has been out and
+ *             back, another trip must give the same bytes
+ *   entities  charset_conv decoding character references, into UTF-8
+ *             and Shift_JIS, over each page and a page of awkward ones
+ *   pipeline  browser-test --pipeline against the serial path: the page
+ *             comes through page_pipe_run in random writes of 1 to 6000
+ *             bytes (several seeds) and is parsed with html_doc_more and
+ *             stripped to html_scan_safe_end as it arrives; the text and
+ *             the title, links, forms and tables must match
+ *   url       url_resolve over the RFC 3986 section 5.4 examples and bases
+ *             with an empty path
+ *
+ * check --convert=<from>,<to> [--entities] [--chunk=<n>] converts stdin
+ * to stdout in pieces of n bytes (default 1460). tools/check_codecs.py
+ * uses it to compare the output with Python's codecs, which the JIS
+ * tables are generated from, and with html.unescape.
+ *
+ * Prints one line per check and page; exits nonzero if any fails.
+ *
+ * Usage: check [--kernel=scalar|swar|sse2|avx2|neon] [paths]
+ *        check --convert=<from>,<to> [--entities] [--chunk=<n>]
+ */
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "charset.h"
+#include "html_doc.h"
+#include "html_scan.h"
+#include "net_transport.h"
+#include "page_arena.h"
+#include "page_pipe.h"
+#include "scan_kernel.h"
+#include "url.h"
+
+#define CHECK_MAX_PAGES  64
+#define CHECK_READ_SIZE  1460
+#define CHECK_RENDER_STEP 4096   /* browser-test's RENDER_STEP */
+#define CHECK_PIPE_SEEDS 8
+#define CHECK_PIPE_WRITE 6000    /* largest random write, past PAGE_PIPE_BUF */
+
+/* Piece sizes each streaming path is fed in, besides the whole page. */
+static const int g_cuts[] = { 1, 2, 3, 4, 5, 7, 13, 33, 64, 511, 1460, 4096 };
+#define CHECK_NUM_CUTS ((int)(sizeof(g_cuts) / sizeof(g_cuts[0])))
+
+/* ------------------------------------------------------------------------
+ * Corpus
+ * ------------------------------------------------------------------------ */
+
+typedef struct {
+    char name[64];
+    page_arena_t page;
+} check_page_t;
+
+static check_page_t g_pages[CHECK_MAX_PAGES];
+static int g_num_pages = 0;
+static int g_failed = 0;
+
+static void check_load(const char *path)
+{
+    FILE *f;
+    char buf[8192];
+    size_t n;
+    check_page_t *cp;
+    const char *slash = strrchr(path, '/');
+
+    if (g_num_pages == CHECK_MAX_PAGES) return;
+    f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "check: cannot open %s\n", path);
+        return;
+    }
+    cp = &g_pages[g_num_pages++];
+    memset(cp, 0, sizeof(*cp));
+    snprintf(cp->name, sizeof(cp->name), "%s", slash ? slash + 1 : path);
+    page_arena_init(&cp->page, PAGE_ARENA_MAX_BYTES);
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        page_arena_append(&cp->page, buf, (int)n);
+    }
+    fclose(f);
+}
+
+static int check_name_cmp(const void *a, const void *b)
+{
+    return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+/* Loads a file, or every *.html / *.htm file in a directory (sorted). */
+static void check_load_path(const char *path)
+{
+    struct stat st;
+    DIR *dir;
+    struct dirent *de;
+    char *names[CHECK_MAX_PAGES];
+    int n = 0;
+
+    if (stat(path, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        check_load(path);
+        return;
+    }
+    dir = opendir(path);
+    if (!dir) return;
+    while ((de = readdir(dir)) != NULL && n < CHECK_MAX_PAGES) {
+        const char *dot = strrchr(de->d_name, '.');
+        if (dot && (strcmp(dot, ".html") == 0 || strcmp(dot, ".htm") == 0)) {
+            names[n] = (char*)malloc(strlen(path) + strlen(de->d_name) + 2);
+            sprintf(names[n], "%s/%s", path, de->d_name);
+            n++;
+        }
+    }
+    closedir(dir);
+    qsort(names, n, sizeof(names[0]), check_name_cmp);
+    for (int i = 0; i < n; ++i) {
+        check_load(names[i]);
+        free(names[i]);
+    }
+}
+
+static void check_pass(const char *check, const char *page, const char *what)
+{
+    printf("ok    %-9s %-28s %s\n", check, page, what);
+}
+
+/* Reports one check on one page; a failure names the first difference. */
+static void check_report(const char *check, const char *page, const char *what,
+                         const page_arena_t *want, const page_arena_t *got)
+{
+    long at = 0;
+
+    while (at < want->len && at < got->len && want->data[at] == got->data[at]) at++;
+    if (at == want->len && at == got->len) {
+        check_pass(check, page, what);
+        return;
+    }
+    printf("FAIL  %-9s %-28s %s: differs at byte %ld (%ld vs %ld bytes)\n",
+           check, page, what, at, want->len, got->len);
+    g_failed++;
+}
+
+/* ------------------------------------------------------------------------
+ * charset
+ * ------------------------------------------------------------------------ */
+
+/* Converts in (cut every `cut` bytes, 0 = whole) into out, replacing it. */
+static void check_convert(charset_t from, charset_t to, int entities, const page_arena_t *in,
+                          int cut, page_arena_t *out)
+{
+    charset_conv_t conv;
+
+    page_arena_reset(out);
+    charset_conv_init(&conv, from, to);
+    conv.entities = entities;
+    for (long at = 0; at < in->len; ) {
+        int n = cut > 0 && in->len - at > cut ? cut : (int)(in->len - at);
+        charset_conv(&conv, in->data + at, n, out);
+        at += n;
+    }
+    charset_conv_finish(&conv, out);
+}
+
+/* Whole against every cut for one direction; leaves the whole result in
+   whole. Returns nonzero if any cut differed. */
+static int check_cuts(const char *check, const char *page, charset_t from, charset_t to,
+                      int entities, const page_arena_t *in, page_arena_t *whole,
+                      page_arena_t *part)
+{
+    char what[64];
+
+    check_convert(from, to, entities, in, 0, whole);
+    for (int i = 0; i < CHECK_NUM_CUTS; ++i) {
+        check_convert(from, to, entities, in, g_cuts[i], part);
+        if (part->len != whole->len || memcmp(part->data, whole->data, whole->len) != 0) {
+            snprintf(what, sizeof(what), "%s -> %s, %d-byte pieces",
+                     charset_name(from), charset_name(to), g_cuts[i]);
+            check_report(check, page, what, whole, part);
+            return 1;
+        }
+    }
+    snprintf(what, sizeof(what), "%s -> %s", charset_name(from), charset_name(to));
+    check_pass(check, page, what);
+    return 0;
+}
+
+/* Every double-byte Shift_JIS code, lead 0x81-0x9F and 0xE0-0xFC with
+   trail 0x40-0xFC (not 0x7F), with a newline after each lead. */
+static void check_all_sjis(page_arena_t *out)
+{
+    page_arena_reset(out);
+    for (int lead = 0x81; lead <= 0xFC; ++lead) {
+        if (lead == 0xA0) lead = 0xE0;
+        for (int trail = 0x40; trail <= 0xFC; ++trail) {
+            char b[2];
+            if (trail == 0x7F) continue;
+            b[0] = (char)lead;
+            b[1] = (char)trail;
+            page_arena_append(out, b, 2);
+        }
+        page_arena_append(out, "\n", 1);
+    }
+}
+
+/* UTF-8 out to Shift_JIS and EUC-JP and back, and between the two, each
+   streamed at every cut; then the round trip. */
+static void check_charset_page(const char *page, charset_t from, const page_arena_t *in)
+{
+    static const charset_t jis[2] = { CHARSET_SHIFT_JIS, CHARSET_EUC_JP };
+    page_arena_t out, back, again, part;
+
+    page_arena_init(&out, 0);
+    page_arena_init(&back, 0);
+    page_arena_init(&again, 0);
+    page_arena_init(&part, 0);
+    for (int j = 0; j < 2; ++j) {
+        charset_t other = jis[1 - j];
+
+        if (from == jis[j]) {
+            page_arena_reset(&out);
+            page_arena_append(&out, in->data, (int)in->len);
+        } else if (check_cuts("charset", page, from, jis[j], 0, in, &out, &part)) {
+            continue;
+        }
+        if (check_cuts("charset", page, jis[j], CHARSET_UTF8, 0, &out, &back, &part)) continue;
+        check_cuts("charset", page, jis[j], other, 0, &out, &part, &again);
+
+        /* The first trip back settles bad bytes as '?' and duplicate codes
+           as the one the encoder picks; after that nothing may change. */
+        check_convert(CHARSET_UTF8, jis[j], 0, &back, 0, &again);
+        check_convert(jis[j], CHARSET_UTF8, 0, &again, 0, &back);
+        check_convert(CHARSET_UTF8, jis[j], 0, &back, 0, &part);
+        check_report("charset", page,
+                     jis[j] == CHARSET_SHIFT_JIS ? "round trip via Shift_JIS" : "round trip via EUC-JP",
+                     &again, &part);
+    }
+    page_arena_free(&out);
+    page_arena_free(&back);
+    page_arena_free(&again);
+    page_arena_free(&part);
+}
+
+static void check_charset(void)
+{
+    page_arena_t all;
+
+    for (int p = 0; p < g_num_pages; ++p) {
+        check_charset_page(g_pages[p].name, CHARSET_UTF8, &g_pages[p].page);
+    }
+    page_arena_init(&all, 0);
+    check_all_sjis(&all);
+    check_charset_page("(every JIS code)", CHARSET_SHIFT_JIS, &all);
+    page_arena_free(&all);
+}
+
+/* ------------------------------------------------------------------------
+ * entities
+ * ------------------------------------------------------------------------ */
+
+/* References a page seldom has: long names, old names without ';' and
+   names that only start like one, numbers out of range, a '&' at the end. */
+static const char g_entity_page[] =
+    "&amp;&amp&ampx&amp;x&AMP;&Amp; &&& &; &#; &#x; &#xg; &# &#a\n"
+    "&copy &copy= &copyright &not &notin &notin; &noti &notit; &notit\n"
+    "&NotSquareSupersetEqual; &CounterClockwiseContourIntegral; "
+    "&CounterClockwiseContourIntegralx &DoubleLongLeftRightArrow;\n"
+    "&ThisIsNotARealReferenceButItIsVeryLong; &thinsp;&ThinSpace;&ensp;&hairsp;\n"
+    "&#0; &#9; &#13; &#65 &#65; &#x41; &#X41 &#0065; &#x0041;x &#128; &#x80; &#x9F;\n"
+    "&#127; &#xD800; &#xDFFF; &#xFFFE; &#x10FFFF; &#x110000; &#99999999999999999999;\n"
+    "&#x000000000000000000041; &#1114111; &#1114112; &#65;&#66;&#67;\n"
+    "&acE; &nGt; &nvlt; &bne; &fjlig; &ThickSpace; &NotEqualTilde;\n"
+    "\xE3\x81\x82&amp;\xE3\x81\x84&eacute;\xE3\x81\x86 &eacute\xE3\x81\x88 &\xE3\x81\x8A;\n"
+    "a&b&c=1&d;&e &lt&gt&quot&nbsp&yen&macr;&frac12 &";
+
+/* Character references decoded as the text streams, into UTF-8 and into
+   Shift_JIS. */
+static void check_entities(void)
+{
+    static const charset_t to[2] = { CHARSET_UTF8, CHARSET_SHIFT_JIS };
+    page_arena_t refs, whole, part;
+
+    page_arena_init(&refs, 0);
+    page_arena_init(&whole, 0);
+    page_arena_init(&part, 0);
+    page_arena_append(&refs, g_entity_page, (int)sizeof(g_entity_page) - 1);
+    for (int p = 0; p <= g_num_pages; ++p) {
+        const char *name = p < g_num_pages ? g_pages[p].name : "(references)";
+        const page_arena_t *in = p < g_num_pages ? &g_pages[p].page : &refs;
+
+        for (int t = 0; t < 2; ++t) {
+            check_cuts("entities", name, CHARSET_UTF8, to[t], 1, in, &whole, &part);
+        }
+    }
+    page_arena_free(&refs);
+    page_arena_free(&whole);
+    page_arena_free(&part);
+}
+
+/* ------------------------------------------------------------------------
+ * pipeline
+ * ------------------------------------------------------------------------ */
+
+/* What browser-test keeps of a page: its bytes, the parsed document, the
+   rendered text and how far rendering got. */
+typedef struct {
+    page_arena_t page;
+    html_doc_t doc;
+    charset_conv_t conv;
+    page_arena_t text;
+    long rendered;
+} check_view_t;
+
+/* The network side: the page pushed through the sink in random writes. */
+typedef struct {
+    const page_arena_t *src;
+    unsigned seed;
+} check_feed_t;
+
+static unsigned check_rand(unsigned *seed)
+{
+    /* xorshift32: the same splits on every host */
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    return *seed;
+}
+
+static int check_feed(void *arg, http_body_fn sink, void *sink_user)
+{
+    check_feed_t *feed = (check_feed_t*)arg;
+
+    for (long at = 0; at < feed->src->len; ) {
+        long n = 1 + check_rand(&feed->seed) % CHECK_PIPE_WRITE;
+        if (n > feed->src->len - at) n = feed->src->len - at;
+        if (sink(sink_user, feed->src->data + at, (int)n) != 0) return -1;
+        at += n;
+    }
+    return 0;
+}
+
+/* As browser-test's pipe_chunk. */
+static void check_pipe_chunk(void *user, const char *data, int len)
+{
+    check_view_t *v = (check_view_t*)user;
+
+    page_arena_append(&v->page, data, len);
+    html_doc_more(&v->doc, &v->page);
+    v->rendered = html_scan_strip(v->page.data, v->rendered,
+                                  html_scan_safe_end(v->page.data, v->rendered, v->page.len),
+                                  0, &v->conv, &v->text);
+}
+
+static void check_view_init(check_view_t *v)
+{
+    page_arena_init(&v->page, PAGE_ARENA_MAX_BYTES);
+    html_doc_init(&v->doc);
+    page_arena_init(&v->text, 0);
+    charset_conv_init(&v->conv, CHARSET_UTF8, CHARSET_UTF8);
+    v->conv.entities = 1;
+    v->rendered = 0;
+}
+
+static void check_view_free(check_view_t *v)
+{
+    page_arena_free(&v->page);
+    html_doc_free(&v->doc);
+    page_arena_free(&v->text);
+}
+
+/* The rest of the page, a step at a time as the pager asks for it. */
+static void check_render_rest(check_view_t *v)
+{
+    while (v->rendered < v->page.len) {
+        v->rendered = html_scan_strip(v->page.data, v->rendered, v->page.len,
+                                      CHECK_RENDER_STEP, &v->conv, &v->text);
+    }
+    charset_conv_finish(&v->conv, &v->text);
+}
+
+static void check_dump_span(page_arena_t *out, const page_arena_t *page, page_span_t span)
+{
+    page_arena_append(out, page_arena_at(page, span.off), span.len);
+    page_arena_append(out, "|", 1);
+}
+
+static void check_dump_int(page_arena_t *out, int n)
+{
+    char buf[16];
+    page_arena_append(out, buf, snprintf(buf, sizeof(buf), "%d|", n));
+}
+
+/* The document as text, spans by their bytes, for comparing two parses. */
+static void check_dump_doc(const check_view_t *v, page_arena_t *out)
+{
+    page_arena_reset(out);
+    check_dump_span(out, &v->page, v->doc.title);
+    check_dump_int(out, v->doc.num_links);
+    for (int i = 0; i < v->doc.num_links; ++i) {
+        const html_doc_link_t *link = html_doc_link(&v->doc, i);
+        page_arena_append(out, "\nL ", 3);
+        check_dump_span(out, &v->page, link->text);
+        check_dump_span(out, &v->page, link->url);
+    }
+    for (const html_doc_form_t *f = v->doc.forms; f; f = f->next) {
+        page_arena_append(out, "\nF ", 3);
+        check_dump_span(out, &v->page, f->method);
+        check_dump_span(out, &v->page, f->action);
+        for (const html_doc_input_t *in = f->inputs; in; in = in->next) {
+            page_arena_append(out, "\nI ", 3);
+            check_dump_span(out, &v->page, in->name);
+            check_dump_span(out, &v->page, in->type);
+            check_dump_span(out, &v->page, in->value);
+            check_dump_int(out, in->textarea);
+        }
+    }
+    for (const html_doc_table_t *t = v->doc.tables; t; t = t->next) {
+        page_arena_append(out, "\nT ", 3);
+        check_dump_int(out, t->num_rows);
+        check_dump_int(out, t->num_cols);
+        for (const html_doc_cell_t *c = t->cells; c; c = c->next) {
+            page_arena_append(out, "\nC ", 3);
+            check_dump_int(out, c->row);
+            check_dump_int(out, c->col);
+            check_dump_int(out, c->header);
+            check_dump_span(out, &v->page, c->text);
+        }
+    }
+}
+
+static void check_pipeline_page(const char *page, const page_arena_t *in)
+{
+    check_view_t serial, piped;
+    page_arena_t want_doc, got_doc;
+    char what[64];
+    int failed = 0;
+
+    /* Serial: the whole body first, then parse, then render. */
+    check_view_init(&serial);
+    page_arena_append(&serial.page, in->data, (int)in->len);
+    html_doc_parse(&serial.doc, &serial.page);
+    check_render_rest(&serial);
+    page_arena_init(&want_doc, 0);
+    page_arena_init(&got_doc, 0);
+    check_dump_doc(&serial, &want_doc);
+
+    for (int seed = 1; seed <= CHECK_PIPE_SEEDS && !failed; ++seed) {
+        check_feed_t feed;
+        net_fail_t why;
+
+        feed.src = in;
+        feed.seed = 0x9E3779B9u * (unsigned)seed;
+        check_view_init(&piped);
+        html_doc_begin(&piped.doc);
+        page_pipe_run(check_feed, &feed, check_pipe_chunk, &piped, &why);
+        html_doc_end(&piped.doc, &piped.page);
+        check_render_rest(&piped);
+        check_dump_doc(&piped, &got_doc);
+
+        if (piped.text.len != serial.text.len
+            || memcmp(piped.text.data, serial.text.data, serial.text.len) != 0) {
+            snprintf(what, sizeof(what), "text, random writes seed %d", seed);
+            check_report("pipeline", page, what, &serial.text, &piped.text);
+            failed = 1;
+        } else if (got_doc.len != want_doc.len
+                   || memcmp(got_doc.data, want_doc.data, want_doc.len) != 0) {
+            snprintf(what, sizeof(what), "links/forms/tables, random writes seed %d", seed);
+            check_report("pipeline", page, what, &want_doc, &got_doc);
+            failed = 1;
+        }
+        check_view_free(&piped);
+    }
+    if (!failed) {
+        snprintf(what, sizeof(what), "%d random splits", CHECK_PIPE_SEEDS);
+        check_pass("pipeline", page, what);
+    }
+    check_view_free(&serial);
+    page_arena_free(&want_doc);
+    page_arena_free(&got_doc);
+}
+
+static void check_pipeline(void)
+{
+    net_transport_enable_threads();
+    for (int p = 0; p < g_num_pages; ++p) {
+        check_pipeline_page(g_pages[p].name, &g_pages[p].page);
+    }
+}
+
+/* ------------------------------------------------------------------------
+ * url
+ * ------------------------------------------------------------------------ */
+
+/* RFC 3986 section 5.4 (but "g:h" and "http:g" are copied as they are),
+   then bases without a path. */
+static const struct {
+    const char *base;
+    const char *link;
+    const char *want;
+} g_resolve[] = {
+    { "http://a/b/c/d;p?q", "g:h", "g:h" },
+    { "http://a/b/c/d;p?q", "g", "http://a/b/c/g" },
+    { "http://a/b/c/d;p?q", "./g", "http://a/b/c/g" },
+    { "http://a/b/c/d;p?q", "g/", "http://a/b/c/g/" },
+    { "http://a/b/c/d;p?q", "/g", "http://a/g" },
+    { "http://a/b/c/d;p?q", "//g", "http://g" },
+    { "http://a/b/c/d;p?q", "?y", "http://a/b/c/d;p?y" },
+    { "http://a/b/c/d;p?q", "g?y", "http://a/b/c/g?y" },
+    { "http://a/b/c/d;p?q", "#s", "http://a/b/c/d;p?q#s" },
+    { "http://a/b/c/d;p?q", "g#s", "http://a/b/c/g#s" },
+    { "http://a/b/c/d;p?q", "g?y#s", "http://a/b/c/g?y#s" },
+    { "http://a/b/c/d;p?q", ";x", "http://a/b/c/;x" },
+    { "http://a/b/c/d;p?q", "g;x", "http://a/b/c/g;x" },
+    { "http://a/b/c/d;p?q", "g;x?y#s", "http://a/b/c/g;x?y#s" },
+    { "http://a/b/c/d;p?q", "", "http://a/b/c/d;p?q" },
+    { "http://a/b/c/d;p?q", ".", "http://a/b/c/" },
+    { "http://a/b/c/d;p?q", "./", "http://a/b/c/" },
+    { "http://a/b/c/d;p?q", "..", "http://a/b/" },
+    { "http://a/b/c/d;p?q", "../", "http://a/b/" },
+    { "http://a/b/c/d;p?q", "../g", "http://a/b/g" },
+    { "http://a/b/c/d;p?q", "../..", "http://a/" },
+    { "http://a/b/c/d;p?q", "../../", "http://a/" },
+    { "http://a/b/c/d;p?q", "../../g", "http://a/g" },
+    { "http://a/b/c/d;p?q", "../../../g", "http://a/g" },
+    { "http://a/b/c/d;p?q", "../../../../g", "http://a/g" },
+    { "http://a/b/c/d;p?q", "/./g", "http://a/g" },
+    { "http://a/b/c/d;p?q", "/../g", "http://a/g" },
+    { "http://a/b/c/d;p?q", "g.", "http://a/b/c/g." },
+    { "http://a/b/c/d;p?q", ".g", "http://a/b/c/.g" },
+    { "http://a/b/c/d;p?q", "g..", "http://a/b/c/g.." },
+    { "http://a/b/c/d;p?q", "..g", "http://a/b/c/..g" },
+    { "http://a/b/c/d;p?q", "./../g", "http://a/b/g" },
+    { "http://a/b/c/d;p?q", "./g/.", "http://a/b/c/g/" },
+    { "http://a/b/c/d;p?q", "g/./h", "http://a/b/c/g/h" },
+    { "http://a/b/c/d;p?q", "g/../h", "http://a/b/c/h" },
+    { "http://a/b/c/d;p?q", "g;x=1/./y", "http://a/b/c/g;x=1/y" },
+    { "http://a/b/c/d;p?q", "g;x=1/../y", "http://a/b/c/y" },
+    { "http://a/b/c/d;p?q", "g?y/./x", "http://a/b/c/g?y/./x" },
+    { "http://a/b/c/d;p?q", "g?y/../x", "http://a/b/c/g?y/../x" },
+    { "http://a/b/c/d;p?q", "g#s/./x", "http://a/b/c/g#s/./x" },
+    { "http://a/b/c/d;p?q", "g#s/../x", "http://a/b/c/g#s/../x" },
+    { "http://a/b/c/d;p?q", "http:g", "http:g" },
+    { "http://host", "?q", "http://host/?q" },
+    { "http://host?x", "?q", "http://host/?q" },
+    { "http://host?x", "#f", "http://host/?x#f" },
+    { "http://host#y", "#f", "http://host/#f" },
+    { "http://host", "#f", "http://host/#f" },
+    { "http://host", "", "http://host/" },
+    { "http://host", "g", "http://host/g" },
+    { "http://host?x", "../g", "http://host/g" },
+    { "https://host:8080", "?q", "https://host:8080/?q" }
+};
+
+static void check_url(void)
+{
+    int n = (int)(sizeof(g_resolve) / sizeof(g_resolve[0]));
+    int bad = 0;
+
+    for (int i = 0; i < n; ++i) {
+        char out[256];
+        if (url_resolve(g_resolve[i].base, g_resolve[i].link, out, sizeof(out)) != 0) {
+            strcpy(out, "(error)");
+        }
+        if (strcmp(out, g_resolve[i].want) != 0) {
+            printf("FAIL  %-9s %-28s \"%s\" against %s: %s, not %s\n", "url", "url_resolve",
+                   g_resolve[i].link, g_resolve[i].base, out, g_resolve[i].want);
+            bad++;
+        }
+    }
+    g_failed += bad;
+    if (!bad) {
+        char what[32];
+        snprintf(what, sizeof(what), "%d references", n);
+        check_pass("url", "url_resolve", what);
+    }
+}
+
+/* ------------------------------------------------------------------------
+ * --convert: stdin to stdout, for tools/check_codecs.py
+ * ------------------------------------------------------------------------ */
+
+static int check_convert_stdin(const char *spec, int entities, int cut)
+{
+    const char *comma = strchr(spec, ',');
+    charset_t from, to;
+    page_arena_t in, out;
+    char buf[8192];
+    size_t n;
+
+    if (!comma) return 2;
+    from = charset_from_name(spec, (int)(comma - spec));
+    to = charset_from_name(comma + 1, (int)strlen(comma + 1));
+    if (from == CHARSET_UNKNOWN || to == CHARSET_UNKNOWN) {
+        fprintf(stderr, "check: unknown charset in %s\n", spec);
+        return 2;
+    }
+    page_arena_init(&in, 0);
+    page_arena_init(&out, 0);
+    while ((n = fread(buf, 1, sizeof(buf), stdin)) > 0) {
+        page_arena_append(&in, buf, (int)n);
+    }
+    check_convert(from, to, entities, &in, cut, &out);
+    fwrite(out.data, 1, out.len, stdout);
+    page_arena_free(&in);
+    page_arena_free(&out);
+    return 0;
+}
+
+static int check_kernel(const char *name)
+{
+    for (int k = SCAN_KERNEL_SCALAR; k <= SCAN_KERNEL_NEON; ++k) {
+        if (strcmp(name, scan_kernel_name((scan_kernel_t)k)) == 0) {
+            scan_kernel_t got = scan_kernel_force((scan_kernel_t)k);
+            if (got != (scan_kernel_t)k) {
+                fprintf(stderr, "check: %s kernel not available, using %s\n",
+                        name, scan_kernel_name(got));
+            }
+            return 0;
+        }
+    }
+    fprintf(stderr, "check: unknown kernel %s\n", name);
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *convert = NULL;
+    int cut = CHECK_READ_SIZE;
+    int entities = 0;
+    int paths = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--convert=", 10) == 0) {
+            convert = argv[i] + 10;
+        } else if (strcmp(argv[i], "--entities") == 0) {
+            entities = 1;
+        } else if (strncmp(argv[i], "--chunk=", 8) == 0) {
+            cut = atoi(argv[i] + 8);
+        } else if (strncmp(argv[i], "--kernel=", 9) == 0) {
+            if (check_kernel(argv[i] + 9) != 0) return 2;
+        } else {
+            check_load_path(argv[i]);
+            paths++;
+        }
+    }
+    if (convert) return check_convert_stdin(convert, entities, cut);
+
+    if (!paths) check_load_path("bench/corpus");
+    if (g_num_pages == 0) {
+        fprintf(stderr, "check: no pages (run from the repository root or pass a corpus path)\n");
+        return 1;
+    }
+    printf("scan kernel: %s\n", scan_kernel_name(scan_kernel_active()));
+    check_charset();
+    check_entities();
+    check_pipeline();
+    check_url();
+    if (g_failed) {
+        printf("%d check(s) failed\n", g_failed);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
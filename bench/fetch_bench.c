@@ -0,0 +1,464 @@
+/*
+ * End-to-end fetch benchmark against an in-process loopback server.
+ *
+ * Serves the corpus (bench/corpus by default, or the files and
+ * directories given) from bench/loopback_server.c and fetches every page
+ * the way the browsers do, reporting the mean time per fetch spent in:
+ *
+ *   resolve  DNS lookup (or cache hit) for "localhost"
+ *   connect  TCP connect; 0 when a pooled connection was reused
+ *   first    request sent until the first byte of the reply
+ *   transfer first byte until the end of the body, less parse time
+ *            spent inside the body callback
+ *   parse    tokenizing (stream) or html_doc_parse (page)
+ *   render   drawing the first screen through the pager
+ *
+ * Clients:
+ *   stream   browser.c fetch_url: http_cached_get (cache closed) feeding
+ *            html_stream as the body arrives, then the first screen
+ *   page     browser-test fetch_page: body into a page arena, then
+ *            html_doc_parse, then the first screen rendered lazily with
+ *            html_scan_strip
+ *
+ * Phase boundaries come from net_transport_set_events. The server can
+ * delay each response and pace it to a bandwidth, which is enough to
+ * stand in for the 64 kbps and 9.6 kbps links; it cannot slow down the
+ * TCP handshake, so connect times are always loopback times.
+ *
+ * Usage: fetch-bench [--link=lan|64k|9.6k] [--rtt=ms] [--bandwidth=bps]
+ *                    [--chunk=bytes] [--chunked] [--client=stream|page]
+ *                    [--iterations=n] [--warm] [paths]
+ */
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "html_doc.h"
+#include "html_scan.h"
+#include "html_stream.h"
+#include "http_cache.h"
+#include "http_client.h"
+#include "loopback_server.h"
+#include "net_transport.h"
+#include "page_arena.h"
+#include "pager.h"
+
+#define FB_MAX_PAGES   64
+#define FB_RENDER_STEP 4096           /* as browser-test's render_more */
+#define FB_HOST        "localhost"
+
+/* ------------------------------------------------------------------------
+ * Corpus
+ * ------------------------------------------------------------------------ */
+
+typedef struct {
+    char name[64];
+    char path[80];                    /* "/<name>" on the server */
+    page_arena_t body;
+} fb_page_t;
+
+static fb_page_t g_pages[FB_MAX_PAGES];
+static int g_num_pages = 0;
+
+static void fb_load(const char *file)
+{
+    FILE *f;
+    char buf[8192];
+    size_t n;
+    fb_page_t *fp;
+    const char *slash = strrchr(file, '/');
+    const char *name = slash ? slash + 1 : file;
+
+    if (g_num_pages == FB_MAX_PAGES) return;
+    f = fopen(file, "rb");
+    if (!f) {
+        fprintf(stderr, "fetch-bench: cannot open %s\n", file);
+        return;
+    }
+    fp = &g_pages[g_num_pages++];
+    memset(fp, 0, sizeof(*fp));
+    snprintf(fp->name, sizeof(fp->name), "%s", name);
+    snprintf(fp->path, sizeof(fp->path), "/%.62s", name);
+    page_arena_init(&fp->body, PAGE_ARENA_MAX_BYTES);
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        page_arena_append(&fp->body, buf, (int)n);
+    }
+    fclose(f);
+}
+
+static int fb_name_cmp(const void *a, const void *b)
+{
+    return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+/* Loads a file, or every *.html / *.htm file in a directory (sorted). */
+static void fb_load_path(const char *path)
+{
+    struct stat st;
+    DIR *dir;
+    struct dirent *de;
+    char *names[FB_MAX_PAGES];
+    int n = 0;
+
+    if (stat(path, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        fb_load(path);
+        return;
+    }
+    dir = opendir(path);
+    if (!dir) return;
+    while ((de = readdir(dir)) != NULL && n < FB_MAX_PAGES) {
+        const char *dot = strrchr(de->d_name, '.');
+        if (dot && (strcmp(dot, ".html") == 0 || strcmp(dot, ".htm") == 0)) {
+            names[n] = (char*)malloc(strlen(path) + strlen(de->d_name) + 2);
+            sprintf(names[n], "%s/%s", path, de->d_name);
+            n++;
+        }
+    }
+    closedir(dir);
+    qsort(names, n, sizeof(names[0]), fb_name_cmp);
+    for (int i = 0; i < n; ++i) {
+        fb_load(names[i]);
+        free(names[i]);
+    }
+}
+
+/* ------------------------------------------------------------------------
+ * Timing
+ * ------------------------------------------------------------------------ */
+
+enum { FB_RESOLVE, FB_CONNECT, FB_FIRST, FB_TRANSFER, FB_PARSE, FB_RENDER, FB_NUM_PHASES };
+
+static const char *g_phase_names[FB_NUM_PHASES] = {
+    "resolve", "connect", "first", "transfer", "parse", "render"
+};
+
+/* Milestones of the fetch in progress; 0 = not seen. */
+typedef struct {
+    double start;
+    double resolved;
+    double connected;
+    double first_byte;
+    double body_end;
+    double parse_in_body;             /* parse time inside the body callback */
+    double parse;
+    double render;
+} fb_marks_t;
+
+static fb_marks_t g_marks;
+
+static double fb_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void fb_on_event(void *user, net_event_t ev)
+{
+    double t = fb_now();
+    (void)user;
+    switch (ev) {
+    case NET_EV_RESOLVED:   g_marks.resolved = t; break;
+    case NET_EV_CONNECTED:
+    case NET_EV_SECURED:
+    case NET_EV_REUSED:     g_marks.connected = t; break;
+    case NET_EV_FIRST_BYTE: if (!g_marks.first_byte) g_marks.first_byte = t; break;
+    }
+}
+
+/* Turns the milestones into phase durations; a phase whose event never
+   fired (e.g. no connect on a reused connection) takes no time. */
+static void fb_phases(const fb_marks_t *m, double *out)
+{
+    double resolved = m->resolved ? m->resolved : m->start;
+    double connected = m->connected ? m->connected : resolved;
+    double first = m->first_byte ? m->first_byte : connected;
+
+    out[FB_RESOLVE] = resolved - m->start;
+    out[FB_CONNECT] = connected - resolved;
+    out[FB_FIRST] = first - connected;
+    out[FB_TRANSFER] = m->body_end - first - m->parse_in_body;
+    out[FB_PARSE] = m->parse_in_body + m->parse;
+    out[FB_RENDER] = m->render;
+}
+
+/* ------------------------------------------------------------------------
+ * Clients
+ * ------------------------------------------------------------------------ */
+
+typedef struct {
+    page_arena_t text;
+    page_arena_t page;
+    long rendered;
+    html_doc_t doc;
+    pager_t pager;
+    html_stream_t stream;
+} fb_client_t;
+
+static void fb_text_run(void *user, const char *text, int len)
+{
+    page_arena_append((page_arena_t*)user, text, len);
+}
+
+static int fb_feed_stream(void *user, const char *data, int len)
+{
+    double t = fb_now();
+    html_stream_feed((html_stream_t*)user, data, len);
+    g_marks.parse_in_body += fb_now() - t;
+    return 0;
+}
+
+/* As browser.c fetch_url. */
+static int fb_fetch_stream(fb_client_t *c, unsigned short port, const fb_page_t *fp)
+{
+    char url[256];
+    net_tls_options_t tls;
+    http_cache_result_t from;
+    int status, rc;
+    double t;
+
+    memset(&tls, 0, sizeof(tls));
+    snprintf(url, sizeof(url), "http://%s:%u%s", FB_HOST, port, fp->path);
+    page_arena_reset(&c->text);
+    html_stream_init(&c->stream, 0, fb_text_run, &c->text);
+    rc = http_cached_get(url, FB_HOST, port, NET_SCHEME_HTTP, &tls, fp->path,
+                         fb_feed_stream, &c->stream, &status, &from, NULL, 0);
+    g_marks.body_end = fb_now();
+    if (rc != 0 || status != 200) return -1;
+
+    t = fb_now();
+    pager_open(&c->pager, &c->text, NULL, NULL);
+    pager_show(&c->pager, 0);
+    g_marks.render = fb_now() - t;
+    return 0;
+}
+
+static int fb_render_more(void *user)
+{
+    fb_client_t *c = (fb_client_t*)user;
+    c->rendered = html_scan_strip(c->page.data, c->rendered, c->page.len,
+                                  FB_RENDER_STEP, NULL, &c->text);
+    return c->rendered < c->page.len;
+}
+
+/* As browser-test fetch_page (GET, no prefetch). */
+static int fb_fetch_page(fb_client_t *c, unsigned short port, const fb_page_t *fp)
+{
+    static http_response_t resp;
+    net_tls_options_t tls;
+    int rc;
+    double t;
+
+    memset(&tls, 0, sizeof(tls));
+    html_doc_reset(&c->doc);
+    page_arena_reset(&c->page);
+    page_arena_reset(&c->text);
+    c->rendered = 0;
+
+    rc = http_request(&resp, "GET", FB_HOST, port, NET_SCHEME_HTTP, &tls,
+                      fp->path, NULL, NULL, NULL);
+    if (rc != 0) return -1;
+    if (resp.content_length > 0 && resp.content_length <= c->page.limit) {
+        page_arena_reserve(&c->page, resp.content_length);
+    }
+    rc = http_read_response(&resp, page_arena_sink, &c->page);
+    http_finish(&resp);
+    g_marks.body_end = fb_now();
+    if (rc != 0 || resp.status != 200) return -1;
+    if (c->page.len != fp->body.len || memcmp(c->page.data, fp->body.data, c->page.len) != 0) {
+        fprintf(stderr, "fetch-bench: %s arrived corrupted\n", fp->name);
+        return -1;
+    }
+
+    t = fb_now();
+    html_doc_parse(&c->doc, &c->page);
+    g_marks.parse = fb_now() - t;
+
+    t = fb_now();
+    pager_open(&c->pager, &c->text, fb_render_more, c);
+    pager_show(&c->pager, 0);
+    g_marks.render = fb_now() - t;
+    return 0;
+}
+
+/* ------------------------------------------------------------------------
+ * Driver
+ * ------------------------------------------------------------------------ */
+
+typedef struct {
+    const char *name;
+    int rtt_ms;
+    long bandwidth_bps;
+} fb_link_t;
+
+/* Round trips are typical figures for the dial-up and GSM data links
+   the device is used on. */
+static const fb_link_t g_links[] = {
+    { "lan",  0,   0 },
+    { "64k",  200, 64000 },
+    { "9.6k", 700, 9600 },
+};
+#define FB_NUM_LINKS ((int)(sizeof(g_links) / sizeof(g_links[0])))
+
+static void fb_usage(void)
+{
+    fprintf(stderr,
+            "usage: fetch-bench [--link=lan|64k|9.6k] [--rtt=ms] [--bandwidth=bps]\n"
+            "                   [--chunk=bytes] [--chunked] [--client=stream|page]\n"
+            "                   [--iterations=n] [--warm] [paths]\n");
+}
+
+int main(int argc, char **argv)
+{
+    loopback_config_t cfg;
+    fb_client_t client;
+    const char *client_name = "stream";
+    int (*fetch)(fb_client_t*, unsigned short, const fb_page_t*) = fb_fetch_stream;
+    const char *link_name = "lan";
+    int iterations = 5;
+    int warm = 0;
+    int paths = 0;
+    unsigned short port;
+    double total[FB_NUM_PHASES];
+    int fetched = 0;
+    FILE *devnull;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_size = 1460;
+    for (int i = 1; i < argc; ++i) {
+        const char *a = argv[i];
+        if (strncmp(a, "--link=", 7) == 0) {
+            int k;
+            for (k = 0; k < FB_NUM_LINKS && strcmp(a + 7, g_links[k].name) != 0; ++k) {}
+            if (k == FB_NUM_LINKS) {
+                fb_usage();
+                return 2;
+            }
+            link_name = g_links[k].name;
+            cfg.rtt_ms = g_links[k].rtt_ms;
+            cfg.bandwidth_bps = g_links[k].bandwidth_bps;
+        } else if (strncmp(a, "--rtt=", 6) == 0) {
+            cfg.rtt_ms = atoi(a + 6);
+            link_name = "custom";
+        } else if (strncmp(a, "--bandwidth=", 12) == 0) {
+            cfg.bandwidth_bps = atol(a + 12);
+            link_name = "custom";
+        } else if (strncmp(a, "--chunk=", 8) == 0) {
+            cfg.chunk_size = atoi(a + 8);
+        } else if (strcmp(a, "--chunked") == 0) {
+            cfg.chunked = 1;
+        } else if (strcmp(a, "--client=stream") == 0) {
+            client_name = "stream";
+            fetch = fb_fetch_stream;
+        } else if (strcmp(a, "--client=page") == 0) {
+            client_name = "page";
+            fetch = fb_fetch_page;
+        } else if (strncmp(a, "--iterations=", 13) == 0) {
+            iterations = atoi(a + 13);
+            if (iterations < 1) iterations = 1;
+        } else if (strcmp(a, "--warm") == 0) {
+            warm = 1;
+        } else if (a[0] == '-') {
+            fb_usage();
+            return 2;
+        } else {
+            fb_load_path(a);
+            paths++;
+        }
+    }
+    if (!paths) fb_load_path("bench/corpus");
+    if (g_num_pages == 0) {
+        fprintf(stderr, "fetch-bench: no pages (run from the repository root or pass a corpus path)\n");
+        return 1;
+    }
+
+    port = loopback_start(&cfg);
+    if (!port) {
+        fprintf(stderr, "fetch-bench: cannot start loopback server\n");
+        return 1;
+    }
+    for (int p = 0; p < g_num_pages; ++p) {
+        loopback_add(g_pages[p].path, g_pages[p].body.data, g_pages[p].body.len);
+    }
+
+    /* The screen goes nowhere; only the time to produce it counts. */
+    devnull = fopen("/dev/null", "w");
+    memset(&client, 0, sizeof(client));
+    page_arena_init(&client.text, PAGE_ARENA_MAX_BYTES);
+    page_arena_init(&client.page, PAGE_ARENA_MAX_BYTES);
+    html_doc_init(&client.doc);
+    pager_init(&client.pager, PAGER_DEFAULT_ROWS, PAGER_DEFAULT_COLS);
+    if (devnull) client.pager.out = devnull;
+    net_transport_set_events(fb_on_event, NULL);
+
+    printf("link %s: rtt %d ms, %ld bps, %d-byte writes%s; client %s, %d iterations, %s\n\n",
+           link_name, cfg.rtt_ms, cfg.bandwidth_bps, cfg.chunk_size,
+           cfg.chunked ? ", chunked" : "", client_name, iterations,
+           warm ? "warm (pooled connections, cached DNS)" : "cold (new connection each fetch)");
+    printf("%-28s %6s", "page", "KB");
+    for (int k = 0; k < FB_NUM_PHASES; ++k) printf(" %9s", g_phase_names[k]);
+    printf(" %9s\n", "total ms");
+
+    memset(total, 0, sizeof(total));
+    for (int p = 0; p < g_num_pages; ++p) {
+        const fb_page_t *fp = &g_pages[p];
+        double sum[FB_NUM_PHASES], all = 0;
+        int ok = 0;
+
+        memset(sum, 0, sizeof(sum));
+        for (int it = 0; it < iterations; ++it) {
+            double ph[FB_NUM_PHASES];
+            if (!warm) {
+                net_transport_pool_flush();
+                net_dns_flush();
+            }
+            memset(&g_marks, 0, sizeof(g_marks));
+            g_marks.start = fb_now();
+            if (fetch(&client, port, fp) != 0) {
+                fprintf(stderr, "fetch-bench: %s failed: %s\n", fp->name,
+                        net_transport_failure_text(net_transport_last_failure()));
+                continue;
+            }
+            fb_phases(&g_marks, ph);
+            for (int k = 0; k < FB_NUM_PHASES; ++k) sum[k] += ph[k];
+            ok++;
+        }
+        if (!ok) continue;
+
+        printf("%-28s %6ld", fp->name, fp->body.len / 1024);
+        for (int k = 0; k < FB_NUM_PHASES; ++k) {
+            printf(" %9.2f", sum[k] / ok * 1000.0);
+            all += sum[k] / ok;
+            total[k] += sum[k] / ok;
+        }
+        printf(" %9.2f\n", all * 1000.0);
+        fetched++;
+    }
+
+    if (fetched) {
+        double all = 0;
+        printf("\n%-28s %6s", "mean per page", "");
+        for (int k = 0; k < FB_NUM_PHASES; ++k) {
+            printf(" %9.2f", total[k] / fetched * 1000.0);
+            all += total[k] / fetched;
+        }
+        printf(" %9.2f\n", all * 1000.0);
+    }
+
+    printf("\n%ld requests served\n", loopback_requests());
+    net_transport_set_events(NULL, NULL);
+    net_transport_pool_flush();
+    loopback_stop();
+
+    pager_free(&client.pager);
+    html_doc_free(&client.doc);
+    page_arena_free(&client.page);
+    page_arena_free(&client.text);
+    for (int p = 0; p < g_num_pages; ++p) page_arena_free(&g_pages[p].body);
+    if (devnull) fclose(devnull);
+    return fetched == g_num_pages ? 0 : 1;
+}
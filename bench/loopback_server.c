@@ -0,0 +1,297 @@
+#include "loopback_server.h"
+#include "sys_thread.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LOOPBACK_MAX_CONNS 16
+#define LOOPBACK_POLL_MS   50
+
+typedef struct {
+    char path[256];
+    const char *body;
+    long len;
+} loopback_body_t;
+
+typedef struct {
+    int fd;
+    int active;
+    sys_thread_t thread;
+} loopback_conn_t;
+
+static loopback_config_t g_cfg;
+static loopback_body_t g_bodies[LOOPBACK_MAX_BODIES];
+static int g_num_bodies = 0;
+static loopback_conn_t g_conns[LOOPBACK_MAX_CONNS];
+static int g_listen_fd = -1;
+static sys_thread_t g_accept_thread;
+static sys_mutex_t g_lock;            /* g_stop, g_requests, g_conns[].active */
+static int g_stop = 0;
+static long g_requests = 0;
+
+static int loopback_stopping(void)
+{
+    int stop;
+    sys_mutex_lock(&g_lock);
+    stop = g_stop;
+    sys_mutex_unlock(&g_lock);
+    return stop;
+}
+
+/* Waits for fd to become readable; 0 when it is, -1 on stop. */
+static int loopback_wait_readable(int fd)
+{
+    while (!loopback_stopping()) {
+        fd_set rd;
+        struct timeval tv;
+        FD_ZERO(&rd);
+        FD_SET(fd, &rd);
+        tv.tv_sec = 0;
+        tv.tv_usec = LOOPBACK_POLL_MS * 1000;
+        if (select(fd + 1, &rd, NULL, NULL, &tv) > 0) return 0;
+    }
+    return -1;
+}
+
+static double loopback_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void loopback_sleep(double secs)
+{
+    struct timespec ts;
+    if (secs <= 0) return;
+    ts.tv_sec = (time_t)secs;
+    ts.tv_nsec = (long)((secs - (double)ts.tv_sec) * 1e9);
+    nanosleep(&ts, NULL);
+}
+
+/* Paced writer: bytes leave no faster than the configured bandwidth,
+   measured from the start of the response. */
+typedef struct {
+    int fd;
+    double start;
+    long sent;
+} loopback_out_t;
+
+static int loopback_write(loopback_out_t *o, const char *data, long len)
+{
+    while (len > 0) {
+        long n = len;
+        ssize_t w;
+
+        if (g_cfg.chunk_size > 0 && n > g_cfg.chunk_size) n = g_cfg.chunk_size;
+        if (g_cfg.bandwidth_bps > 0) {
+            double due = o->start + (double)(o->sent + n) * 8.0 / (double)g_cfg.bandwidth_bps;
+            loopback_sleep(due - loopback_now());
+        }
+        w = send(o->fd, data, (size_t)n, MSG_NOSIGNAL);
+        if (w <= 0) return -1;
+        o->sent += w;
+        data += w;
+        len -= w;
+    }
+    return 0;
+}
+
+static const loopback_body_t *loopback_find(const char *path)
+{
+    for (int i = 0; i < g_num_bodies; ++i) {
+        if (strcmp(g_bodies[i].path, path) == 0) return &g_bodies[i];
+    }
+    return NULL;
+}
+
+static int loopback_respond(int fd, const char *path)
+{
+    const loopback_body_t *b = loopback_find(path);
+    loopback_out_t o;
+    char head[256];
+    int hlen;
+
+    loopback_sleep(g_cfg.rtt_ms / 1000.0);
+    o.fd = fd;
+    o.start = loopback_now();
+    o.sent = 0;
+
+    if (!b) {
+        static const char missing[] =
+            "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+        return loopback_write(&o, missing, (long)sizeof(missing) - 1);
+    }
+    if (!g_cfg.chunked) {
+        hlen = snprintf(head, sizeof(head),
+                        "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\n"
+                        "Content-Length: %ld\r\n\r\n", b->len);
+        if (loopback_write(&o, head, hlen) != 0) return -1;
+        return loopback_write(&o, b->body, b->len);
+    }
+
+    hlen = snprintf(head, sizeof(head),
+                    "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\n"
+                    "Transfer-Encoding: chunked\r\n\r\n");
+    if (loopback_write(&o, head, hlen) != 0) return -1;
+    for (long off = 0; off < b->len; ) {
+        long n = b->len - off;
+        if (g_cfg.chunk_size > 0 && n > g_cfg.chunk_size) n = g_cfg.chunk_size;
+        hlen = snprintf(head, sizeof(head), "%lx\r\n", n);
+        if (loopback_write(&o, head, hlen) != 0 ||
+            loopback_write(&o, b->body + off, n) != 0 ||
+            loopback_write(&o, "\r\n", 2) != 0) {
+            return -1;
+        }
+        off += n;
+    }
+    return loopback_write(&o, "0\r\n\r\n", 5);
+}
+
+/* One keep-alive connection: read a request head, answer, repeat. */
+static void loopback_serve(void *arg)
+{
+    loopback_conn_t *c = (loopback_conn_t*)arg;
+    char req[4096];
+    int have = 0;
+
+    while (loopback_wait_readable(c->fd) == 0) {
+        char *end, path[256];
+        ssize_t n = recv(c->fd, req + have, sizeof(req) - 1 - have, 0);
+        if (n <= 0) break;
+        have += (int)n;
+        req[have] = '\0';
+        if ((end = strstr(req, "\r\n\r\n")) == NULL) {
+            if (have == (int)sizeof(req) - 1) break;
+            continue;
+        }
+        if (sscanf(req, "%*s %255s", path) != 1) break;
+
+        sys_mutex_lock(&g_lock);
+        g_requests++;
+        sys_mutex_unlock(&g_lock);
+        if (loopback_respond(c->fd, path) != 0) break;
+
+        /* Keep whatever followed the head (a pipelined request). */
+        end += 4;
+        have -= (int)(end - req);
+        memmove(req, end, have);
+    }
+    close(c->fd);
+    sys_mutex_lock(&g_lock);
+    c->active = 0;
+    sys_mutex_unlock(&g_lock);
+}
+
+static void loopback_accept(void *arg)
+{
+    (void)arg;
+    while (loopback_wait_readable(g_listen_fd) == 0) {
+        int one = 1;
+        loopback_conn_t *c = NULL;
+        int fd = accept(g_listen_fd, NULL, NULL);
+        if (fd < 0) continue;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        /* Reap finished connections and take a free slot. */
+        for (int i = 0; i < LOOPBACK_MAX_CONNS && !c; ++i) {
+            int active;
+            sys_mutex_lock(&g_lock);
+            active = g_conns[i].active;
+            sys_mutex_unlock(&g_lock);
+            if (active) continue;
+            if (g_conns[i].fd >= 0) sys_thread_join(&g_conns[i].thread);
+            c = &g_conns[i];
+        }
+        if (!c) {
+            close(fd);
+            continue;
+        }
+        c->fd = fd;
+        c->active = 1;
+        if (sys_thread_start(&c->thread, loopback_serve, c, 0) != 0) {
+            close(fd);
+            c->active = 0;
+            c->fd = -1;
+        }
+    }
+}
+
+unsigned short loopback_start(const loopback_config_t *cfg)
+{
+    struct sockaddr_in addr;
+    socklen_t alen = sizeof(addr);
+    int one = 1;
+
+    g_cfg = *cfg;
+    g_stop = 0;
+    g_requests = 0;
+    for (int i = 0; i < LOOPBACK_MAX_CONNS; ++i) {
+        g_conns[i].fd = -1;
+        g_conns[i].active = 0;
+    }
+    sys_mutex_init(&g_lock);
+
+    g_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (g_listen_fd < 0) return 0;
+    setsockopt(g_listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    if (bind(g_listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(g_listen_fd, 16) != 0 ||
+        getsockname(g_listen_fd, (struct sockaddr*)&addr, &alen) != 0 ||
+        sys_thread_start(&g_accept_thread, loopback_accept, NULL, 0) != 0) {
+        close(g_listen_fd);
+        g_listen_fd = -1;
+        return 0;
+    }
+    return ntohs(addr.sin_port);
+}
+
+int loopback_add(const char *path, const char *body, long len)
+{
+    loopback_body_t *b;
+
+    if (g_num_bodies == LOOPBACK_MAX_BODIES) return -1;
+    b = &g_bodies[g_num_bodies++];
+    snprintf(b->path, sizeof(b->path), "%s", path);
+    b->body = body;
+    b->len = len;
+    return 0;
+}
+
+void loopback_stop(void)
+{
+    if (g_listen_fd < 0) return;
+    sys_mutex_lock(&g_lock);
+    g_stop = 1;
+    sys_mutex_unlock(&g_lock);
+
+    sys_thread_join(&g_accept_thread);
+    for (int i = 0; i < LOOPBACK_MAX_CONNS; ++i) {
+        if (g_conns[i].fd >= 0) sys_thread_join(&g_conns[i].thread);
+        g_conns[i].fd = -1;
+    }
+    close(g_listen_fd);
+    g_listen_fd = -1;
+    sys_mutex_destroy(&g_lock);
+}
+
+long loopback_requests(void)
+{
+    long n;
+    sys_mutex_lock(&g_lock);
+    n = g_requests;
+    sys_mutex_unlock(&g_lock);
+    return n;
+}
@@ -0,0 +1,36 @@
+#ifndef LOOPBACK_SERVER_H
+#define LOOPBACK_SERVER_H
+
+/*
+ * In-process HTTP/1.1 stand-in server on 127.0.0.1, for fetch benchmarks.
+ *
+ * Serves a fixed set of bodies by path, one thread per connection, with
+ * keep-alive. Responses can be shaped to look like a slow link: each one
+ * starts only after `rtt_ms` (request-to-first-byte round trip), and the
+ * head and body are written `chunk_size` bytes at a time, paced to
+ * `bandwidth_bps`. TCP connects complete at loopback speed; the kernel
+ * accepts them before the server sees them.
+ */
+
+typedef struct {
+    int  rtt_ms;              /* delay before each response */
+    long bandwidth_bps;       /* bits per second, 0 = unpaced */
+    int  chunk_size;          /* bytes per write (and per chunk if chunked) */
+    int  chunked;             /* Transfer-Encoding: chunked, else Content-Length */
+} loopback_config_t;
+
+#define LOOPBACK_MAX_BODIES 64
+
+/* Starts serving on an ephemeral port. Returns the port, or 0 on failure. */
+unsigned short loopback_start(const loopback_config_t *cfg);
+
+/* Serves body (not copied; must outlive the server) at path. */
+int loopback_add(const char *path, const char *body, long len);
+
+/* Closes the listener and all connections and waits for their threads. */
+void loopback_stop(void);
+
+/* Requests served since start; call before loopback_stop. */
+long loopback_requests(void);
+
+#endif
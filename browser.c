@@ -4,13 +4,41 @@
 #include <string.h>
 #include <stdlib.h>
 #include "net_transport.h"
+#include "charset.h"
+#include "dump.h"
+#include "html_stream.h"
+#include "http_client.h"
+#include "http_cache.h"
+#include "page_arena.h"
+#include "pager.h"
+#include "prerender.h"
+#include "proxy.h"
+#include "stats.h"
+#include "url.h"
 
 /*
  (C)Tsubasa Kato - Inspire Search Corporation - 2024
  Lynx-CE Ver. 0.01
  * Minimal text browser for Windows CE with a Lynx-like prompt:
  *   - Press 'g' to type a URL: e.g. http://example.com/
+ *   - Press '+' (or space) / '-' to page through it, 'j' to jump to a line
+ *   - Press 'd' to show the DNS cache (and optionally flush it)
+ *   - Press 'c' to show the HTTP disk cache (and optionally flush it)
+ *   - Press 's' to show timings and counters for the last page (--stats)
  *   - Press 'q' to quit
+ *   - Press Esc while a page is loading to abandon it
+ *
+ * Pages in UTF-8, Shift_JIS, EUC-JP or windows-1252 are shown in the
+ * console's code page, or in the one given with --charset=LABEL.
+ *
+ * Or headless, like lynx -dump: browser -dump [--dump-links] [--jobs=N]
+ * [--dump-list=FILE] [--dump-dir=DIR] URL... writes the text of each page
+ * to stdout (or DIR/1.txt, DIR/2.txt, ...) and exits.
+ *
+ * Or as a pre-rendering gateway on a desktop box: browser -gateway
+ * [--gateway-port=N] [--gateway-bind=ADDR] [--jobs=N] fetches pages for
+ * devices started with --proxy=HOST:PORT, which then get text and a link
+ * list ('l' to follow one) instead of HTML, and never do TLS themselves.
  *
  * This code uses no explicit '-lws2' or '-lcoredll'. We assume the CeGCC
  * environment links them automatically. If it doesn't, you'll have to add them.
@@ -21,84 +49,134 @@
 
 
 //------------------------------------------------------------------------------
-// Strips out everything between '<' and '>'. Very naive HTML removal.
-static void strip_html_tags(char *buffer)
+// Text of the current page, shown a screen at a time by g_pager.
+static page_arena_t g_text;
+static pager_t g_pager;
+
+// --stats: measure every page load and print the numbers after it.
+static int g_show_stats = 0;
+
+// Charset text is shown in: the console's code page, or --charset=LABEL.
+// Pages are converted to it as they are rendered.
+static charset_t g_charset;
+
+// --proxy=host:port: pages come pre-rendered from a gateway (browser
+// -gateway), with their links listed in g_links.
+static char g_proxy_host[256] = "";
+static unsigned short g_proxy_port = PROXY_DEFAULT_PORT;
+static page_arena_t g_links;
+static prerender_reader_t g_page;
+
+// One page being loaded: the tokenizer, and the conversion of its text
+// runs from the page's charset, which is settled by the first chunk.
+typedef struct
 {
-    char *r = buffer;
-    char *w = buffer;
-    int in_tag = 0;
+    html_stream_t stream;
+    charset_conv_t conv;
+    int sniffed;
+    char content_type[128];
+} page_load_t;
 
-    while (*r)
+// Text-run sink for the streaming tokenizer: runs point into the recv
+// buffer and are converted into the page text, not printed.
+static void append_text_run(void *user, const char *text, int len)
+{
+    page_load_t *load = (page_load_t*)user;
+    charset_conv(&load->conv, text, len, &g_text);
+}
+
+// Body consumer for http_read_response: tokenizes each chunk in place.
+static int feed_html_stream(void *user, const char *data, int len)
+{
+    page_load_t *load = (page_load_t*)user;
+    if (!load->sniffed)
     {
-        if (*r == '<')
-        {
-            in_tag = 1;
-        }
-        else if (*r == '>')
-        {
-            in_tag = 0;
-        }
-        else if (!in_tag)
-        {
-            *w++ = *r;
-        }
-        r++;
+        charset_t cs = charset_detect(load->content_type[0] ? load->content_type : NULL,
+                                      data, len, g_charset);
+        charset_conv_init(&load->conv, cs, g_charset);
+        load->conv.entities = 1;
+        load->sniffed = 1;
     }
-    *w = '\0';
+    html_stream_feed(&load->stream, data, len);
+    return 0;
+}
+
+// Cancel hook for net_transport: polled while a load waits on the network.
+static int escape_pressed(void *user)
+{
+    (void)user;
+    return (GetAsyncKeyState(VK_ESCAPE) & 0x8000) != 0;
 }
 
 //------------------------------------------------------------------------------
-// URL parser for http:// and https://
-static int parse_url(const char *url, net_scheme_t *scheme, char *host, int hostLen,
-                     char *path, int pathLen, unsigned short *port)
+// Asks the gateway for url. What comes back is already text plus a list
+// of absolute links (prerender.h): the lines in front are split off as
+// they arrive and the rest is appended to the page text as it is, so
+// there is no TLS, inflate or tag stripping here.
+static void fetch_via_proxy(const char *url)
 {
-    const char *p = NULL;
-    const char *slash = NULL;
-    const char *colon = NULL;
-    char hostport[256] = {0};
-
-    if (strncmp(url, "https://", 8) == 0) {
-        *scheme = NET_SCHEME_HTTPS;
-        *port = 443;
-        p = url + 8;
-    } else if (strncmp(url, "http://", 7) == 0) {
-        *scheme = NET_SCHEME_HTTP;
-        *port = 80;
-        p = url + 7;
-    } else {
-        return -1;
-    }
-
-    slash = strchr(p, '/');
-    if (!slash) {
-        strncpy(hostport, p, sizeof(hostport) - 1);
-        strcpy(path, "/");
-    } else {
-        int hpLen = (int)(slash - p);
-        if (hpLen <= 0 || hpLen >= (int)sizeof(hostport)) return -1;
-        strncpy(hostport, p, hpLen);
-        hostport[hpLen] = '\0';
-        strncpy(path, slash, pathLen - 1);
-        path[pathLen - 1] = '\0';
-    }
-
-    colon = strchr(hostport, ':');
-    if (colon) {
-        int hLen = (int)(colon - hostport);
-        if (hLen <= 0 || hLen >= hostLen) return -1;
-        strncpy(host, hostport, hLen);
-        host[hLen] = '\0';
-        *port = (unsigned short)atoi(colon + 1);
-    } else {
-        strncpy(host, hostport, hostLen - 1);
-        host[hostLen - 1] = '\0';
+    static http_response_t resp;
+    net_tls_options_t plain;
+    char accept[128], type[128];
+    charset_t from = CHARSET_UTF8;
+    int rc;
+
+    memset(&plain, 0, sizeof(plain));
+    stats_reset();
+    page_arena_reset(&g_text);
+    page_arena_reset(&g_links);
+    // No links until the gateway answers: 'l' must not find the last page's.
+    prerender_reader_init(&g_page, &g_text, &g_links, CHARSET_UTF8, g_charset);
+    // The gateway converts the text to our charset, so it is shown as is.
+    snprintf(accept, sizeof(accept), "Accept: %s\r\nAccept-Charset: %s\r\n",
+             PRERENDER_CONTENT_TYPE, charset_name(g_charset));
+    if (http_request(&resp, "GET", g_proxy_host, g_proxy_port, NET_SCHEME_HTTP, &plain,
+                     url, NULL, NULL, accept) != 0)
+    {
+        printf("Gateway %s:%u failed: %s.\n", g_proxy_host, g_proxy_port,
+               net_transport_failure_text(net_transport_last_failure()));
+        if (g_show_stats) stats_print();
+        return;
+    }
+    if (http_header(&resp, "Content-Type", type, sizeof(type)) == 0 &&
+        charset_from_content_type(type) != CHARSET_UNKNOWN)
+        from = charset_from_content_type(type);
+    charset_conv_init(&g_page.conv, from, g_charset);
+    rc = http_read_response(&resp, prerender_read, &g_page);
+    http_finish(&resp);
+    charset_conv_finish(&g_page.conv, &g_text);
+    if (g_page.status == 0 && resp.status != 502)
+    {
+        printf("Gateway refused the request [HTTP %d].\n", resp.status);
+        if (g_show_stats) stats_print();
+        return;
     }
 
-    return 0;
+    if (g_page.title[0]) printf("%s\n", g_page.title);
+    pager_open(&g_pager, &g_text, NULL, NULL);
+    pager_show(&g_pager, 0);
+    if (rc != 0)
+    {
+        net_fail_t why = net_transport_last_failure();
+        if (why == NET_FAIL_CANCELLED || why == NET_FAIL_TIMEOUT)
+            printf("[Transfer %s]\n", net_transport_failure_text(why));
+        else
+            printf("[Transfer interrupted]\n");
+    }
+    if (g_page.status == 0)
+        printf("[Gateway could not fetch the page]\n");
+    else if (g_page.status != 200)
+        printf("[HTTP %d]\n", g_page.status);
+    if (g_page.url[0] && strcmp(g_page.url, url) != 0)
+        printf("[Redirected to %s]\n", g_page.url);
+    if (g_page.num_links > 0)
+        printf("[%d links, 'l' to follow one]\n", g_page.num_links);
+    if (g_show_stats) stats_print();
 }
 
 //------------------------------------------------------------------------------
-// Sends a GET request to the given URL, reads the response, strips HTML, prints text.
+// Sends a GET request to the given URL, reads the response, strips HTML and
+// shows the first screen of text.
 static void fetch_url(const char *url, const net_tls_options_t *tls_opts)
 {
     char host[256] = {0};
@@ -106,72 +184,70 @@ static void fetch_url(const char *url, const net_tls_options_t *tls_opts)
     unsigned short port = 0;
     net_scheme_t scheme;
 
-    if (parse_url(url, &scheme, host, sizeof(host), path, sizeof(path), &port) != 0)
+    if (url_parse(url, &scheme, host, sizeof(host), path, sizeof(path), &port) != 0)
     {
         printf("Error: Malformed or unsupported URL. Try http://example.com/ or https://example.com/\n");
         return;
     }
 
-    net_tls_options_t effective_tls = *tls_opts;
-    effective_tls.server_name = host;
-
-    net_transport_t transport;
-    if (net_transport_connect(&transport, host, port, scheme, &effective_tls) != 0)
+    if (g_proxy_host[0])
     {
-        printf("connect() failed.\n");
+        fetch_via_proxy(url);
         return;
     }
 
-    // Build a minimal HTTP GET request
-    char request[1024];
-    snprintf(request, sizeof(request),
-             "GET %s HTTP/1.0\r\n"
-             "Host: %s\r\n"
-             "Connection: close\r\n"
-             "User-Agent: CE-Lynx/1.0\r\n\r\n",
-             path, host);
+    net_tls_options_t effective_tls = *tls_opts;
+    effective_tls.server_name = host;
+    stats_reset();
+
+    // HTTP/1.1 GET over a pooled keep-alive connection: following links on
+    // the same site skips DNS, TCP connect and the TLS handshake. With
+    // --cache-dir, fresh pages come from disk and stale ones are revalidated.
+    // Body bytes are pushed to the tokenizer as they arrive; reading stops
+    // at Content-Length or the last chunk instead of waiting for close.
+    // The page's charset comes from its Content-Type (handed over before
+    // the first body byte) or, failing that, from the first chunk.
+    static page_load_t load;
+    http_cache_result_t from;
+    int status;
+    int rc;
 
-    // Send it
-    if (net_transport_send(&transport, request, (int)strlen(request)) <= 0)
+    page_arena_reset(&g_text);
+    html_stream_init(&load.stream, 0, append_text_run, &load);
+    load.sniffed = 0;
+    load.content_type[0] = '\0';
+    rc = http_cached_get(url, host, port, scheme, &effective_tls, path,
+                         feed_html_stream, &load, &status, &from,
+                         load.content_type, sizeof(load.content_type));
+    if (load.sniffed) charset_conv_finish(&load.conv, &g_text);
+    if (status == 0)
     {
-        printf("send() failed.\n");
-        net_transport_close(&transport);
+        printf("Request failed: %s.\n", net_transport_failure_text(net_transport_last_failure()));
+        if (g_show_stats) stats_print();
         return;
     }
 
-    // Read the response, strip headers, remove HTML tags
-    int headers_done = 0;
-    char buffer[1024];
-    int received;
-
-    while ((received = net_transport_recv(&transport, buffer, sizeof(buffer) - 1)) > 0)
+    // Only the first screen is drawn: a long page no longer has to
+    // scroll through the console before the prompt comes back.
+    pager_open(&g_pager, &g_text, NULL, NULL);
+    pager_show(&g_pager, 0);
+    if (rc != 0)
     {
-        buffer[received] = '\0';
-
-        if (!headers_done)
-        {
-            // Look for "\r\n\r\n" to mark end of headers
-            char *body = strstr(buffer, "\r\n\r\n");
-            if (body)
-            {
-                headers_done = 1;
-                body += 4;  // skip the \r\n\r\n
-                strip_html_tags(body);
-                printf("%s", body);
-            }
-            // If we haven't seen headers end yet, do nothing with partial data
-        }
+        net_fail_t why = net_transport_last_failure();
+        if (why == NET_FAIL_CANCELLED || why == NET_FAIL_TIMEOUT)
+            printf("[Transfer %s]\n", net_transport_failure_text(why));
         else
-        {
-            // Already reading body
-            strip_html_tags(buffer);
-            printf("%s", buffer);
-        }
+            printf("[Transfer interrupted]\n");
     }
-
-    printf("\n");  // extra newline after printing
-
-    net_transport_close(&transport);
+    if (status != 200)
+    {
+        printf("[HTTP %d]\n", status);
+    }
+    if (from != HTTP_CACHE_MISS)
+    {
+        printf("[%s]\n", from == HTTP_CACHE_HIT ? "from cache" : "revalidated, from cache");
+    }
+    if (g_show_stats) stats_print();
 }
 
 //------------------------------------------------------------------------------
@@ -187,10 +263,116 @@ int main(int argc, char **argv)
     }
 
     net_tls_options_t tls_opts;
+    const char *cache_dir = NULL;
+    long cache_bytes = HTTP_CACHE_DEFAULT_BYTES;
+    unsigned long connect_ms = NET_DEFAULT_CONNECT_MS;
+    unsigned long first_byte_ms = NET_DEFAULT_FIRST_BYTE_MS;
+    unsigned long idle_ms = NET_DEFAULT_IDLE_MS;
+    int rows = PAGER_DEFAULT_ROWS;
+    int cols = PAGER_DEFAULT_COLS;
+    int dump = 0;
+    int gateway = 0;
+    charset_t charset = CHARSET_UNKNOWN;
+    proxy_options_t gateway_opts;
+    dump_options_t dump_opts;
+    dump_list_t dump_urls;
     memset(&tls_opts, 0, sizeof(tls_opts));
+    memset(&dump_opts, 0, sizeof(dump_opts));
+    memset(&gateway_opts, 0, sizeof(gateway_opts));
+    gateway_opts.port = PROXY_DEFAULT_PORT;
+    gateway_opts.jobs = PROXY_DEFAULT_JOBS;
+    gateway_opts.tls = &tls_opts;
+    dump_opts.jobs = DUMP_DEFAULT_JOBS;
+    dump_opts.tls = &tls_opts;
+    dump_list_init(&dump_urls);
     for (int i = 1; i < argc; ++i) {
         if (strcmp(argv[i], "--tls-insecure") == 0) tls_opts.tls_insecure = 1;
         else if (strncmp(argv[i], "--ca-bundle=", 12) == 0) tls_opts.ca_bundle_path = argv[i] + 12;
+        else if (strncmp(argv[i], "--cache-dir=", 12) == 0) cache_dir = argv[i] + 12;
+        else if (strncmp(argv[i], "--cache-size=", 13) == 0) cache_bytes = atol(argv[i] + 13) * 1024L;
+        else if (strncmp(argv[i], "--dns-ttl=", 10) == 0)
+            net_dns_config(strtoul(argv[i] + 10, NULL, 10) * 1000UL, NET_DNS_NEGATIVE_TTL_MS);
+        else if (strncmp(argv[i], "--connect-timeout=", 18) == 0)
+            connect_ms = strtoul(argv[i] + 18, NULL, 10) * 1000UL;
+        else if (strncmp(argv[i], "--first-byte-timeout=", 21) == 0)
+            first_byte_ms = strtoul(argv[i] + 21, NULL, 10) * 1000UL;
+        else if (strncmp(argv[i], "--idle-timeout=", 15) == 0)
+            idle_ms = strtoul(argv[i] + 15, NULL, 10) * 1000UL;
+        else if (strncmp(argv[i], "--rows=", 7) == 0) rows = atoi(argv[i] + 7);
+        else if (strncmp(argv[i], "--cols=", 7) == 0) cols = atoi(argv[i] + 7);
+        else if (strcmp(argv[i], "--stats") == 0) g_show_stats = 1;
+        else if (strncmp(argv[i], "--charset=", 10) == 0)
+        {
+            charset = charset_from_name(argv[i] + 10, -1);
+            if (charset == CHARSET_UNKNOWN || charset == CHARSET_UTF16LE)
+                fprintf(stderr, "Unknown charset %s, using the console's\n", argv[i] + 10);
+        }
+        else if (strcmp(argv[i], "-dump") == 0) dump = 1;
+        else if (strcmp(argv[i], "--dump-links") == 0) dump_opts.links = 1;
+        else if (strncmp(argv[i], "--dump-dir=", 11) == 0) dump_opts.out_dir = argv[i] + 11;
+        else if (strncmp(argv[i], "--jobs=", 7) == 0)
+            dump_opts.jobs = gateway_opts.jobs = atoi(argv[i] + 7);
+        else if (strcmp(argv[i], "-gateway") == 0) gateway = 1;
+        else if (strncmp(argv[i], "--gateway-port=", 15) == 0)
+            gateway_opts.port = (unsigned short)atoi(argv[i] + 15);
+        else if (strncmp(argv[i], "--gateway-bind=", 15) == 0) gateway_opts.bind_addr = argv[i] + 15;
+        else if (strncmp(argv[i], "--proxy=", 8) == 0)
+        {
+            char *colon;
+            snprintf(g_proxy_host, sizeof(g_proxy_host), "%s", argv[i] + 8);
+            colon = strrchr(g_proxy_host, ':');
+            if (colon)
+            {
+                *colon = '\0';
+                g_proxy_port = (unsigned short)atoi(colon + 1);
+            }
+        }
+        else if (strncmp(argv[i], "--dump-list=", 12) == 0)
+        {
+            if (dump_list_read(&dump_urls, argv[i] + 12) != 0)
+                fprintf(stderr, "Cannot read URL list %s\n", argv[i] + 12);
+        }
+        else if (argv[i][0] != '-') dump_list_add(&dump_urls, argv[i]);
+    }
+    g_charset = charset != CHARSET_UNKNOWN && charset != CHARSET_UTF16LE ? charset : charset_device();
+    dump_opts.charset = g_charset;
+    stats_init();
+    stats_enable(g_show_stats);
+    net_transport_timeouts(connect_ms, first_byte_ms, idle_ms);
+
+    // -dump: no prompt, no pager; fetch the list in parallel and exit.
+    if (dump)
+    {
+        int failed = dump_run(&dump_urls, &dump_opts);
+        dump_list_free(&dump_urls);
+        net_transport_pool_flush();
+        WSACleanup();
+        return failed ? 1 : 0;
+    }
+    dump_list_free(&dump_urls);
+
+    // -gateway: serve pre-rendered pages to --proxy clients until killed.
+    if (gateway)
+    {
+        if (proxy_run(&gateway_opts) != 0)
+        {
+            fprintf(stderr, "Cannot listen on port %u\n", gateway_opts.port);
+            WSACleanup();
+            return 1;
+        }
+        WSACleanup();
+        return 0;
+    }
+
+    net_transport_set_cancel(escape_pressed, NULL);
+    page_arena_init(&g_text, PAGE_ARENA_MAX_BYTES);
+    page_arena_init(&g_links, PAGE_ARENA_MAX_BYTES);
+    pager_init(&g_pager, rows, cols);
+    g_pager.charset = g_charset;
+
+    if (cache_dir && http_cache_open(cache_dir, cache_bytes) != 0)
+    {
+        printf("Cannot use cache directory %s\n", cache_dir);
     }
 
     printf("Minimal CE-Lynx Demo\n");
@@ -198,7 +380,7 @@ int main(int argc, char **argv)
 
     while (1)
     {
-        printf("\nCommand (g=Go, q=Quit): ");
+        printf("\nCommand (g=Go, +/-=Page, j=Jump, l=Links, d=DNS cache, c=HTTP cache, s=Stats, q=Quit): ");
 
         int c = getchar();
         // Clear out any trailing chars up to newline
@@ -229,14 +411,88 @@ int main(int argc, char **argv)
                 url[len - 1] = '\0';
 
             // Attempt to fetch
+            printf("(Esc to cancel)\n");
             fetch_url(url, &tls_opts);
         }
+        else if (c == '+' || c == ' ')
+        {
+            pager_next(&g_pager);
+        }
+        else if (c == '-')
+        {
+            pager_prev(&g_pager);
+        }
+        else if (c == 'j' || c == 'J')
+        {
+            char line[32];
+            printf("Line number: ");
+            fflush(stdout);
+            if (fgets(line, sizeof(line), stdin))
+                pager_show(&g_pager, atoi(line) - 1);
+        }
+        else if (c == 'l' || c == 'L')
+        {
+            // Only gateway pages come with their links picked out.
+            char line[32], link[PRERENDER_MAX_LINE];
+            if (g_page.num_links == 0)
+            {
+                printf(g_proxy_host[0] ? "No links on this page.\n"
+                                       : "Links are listed for pages fetched through --proxy.\n");
+                continue;
+            }
+            for (int n = 1; prerender_link(&g_page, n, link, sizeof(link)) == 0; ++n)
+                printf("[%d] %s\n", n, link);
+            printf("Link number to follow (Enter for none): ");
+            fflush(stdout);
+            if (fgets(line, sizeof(line), stdin) &&
+                prerender_link(&g_page, atoi(line), link, sizeof(link)) == 0)
+            {
+                printf("(Esc to cancel)\n");
+                fetch_url(link, &tls_opts);
+            }
+        }
+        else if (c == 'd' || c == 'D')
+        {
+            char answer[8];
+            net_dns_print();
+            printf("Flush DNS cache? (y/n): ");
+            fflush(stdout);
+            if (fgets(answer, sizeof(answer), stdin) && (answer[0] == 'y' || answer[0] == 'Y'))
+            {
+                net_dns_flush();
+                printf("DNS cache flushed.\n");
+            }
+        }
+        else if (c == 'c' || c == 'C')
+        {
+            char answer[8];
+            http_cache_print();
+            if (http_cache_enabled())
+            {
+                printf("Flush HTTP cache? (y/n): ");
+                fflush(stdout);
+                if (fgets(answer, sizeof(answer), stdin) && (answer[0] == 'y' || answer[0] == 'Y'))
+                {
+                    http_cache_flush();
+                    printf("HTTP cache flushed.\n");
+                }
+            }
+        }
+        else if (c == 's' || c == 'S')
+        {
+            stats_print();
+        }
         else
         {
             printf("Unknown command '%c'\n", c);
         }
     }
 
+    pager_free(&g_pager);
+    page_arena_free(&g_text);
+    page_arena_free(&g_links);
+    http_cache_close();
+    net_transport_pool_flush();
     WSACleanup();
     return 0;
 }
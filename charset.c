@@ -0,0 +1,732 @@
+#include <windows.h>
+#include "charset.h"
+#include "charset_tables.h"
+#include "scan_kernel.h"
+
+#include <string.h>
+
+#define CHARSET_REPLACEMENT 0xFFFD
+#define CHARSET_OUT_BUF     256
+#define CHARSET_GUESS_BYTES 65536   /* of an undeclared page, to guess from */
+
+/* Decoders hand Shift_JIS output a JIS pointer as CHARSET_JIS + pointer,
+   so EUC-JP needs no table to get there. */
+#define CHARSET_JIS         0x110000u
+
+/* windows-1252 0x80-0x9F; the five unassigned bytes map to themselves. */
+static const unsigned short g_cp1252_high[32] = {
+    0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x008D, 0x017D, 0x008F,
+    0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178
+};
+
+/* Characters Windows-31J has under another code point (JIS X 0208 as
+   Unicode mapped it vs. as Windows does): the same glyph on screen. */
+static const unsigned short g_sjis_fold[][2] = {
+    { 0x00A2, 0xFFE0 }, { 0x00A3, 0xFFE1 }, { 0x00AC, 0xFFE2 }, { 0x2014, 0x2015 },
+    { 0x2016, 0x2225 }, { 0x2212, 0xFF0D }, { 0x301C, 0xFF5E }
+};
+
+static const struct {
+    const char *label;
+    charset_t charset;
+} g_labels[] = {
+    { "utf-8", CHARSET_UTF8 },
+    { "utf8", CHARSET_UTF8 },
+    { "unicode-1-1-utf-8", CHARSET_UTF8 },
+    { "shift_jis", CHARSET_SHIFT_JIS },
+    { "shift-jis", CHARSET_SHIFT_JIS },
+    { "sjis", CHARSET_SHIFT_JIS },
+    { "x-sjis", CHARSET_SHIFT_JIS },
+    { "ms_kanji", CHARSET_SHIFT_JIS },
+    { "csshiftjis", CHARSET_SHIFT_JIS },
+    { "windows-31j", CHARSET_SHIFT_JIS },
+    { "ms932", CHARSET_SHIFT_JIS },
+    { "cp932", CHARSET_SHIFT_JIS },
+    { "euc-jp", CHARSET_EUC_JP },
+    { "x-euc-jp", CHARSET_EUC_JP },
+    { "cseucpkdfmtjapanese", CHARSET_EUC_JP },
+    { "windows-1252", CHARSET_WINDOWS_1252 },
+    { "cp1252", CHARSET_WINDOWS_1252 },
+    { "x-cp1252", CHARSET_WINDOWS_1252 },
+    { "iso-8859-1", CHARSET_WINDOWS_1252 },
+    { "iso8859-1", CHARSET_WINDOWS_1252 },
+    { "iso_8859-1", CHARSET_WINDOWS_1252 },
+    { "latin1", CHARSET_WINDOWS_1252 },
+    { "l1", CHARSET_WINDOWS_1252 },
+    { "us-ascii", CHARSET_WINDOWS_1252 },
+    { "ascii", CHARSET_WINDOWS_1252 }
+};
+
+/* ------------------------------------------------------------------------
+ * Labels and detection
+ * ------------------------------------------------------------------------ */
+
+static char charset_lower(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+static int charset_is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f';
+}
+
+charset_t charset_from_name(const char *name, int len)
+{
+    if (len < 0) len = (int)strlen(name);
+    while (len > 0 && charset_is_space(*name)) {
+        name++;
+        len--;
+    }
+    while (len > 0 && charset_is_space(name[len - 1])) len--;
+
+    for (size_t i = 0; i < sizeof(g_labels) / sizeof(g_labels[0]); ++i) {
+        const char *label = g_labels[i].label;
+        int k = 0;
+        while (k < len && label[k] && charset_lower(name[k]) == label[k]) k++;
+        if (k == len && !label[k]) return g_labels[i].charset;
+    }
+    return CHARSET_UNKNOWN;
+}
+
+const char *charset_name(charset_t cs)
+{
+    switch (cs) {
+    case CHARSET_UTF8:         return "utf-8";
+    case CHARSET_SHIFT_JIS:    return "shift_jis";
+    case CHARSET_EUC_JP:       return "euc-jp";
+    case CHARSET_WINDOWS_1252: return "windows-1252";
+    case CHARSET_UTF16LE:      return "utf-16le";
+    default:                   return "unknown";
+    }
+}
+
+/* Case-insensitive search for a lower-case word in [s, end). */
+static const char *charset_find(const char *s, const char *end, const char *word)
+{
+    int n = (int)strlen(word);
+
+    for (; end - s >= n; ++s) {
+        int k = 0;
+        while (k < n && charset_lower(s[k]) == word[k]) k++;
+        if (k == n) return s;
+    }
+    return NULL;
+}
+
+/* "charset = value" somewhere in [s, end), value optionally quoted. */
+static charset_t charset_param(const char *s, const char *end)
+{
+    const char *value;
+
+    while ((s = charset_find(s, end, "charset")) != NULL) {
+        s += 7;
+        while (s < end && charset_is_space(*s)) s++;
+        if (s < end && *s == '=') break;
+    }
+    if (!s) return CHARSET_UNKNOWN;
+    s++;
+    while (s < end && (charset_is_space(*s) || *s == '"' || *s == '\'')) s++;
+    value = s;
+    while (s < end && *s != '"' && *s != '\'' && *s != ';' && *s != '>' && !charset_is_space(*s)) s++;
+    return charset_from_name(value, (int)(s - value));
+}
+
+charset_t charset_from_content_type(const char *content_type)
+{
+    if (!content_type) return CHARSET_UNKNOWN;
+    return charset_param(content_type, content_type + strlen(content_type));
+}
+
+/* <meta charset=...> or <meta http-equiv=... content="...; charset=...">:
+   either way, a charset= inside a meta tag. */
+static charset_t charset_meta(const char *data, int len)
+{
+    const char *end = data + (len < CHARSET_SNIFF_BYTES ? len : CHARSET_SNIFF_BYTES);
+    const char *s = data;
+
+    while ((s = charset_find(s, end, "<meta")) != NULL) {
+        const char *gt = memchr(s, '>', end - s);
+        charset_t cs = charset_param(s + 5, gt ? gt : end);
+        if (cs != CHARSET_UNKNOWN) return cs;
+        if (!gt) break;
+        s = gt;
+    }
+    return CHARSET_UNKNOWN;
+}
+
+static int charset_decode(charset_t from, int to_sjis, const unsigned char *p,
+                          const unsigned char *end, unsigned *cp);
+
+/* Undeclared pages: UTF-8 if the bytes are valid UTF-8, else EUC-JP or
+   Shift_JIS if valid as that, else windows-1252. Accented Latin letters
+   followed by ASCII can pass as Shift_JIS (as kanji), so that also needs
+   a quarter of the double-byte characters to be kana, CJK punctuation or
+   full-width forms, whose lead bytes 0x81-0x83 Latin text hardly uses. */
+static charset_t charset_guess(const unsigned char *p, const unsigned char *end, charset_t fallback)
+{
+    static const charset_t order[3] = { CHARSET_UTF8, CHARSET_EUC_JP, CHARSET_SHIFT_JIS };
+
+    if ((const unsigned char*)scan_find_high((const char*)p, (const char*)end) == end) return fallback;
+    for (int i = 0; i < 3; ++i) {
+        const unsigned char *q = p;
+        int wide = 0, kana = 0;
+        unsigned cp;
+        int n = 1;
+
+        while (q < end) {
+            if (*q < 0x80) {
+                q++;
+                continue;
+            }
+            n = charset_decode(order[i], 0, q, end, &cp);
+            if (n == 0) break;               /* cut off at the end */
+            if (cp == CHARSET_REPLACEMENT) break;
+            if (n == 2) {
+                wide++;
+                if ((cp >= 0x3000 && cp <= 0x30FF) || (cp >= 0xFF01 && cp <= 0xFF5E)) kana++;
+            }
+            q += n;
+        }
+        if ((q == end || n == 0) && (order[i] != CHARSET_SHIFT_JIS || (wide > 0 && kana * 4 >= wide))) {
+            return order[i];
+        }
+    }
+    return CHARSET_WINDOWS_1252;
+}
+
+charset_t charset_detect(const char *content_type, const char *data, int len,
+                         charset_t fallback)
+{
+    charset_t cs;
+
+    if (len >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0) return CHARSET_UTF8;
+    cs = charset_from_content_type(content_type);
+    if (cs == CHARSET_UNKNOWN) cs = charset_meta(data, len);
+    if (cs == CHARSET_UNKNOWN) {
+        if (len > CHARSET_GUESS_BYTES) len = CHARSET_GUESS_BYTES;
+        cs = charset_guess((const unsigned char*)data, (const unsigned char*)data + len, fallback);
+    }
+    return cs;
+}
+
+charset_t charset_device(void)
+{
+    switch (GetACP()) {
+    case 65001: return CHARSET_UTF8;
+    case 932:   return CHARSET_SHIFT_JIS;
+    default:    return CHARSET_WINDOWS_1252;
+    }
+}
+
+/* ------------------------------------------------------------------------
+ * JIS X 0208
+ * ------------------------------------------------------------------------ */
+
+/* 0 if the pointer has no character. */
+static unsigned charset_jis_char(unsigned pointer)
+{
+    unsigned row = pointer / 94;
+
+    if (pointer >= JIS_PUA_FIRST && pointer <= JIS_PUA_LAST) return 0xE000 + pointer - JIS_PUA_FIRST;
+    if (row >= JIS_ROWS || g_jis_row[row] == JIS_NO_ROW) return 0;
+    return g_jis_cells[g_jis_row[row] * 94 + pointer % 94];
+}
+
+static int charset_popcount(unsigned int w)
+{
+#ifdef __GNUC__
+    return __builtin_popcount(w);
+#else
+    int n = 0;
+    for (; w; w &= w - 1) n++;
+    return n;
+#endif
+}
+
+/* Pointer to encode cp with, or -1: its place among the encodable
+   characters is the start of its 256-character block plus the bits set
+   below it in the block's bitmap. */
+static int charset_jis_pointer(unsigned cp)
+{
+    const unsigned int *bits;
+    unsigned lo = cp & 0xFF, w = lo >> 5;
+    int k;
+
+    if (cp >= 0xE000 && cp <= 0xE000 + JIS_PUA_LAST - JIS_PUA_FIRST) return (int)(cp - 0xE000 + JIS_PUA_FIRST);
+    if (cp > 0xFFFF || g_jis_block[cp >> 8] == JIS_NO_ROW) return -1;
+    bits = g_jis_bits + g_jis_block[cp >> 8] * 8;
+    if (!(bits[w] >> (lo & 31) & 1)) return -1;
+    k = g_jis_bucket[cp >> 8] + charset_popcount(bits[w] & ((1u << (lo & 31)) - 1));
+    for (unsigned i = 0; i < w; ++i) k += charset_popcount(bits[i]);
+    return g_jis_by_char[k];
+}
+
+/* ------------------------------------------------------------------------
+ * Decoding: one character from p (*p >= 0x80)
+ * ------------------------------------------------------------------------ */
+
+/* Returns the bytes used, or 0 if the character is cut off at end. Bad
+   bytes give CHARSET_REPLACEMENT; an ASCII byte that cannot be a trail
+   byte is not used, so it is read again as itself. */
+static int charset_decode(charset_t from, int to_sjis, const unsigned char *p,
+                          const unsigned char *end, unsigned *cp)
+{
+    unsigned b = p[0], t, u, pointer;
+
+    *cp = CHARSET_REPLACEMENT;
+    switch (from) {
+    case CHARSET_UTF8: {
+        unsigned lo = 0x80, hi = 0xBF;
+        int n;
+        if (b < 0xC2 || b > 0xF4) return 1;
+        n = b < 0xE0 ? 2 : b < 0xF0 ? 3 : 4;
+        if (b == 0xE0) lo = 0xA0;
+        else if (b == 0xED) hi = 0x9F;        /* no surrogates */
+        else if (b == 0xF0) lo = 0x90;
+        else if (b == 0xF4) hi = 0x8F;
+        u = b & (0x7F >> n);
+        for (int i = 1; i < n; ++i) {
+            if (p + i >= end) return 0;
+            if (p[i] < lo || p[i] > hi) return i;
+            lo = 0x80;
+            hi = 0xBF;
+            u = u << 6 | (p[i] & 0x3F);
+        }
+        *cp = u;
+        return n;
+    }
+
+    case CHARSET_SHIFT_JIS:
+        if (b == 0x80) {
+            *cp = 0x80;
+            return 1;
+        }
+        if (b >= 0xA1 && b <= 0xDF) {
+            *cp = 0xFF61 + b - 0xA1;       /* half-width katakana */
+            return 1;
+        }
+        if (b > 0xFC || b == 0xA0) return 1;
+        if (p + 1 >= end) return 0;
+        t = p[1];
+        if (t < 0x40 || t == 0x7F || t > 0xFC) return t < 0x80 ? 1 : 2;
+        pointer = (b - (b < 0xA0 ? 0x81 : 0xC1)) * 188 + t - (t < 0x7F ? 0x40 : 0x41);
+        break;
+
+    case CHARSET_EUC_JP:
+        if (b == 0x8F) {
+            /* JIS X 0212: not in the tables. */
+            for (int i = 1; i < 3; ++i) {
+                if (p + i >= end) return 0;
+                if (p[i] < 0xA1 || p[i] > 0xFE) return p[i] < 0x80 ? i : i + 1;
+            }
+            return 3;
+        }
+        if (b != 0x8E && (b < 0xA1 || b > 0xFE)) return 1;
+        if (p + 1 >= end) return 0;
+        t = p[1];
+        if (b == 0x8E) {
+            if (t < 0xA1 || t > 0xDF) return t < 0x80 ? 1 : 2;
+            *cp = 0xFF61 + t - 0xA1;
+            return 2;
+        }
+        if (t < 0xA1 || t > 0xFE) return t < 0x80 ? 1 : 2;
+        pointer = (b - 0xA1) * 94 + t - 0xA1;
+        break;
+
+    case CHARSET_WINDOWS_1252:
+        *cp = b < 0xA0 ? g_cp1252_high[b - 0x80] : b;
+        return 1;
+
+    default:
+        return 1;
+    }
+
+    /* A double-byte JIS code. */
+    if ((u = charset_jis_char(pointer)) != 0) *cp = to_sjis ? CHARSET_JIS + pointer : u;
+    return 2;
+}
+
+/* ------------------------------------------------------------------------
+ * Encoding
+ * ------------------------------------------------------------------------ */
+
+typedef struct {
+    page_arena_t *arena;
+    int len;
+    char buf[CHARSET_OUT_BUF];
+} charset_out_t;
+
+static void charset_flush(charset_out_t *o)
+{
+    if (o->len > 0) page_arena_append(o->arena, o->buf, o->len);
+    o->len = 0;
+}
+
+static void charset_put_sjis(charset_out_t *o, unsigned pointer)
+{
+    unsigned lead = pointer / 188, trail = pointer % 188;
+    o->buf[o->len++] = (char)(lead + (lead < 0x1F ? 0x81 : 0xC1));
+    o->buf[o->len++] = (char)(trail + (trail < 0x3F ? 0x40 : 0x41));
+}
+
+static void charset_put_euc(charset_out_t *o, unsigned pointer)
+{
+    o->buf[o->len++] = (char)(pointer / 94 + 0xA1);
+    o->buf[o->len++] = (char)(pointer % 94 + 0xA1);
+}
+
+/* EUC-JP has the 94 x 94 rows only. The IBM extensions past them (Shift_JIS
+   FA-FC) are also in the NEC-selected rows 89-92, which the encoder for
+   Shift_JIS passes over: look there for those. */
+static int charset_euc_pointer(unsigned cp)
+{
+    int pointer = charset_jis_pointer(cp);
+
+    if (pointer < 0) {
+        for (size_t i = 0; i < sizeof(g_sjis_fold) / sizeof(g_sjis_fold[0]); ++i) {
+            if (g_sjis_fold[i][0] == cp) pointer = charset_jis_pointer(g_sjis_fold[i][1]);
+        }
+    }
+    if (pointer < JIS_PUA_FIRST) return pointer;
+    for (unsigned p = JIS_NEC_IBM_FIRST; p <= JIS_NEC_IBM_LAST; ++p) {
+        if (charset_jis_char(p) == cp) return (int)p;
+    }
+    return -1;
+}
+
+static void charset_put(charset_conv_t *c, charset_out_t *o, unsigned cp)
+{
+    unsigned char *q;
+    int pointer;
+
+    if (o->len > CHARSET_OUT_BUF - 4) charset_flush(o);
+    if (cp == CHARSET_REPLACEMENT) c->replaced++;
+    q = (unsigned char*)o->buf + o->len;
+
+    switch (c->to) {
+    case CHARSET_UTF8:
+        if (cp < 0x80) {
+            q[0] = (unsigned char)cp;
+            o->len += 1;
+        } else if (cp < 0x800) {
+            q[0] = (unsigned char)(0xC0 | cp >> 6);
+            q[1] = (unsigned char)(0x80 | (cp & 0x3F));
+            o->len += 2;
+        } else if (cp < 0x10000) {
+            q[0] = (unsigned char)(0xE0 | cp >> 12);
+            q[1] = (unsigned char)(0x80 | (cp >> 6 & 0x3F));
+            q[2] = (unsigned char)(0x80 | (cp & 0x3F));
+            o->len += 3;
+        } else {
+            q[0] = (unsigned char)(0xF0 | cp >> 18);
+            q[1] = (unsigned char)(0x80 | (cp >> 12 & 0x3F));
+            q[2] = (unsigned char)(0x80 | (cp >> 6 & 0x3F));
+            q[3] = (unsigned char)(0x80 | (cp & 0x3F));
+            o->len += 4;
+        }
+        return;
+
+    case CHARSET_UTF16LE:
+        if (cp >= 0x10000) {
+            unsigned hi = 0xD800 + ((cp - 0x10000) >> 10);
+            q[0] = (unsigned char)hi;
+            q[1] = (unsigned char)(hi >> 8);
+            cp = 0xDC00 + (cp & 0x3FF);
+            q += 2;
+            o->len += 2;
+        }
+        q[0] = (unsigned char)cp;
+        q[1] = (unsigned char)(cp >> 8);
+        o->len += 2;
+        return;
+
+    case CHARSET_EUC_JP:
+        if (cp < 0x80 || cp == 0xA0 || cp == 0xA5 || cp == 0x203E) {
+            q[0] = (unsigned char)(cp == 0xA0 ? 0x20 : cp == 0xA5 ? 0x5C : cp == 0x203E ? 0x7E : cp);
+            o->len += 1;
+            return;
+        }
+        if (cp >= 0xFF61 && cp <= 0xFF9F) {
+            q[0] = 0x8E;
+            q[1] = (unsigned char)(cp - 0xFF61 + 0xA1);
+            o->len += 2;
+            return;
+        }
+        if ((pointer = charset_euc_pointer(cp)) >= 0) {
+            charset_put_euc(o, (unsigned)pointer);
+            return;
+        }
+        break;
+
+    case CHARSET_SHIFT_JIS:
+        if (cp >= CHARSET_JIS) {
+            charset_put_sjis(o, cp - CHARSET_JIS);
+            return;
+        }
+        if (cp < 0x80 || cp == 0xA0 || cp == 0xA5 || cp == 0x203E) {
+            /* No-break space (&nbsp;) has no code of its own: a space. */
+            q[0] = (unsigned char)(cp == 0xA0 ? 0x20 : cp == 0xA5 ? 0x5C : cp == 0x203E ? 0x7E : cp);
+            o->len += 1;
+            return;
+        }
+        if (cp >= 0xFF61 && cp <= 0xFF9F) {
+            q[0] = (unsigned char)(cp - 0xFF61 + 0xA1);
+            o->len += 1;
+            return;
+        }
+        if ((pointer = charset_jis_pointer(cp)) < 0) {
+            for (size_t i = 0; i < sizeof(g_sjis_fold) / sizeof(g_sjis_fold[0]); ++i) {
+                if (g_sjis_fold[i][0] == cp) pointer = charset_jis_pointer(g_sjis_fold[i][1]);
+            }
+        }
+        if (pointer >= 0) {
+            charset_put_sjis(o, (unsigned)pointer);
+            return;
+        }
+        break;
+
+    default:
+        if (cp < 0x80 || (cp >= 0xA0 && cp <= 0xFF)) {
+            q[0] = (unsigned char)cp;
+            o->len += 1;
+            return;
+        }
+        for (int i = 0; i < 32; ++i) {
+            if (g_cp1252_high[i] == cp) {
+                q[0] = (unsigned char)(0x80 + i);
+                o->len += 1;
+                return;
+            }
+        }
+        break;
+    }
+
+    /* Not in the target charset. */
+    if (cp != CHARSET_REPLACEMENT) c->replaced++;
+    o->buf[o->len++] = '?';
+}
+
+/* ASCII is ASCII everywhere but in UTF-16. */
+static void charset_put_ascii(const charset_conv_t *c, charset_out_t *o, const unsigned char *p, int n)
+{
+    if (c->to == CHARSET_UTF16LE) {
+        while (n > 0) {
+            int k = (CHARSET_OUT_BUF - o->len) / 2;
+            if (k == 0) {
+                charset_flush(o);
+                continue;
+            }
+            if (k > n) k = n;
+            for (int i = 0; i < k; ++i) {
+                o->buf[o->len++] = (char)p[i];
+                o->buf[o->len++] = 0;
+            }
+            p += k;
+            n -= k;
+        }
+    } else if (n <= CHARSET_OUT_BUF - o->len) {
+        memcpy(o->buf + o->len, p, n);
+        o->len += n;
+    } else {
+        charset_flush(o);
+        page_arena_append(o->arena, (const char*)p, n);
+    }
+}
+
+/* ------------------------------------------------------------------------
+ * Conversion
+ * ------------------------------------------------------------------------ */
+
+void charset_conv_init(charset_conv_t *c, charset_t from, charset_t to)
+{
+    memset(c, 0, sizeof(*c));
+    c->from = from;
+    c->to = to;
+}
+
+/* Completes the character held over from the last run with the first
+   bytes of this one. Returns where the rest of the run starts. */
+static const unsigned char *charset_conv_pending(charset_conv_t *c, charset_out_t *o,
+                                                 const unsigned char *p, const unsigned char *end)
+{
+    unsigned char tmp[8];
+    unsigned cp;
+
+    while (c->pending_len > 0) {
+        int have = c->pending_len;
+        int take = end - p < 4 ? (int)(end - p) : 4;
+        int n;
+
+        memcpy(tmp, c->pending, have);
+        memcpy(tmp + have, p, take);
+        if (tmp[0] < 0x80) {
+            cp = tmp[0];
+            n = 1;
+        } else {
+            n = charset_decode(c->from, c->to == CHARSET_SHIFT_JIS, tmp, tmp + have + take, &cp);
+        }
+        if (n == 0) {
+            /* Still not all there: the whole run is held. */
+            memcpy(c->pending + have, p, take);
+            c->pending_len += take;
+            return end;
+        }
+        charset_put(c, o, cp);
+        if (n >= have) {
+            p += n - have;
+            c->pending_len = 0;
+        } else {
+            memmove(c->pending, c->pending + n, have - n);
+            c->pending_len -= n;
+        }
+    }
+    return p;
+}
+
+/* Converts [p, end) up to the first '&' if amps, which starts a
+   reference, else all of it. Returns where it stopped. The '&' is found by
+   the same scan that finds the end of each run of ASCII. */
+static const unsigned char *charset_conv_run(charset_conv_t *c, charset_out_t *o,
+                                             const unsigned char *p, const unsigned char *end,
+                                             int amps)
+{
+    int to_sjis = c->to == CHARSET_SHIFT_JIS;
+
+    if (c->from == c->to || c->from == CHARSET_UNKNOWN) {
+        const unsigned char *q = amps ? (const unsigned char*)scan_find_any((const char*)p, (const char*)end, "&", 1) : end;
+        charset_flush(o);
+        page_arena_append(o->arena, (const char*)p, (int)(q - p));
+        return q;
+    }
+    /* An '&' is never a trail byte, so a character always ends before one
+       and the decoder leaves it to be found below. */
+    if (c->pending_len > 0) p = charset_conv_pending(c, o, p, end);
+    while (p < end) {
+        unsigned cp;
+        int n;
+
+        if (*p < 0x80) {
+            const unsigned char *q = (const unsigned char*)scan_find_high_any((const char*)p, (const char*)end, "&", amps);
+            charset_put_ascii(c, o, p, (int)(q - p));
+            p = q;
+            if (p < end && *p == '&') return p;
+            continue;
+        }
+        n = charset_decode(c->from, to_sjis, p, end, &cp);
+        if (n == 0) {
+            /* At most 3 bytes: the rest comes with the next run. */
+            memcpy(c->pending, p, end - p);
+            c->pending_len = (int)(end - p);
+            break;
+        }
+        charset_put(c, o, cp);
+        p += n;
+    }
+    return end;
+}
+
+/* Adds [p, end) to the reference after an '&'. Returns where text resumes:
+   end while the reference is still open, else just after it. */
+static const unsigned char *charset_conv_entity(charset_conv_t *c, charset_out_t *o,
+                                                const unsigned char *p, const unsigned char *end,
+                                                int final)
+{
+    int held = c->entity_len;
+    int take = end - p < HTML_ENTITY_MAX - held ? (int)(end - p) : HTML_ENTITY_MAX - held;
+    unsigned cp[2];
+    int n;
+
+    memcpy(c->entity + held, p, take);
+    c->entity_len += take;
+    n = html_entity_decode(c->entity, c->entity_len, final ? HTML_ENTITY_FINAL : 0, cp);
+    if (n < 0) return end;
+
+    c->in_entity = 0;
+    c->entity_len = 0;
+    if (n == 0) {
+        charset_put(c, o, '&');
+    } else {
+        charset_put(c, o, cp[0]);
+        if (cp[1]) charset_put(c, o, cp[1]);
+    }
+    /* Held bytes it did not take are text again: name characters, ASCII. */
+    if (n < held) {
+        charset_put_ascii(c, o, (const unsigned char*)c->entity + n, held - n);
+        return p;
+    }
+    return p + (n - held);
+}
+
+void charset_conv(charset_conv_t *c, const char *data, int len, page_arena_t *out)
+{
+    const unsigned char *p = (const unsigned char*)data;
+    const unsigned char *end = p + len;
+    charset_out_t o;
+
+    if (len <= 0) return;
+    if (!c->started) {
+        c->started = 1;
+        if (c->from == CHARSET_UTF8 && len >= 3 && memcmp(p, "\xEF\xBB\xBF", 3) == 0) p += 3;
+    }
+    if (!c->entities && (c->from == c->to || c->from == CHARSET_UNKNOWN)) {
+        page_arena_append(out, (const char*)p, (int)(end - p));
+        return;
+    }
+
+    o.arena = out;
+    o.len = 0;
+    if (!c->entities) {
+        charset_conv_run(c, &o, p, end, 0);
+        charset_flush(&o);
+        return;
+    }
+    while (p < end) {
+        const unsigned char *amp;
+
+        if (c->in_entity) {
+            p = charset_conv_entity(c, &o, p, end, 0);
+            continue;
+        }
+        amp = charset_conv_run(c, &o, p, end, 1);
+        if (amp == end) break;
+        c->in_entity = 1;
+        p = amp + 1;
+    }
+    charset_flush(&o);
+}
+
+void charset_conv_finish(charset_conv_t *c, page_arena_t *out)
+{
+    charset_out_t o;
+
+    if (c->pending_len == 0 && !c->in_entity) return;
+    o.arena = out;
+    o.len = 0;
+    if (c->in_entity) charset_conv_entity(c, &o, (const unsigned char*)c->entity, (const unsigned char*)c->entity, 1);
+    if (c->pending_len > 0) charset_put(c, &o, CHARSET_REPLACEMENT);
+    charset_flush(&o);
+    c->pending_len = 0;
+}
+
+int charset_convert(charset_t from, charset_t to, const char *in, int len, int entities,
+                    char *out, int out_size)
+{
+    charset_conv_t c;
+    page_arena_t a;
+    int n;
+
+    if (out_size <= 0) return 0;
+    page_arena_init(&a, out_size - 1);
+    charset_conv_init(&c, from, to);
+    c.entities = entities;
+    charset_conv(&c, in, len, &a);
+    charset_conv_finish(&c, &a);
+    n = (int)a.len;
+    if (n > 0) memcpy(out, a.data, n);
+    out[n] = '\0';
+    page_arena_free(&a);
+    return n;
+}
@@ -0,0 +1,96 @@
+#ifndef CHARSET_H
+#define CHARSET_H
+
+#include "html_entity.h"
+#include "page_arena.h"
+
+/*
+ * Streaming charset conversion for page text.
+ *
+ * A page's encoding is taken from, in order: a UTF-8 byte order mark,
+ * the charset parameter of Content-Type, a <meta charset> or <meta
+ * http-equiv="Content-Type"> in the first CHARSET_SNIFF_BYTES, and
+ * failing those a guess from the bytes themselves. Text is then converted
+ * to the charset the device displays (its ANSI code page) as it is
+ * rendered, one text run at a time. A character cut in two by the end of
+ * a run is held in the converter until the next one.
+ *
+ * Runs of ASCII are found with scan_find_high and copied as they are, and
+ * a page already in the device charset is copied without looking at it,
+ * so most Western text costs a memcpy. Japanese text goes through the
+ * JIS X 0208 tables in charset_tables.h (about 35 KB, generated by
+ * tools/gen_charset_tables.py): one lookup per character to Unicode, and
+ * a bitmap and bit count per character back. EUC-JP to Shift_JIS is
+ * arithmetic only.
+ *
+ * With entities set, HTML character references (&amp;, &eacute;, &#8212;)
+ * are decoded on the way, into characters of the output charset; '&' is
+ * found with scan_find_any, so text without any costs one more scan.
+ *
+ * Shift_JIS means Windows-31J (CP932) and windows-1252 also covers pages
+ * labelled ISO-8859-1 or US-ASCII, as in browsers. JIS X 0212 characters
+ * in EUC-JP (three bytes, rare) come out as replacement characters.
+ */
+
+#define CHARSET_SNIFF_BYTES 1024   /* how far to look for <meta charset> */
+
+typedef enum {
+    CHARSET_UNKNOWN = 0,
+    CHARSET_UTF8,
+    CHARSET_SHIFT_JIS,
+    CHARSET_EUC_JP,
+    CHARSET_WINDOWS_1252,
+    CHARSET_UTF16LE            /* output only, for the wide-character APIs */
+} charset_t;
+
+/* Encoding label (case-insensitive, e.g. "Shift_JIS", "x-euc-jp"), len
+   bytes or up to the NUL if len < 0. CHARSET_UNKNOWN if not supported. */
+charset_t charset_from_name(const char *name, int len);
+
+/* Preferred label, e.g. for a Content-Type charset parameter. */
+const char *charset_name(charset_t cs);
+
+/* The charset=... parameter of a Content-Type value; CHARSET_UNKNOWN if
+   there is none or it is not supported. */
+charset_t charset_from_content_type(const char *content_type);
+
+/* Charset of a page given its Content-Type (NULL if none) and its first
+   len bytes, as described above. When nothing says and the bytes are all
+   ASCII, fallback. */
+charset_t charset_detect(const char *content_type, const char *data, int len,
+                         charset_t fallback);
+
+/* The charset console output is shown in: the ANSI code page, or
+   windows-1252 if that is one without support here. */
+charset_t charset_device(void);
+
+typedef struct {
+    charset_t from;
+    charset_t to;
+    int started;                   /* past a leading byte order mark */
+    unsigned char pending[4];      /* incomplete character from the last run */
+    int pending_len;
+    int entities;                  /* decode character references (HTML text) */
+    int in_entity;                 /* past an '&' the last run ended in */
+    char entity[HTML_ENTITY_MAX];  /* what followed it so far */
+    int entity_len;
+    long replaced;                 /* characters shown as U+FFFD or '?' */
+} charset_conv_t;
+
+/* entities is off: set it after init for HTML text. */
+void charset_conv_init(charset_conv_t *c, charset_t from, charset_t to);
+
+/* Converts len bytes and appends the result to out. */
+void charset_conv(charset_conv_t *c, const char *data, int len, page_arena_t *out);
+
+/* Ends the text: a character still incomplete is appended as a
+   replacement, a reference still open is decoded as far as it goes. */
+void charset_conv_finish(charset_conv_t *c, page_arena_t *out);
+
+/* One-shot conversion of a short string (a title, say) into out,
+   NUL-terminated and cut at out_size, decoding references if entities is
+   set. Returns the length. */
+int charset_convert(charset_t from, charset_t to, const char *in, int len, int entities,
+                    char *out, int out_size);
+
+#endif
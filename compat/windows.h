@@ -0,0 +1,48 @@
+#ifndef COMPAT_WINDOWS_H
+#define COMPAT_WINDOWS_H
+
+/*
+ * Host-build stand-in for <windows.h>: just the handful of types and calls
+ * the browser uses, mapped onto POSIX. Only the Makefile's native build
+ * puts compat/ on the include path; CeGCC builds never see this file.
+ */
+
+#include <time.h>
+#include <unistd.h>
+
+typedef unsigned int   DWORD;
+typedef unsigned short WORD;
+
+#define MAKEWORD(lo, hi) ((WORD)(((lo) & 0xff) | (((hi) & 0xff) << 8)))
+
+/* Milliseconds from a monotonic clock; wraps like the real one. */
+static inline DWORD GetTickCount(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (DWORD)((unsigned long)ts.tv_sec * 1000UL + (unsigned long)ts.tv_nsec / 1000000UL);
+}
+
+static inline void Sleep(DWORD ms)
+{
+    usleep((useconds_t)ms * 1000);
+}
+
+/* Host terminals are UTF-8. */
+#define CP_UTF8 65001
+
+static inline unsigned int GetACP(void)
+{
+    return CP_UTF8;
+}
+
+/* No keyboard polling on the host: Esc-to-cancel never fires. */
+#define VK_ESCAPE 0x1B
+
+static inline short GetAsyncKeyState(int vkey)
+{
+    (void)vkey;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef COMPAT_WINSOCK2_H
+#define COMPAT_WINSOCK2_H
+
+/*
+ * Host-build stand-in for Winsock 2 over BSD sockets (see windows.h in
+ * this directory).
+ */
+
+#include "windows.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <sys/ioctl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <errno.h>
+
+typedef int SOCKET;
+typedef unsigned long u_long;
+
+#define INVALID_SOCKET (-1)
+#define SOCKET_ERROR   (-1)
+
+#define WSAEWOULDBLOCK EWOULDBLOCK
+#define WSAEINPROGRESS EINPROGRESS
+
+typedef struct {
+    WORD wVersion;
+} WSADATA;
+
+static inline int WSAStartup(WORD version, WSADATA *data)
+{
+    data->wVersion = version;
+    return 0;
+}
+
+static inline int WSACleanup(void)           { return 0; }
+static inline int WSAGetLastError(void)      { return errno; }
+static inline int closesocket(SOCKET s)      { return close(s); }
+
+/* FIONBIO takes an int on POSIX, a u_long on Winsock. */
+static inline int ioctlsocket(SOCKET s, long cmd, u_long *argp)
+{
+    int arg = (int)*argp;
+    return ioctl(s, (unsigned long)cmd, &arg);
+}
+
+#endif
@@ -0,0 +1,321 @@
+#include "dump.h"
+#include "html_doc.h"
+#include "html_entity.h"
+#include "html_stream.h"
+#include "http_client.h"
+#include "page_arena.h"
+#include "scan_kernel.h"
+#include "sys_thread.h"
+#include "url.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    int ready;                /* finished, waiting for the ones before it */
+    page_arena_t out;         /* its output, handed over by the worker */
+} dump_slot_t;
+
+/* Per-worker buffers, reused from page to page. */
+typedef struct {
+    sys_thread_t thread;
+    http_response_t resp;
+    page_arena_t page;        /* response body */
+    page_arena_t text;        /* what gets written for the current URL */
+    charset_conv_t conv;      /* page charset -> output charset */
+    html_doc_t doc;
+} dump_worker_t;
+
+static const dump_list_t *g_list;
+static const dump_options_t *g_opts;
+static dump_slot_t *g_slots;          /* stdout mode: one per URL */
+static sys_mutex_t g_lock;            /* everything below */
+static int g_next_claim;              /* next URL to hand to a worker */
+static int g_next_write;              /* next URL due on stdout */
+static int g_failed;
+
+void dump_list_init(dump_list_t *list)
+{
+    list->urls = NULL;
+    list->count = 0;
+    list->cap = 0;
+}
+
+void dump_list_free(dump_list_t *list)
+{
+    for (int i = 0; i < list->count; ++i) free(list->urls[i]);
+    free(list->urls);
+    dump_list_init(list);
+}
+
+int dump_list_add(dump_list_t *list, const char *url)
+{
+    char *copy;
+
+    if (list->count == list->cap) {
+        int cap = list->cap ? list->cap * 2 : 16;
+        char **urls = (char**)realloc(list->urls, cap * sizeof(*urls));
+        if (!urls) return -1;
+        list->urls = urls;
+        list->cap = cap;
+    }
+    copy = (char*)malloc(strlen(url) + 1);
+    if (!copy) return -1;
+    strcpy(copy, url);
+    list->urls[list->count++] = copy;
+    return 0;
+}
+
+int dump_list_read(dump_list_t *list, const char *path)
+{
+    FILE *f = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+    char line[1024];
+    int rc = 0;
+
+    if (!f) return -1;
+    while (rc == 0 && fgets(line, sizeof(line), f)) {
+        char *s = line, *e;
+        while (isspace((unsigned char)*s)) s++;
+        e = s + strlen(s);
+        while (e > s && isspace((unsigned char)e[-1])) e--;
+        *e = '\0';
+        if (*s && *s != '#') rc = dump_list_add(list, s);
+    }
+    if (f != stdin) fclose(f);
+    return rc;
+}
+
+static void dump_append_str(page_arena_t *a, const char *s)
+{
+    page_arena_append(a, s, (int)strlen(s));
+}
+
+/* Text-run sink for the tokenizer: user is the worker. */
+static void dump_text_run(void *user, const char *text, int len)
+{
+    dump_worker_t *w = (dump_worker_t*)user;
+    charset_conv(&w->conv, text, len, &w->text);
+}
+
+/* Appends the numbered link list, each made absolute against url (where
+   the page came from, after redirects), with
+   "&amp;" and other references decoded. */
+static void dump_references(dump_worker_t *w, const char *url)
+{
+    char raw[1024], link[1024], abs[1024], line[1100];
+
+    html_doc_parse(&w->doc, &w->page);   /* a partial list is still listed */
+    if (w->doc.num_links == 0) return;
+    dump_append_str(&w->text, "\nReferences\n\n");
+    for (int i = 0; i < w->doc.num_links; ++i) {
+        const html_doc_link_t *l = html_doc_link(&w->doc, i);
+        char *s = link, *e;
+
+        page_arena_copy(&w->page, l->url, raw, sizeof(raw));
+        html_entity_unescape(raw, (int)strlen(raw), link, sizeof(link));
+        while (isspace((unsigned char)*s)) s++;
+        e = s + strlen(s);
+        while (e > s && isspace((unsigned char)e[-1])) e--;
+        *e = '\0';
+        snprintf(line, sizeof(line), "%4d. %s\n", i + 1,
+                 url_resolve(url, s, abs, sizeof(abs)) == 0 ? abs : s);
+        dump_append_str(&w->text, line);
+    }
+}
+
+/* Fetches and renders URL i into w->text. Returns 0, or -1 if the page
+   failed (what did arrive is still rendered). */
+static int dump_one(dump_worker_t *w, int i)
+{
+    const char *url = g_list->urls[i];
+    char final[1024];
+    html_stream_t stream;
+    char type[128];
+    int rc;
+
+    page_arena_reset(&w->page);
+    page_arena_reset(&w->text);
+    if (g_list->count > 1 && !g_opts->out_dir) {
+        dump_append_str(&w->text, i ? "\n==> " : "==> ");
+        dump_append_str(&w->text, url);
+        dump_append_str(&w->text, " <==\n");
+    }
+
+    rc = http_get(&w->resp, url, g_opts->tls, &w->page, final, sizeof(final));
+    if (rc == HTTP_GET_BAD_URL) {
+        fprintf(stderr, "%s: malformed or unsupported URL\n", final);
+        return -1;
+    }
+    if (rc == HTTP_GET_NO_REPLY) {
+        fprintf(stderr, "%s: %s\n", final,
+                net_transport_failure_text(net_transport_last_failure()));
+        return -1;
+    }
+    if (rc != 0) {
+        fprintf(stderr, "%s: transfer interrupted\n", url);
+    }
+    if (w->resp.status != 200) {
+        fprintf(stderr, "%s: HTTP %d\n", url, w->resp.status);
+        rc = -1;
+    }
+
+    http_header(&w->resp, "content-type", type, sizeof(type));
+    charset_conv_init(&w->conv, charset_detect(type, w->page.data, (int)w->page.len, g_opts->charset),
+                      g_opts->charset);
+    w->conv.entities = 1;
+    html_stream_init(&stream, 0, dump_text_run, w);
+    html_stream_feed(&stream, w->page.data, (int)w->page.len);
+    charset_conv_finish(&w->conv, &w->text);
+    dump_append_str(&w->text, "\n");
+    if (g_opts->links) dump_references(w, final);
+    return rc ? -1 : 0;
+}
+
+/* Hands out the next URL index, or -1 when none are left. In stdout mode
+   waits while the window of held pages is full. */
+static int dump_claim(void)
+{
+    int i;
+
+    sys_mutex_lock(&g_lock);
+    while (g_slots && g_next_claim < g_list->count &&
+           g_next_claim - g_next_write >= DUMP_WINDOW) {
+        sys_mutex_unlock(&g_lock);
+        sys_sleep_ms(5);
+        sys_mutex_lock(&g_lock);
+    }
+    i = g_next_claim < g_list->count ? g_next_claim++ : -1;
+    sys_mutex_unlock(&g_lock);
+    return i;
+}
+
+static void dump_to_file(dump_worker_t *w, int i)
+{
+    char name[512];
+    FILE *f;
+
+    snprintf(name, sizeof(name), "%s/%d.txt", g_opts->out_dir, i + 1);
+    f = fopen(name, "wb");
+    if (!f || fwrite(w->text.data, 1, (size_t)w->text.len, f) != (size_t)w->text.len) {
+        fprintf(stderr, "%s: cannot write %s\n", g_list->urls[i], name);
+    }
+    if (f) fclose(f);
+}
+
+/* Takes the worker's output for URL i and writes whatever is now due. */
+static void dump_deliver(dump_worker_t *w, int i, int failed)
+{
+    if (g_opts->out_dir) {
+        dump_to_file(w, i);
+        sys_mutex_lock(&g_lock);
+        g_failed += failed;
+        sys_mutex_unlock(&g_lock);
+        return;
+    }
+
+    sys_mutex_lock(&g_lock);
+    g_failed += failed;
+    {
+        /* Swap buffers: the slot keeps the text, the worker gets the
+           slot's empty arena for its next page. */
+        page_arena_t held = g_slots[i].out;
+        g_slots[i].out = w->text;
+        w->text = held;
+        g_slots[i].ready = 1;
+    }
+    while (g_next_write < g_list->count && g_slots[g_next_write].ready) {
+        page_arena_t *out = &g_slots[g_next_write].out;
+        fwrite(out->data, 1, (size_t)out->len, stdout);
+        page_arena_free(out);
+        g_next_write++;
+    }
+    fflush(stdout);
+    sys_mutex_unlock(&g_lock);
+}
+
+static void dump_drain(dump_worker_t *w)
+{
+    int i;
+
+    while ((i = dump_claim()) >= 0) {
+        int failed = dump_one(w, i) != 0;
+        dump_deliver(w, i, failed);
+    }
+}
+
+static void dump_worker(void *arg)
+{
+    dump_drain((dump_worker_t*)arg);
+    net_transport_thread_exit();
+}
+
+int dump_run(const dump_list_t *list, const dump_options_t *opts)
+{
+    dump_worker_t *workers;
+    int jobs = opts->jobs;
+    int started = 0;
+
+    if (jobs < 1) jobs = 1;
+    if (jobs > DUMP_MAX_JOBS) jobs = DUMP_MAX_JOBS;
+    if (jobs > list->count) jobs = list->count;
+    if (jobs == 0) return 0;
+
+    g_list = list;
+    g_opts = opts;
+    g_next_claim = g_next_write = g_failed = 0;
+    g_slots = NULL;
+    if (!opts->out_dir) {
+        g_slots = (dump_slot_t*)calloc(list->count, sizeof(*g_slots));
+        if (!g_slots) return list->count;
+        for (int i = 0; i < list->count; ++i) {
+            page_arena_init(&g_slots[i].out, PAGE_ARENA_MAX_BYTES);
+        }
+    }
+    /* Off the stack: each one holds a response head and three arenas. */
+    workers = (dump_worker_t*)calloc(jobs, sizeof(*workers));
+    if (!workers) {
+        free(g_slots);
+        return list->count;
+    }
+
+    net_transport_enable_threads();
+    /* Keep a parked connection per worker, so a list of pages on one
+       site does not reconnect for each. */
+    net_transport_pool_config(jobs < NET_POOL_MAX_SLOTS ? jobs : NET_POOL_MAX_SLOTS,
+                              NET_POOL_DEFAULT_IDLE_MS);
+    scan_kernel_active();     /* pick the scanner before threads race to */
+    sys_mutex_init(&g_lock);
+
+    for (int j = 0; j < jobs; ++j) {
+        page_arena_init(&workers[j].page, PAGE_ARENA_MAX_BYTES);
+        page_arena_init(&workers[j].text, PAGE_ARENA_MAX_BYTES);
+        html_doc_init(&workers[j].doc);
+    }
+    for (int j = 0; j < jobs; ++j) {
+        if (sys_thread_start(&workers[j].thread, dump_worker, &workers[j], 0) != 0) break;
+        started++;
+    }
+    if (started == 0) {
+        /* No threads to be had: do the work here. */
+        dump_drain(&workers[0]);
+    }
+    for (int j = 0; j < started; ++j) {
+        sys_thread_join(&workers[j].thread);
+    }
+
+    for (int j = 0; j < jobs; ++j) {
+        page_arena_free(&workers[j].page);
+        page_arena_free(&workers[j].text);
+        html_doc_free(&workers[j].doc);
+    }
+    free(workers);
+    if (g_slots) {
+        for (int i = 0; i < list->count; ++i) page_arena_free(&g_slots[i].out);
+        free(g_slots);
+        g_slots = NULL;
+    }
+    sys_mutex_destroy(&g_lock);
+    return g_failed;
+}
@@ -0,0 +1,59 @@
+#ifndef DUMP_H
+#define DUMP_H
+
+#include "charset.h"
+#include "net_transport.h"
+
+/*
+ * Headless batch mode (-dump): fetch a list of URLs and write the rendered
+ * text of each, optionally followed by a numbered list of its links made
+ * absolute, the way lynx -dump does.
+ *
+ * Up to `jobs` worker threads each take the next URL in turn, fetch it
+ * over the shared keep-alive pool into their own page arena, strip it and
+ * (for the link list) parse it, so both the waiting and the parsing are
+ * spread over the workers. Output either goes to stdout in input order --
+ * a page that finishes early is held until the ones before it are written,
+ * and workers stop taking URLs more than DUMP_WINDOW ahead of the oldest
+ * unwritten one -- or to one file per URL, <out_dir>/<n>.txt with n
+ * counted from 1 in input order, written as each page is done.
+ *
+ * Redirects are followed (http_get), and links are made absolute against
+ * the URL the page came from. Text is written in `charset`, converted
+ * from each page's own (charset.h). Failures and non-200 replies are
+ * reported on stderr. The HTTP disk cache is not used.
+ */
+
+#define DUMP_DEFAULT_JOBS  4
+#define DUMP_MAX_JOBS      16
+#define DUMP_WINDOW        64   /* pages held for in-order stdout output */
+
+typedef struct {
+    char **urls;
+    int count;
+    int cap;
+} dump_list_t;
+
+typedef struct {
+    int jobs;                       /* worker threads, 1..DUMP_MAX_JOBS */
+    int links;                      /* append a "References" list */
+    const char *out_dir;            /* NULL: everything to stdout */
+    charset_t charset;              /* of the text written */
+    const net_tls_options_t *tls;   /* server_name is filled in per URL */
+} dump_options_t;
+
+void dump_list_init(dump_list_t *list);
+void dump_list_free(dump_list_t *list);
+
+/* Copies url onto the end of the list. Returns 0, or -1 out of memory. */
+int dump_list_add(dump_list_t *list, const char *url);
+
+/* Adds one URL per line of the file ("-" is stdin), skipping blank lines
+   and lines starting with '#'. Returns 0, or -1 if it cannot be read. */
+int dump_list_read(dump_list_t *list, const char *path);
+
+/* Dumps every URL on the list. Call from the main thread before any other
+   network threads start. Returns the number of URLs that failed. */
+int dump_run(const dump_list_t *list, const dump_options_t *opts);
+
+#endif
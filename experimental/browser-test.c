@@ -1,221 +1,125 @@
 #include <windows.h>    // For Windows CE definitions
 #include "winsock2.h"   // Local winsock2.h in the same directory
+#include <ctype.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
+#include "../charset.h"
+#include "../net_transport.h"
+#include "../http_client.h"
+#include "../http_cache.h"
+#include "../image_out.h"
+#include "../page_arena.h"
+#include "../html_doc.h"
+#include "../html_entity.h"
+#include "../html_scan.h"
+#include "../jpeg_stream.h"
+#include "../prefetch.h"
+#include "../page_history.h"
+#include "../page_pipe.h"
+#include "../pager.h"
+#include "../scan_kernel.h"
+#include "../stats.h"
+#include "../url.h"
 
 // Define HTTP port
 #define HTTP_PORT 80
 
-// Structure to store discovered links
-typedef struct {
-    char text[128];
-    char url[512];
-} Link;
-
-// Structure to store a naive form
-typedef struct {
-    char method[16];        // e.g., "GET" or "POST"
-    char action[512];       // e.g., "http://example.com/search"
-    char inputName[64];     // e.g., "q"
-    int  found;             // Flag to indicate if a form was found
-} FormInfo;
-
-// Global variables to store links and form information
-static Link gLinks[100];
-static int  gNumLinks = 0;
-static FormInfo gForm;
-
-// Minimal 'tolower' replacement for ASCII, without <ctype.h>
-static char my_lower(char c) {
-    if (c >= 'A' && c <= 'Z') {
-        c = c + ('a' - 'A');
-    }
-    return c;
+// The current page: its body, the links/forms/tables found in it (as
+// offsets into the body) and its rendered text. Pages the user leaves are
+// moved into the history cache whole.
+static page_view_t gView;
+
+// Shows the rendered text one screen at a time (--rows, --cols)
+static pager_t gPager;
+
+// Charset the console shows (its code page, or --charset=<label>); page
+// text is converted to it as it is rendered
+static charset_t gCharset;
+
+// --stats: measure every page load and print the numbers after it
+static int gShowStats = 0;
+
+// --pipeline: the request runs on a network thread and this one parses
+// and renders the body as it arrives, instead of after the last byte
+static int gPipeline = 0;
+
+// --jpeg=<dir>: following a link to a .jpg decodes it as it downloads,
+// scaled in the DCT to fit --jpeg-size=<W>x<H>, and saves it there as
+// img<n>.bmp in --jpeg-depth=24|16|8 bits (or --jpeg-raw, a bare RGB565
+// framebuffer dump) instead of showing the bytes as a page
+static const char *gJpegDir = NULL;
+static int gJpegWidth = 240, gJpegHeight = 320;
+static image_out_format_t gJpegFormat = IMAGE_OUT_BMP16;
+static int gJpegCount = 0;
+
+// Body bytes rendered per pager fill: roughly a few screens of text.
+#define RENDER_STEP 4096
+
+// Pager fill callback: renders about RENDER_STEP more body bytes of the
+// view with naive HTML tags (everything between < and >) left out, one
+// append per text run. Returns 0 once the whole body is rendered, so text
+// below the screens the user looks at is never rendered at all.
+static int render_more(void *user)
+{
+    page_view_t *v = (page_view_t*)user;
+    v->rendered = html_scan_strip(v->page.data, v->rendered, v->page.len,
+                                  RENDER_STEP, &v->conv, &v->text);
+    if (v->rendered < v->page.len) return 1;
+    charset_conv_finish(&v->conv, &v->text);
+    return 0;
 }
 
-// Custom case-insensitive substring search (replaces strcasestr)
-static char* my_strcasestr(const char *haystack, const char *needle)
+// Settles the charset of the body in gView (from contentType, which may
+// be empty, and the bytes so far) before anything of it is rendered
+static void start_render(const char *contentType)
 {
-    if (!haystack || !needle) return NULL;
-    if (!*needle) return (char*)haystack;  // If needle is empty, match at start
-
-    for (; *haystack; haystack++) {
-        // Compare first characters (case-insensitive)
-        if (my_lower(*haystack) == my_lower(*needle)) {
-            const char *h = haystack + 1;
-            const char *n = needle + 1;
-            while (*n && *h && (my_lower(*h) == my_lower(*n))) {
-                h++;
-                n++;
-            }
-            if (!*n) {
-                // Reached end of needle => match found
-                return (char*)haystack;
-            }
-        }
-    }
-    return NULL;
+    charset_t cs = charset_detect(contentType[0] ? contentType : NULL, gView.page.data,
+                                  (int)gView.page.len, gCharset);
+    charset_conv_init(&gView.conv, cs, gCharset);
+    gView.conv.entities = 1;
 }
 
-// Strips out naive HTML tags: everything between < and > is removed
-static void strip_html_tags(char *buffer)
+// Prints up to maxLen bytes of a page span, in the console's charset and
+// with references decoded, with \r and \n shown as spaces
+static void print_span(page_span_t span, int maxLen)
 {
-    char *r = buffer;
-    char *w = buffer;
-    int in_tag = 0;
-
-    while (*r) {
-        if (*r == '<') {
-            in_tag = 1;
-        } else if (*r == '>') {
-            in_tag = 0;
-        } else if (!in_tag) {
-            *w++ = *r;
-        }
-        r++;
+    char buf[1024];
+    int n = span.len < maxLen ? span.len : maxLen;
+    n = charset_convert(gView.conv.from, gView.conv.to, page_arena_at(&gView.page, span.off), n, 1,
+                        buf, sizeof(buf));
+    for (int i = 0; i < n; i++) {
+        putchar((buf[i] == '\r' || buf[i] == '\n') ? ' ' : buf[i]);
     }
-    *w = '\0';
 }
 
-// Convert entire string to lower-case using my_lower, in place
-static void strlower(char *s)
+// Copies the URL of link i, "&amp;" and other references decoded
+static void link_url(int i, char *out, int outSize)
 {
-    while (*s) {
-        *s = my_lower(*s);
-        s++;
-    }
+    char raw[512];
+    page_arena_copy(&gView.page, html_doc_link(&gView.doc, i)->url, raw, sizeof(raw));
+    html_entity_unescape(raw, (int)strlen(raw), out, outSize);
 }
 
-// Parse out <a href="...">LinkText</a> and store in gLinks[]
-// Also parse out <form ...> and <input ...> (very naive)
-static void parse_links_and_form(char *html)
+// The input the 'f' command fills in: the first text-like field
+static const html_doc_input_t *form_text_input(const html_doc_form_t *form)
 {
-    gNumLinks = 0;
-    memset(&gForm, 0, sizeof(gForm));
-
-    // Scan for <a href="..."> or <form ...> or <input ...>
-    char *p = html;
-
-    while (1)
-    {
-        char *tagStart = strstr(p, "<");
-        if (!tagStart) break;
-        char *tagEnd = strstr(tagStart, ">");
-        if (!tagEnd) break;
-
-        int tagLen = (int)(tagEnd - tagStart + 1);
-        if (tagLen < 3) {
-            p = tagEnd + 1;
-            continue;
-        }
-
-        // Extract the tag into a temporary buffer
-        char tagBuf[1024];
-        int copyLen = (tagLen >= 1023) ? 1023 : tagLen;
-        strncpy(tagBuf, tagStart, copyLen);
-        tagBuf[copyLen] = '\0';
-        strlower(tagBuf);  // Easier to parse in lower-case
-
-        // <a ...
-        if (strncmp(tagBuf, "<a ", 3) == 0) {
-            // Find href="
-            char *hrefPos = strstr(tagBuf, "href=");
-            if (hrefPos) {
-                // Usually it's href="someURL"
-                char *quote1 = strchr(hrefPos, '\"');
-                if (quote1) {
-                    char *quote2 = strchr(quote1+1, '\"');
-                    if (quote2) {
-                        int urlLen = (int)(quote2 - (quote1+1));
-                        if (urlLen > 0 && urlLen < (int)sizeof(gLinks[gNumLinks].url)-1) {
-                            strncpy(gLinks[gNumLinks].url, quote1+1, urlLen);
-                            gLinks[gNumLinks].url[urlLen] = '\0';
-                        }
-                    }
-                }
-            }
-            // Find link text after the tagEnd, up to </a>
-            char *linkTextStart = tagEnd + 1;
-            char *endTag = my_strcasestr(linkTextStart, "</a>");
-            if (endTag) {
-                int txtLen = (int)(endTag - linkTextStart);
-                if (txtLen < 0) txtLen = 0;
-                if (txtLen > (int)sizeof(gLinks[gNumLinks].text)-1) {
-                    txtLen = sizeof(gLinks[gNumLinks].text)-1;
-                }
-                strncpy(gLinks[gNumLinks].text, linkTextStart, txtLen);
-                gLinks[gNumLinks].text[txtLen] = '\0';
-
-                // Replace \r or \n with spaces
-                for (int i = 0; i < (int)strlen(gLinks[gNumLinks].text); i++) {
-                    if (gLinks[gNumLinks].text[i] == '\r' || gLinks[gNumLinks].text[i] == '\n') {
-                        gLinks[gNumLinks].text[i] = ' ';
-                    }
-                }
-                gNumLinks++;
-                if (gNumLinks >= 100) gNumLinks = 99; // Arbitrary limit
-            }
-        }
-        // <form ...
-        else if (strncmp(tagBuf, "<form", 5) == 0) {
-            gForm.found = 1;
-            // Default to "get"
-            strcpy(gForm.method, "get");
-
-            // Parse method=
-            char *methodPos = strstr(tagBuf, "method=");
-            if (methodPos) {
-                char *q1 = strchr(methodPos, '\"');
-                if (q1) {
-                    char *q2 = strchr(q1+1, '\"');
-                    if (q2) {
-                        int len = (int)(q2 - (q1+1));
-                        if (len > 0 && len < (int)sizeof(gForm.method)) {
-                            strncpy(gForm.method, q1+1, len);
-                            gForm.method[len] = '\0';
-                        }
-                        strlower(gForm.method);
-                    }
-                }
-            }
-            // Parse action=
-            char *actionPos = strstr(tagBuf, "action=");
-            if (actionPos) {
-                char *q1 = strchr(actionPos, '\"');
-                if (q1) {
-                    char *q2 = strchr(q1+1, '\"');
-                    if (q2) {
-                        int len = (int)(q2 - (q1+1));
-                        if (len > 0 && len < (int)sizeof(gForm.action)) {
-                            strncpy(gForm.action, q1+1, len);
-                            gForm.action[len] = '\0';
-                        }
-                    }
-                }
-            }
-        }
-        // <input ...
-        else if (strncmp(tagBuf, "<input", 6) == 0 && gForm.found) {
-            // Find name=
-            char *namePos = strstr(tagBuf, "name=");
-            if (namePos) {
-                char *q1 = strchr(namePos, '\"');
-                if (q1) {
-                    char *q2 = strchr(q1+1, '\"');
-                    if (q2) {
-                        int len = (int)(q2 - (q1+1));
-                        if (len > 0 && len < (int)sizeof(gForm.inputName)) {
-                            strncpy(gForm.inputName, q1+1, len);
-                            gForm.inputName[len] = '\0';
-                        }
-                    }
-                }
-            }
+    const html_doc_input_t *in;
+    for (in = form->inputs; in; in = in->next) {
+        if (in->type.len == 0 || in->textarea ||
+            html_doc_span_is(&gView.page, in->type, "text") ||
+            html_doc_span_is(&gView.page, in->type, "search")) {
+            return in;
         }
-
-        // Move p past this tag
-        p = tagEnd + 1;
     }
+    return form->inputs;
+}
+
+// Cancel hook for net_transport: Esc abandons a page that is loading.
+static int escape_pressed(void *user)
+{
+    (void)user;
+    return (GetAsyncKeyState(VK_ESCAPE) & 0x8000) != 0;
 }
 
 // Minimal function to parse "http://host/path" into host+path.
@@ -243,6 +147,104 @@ static int parse_http_url(const char *url, char *host, char *path, int maxLen)
     return 0;
 }
 
+static int make_absolute_url(const char *baseURL, const char *link, char *out, int outSize);
+
+// Queue the first --prefetch links of the page that stay on its host.
+// Fragments, mailto: and javascript: links are not worth a request.
+static void prefetch_links(const char *pageURL, const char *pageHost)
+{
+    for (int i = 0; i < gView.doc.num_links && prefetch_room() > 0; ++i) {
+        char link[512], absURL[512], host[256], path[512];
+        link_url(i, link, sizeof(link));
+        if (link[0] == '#' || strncmp(link, "mailto:", 7) == 0 ||
+            strncmp(link, "javascript:", 11) == 0) {
+            continue;
+        }
+        if (make_absolute_url(pageURL, link, absURL, sizeof(absURL)) != 0 ||
+            strcmp(absURL, pageURL) == 0 ||
+            parse_http_url(absURL, host, path, 256) != 0 ||
+            strcmp(host, pageHost) != 0) {
+            continue;
+        }
+        prefetch_add(absURL, host, HTTP_PORT, path);
+    }
+    prefetch_start();
+}
+
+// Shows the first screen of the current page; the rest is rendered as
+// the user pages down.
+static void show_page(void)
+{
+    printf("----- Page Text -----\n");
+    pager_open(&gPager, &gView.text, render_more, &gView);
+    pager_show(&gPager, 0);
+}
+
+// One page request, as run by fetch_body on whichever thread does the
+// network side of the load.
+typedef struct {
+    const char *url;
+    const char *host;
+    const char *path;
+    const char *postData;
+    page_arena_t *reserve;    // sized from Content-Length if the body goes straight in
+    int status;
+    http_cache_result_t from;
+    char contentType[128];    // filled in before the first body byte
+    int sniffed;              // --pipeline: start_render done
+} fetch_job_t;
+
+// HTTP/1.1 over a pooled keep-alive connection, body pushed to sink. GETs
+// go through the disk cache when --cache-dir is set; POSTs always hit the
+// network. The Esc hook is set here because each thread has its own.
+static int fetch_body(void *arg, http_body_fn sink, void *user)
+{
+    fetch_job_t *job = (fetch_job_t*)arg;
+    net_tls_options_t tls_opts;
+    int rc;
+
+    memset(&tls_opts, 0, sizeof(tls_opts));
+    net_transport_set_cancel(escape_pressed, NULL);
+    if (!job->postData) {
+        return http_cached_get(job->url, job->host, HTTP_PORT, NET_SCHEME_HTTP, &tls_opts,
+                               job->path, sink, user, &job->status, &job->from,
+                               job->contentType, sizeof(job->contentType));
+    }
+
+    static http_response_t resp;
+    rc = http_request(&resp, "POST", job->host, HTTP_PORT, NET_SCHEME_HTTP,
+                      &tls_opts, job->path, NULL, job->postData, NULL);
+    if (rc == 0) {
+        job->status = resp.status;
+        http_header(&resp, "Content-Type", job->contentType, sizeof(job->contentType));
+        if (job->reserve && resp.content_length > 0 && resp.content_length <= job->reserve->limit) {
+            page_arena_reserve(job->reserve, resp.content_length);
+        }
+        rc = http_read_response(&resp, sink, user);
+        http_finish(&resp);
+    }
+    return rc;
+}
+
+// page_pipe consumer (--pipeline): each buffer is appended to the page,
+// the tags completed by it are recorded and the text up to the last
+// complete tag is rendered, while the next buffer is still on the wire.
+// user is the fetch_job_t; the charset is settled by the first buffer.
+static void pipe_chunk(void *user, const char *data, int len)
+{
+    fetch_job_t *job = (fetch_job_t*)user;
+    page_view_t *v = &gView;
+    page_arena_append(&v->page, data, len);
+    if (!job->sniffed) {
+        start_render(job->contentType);
+        job->sniffed = 1;
+    }
+    html_doc_more(&v->doc, &v->page);
+    v->rendered = html_scan_strip(v->page.data, v->rendered,
+                                  html_scan_safe_end(v->page.data, v->rendered, v->page.len),
+                                  0, &v->conv, &v->text);
+}
+
 // Core fetch function: do HTTP GET or POST, read response, parse links & forms, strip HTML for display.
 static void fetch_page(const char *url, const char *postData)
 {
@@ -254,126 +256,231 @@ static void fetch_page(const char *url, const char *postData)
         return;
     }
 
-    // Create socket
-    SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    if (s == INVALID_SOCKET) {
-        printf("socket() failed.\n");
+    // The body lands once in the page arena, which grows as needed. The
+    // previous page's links point into it, so forget them first.
+    html_doc_reset(&gView.doc);
+    page_arena_reset(&gView.page);
+    page_arena_reset(&gView.text);
+    gView.rendered = 0;
+    stats_reset();
+
+    // A link the prefetcher already brought in is used as is; whatever
+    // else it fetched for the previous page is dropped.
+    int status = 0;
+    int rc = 0;
+    int pipelined = 0;
+    int docFailed = 0;
+    char contentType[128] = "";
+    net_fail_t why = NET_FAIL_NONE;
+    if (!postData && prefetch_take(url, &gView.page, &status)) {
+        printf("[prefetched]\n");
+        prefetch_clear();
+    } else {
+        fetch_job_t job;
+        memset(&job, 0, sizeof(job));
+        job.url = url;
+        job.host = host;
+        job.path = path;
+        job.postData = postData;
+        job.from = HTTP_CACHE_MISS;
+        prefetch_clear();
+        if (gPipeline) {
+            pipelined = 1;
+            html_doc_begin(&gView.doc);
+            rc = page_pipe_run(fetch_body, &job, pipe_chunk, &job, &why);
+            docFailed = html_doc_end(&gView.doc, &gView.page) != 0;
+        } else {
+            job.reserve = &gView.page;
+            rc = fetch_body(&job, page_arena_sink, &gView.page);
+            why = net_transport_last_failure();
+        }
+        status = job.status;
+        memcpy(contentType, job.contentType, sizeof(contentType));
+        if (job.from != HTTP_CACHE_MISS) {
+            printf("[%s]\n", job.from == HTTP_CACHE_HIT ? "from cache" : "revalidated, from cache");
+        }
+    }
+    if (status == 0) {
+        printf("Request to %s failed: %s.\n", host, net_transport_failure_text(why));
+        if (gShowStats) stats_print();
         return;
     }
+    if (status != 200) {
+        printf("[HTTP %d]\n", status);
+    }
+    if (rc != 0) {
+        printf("Warning: transfer %s, page may be incomplete.\n",
+               (why == NET_FAIL_CANCELLED || why == NET_FAIL_TIMEOUT)
+                   ? net_transport_failure_text(why) : "interrupted");
+    }
+    if (gView.page.dropped > 0) {
+        printf("Warning: page truncated, %ld bytes past %ld KB not shown.\n",
+               gView.page.dropped, gView.page.limit / 1024);
+    }
 
-    // Resolve host
-    struct hostent *he = gethostbyname(host);
-    if (!he) {
-        printf("gethostbyname() failed for %s\n", host);
-        closesocket(s);
-        return;
+    // 1) Parse links, forms and tables (recorded as offsets into gView.page);
+    // pipelined, that already happened as the body came in
+    if (!pipelined) docFailed = html_doc_parse(&gView.doc, &gView.page) != 0;
+    if (docFailed) {
+        printf("Warning: out of memory, some links/forms not recorded.\n");
     }
 
-    // Build address
-    struct sockaddr_in server;
-    memset(&server, 0, sizeof(server));
-    server.sin_family = AF_INET;
-    server.sin_port = htons(HTTP_PORT);
-    server.sin_addr.s_addr = *((u_long*)he->h_addr);
-
-    // Connect
-    if (connect(s, (struct sockaddr*)&server, sizeof(server)) != 0) {
-        printf("connect() failed.\n");
-        closesocket(s);
-        return;
+    // 2) Show the first screen of the same bytes with the tags left out,
+    // converted to the console's charset
+    if (!pipelined || gView.page.len == 0) start_render(contentType);
+    show_page();
+    if (gShowStats) stats_print();
+
+    // 3) Warm the first few links on the same host while the user reads
+    if (status == 200 && prefetch_enabled()) {
+        prefetch_links(url, host);
     }
+}
 
-    // Build request (POST if postData != NULL, else GET)
-    char request[2048];
-    if (postData) {
-        // POST
-        snprintf(request, sizeof(request),
-            "POST %s HTTP/1.0\r\n"
-            "Host: %s\r\n"
-            "User-Agent: CE-Lynx/1.0\r\n"
-            "Connection: close\r\n"
-            "Content-Type: application/x-www-form-urlencoded\r\n"
-            "Content-Length: %d\r\n"
-            "\r\n"
-            "%s",
-            path, host, (int)strlen(postData), postData
-        );
-    } else {
-        // GET
-        snprintf(request, sizeof(request),
-            "GET %s HTTP/1.0\r\n"
-            "Host: %s\r\n"
-            "User-Agent: CE-Lynx/1.0\r\n"
-            "Connection: close\r\n\r\n",
-            path, host);
+// Does url name a JPEG (by its path, before any query)?
+static int is_jpeg_url(const char *url)
+{
+    int len = (int)strcspn(url, "?#");
+    char ext[6] = {0};
+    for (int i = 0; i < 5 && i < len; ++i) {
+        ext[4 - i] = (char)tolower((unsigned char)url[len - 1 - i]);
     }
+    return strcmp(ext + 1, ".jpg") == 0 || strcmp(ext, ".jpeg") == 0;
+}
 
-    // Send
-    if (send(s, request, (int)strlen(request), 0) <= 0) {
-        printf("send() failed.\n");
-        closesocket(s);
+// Body sink for pictures: the decoder takes each read as it comes and
+// hands finished rows to the writer, so neither the file nor the picture
+// is ever held whole. A bad file stops the transfer.
+static int jpeg_sink(void *user, const char *data, int len)
+{
+    return jpeg_stream_feed((jpeg_stream_t*)user, data, len) != JPEG_OK;
+}
+
+// Fetch a picture into gJpegDir (--jpeg). The current page stays as it is.
+static void fetch_image(const char *url)
+{
+    char host[256] = {0};
+    char path[512] = {0};
+    char name[600];
+    image_out_t out;
+    fetch_job_t job;
+    net_fail_t why;
+
+    if (parse_http_url(url, host, path, 256) != 0) {
+        printf("Malformed or unsupported URL (only http://...).\n");
         return;
     }
-
-    // Read the entire response into a large buffer. Very naive.
-    static char bigBuf[65536]; // 64 KB max
-    int totalReceived = 0;
-    while (1) {
-        if (totalReceived >= (int)sizeof(bigBuf)-1) break;
-        int r = recv(s, bigBuf + totalReceived, (int)(sizeof(bigBuf)-1 - totalReceived), 0);
-        if (r <= 0) break;
-        totalReceived += r;
+    snprintf(name, sizeof(name), "%s/img%d.%s", gJpegDir, ++gJpegCount,
+             image_out_extension(gJpegFormat));
+    if (image_out_open(&out, name, gJpegFormat, gJpegWidth, gJpegHeight) != 0) {
+        printf("Cannot create %s\n", name);
+        return;
     }
-    bigBuf[totalReceived] = '\0';
-    closesocket(s);
 
-    // Skip headers
-    char *body = strstr(bigBuf, "\r\n\r\n");
-    if (!body) {
-        printf("No HTTP body found.\n");
+    // Off the stack: the decoder keeps a 16 KB input buffer.
+    jpeg_stream_t *jpeg = (jpeg_stream_t*)malloc(sizeof(*jpeg));
+    if (!jpeg) {
+        image_out_close(&out);
+        remove(name);
+        printf("Out of memory.\n");
         return;
     }
-    body += 4;
-
-    // 1) Parse links and form info
-    parse_links_and_form(body);
+    jpeg_stream_init(jpeg, gJpegWidth, gJpegHeight, image_out_row, &out);
+
+    memset(&job, 0, sizeof(job));
+    job.url = url;
+    job.host = host;
+    job.path = path;
+    job.from = HTTP_CACHE_MISS;
+    int rc = fetch_body(&job, jpeg_sink, jpeg);
+    why = net_transport_last_failure();
+    int decoded = job.status == 200 && jpeg_stream_finish(jpeg) == JPEG_OK;
+    int written = image_out_close(&out) == 0;
+
+    if (job.status == 0) {
+        printf("Request to %s failed: %s.\n", host, net_transport_failure_text(why));
+    } else if (job.status != 200) {
+        printf("[HTTP %d]\n", job.status);
+    } else if (!jpeg_stream_has_header(jpeg)) {
+        printf("Cannot show picture: %s.\n", jpeg->error ? jpeg->error : "not a JPEG file");
+    } else {
+        printf("[JPEG %dx%d, 1/%d in the DCT, %dx%d saved as %s]\n",
+               jpeg->width, jpeg->height, 8 / jpeg->scale, out.width, out.height, name);
+        if (!decoded || rc != 0) {
+            printf("Warning: %s, picture may be incomplete.\n",
+                   rc != 0 && why != NET_FAIL_NONE ? net_transport_failure_text(why)
+                   : jpeg->error ? jpeg->error : "transfer interrupted");
+        } else if (!written) {
+            printf("Warning: could not write all of %s.\n", name);
+        }
+    }
+    if (job.status != 200 || !jpeg_stream_has_header(jpeg)) {
+        remove(name);
+        gJpegCount--;
+    }
+    jpeg_stream_free(jpeg);
+    free(jpeg);
+}
 
-    // 2) Make a copy for display, removing HTML tags
-    static char displayBuf[65536];
-    strncpy(displayBuf, body, sizeof(displayBuf)-1);
-    displayBuf[sizeof(displayBuf)-1] = '\0';
+// Global variable storing the "current URL" so user can follow links easily.
+static char gCurrentURL[512] = "";  // Start with empty URL
 
-    strip_html_tags(displayBuf);
+// Make link absolute against the page URL ("next.html" goes in the page's
+// directory, see url_resolve), without its #fragment, which is never sent.
+// With no page URL yet the link is taken as it is. Returns -1 (and an empty
+// out) if the URL does not fit: a cut URL is a different page.
+static int make_absolute_url(const char *baseURL, const char *link, char *out, int outSize)
+{
+    int n;
 
-    // 3) Print
-    printf("----- Page Text -----\n%s\n----- End -----\n", displayBuf);
+    if (url_resolve(baseURL, link, out, outSize) != 0) {
+        n = strstr(baseURL, "://") ? -1 : snprintf(out, outSize, "%s", link);
+        if (n < 0 || n >= outSize) {
+            out[0] = '\0';
+            return -1;
+        }
+    }
+    out[strcspn(out, "#")] = '\0';
+    return 0;
 }
 
-// Global variable storing the "current URL" so user can follow links easily.
-static char gCurrentURL[512] = "";  // Start with empty URL
+// Leave the current page for url: it goes into the history (and its state
+// into the history cache) before the new one is fetched.
+static void visit(const char *url, const char *postData)
+{
+    if (gJpegDir && !postData && is_jpeg_url(url)) {
+        fetch_image(url);
+        return;
+    }
+    strncpy(gCurrentURL, url, sizeof(gCurrentURL));
+    gCurrentURL[sizeof(gCurrentURL)-1] = '\0';
+    page_history_stash(&gView);
+    page_history_push(gCurrentURL, postData != NULL);
+    fetch_page(gCurrentURL, postData);
+}
 
-// Make absolute URL if link is relative. If link starts with "http://" we keep it.
-static void make_absolute_url(const char *baseURL, const char *link, char *out, int outSize)
+// Back (delta -1) or forward (+1): cached pages are shown again as they
+// were, without touching the network; evicted ones are fetched again.
+static void go_history(int delta)
 {
-    if (strncmp(link, "http://", 7) == 0) {
-        // Already absolute
-        strncpy(out, link, outSize);
-        out[outSize-1] = '\0';
+    int cached;
+    const char *url = page_history_go(delta, &gView, &cached);
+    if (!url) {
+        printf("No %s page.\n", delta < 0 ? "previous" : "next");
+        return;
+    }
+    strncpy(gCurrentURL, url, sizeof(gCurrentURL));
+    gCurrentURL[sizeof(gCurrentURL)-1] = '\0';
+    if (cached) {
+        printf("[from history]\n");
+        show_page();
     } else {
-        // Parse base, extract host, then append link
-        char baseHost[256], basePath[512];
-        if (parse_http_url(baseURL, baseHost, basePath, 256) == 0) {
-            snprintf(out, outSize, "http://%s%s", baseHost, link);
-        } else {
-            // Fallback
-            strncpy(out, link, outSize);
-            out[outSize-1] = '\0';
-        }
+        fetch_page(gCurrentURL, NULL);
     }
 }
 
 // Interactive loop
-int main(void)
+int main(int argc, char **argv)
 {
     // Initialize Winsock
     WSADATA wsa;
@@ -382,18 +489,85 @@ int main(void)
         return 1;
     }
 
+    // --cache-dir=<path> [--cache-size=<KB>] enables the on-disk HTTP cache
+    const char *cacheDir = NULL;
+    long cacheBytes = HTTP_CACHE_DEFAULT_BYTES;
+    // --prefetch=<links> [--prefetch-workers=<n>] [--prefetch-budget=<KB>]
+    int prefetchLinks = 0, prefetchWorkers = PREFETCH_DEFAULT_WORKERS;
+    long prefetchBytes = PREFETCH_DEFAULT_BUDGET;
+    // --history-cache=<KB> sizes the cache behind back/forward (0 = off)
+    long historyBytes = PAGE_HISTORY_DEFAULT_BUDGET;
+    // --stats prints timings and counters after every page
+    // --pipeline parses and renders pages while they download
+    // --jpeg=<dir> [--jpeg-size=<W>x<H>] [--jpeg-depth=24|16|8] [--jpeg-raw]
+    // saves linked pictures scaled for the screen
+    // --rows=<n> (0 = print whole pages) and --cols=<n> size the pager
+    // --charset=<label> shows text in that charset, not the console's
+    int rows = PAGER_DEFAULT_ROWS, cols = PAGER_DEFAULT_COLS;
+    gCharset = charset_device();
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--cache-dir=", 12) == 0) cacheDir = argv[i] + 12;
+        else if (strncmp(argv[i], "--cache-size=", 13) == 0) cacheBytes = atol(argv[i] + 13) * 1024L;
+        else if (strncmp(argv[i], "--rows=", 7) == 0) rows = atoi(argv[i] + 7);
+        else if (strncmp(argv[i], "--cols=", 7) == 0) cols = atoi(argv[i] + 7);
+        else if (strncmp(argv[i], "--history-cache=", 16) == 0) historyBytes = atol(argv[i] + 16) * 1024L;
+        else if (strncmp(argv[i], "--prefetch=", 11) == 0) prefetchLinks = atoi(argv[i] + 11);
+        else if (strncmp(argv[i], "--prefetch-workers=", 19) == 0) prefetchWorkers = atoi(argv[i] + 19);
+        else if (strncmp(argv[i], "--prefetch-budget=", 18) == 0) prefetchBytes = atol(argv[i] + 18) * 1024L;
+        else if (strcmp(argv[i], "--stats") == 0) gShowStats = 1;
+        else if (strcmp(argv[i], "--pipeline") == 0) gPipeline = 1;
+        else if (strncmp(argv[i], "--charset=", 10) == 0) {
+            charset_t cs = charset_from_name(argv[i] + 10, -1);
+            if (cs != CHARSET_UNKNOWN && cs != CHARSET_UTF16LE) gCharset = cs;
+            else printf("Unknown charset %s, using the console's\n", argv[i] + 10);
+        }
+        else if (strncmp(argv[i], "--jpeg=", 7) == 0) gJpegDir = argv[i] + 7;
+        else if (strncmp(argv[i], "--jpeg-size=", 12) == 0) sscanf(argv[i] + 12, "%dx%d", &gJpegWidth, &gJpegHeight);
+        else if (strcmp(argv[i], "--jpeg-depth=24") == 0) gJpegFormat = IMAGE_OUT_BMP24;
+        else if (strcmp(argv[i], "--jpeg-depth=16") == 0) gJpegFormat = IMAGE_OUT_BMP16;
+        else if (strcmp(argv[i], "--jpeg-depth=8") == 0) gJpegFormat = IMAGE_OUT_BMP8;
+        else if (strcmp(argv[i], "--jpeg-raw") == 0) gJpegFormat = IMAGE_OUT_RAW565;
+    }
+    // Before prefetch_config: only this thread is measured, never the workers
+    stats_init();
+    stats_enable(gShowStats);
+    prefetch_config(prefetchLinks, prefetchWorkers, prefetchBytes);
+    if (gPipeline) {
+        net_transport_enable_threads();
+        scan_kernel_active();   // picked here, not raced for by two threads
+    }
+    net_transport_set_cancel(escape_pressed, NULL);
+    page_arena_init(&gView.page, PAGE_ARENA_MAX_BYTES);
+    html_doc_init(&gView.doc);
+    page_arena_init(&gView.text, PAGE_ARENA_MAX_BYTES);
+    page_history_init(historyBytes);
+    pager_init(&gPager, rows, cols);
+    gPager.charset = gCharset;
+
+    if (cacheDir && http_cache_open(cacheDir, cacheBytes) != 0) {
+        printf("Cannot use cache directory %s\n", cacheDir);
+    }
+
     printf("Welcome to CE-Lynx Advanced Demo (No Automatic Navigation)\n");
     printf("Commands:\n");
     printf("  g = Go to a new URL\n");
+    printf("  + = Next screen of the page (or space), - = previous screen\n");
+    printf("  j = Jump to a line of the page\n");
     printf("  l = List discovered links on current page, pick one to follow\n");
     printf("  f = If there's a form, fill text input & submit\n");
+    printf("  d = Show DNS cache, optionally flush it\n");
+    printf("  b = Back to the previous page\n");
+    printf("  n = Forward to the next page\n");
+    printf("  h = Show history\n");
+    printf("  p = Show prefetched links\n");
+    printf("  s = Show timings and counters for the current page (--stats)\n");
     printf("  q = Quit\n");
 
     printf("\nPress 'g' to enter a URL or 'q' to quit.\n");
 
     while (1) {
         printf("\nCurrent URL: %s\n", gCurrentURL[0] ? gCurrentURL : "None");
-        printf("Command (g/l/f/q) > ");
+        printf("Command (g/+/-/j/l/f/b/n/h/d/p/s/q) > ");
         fflush(stdout);
 
         int c = getchar();
@@ -419,18 +593,21 @@ int main(void)
                 continue;
             }
 
-            strncpy(gCurrentURL, url, sizeof(gCurrentURL));
-            gCurrentURL[sizeof(gCurrentURL)-1] = '\0';
-
-            fetch_page(gCurrentURL, NULL);
+            visit(url, NULL);
         }
         else if (c == 'l' || c == 'L') {
             // List links
-            if (gNumLinks == 0) {
+            if (gView.doc.num_links == 0) {
                 printf("No links found on this page.\n");
             } else {
-                for (int i = 0; i < gNumLinks; i++) {
-                    printf("[%d] %s => %s\n", i+1, gLinks[i].text, gLinks[i].url);
+                const html_doc_link_t *l;
+                int i = 0;
+                for (l = gView.doc.links; l; l = l->next) {
+                    printf("[%d] ", ++i);
+                    print_span(l->text, 127);
+                    printf(" => ");
+                    print_span(l->url, 511);
+                    printf("\n");
                 }
                 printf("Enter link number to follow: ");
                 fflush(stdout);
@@ -438,24 +615,32 @@ int main(void)
                 char buf[32];
                 if (!fgets(buf, sizeof(buf), stdin)) continue;
                 int choice = atoi(buf);
-                if (choice < 1 || choice > gNumLinks) {
+                if (choice < 1 || choice > gView.doc.num_links) {
                     printf("Invalid link index.\n");
                 } else {
-                    char absURL[512];
-                    make_absolute_url(gCurrentURL, gLinks[choice-1].url, absURL, sizeof(absURL));
-                    strncpy(gCurrentURL, absURL, sizeof(gCurrentURL));
-                    gCurrentURL[sizeof(gCurrentURL)-1] = '\0';
-                    fetch_page(gCurrentURL, NULL);
+                    char link[512], absURL[512];
+                    link_url(choice - 1, link, sizeof(link));
+                    if (make_absolute_url(gCurrentURL, link, absURL, sizeof(absURL)) != 0) {
+                        printf("Link URL too long.\n");
+                        continue;
+                    }
+                    visit(absURL, NULL);
                 }
             }
         }
         else if (c == 'f' || c == 'F') {
             // If we found a form
-            if (!gForm.found) {
+            if (gView.doc.num_forms == 0) {
                 printf("No form found on this page.\n");
             } else {
-                printf("Form method=%s, action=%s\n", gForm.method, gForm.action);
-                printf("Input name=%s\n", gForm.inputName);
+                const html_doc_form_t *form = gView.doc.forms;
+                const html_doc_input_t *input = form_text_input(form);
+                int isPost = html_doc_span_is(&gView.page, form->method, "post");
+                char action[512], inputName[64] = "";
+                page_arena_copy(&gView.page, form->action, action, sizeof(action));
+                if (input) page_arena_copy(&gView.page, input->name, inputName, sizeof(inputName));
+                printf("Form method=%s, action=%s\n", isPost ? "post" : "get", action);
+                printf("Input name=%s\n", inputName);
                 printf("Enter text for input: ");
                 fflush(stdout);
 
@@ -487,31 +672,85 @@ int main(void)
 
                 // Make absolute action URL
                 char fullURL[512];
-                make_absolute_url(gCurrentURL, gForm.action, fullURL, sizeof(fullURL));
+                if (make_absolute_url(gCurrentURL, action, fullURL, sizeof(fullURL)) != 0) {
+                    printf("Form action URL too long.\n");
+                    continue;
+                }
 
                 // Determine if GET or POST
-                if (strcmp(gForm.method, "post") == 0) {
+                if (isPost) {
                     // POST: inputName=enc
                     char postData[512];
-                    snprintf(postData, sizeof(postData), "%s=%s", gForm.inputName, enc);
-                    strncpy(gCurrentURL, fullURL, sizeof(gCurrentURL));
-                    gCurrentURL[sizeof(gCurrentURL)-1] = '\0';
-                    fetch_page(gCurrentURL, postData);
+                    int n = snprintf(postData, sizeof(postData), "%s=%s", inputName, enc);
+                    if (n < 0 || n >= (int)sizeof(postData)) {
+                        printf("Form data too long.\n");
+                        continue;
+                    }
+                    visit(fullURL, postData);
                 } else {
                     // Assume GET: append ?inputName=enc
                     char getURL[512];
-                    snprintf(getURL, sizeof(getURL), "%s?%s=%s", fullURL, gForm.inputName, enc);
-                    strncpy(gCurrentURL, getURL, sizeof(gCurrentURL));
-                    gCurrentURL[sizeof(gCurrentURL)-1] = '\0';
-                    fetch_page(gCurrentURL, NULL);
+                    int n = snprintf(getURL, sizeof(getURL), "%s?%s=%s", fullURL, inputName, enc);
+                    if (n < 0 || n >= (int)sizeof(getURL)) {
+                        printf("Form URL too long.\n");
+                        continue;
+                    }
+                    visit(getURL, NULL);
                 }
             }
         }
+        else if (c == 'd' || c == 'D') {
+            char answer[8];
+            net_dns_print();
+            printf("Flush DNS cache? (y/n): ");
+            fflush(stdout);
+            if (fgets(answer, sizeof(answer), stdin) && (answer[0] == 'y' || answer[0] == 'Y')) {
+                net_dns_flush();
+                printf("DNS cache flushed.\n");
+            }
+        }
+        else if (c == '+' || c == ' ') {
+            pager_next(&gPager);
+        }
+        else if (c == '-') {
+            pager_prev(&gPager);
+        }
+        else if (c == 'j' || c == 'J') {
+            char buf[32];
+            printf("Line number: ");
+            fflush(stdout);
+            if (fgets(buf, sizeof(buf), stdin)) {
+                pager_show(&gPager, atoi(buf) - 1);
+            }
+        }
+        else if (c == 'b' || c == 'B') {
+            go_history(-1);
+        }
+        else if (c == 'n' || c == 'N') {
+            go_history(1);
+        }
+        else if (c == 'h' || c == 'H') {
+            page_history_print();
+        }
+        else if (c == 'p' || c == 'P') {
+            prefetch_print();
+        }
+        else if (c == 's' || c == 'S') {
+            stats_print();
+        }
         else {
             printf("Unknown command.\n");
         }
     }
 
+    prefetch_clear();
+    page_history_free();
+    html_doc_free(&gView.doc);
+    page_arena_free(&gView.page);
+    page_arena_free(&gView.text);
+    pager_free(&gPager);
+    http_cache_close();
+    net_transport_pool_flush();
     WSACleanup();
     return 0;
 }
@@ -0,0 +1,361 @@
+#include "html_doc.h"
+#include "html_scan.h"
+#include "stats.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define HTML_DOC_BLOCK_SIZE 4096
+
+struct html_doc_block {
+    html_doc_block_t *next;
+    long used;
+    long size;
+    /* records follow */
+};
+
+/* Keeps records aligned for pointers and longs. */
+#define HTML_DOC_ALIGN(n) ((long)(((n) + sizeof(void*) - 1) & ~(sizeof(void*) - 1)))
+#define HTML_DOC_HEADER   HTML_DOC_ALIGN(sizeof(html_doc_block_t))
+
+static void *html_doc_alloc(html_doc_t *doc, long size)
+{
+    html_doc_block_t *b = doc->blocks;
+    void *p;
+
+    size = HTML_DOC_ALIGN(size);
+    if (!b || b->used + size > b->size) {
+        long cap = HTML_DOC_BLOCK_SIZE;
+        if (cap < HTML_DOC_HEADER + size) cap = HTML_DOC_HEADER + size;
+        b = (html_doc_block_t*)malloc(cap);
+        if (!b) {
+            doc->failed = 1;
+            return NULL;
+        }
+        b->next = doc->blocks;
+        b->used = HTML_DOC_HEADER;
+        b->size = cap;
+        doc->blocks = b;
+        doc->bytes += cap;
+    }
+    p = (char*)b + b->used;
+    b->used += size;
+    memset(p, 0, size);
+    return p;
+}
+
+void html_doc_init(html_doc_t *doc)
+{
+    memset(doc, 0, sizeof(*doc));
+}
+
+void html_doc_reset(html_doc_t *doc)
+{
+    html_doc_block_t *keep = doc->blocks;
+
+    /* The newest block is the one most likely to be full size; keep the
+       last one in the chain (the first allocated) and free the rest. */
+    while (keep && keep->next) {
+        html_doc_block_t *b = keep;
+        keep = keep->next;
+        free(b);
+    }
+    memset(doc, 0, sizeof(*doc));
+    if (keep) {
+        keep->used = HTML_DOC_HEADER;
+        keep->next = NULL;
+        doc->blocks = keep;
+        doc->bytes = keep->size;
+    }
+}
+
+void html_doc_free(html_doc_t *doc)
+{
+    while (doc->blocks) {
+        html_doc_block_t *b = doc->blocks;
+        doc->blocks = b->next;
+        free(b);
+    }
+    memset(doc, 0, sizeof(*doc));
+}
+
+const html_doc_link_t *html_doc_link(const html_doc_t *doc, int i)
+{
+    if (i < 0 || i >= doc->num_links) return NULL;
+    if (doc->link_index) return doc->link_index[i];
+    {
+        const html_doc_link_t *l = doc->links;
+        while (l && i-- > 0) l = l->next;
+        return l;
+    }
+}
+
+int html_doc_span_is(const page_arena_t *page, page_span_t span, const char *word)
+{
+    const char *s = page_arena_at(page, span.off);
+    int n = (int)strlen(word);
+
+    if (span.len != n) return 0;
+    for (int i = 0; i < n; ++i) {
+        char c = s[i];
+        if (c >= 'A' && c <= 'Z') c = (char)(c + ('a' - 'A'));
+        if (c != word[i]) return 0;
+    }
+    return 1;
+}
+
+/* ------------------------------------------------------------------------
+ * Parsing: html_scan events -> records
+ * ------------------------------------------------------------------------ */
+
+struct html_doc_parser {
+    html_doc_t *doc;
+    long scanned;                     /* page bytes consumed so far */
+    html_doc_link_t *open_link;       /* <a> waiting for </a> */
+    html_doc_form_t *form;            /* inside <form> */
+    html_doc_input_t *open_textarea;  /* <textarea> waiting for its close */
+    html_doc_table_t *table;          /* innermost open table */
+    int in_title;
+    long title_start;
+};
+
+static page_span_t html_doc_attr(const html_scan_tag_t *tag, const char *name)
+{
+    const html_scan_attr_t *attr = html_scan_attr(tag, name);
+    page_span_t none = {0, 0};
+    return attr ? attr->value : none;
+}
+
+static void html_doc_close_link(html_doc_parser_t *ps, long at)
+{
+    if (ps->open_link) {
+        ps->open_link->text.len = (int)(at - ps->open_link->text.off);
+        ps->open_link = NULL;
+    }
+}
+
+static void html_doc_close_cell(html_doc_table_t *t, long at)
+{
+    if (t && t->open_cell) {
+        t->open_cell->text.len = (int)(at - t->open_cell->text.off);
+        t->open_cell = NULL;
+    }
+}
+
+static void html_doc_on_link(html_doc_parser_t *ps, const html_scan_tag_t *tag)
+{
+    html_doc_t *doc = ps->doc;
+    html_doc_link_t *link;
+    page_span_t href;
+
+    html_doc_close_link(ps, tag->off);
+    if (tag->closing) return;
+
+    href = html_doc_attr(tag, "href");
+    if (href.len == 0) return;        /* a name= anchor, not a link */
+    link = (html_doc_link_t*)html_doc_alloc(doc, sizeof(*link));
+    if (!link) return;
+    link->url = href;
+    link->text.off = tag->end;
+    if (doc->last_link) doc->last_link->next = link;
+    else doc->links = link;
+    doc->last_link = link;
+    doc->num_links++;
+    ps->open_link = link;
+}
+
+static html_doc_input_t *html_doc_add_input(html_doc_parser_t *ps, const html_scan_tag_t *tag)
+{
+    html_doc_form_t *form = ps->form;
+    html_doc_input_t *input;
+    page_span_t name = html_doc_attr(tag, "name");
+
+    if (name.len == 0) return NULL;
+    input = (html_doc_input_t*)html_doc_alloc(ps->doc, sizeof(*input));
+    if (!input) return NULL;
+    input->name = name;
+    input->type = html_doc_attr(tag, "type");
+    input->value = html_doc_attr(tag, "value");
+    if (form->last_input) form->last_input->next = input;
+    else form->inputs = input;
+    form->last_input = input;
+    form->num_inputs++;
+    return input;
+}
+
+static void html_doc_on_form_tag(html_doc_parser_t *ps, const html_scan_tag_t *tag)
+{
+    html_doc_t *doc = ps->doc;
+
+    if (html_scan_is(tag, "form")) {
+        html_doc_form_t *form;
+        if (tag->closing) {
+            ps->form = NULL;
+            return;
+        }
+        form = (html_doc_form_t*)html_doc_alloc(doc, sizeof(*form));
+        if (!form) return;
+        form->method = html_doc_attr(tag, "method");
+        form->action = html_doc_attr(tag, "action");
+        if (doc->last_form) doc->last_form->next = form;
+        else doc->forms = form;
+        doc->last_form = form;
+        doc->num_forms++;
+        ps->form = form;
+    } else if (html_scan_is(tag, "textarea")) {
+        if (tag->closing) {
+            if (ps->open_textarea) {
+                html_doc_input_t *in = ps->open_textarea;
+                in->value.len = (int)(tag->off - in->value.off);
+                ps->open_textarea = NULL;
+            }
+        } else if (ps->form) {
+            html_doc_input_t *in = html_doc_add_input(ps, tag);
+            if (in) {
+                in->textarea = 1;
+                in->value.off = tag->end;
+                in->value.len = 0;
+                ps->open_textarea = in;
+            }
+        }
+    } else if (!tag->closing && ps->form &&
+               (html_scan_is(tag, "input") || html_scan_is(tag, "select"))) {
+        html_doc_add_input(ps, tag);
+    }
+}
+
+static void html_doc_on_table_tag(html_doc_parser_t *ps, const html_scan_tag_t *tag)
+{
+    html_doc_t *doc = ps->doc;
+    html_doc_table_t *t = ps->table;
+
+    if (html_scan_is(tag, "table")) {
+        if (tag->closing) {
+            if (t) {
+                html_doc_close_cell(t, tag->off);
+                ps->table = t->parent;
+            }
+            return;
+        }
+        t = (html_doc_table_t*)html_doc_alloc(doc, sizeof(*t));
+        if (!t) return;
+        t->parent = ps->table;
+        if (doc->last_table) doc->last_table->next = t;
+        else doc->tables = t;
+        doc->last_table = t;
+        doc->num_tables++;
+        ps->table = t;
+    } else if (!t) {
+        return;
+    } else if (html_scan_is(tag, "tr")) {
+        html_doc_close_cell(t, tag->off);
+        if (!tag->closing) {
+            t->num_rows++;
+            t->cur_col = 0;
+        }
+    } else if (html_scan_is(tag, "td") || html_scan_is(tag, "th")) {
+        html_doc_cell_t *cell;
+        html_doc_close_cell(t, tag->off);
+        if (tag->closing) return;
+        if (t->num_rows == 0) t->num_rows = 1;   /* cell before any <tr> */
+        cell = (html_doc_cell_t*)html_doc_alloc(doc, sizeof(*cell));
+        if (!cell) return;
+        cell->row = t->num_rows - 1;
+        cell->col = t->cur_col++;
+        cell->header = html_scan_is(tag, "th");
+        cell->text.off = tag->end;
+        if (t->cur_col > t->num_cols) t->num_cols = t->cur_col;
+        if (t->last_cell) t->last_cell->next = cell;
+        else t->cells = cell;
+        t->last_cell = cell;
+        t->num_cells++;
+        t->open_cell = cell;
+    }
+}
+
+static void html_doc_on_tag(void *user, const html_scan_tag_t *tag)
+{
+    html_doc_parser_t *ps = (html_doc_parser_t*)user;
+    html_doc_t *doc = ps->doc;
+
+    switch (tag->base[tag->name.off] | 0x20) {
+    case 'a':
+        if (tag->name.len == 1) html_doc_on_link(ps, tag);
+        break;
+    case 't':
+        if (html_scan_is(tag, "title")) {
+            if (!tag->closing && doc->title.len == 0) {
+                ps->in_title = 1;
+                ps->title_start = tag->end;
+            } else if (tag->closing && ps->in_title) {
+                doc->title.off = ps->title_start;
+                doc->title.len = (int)(tag->off - ps->title_start);
+                ps->in_title = 0;
+            }
+        } else if (html_scan_is(tag, "textarea")) {
+            html_doc_on_form_tag(ps, tag);
+        } else {
+            html_doc_on_table_tag(ps, tag);
+        }
+        break;
+    case 'f':
+    case 'i':
+    case 's':
+        html_doc_on_form_tag(ps, tag);
+        break;
+    }
+}
+
+void html_doc_begin(html_doc_t *doc)
+{
+    html_doc_reset(doc);
+    doc->parser = (html_doc_parser_t*)html_doc_alloc(doc, sizeof(*doc->parser));
+    if (doc->parser) doc->parser->doc = doc;
+}
+
+/* Scans page[scanned, len); a cut-off tag waits for the next call. */
+static void html_doc_scan(html_doc_t *doc, const page_arena_t *page, int final)
+{
+    html_doc_parser_t *ps = doc->parser;
+    stats_time_t t = stats_begin();
+
+    ps->scanned = html_scan_more(page->data, ps->scanned, page->len, final,
+                                 html_doc_on_tag, NULL, ps);
+    stats_end(STATS_DOC, t);
+}
+
+void html_doc_more(html_doc_t *doc, const page_arena_t *page)
+{
+    if (doc->parser) html_doc_scan(doc, page, 0);
+}
+
+int html_doc_end(html_doc_t *doc, const page_arena_t *page)
+{
+    html_doc_parser_t *ps = doc->parser;
+
+    if (!ps) return -1;
+    html_doc_scan(doc, page, 1);
+
+    /* Close whatever the page left open. */
+    html_doc_close_link(ps, page->len);
+    for (; ps->table; ps->table = ps->table->parent) {
+        html_doc_close_cell(ps->table, page->len);
+    }
+    doc->parser = NULL;
+
+    if (doc->num_links > 0) {
+        doc->link_index = (html_doc_link_t**)html_doc_alloc(doc,
+                              (long)doc->num_links * (long)sizeof(html_doc_link_t*));
+        if (doc->link_index) {
+            html_doc_link_t *l = doc->links;
+            for (int i = 0; l; l = l->next) doc->link_index[i++] = l;
+        }
+    }
+    return doc->failed ? -1 : 0;
+}
+
+int html_doc_parse(html_doc_t *doc, const page_arena_t *page)
+{
+    html_doc_begin(doc);
+    return html_doc_end(doc, page);
+}
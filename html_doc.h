@@ -0,0 +1,118 @@
+#ifndef HTML_DOC_H
+#define HTML_DOC_H
+
+#include "page_arena.h"
+
+/*
+ * Compact document model: title, links, forms with their inputs, and
+ * table cells found on a page.
+ *
+ * Nothing here holds text. Every string is a page_span_t into the page
+ * arena the document was parsed from, and the records themselves come
+ * from a small per-document block allocator, so a document costs a few
+ * dozen bytes per link/input/cell it actually contains and has no
+ * fixed caps. Records are kept in page order on singly linked lists;
+ * html_doc_parse also builds an index so link N is one lookup.
+ *
+ * Spans are raw page bytes (entities and nested tags included).
+ */
+
+typedef struct html_doc_link {
+    page_span_t text;
+    page_span_t url;
+    struct html_doc_link *next;
+} html_doc_link_t;
+
+typedef struct html_doc_input {
+    page_span_t name;
+    page_span_t type;         /* len 0 means "text" */
+    page_span_t value;        /* value= attribute, or <textarea> body */
+    int textarea;
+    struct html_doc_input *next;
+} html_doc_input_t;
+
+typedef struct html_doc_form {
+    page_span_t method;       /* len 0 means "get" */
+    page_span_t action;
+    int num_inputs;
+    html_doc_input_t *inputs;
+    html_doc_input_t *last_input;
+    struct html_doc_form *next;
+} html_doc_form_t;
+
+typedef struct html_doc_cell {
+    int row;
+    int col;
+    int header;               /* <th> */
+    page_span_t text;
+    struct html_doc_cell *next;
+} html_doc_cell_t;
+
+typedef struct html_doc_table {
+    int num_rows;
+    int num_cols;
+    int num_cells;
+    html_doc_cell_t *cells;
+    html_doc_cell_t *last_cell;
+    struct html_doc_table *next;
+
+    /* parse-time state, meaningless afterwards */
+    struct html_doc_table *parent;   /* enclosing table */
+    int cur_col;
+    html_doc_cell_t *open_cell;
+} html_doc_table_t;
+
+typedef struct html_doc_block html_doc_block_t;
+typedef struct html_doc_parser html_doc_parser_t;
+
+typedef struct {
+    page_span_t title;
+
+    int num_links;
+    html_doc_link_t *links;
+    html_doc_link_t *last_link;
+    html_doc_link_t **link_index;    /* num_links entries */
+
+    int num_forms;
+    html_doc_form_t *forms;
+    html_doc_form_t *last_form;
+
+    int num_tables;
+    html_doc_table_t *tables;
+    html_doc_table_t *last_table;
+
+    html_doc_parser_t *parser;       /* between html_doc_begin and _end */
+
+    html_doc_block_t *blocks;        /* record storage */
+    long bytes;                      /* bytes held in blocks */
+    int failed;                      /* an allocation failed; lists are short */
+} html_doc_t;
+
+void html_doc_init(html_doc_t *doc);
+
+/* Drops all records; keeps one block for the next page. */
+void html_doc_reset(html_doc_t *doc);
+void html_doc_free(html_doc_t *doc);
+
+/* Resets doc and fills it from the page. Returns 0, or -1 if memory ran
+   out part way (what was found so far is kept). */
+int html_doc_parse(html_doc_t *doc, const page_arena_t *page);
+
+/*
+ * The same, for a page that is still arriving: html_doc_begin resets doc,
+ * html_doc_more records the tags that are complete in the page so far and
+ * can be called again each time it grows, and html_doc_end takes the rest
+ * and builds the link index (returns as html_doc_parse). Until then
+ * links are found by walking the list.
+ */
+void html_doc_begin(html_doc_t *doc);
+void html_doc_more(html_doc_t *doc, const page_arena_t *page);
+int html_doc_end(html_doc_t *doc, const page_arena_t *page);
+
+/* Link i (0-based), or NULL. */
+const html_doc_link_t *html_doc_link(const html_doc_t *doc, int i);
+
+/* Case-insensitive compare of a span with a lower-case word. */
+int html_doc_span_is(const page_arena_t *page, page_span_t span, const char *word);
+
+#endif
@@ -0,0 +1,171 @@
+#include "html_entity.h"
+#include "html_entity_table.h"
+
+#include <string.h>
+
+#define ENTITY_NAME_MAX  31       /* "CounterClockwiseContourIntegral" */
+#define ENTITY_OLD_MAX   6        /* longest name allowed without ';' */
+#define ENTITY_REPLACE   0xFFFD
+
+/* What &#128; to &#159; mean: the windows-1252 characters, except for the
+   five bytes that have none there. */
+static const unsigned short g_entity_c1[32] = {
+    0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x008D, 0x017D, 0x008F,
+    0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178
+};
+
+static int entity_is_alnum(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+static int entity_hex(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+/* The generator's mix; see tools/gen_entity_table.py. */
+static unsigned entity_mix(unsigned h)
+{
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h;
+}
+
+/* The table value for name, or 0 if it is not one. */
+static unsigned entity_find(const char *name, int len)
+{
+    unsigned h = 2166136261u;
+    unsigned slot, v;
+
+    for (int i = 0; i < len; ++i) h = (h ^ (unsigned char)name[i]) * 16777619u;
+    slot = entity_mix(h ^ g_entity_seed[h % ENTITY_BUCKETS]) % ENTITY_SLOTS;
+    v = g_entity_value[slot];
+    if ((int)(v >> 26) != len || memcmp(g_entity_pool + g_entity_name[slot], name, len) != 0) return 0;
+    return v;
+}
+
+static int entity_numeric(const char *s, int len, int flags, unsigned cp[2])
+{
+    int hex = len > 1 && (s[1] | 0x20) == 'x';
+    int i = hex ? 2 : 1;
+    int start = i;
+    unsigned long value = 0;
+
+    for (; i < len; ++i) {
+        int d = hex ? entity_hex(s[i]) : (s[i] >= '0' && s[i] <= '9' ? s[i] - '0' : -1);
+        if (d < 0) break;
+        value = value * (hex ? 16 : 10) + d;
+        if (value > 0x10FFFF) value = 0x110000;    /* stays out of range */
+    }
+    if (i == len && !(flags & HTML_ENTITY_FINAL) && len < HTML_ENTITY_MAX) return -1;
+    if (i == start) return 0;                      /* "&#" or "&#x" alone */
+    if (i < len && s[i] == ';') i++;
+
+    if (value == 0 || value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF)) {
+        value = ENTITY_REPLACE;
+    } else if (value >= 0x80 && value <= 0x9F) {
+        value = g_entity_c1[value - 0x80];
+    }
+    cp[0] = (unsigned)value;
+    cp[1] = 0;
+    return i;
+}
+
+int html_entity_decode(const char *s, int len, int flags, unsigned cp[2])
+{
+    unsigned v = 0;
+    int n = 0;
+    int k;
+
+    if (len <= 0) return (flags & HTML_ENTITY_FINAL) ? 0 : -1;
+    if (s[0] == '#') return entity_numeric(s, len, flags, cp);
+
+    while (n < len && n < ENTITY_NAME_MAX && entity_is_alnum(s[n])) n++;
+    if (n == len && !(flags & HTML_ENTITY_FINAL) && len < HTML_ENTITY_MAX) return -1;
+    if (n == 0) return 0;
+
+    if (n < len && s[n] == ';' && (v = entity_find(s, n)) != 0) {
+        k = n + 1;
+    } else {
+        /* The longest old name in front, if any: "&copy2024", "&notit;". */
+        for (k = n < ENTITY_OLD_MAX ? n : ENTITY_OLD_MAX; k >= 2; --k) {
+            v = entity_find(s, k);
+            if (v & (1u << 25)) break;
+        }
+        if (k < 2) return 0;
+        if ((flags & HTML_ENTITY_ATTR) && k < len && (entity_is_alnum(s[k]) || s[k] == '=')) return 0;
+    }
+    cp[0] = v & 0x1FFFFF;
+    cp[1] = (v >> 21) & 0xF ? g_entity_second[((v >> 21) & 0xF) - 1] : 0;
+    return k;
+}
+
+static int entity_put_utf8(char *out, int at, int out_size, unsigned c)
+{
+    char b[4];
+    int n;
+
+    if (c < 0x80) {
+        b[0] = (char)c;
+        n = 1;
+    } else if (c < 0x800) {
+        b[0] = (char)(0xC0 | c >> 6);
+        b[1] = (char)(0x80 | (c & 0x3F));
+        n = 2;
+    } else if (c < 0x10000) {
+        b[0] = (char)(0xE0 | c >> 12);
+        b[1] = (char)(0x80 | (c >> 6 & 0x3F));
+        b[2] = (char)(0x80 | (c & 0x3F));
+        n = 3;
+    } else {
+        b[0] = (char)(0xF0 | c >> 18);
+        b[1] = (char)(0x80 | (c >> 12 & 0x3F));
+        b[2] = (char)(0x80 | (c >> 6 & 0x3F));
+        b[3] = (char)(0x80 | (c & 0x3F));
+        n = 4;
+    }
+    if (at + n > out_size - 1) return at;          /* whole characters only */
+    memcpy(out + at, b, n);
+    return at + n;
+}
+
+int html_entity_unescape(const char *in, int len, char *out, int out_size)
+{
+    const char *end = in + len;
+    int at = 0;
+
+    if (out_size <= 0) return 0;
+    while (in < end && at < out_size - 1) {
+        const char *amp = (const char*)memchr(in, '&', end - in);
+        int run = (int)((amp ? amp : end) - in);
+        unsigned cp[2];
+        int n;
+
+        if (run > out_size - 1 - at) run = out_size - 1 - at;
+        memcpy(out + at, in, run);
+        at += run;
+        in += run;
+        if (!amp || in < amp) break;
+
+        n = html_entity_decode(amp + 1, (int)(end - amp - 1), HTML_ENTITY_FINAL | HTML_ENTITY_ATTR, cp);
+        if (n <= 0) {
+            out[at++] = '&';
+            in = amp + 1;
+            continue;
+        }
+        at = entity_put_utf8(out, at, out_size, cp[0]);
+        if (cp[1]) at = entity_put_utf8(out, at, out_size, cp[1]);
+        in = amp + 1 + n;
+    }
+    out[at] = '\0';
+    return at;
+}
@@ -0,0 +1,39 @@
+#ifndef HTML_ENTITY_H
+#define HTML_ENTITY_H
+
+/*
+ * HTML character references: &name; for every name in the HTML standard
+ * (2125 of them), &#nnn; and &#xhhh;.
+ *
+ * Names are found through a perfect hash generated ahead of time into
+ * html_entity_table.h by tools/gen_entity_table.py: no set-up at run time,
+ * one pass over the name and a single compare to find or reject it, and
+ * about 24 KB of tables. Decoding follows the HTML parser: the longest
+ * name wins, the 106 old names such as "&amp" and "&copy" also work
+ * without the ';', and numeric references to nothing (0, surrogates, past
+ * U+10FFFF) become U+FFFD, with 0x80-0x9F read as windows-1252 the way
+ * browsers do.
+ *
+ * Text is decoded as it streams through the charset converter (charset.h,
+ * charset_conv_t.entities), which holds a reference cut in two by the end
+ * of a text run until the next one.
+ */
+
+#define HTML_ENTITY_MAX  32   /* bytes after '&' that settle any reference */
+
+#define HTML_ENTITY_FINAL 1   /* nothing follows: decide with what there is */
+#define HTML_ENTITY_ATTR  2   /* in an attribute: "&copy=1" stays as written */
+
+/* s is what follows an '&', len bytes of it. Returns how many of them the
+   reference takes (';' included), with its characters in cp[0] and cp[1]
+   (0 if there is only one); 0 if the '&' is just text; or -1 if more input
+   could still change the answer (never with HTML_ENTITY_FINAL or once len
+   reaches HTML_ENTITY_MAX). */
+int html_entity_decode(const char *s, int len, int flags, unsigned cp[2]);
+
+/* Decodes the references in an attribute value (an href, say) into out,
+   characters as UTF-8, NUL-terminated and cut at out_size. Returns the
+   length. */
+int html_entity_unescape(const char *in, int len, char *out, int out_size);
+
+#endif
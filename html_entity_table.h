@@ -0,0 +1,758 @@
+/* Generated by tools/gen_entity_table.py; do not edit. */
+
+#ifndef HTML_ENTITY_TABLE_H
+#define HTML_ENTITY_TABLE_H
+
+#define ENTITY_NAMES   2125
+#define ENTITY_SLOTS   2125
+#define ENTITY_BUCKETS 532
+
+/* Seed of each bucket (FNV-1a hash % ENTITY_BUCKETS). */
+static const unsigned short g_entity_seed[532] = {
+    0x00B7, 0x0026, 0x0054, 0x006B, 0x0014, 0x000B, 0x003C, 0x0047, 0x0012, 0x0020, 0x0019, 0x0088,
+    0x0009, 0x005F, 0x0000, 0x0015, 0x000D, 0x0000, 0x005A, 0x0014, 0x000B, 0x0026, 0x005F, 0x0000,
+    0x0000, 0x000C, 0x0008, 0x0036, 0x0001, 0x0043, 0x0068, 0x0001, 0x0069, 0x0051, 0x0002, 0x0137,
+    0x0112, 0x003E, 0x002C, 0x002A, 0x0000, 0x000D, 0x0002, 0x004E, 0x001D, 0x006F, 0x0000, 0x0004,
+    0x0001, 0x0001, 0x00B3, 0x0009, 0x0000, 0x001A, 0x0000, 0x000A, 0x0003, 0x0002, 0x004F, 0x001D,
+    0x0004, 0x0015, 0x000D, 0x0018, 0x0005, 0x0009, 0x0004, 0x0030, 0x0001, 0x005F, 0x0036, 0x0000,
+    0x0000, 0x0100, 0x0014, 0x001D, 0x00B3, 0x0015, 0x0067, 0x0077, 0x0000, 0x0001, 0x0001, 0x0000,
+    0x0002, 0x001F, 0x001C, 0x0045, 0x000D, 0x0001, 0x0023, 0x0004, 0x000E, 0x0004, 0x000D, 0x0013,
+    0x0005, 0x0000, 0x0008, 0x0003, 0x0009, 0x0000, 0x00A8, 0x0046, 0x0000, 0x003F, 0x004A, 0x0000,
+    0x012A, 0x003D, 0x004D, 0x0005, 0x0004, 0x0007, 0x0000, 0x003D, 0x0039, 0x0015, 0x00E2, 0x0002,
+    0x001B, 0x000E, 0x0013, 0x0055, 0x0006, 0x0167, 0x0036, 0x0000, 0x0012, 0x00ED, 0x0061, 0x00F5,
+    0x0001, 0x0169, 0x00EF, 0x00CD, 0x0001, 0x0007, 0x010E, 0x0001, 0x002F, 0x001F, 0x0014, 0x0006,
+    0x003F, 0x0029, 0x0015, 0x0038, 0x0012, 0x00D4, 0x00AB, 0x0000, 0x001F, 0x001D, 0x00DE, 0x0000,
+    0x0001, 0x0194, 0x001F, 0x01AC, 0x0056, 0x00DF, 0x0000, 0x0088, 0x005F, 0x005C, 0x000A, 0x0000,
+    0x0016, 0x0000, 0x0055, 0x0060, 0x002B, 0x000E, 0x001C, 0x0034, 0x000E, 0x0003, 0x0009, 0x0000,
+    0x0016, 0x0025, 0x0002, 0x000A, 0x0001, 0x0104, 0x0031, 0x0019, 0x0003, 0x013C, 0x0001, 0x0012,
+    0x001E, 0x0097, 0x0003, 0x0000, 0x0008, 0x00DE, 0x0589, 0x02C2, 0x0007, 0x0011, 0x0041, 0x0003,
+    0x0002, 0x0018, 0x0009, 0x001D, 0x0025, 0x0015, 0x000A, 0x000C, 0x0064, 0x00AF, 0x0001, 0x0049,
+    0x0074, 0x0006, 0x002D, 0x0022, 0x001E, 0x0007, 0x0003, 0x0006, 0x0009, 0x0005, 0x00A2, 0x0012,
+    0x011E, 0x0086, 0x0002, 0x0000, 0x001E, 0x0127, 0x0015, 0x0001, 0x0005, 0x01F8, 0x002B, 0x0007,
+    0x00A0, 0x0024, 0x017A, 0x0034, 0x0000, 0x0007, 0x000C, 0x0022, 0x002E, 0x0020, 0x0009, 0x0250,
+    0x000A, 0x02F5, 0x0104, 0x0004, 0x00E0, 0x003D, 0x0027, 0x0002, 0x00FF, 0x002D, 0x0003, 0x004C,
+    0x001B, 0x00D8, 0x0007, 0x0003, 0x0001, 0x005F, 0x00D4, 0x006C, 0x0068, 0x0007, 0x012B, 0x001C,
+    0x00CF, 0x0003, 0x0002, 0x003D, 0x000D, 0x0002, 0x0001, 0x009E, 0x0016, 0x00C7, 0x00D8, 0x0000,
+    0x0002, 0x0021, 0x00CF, 0x00C2, 0x0001, 0x00BA, 0x005B, 0x0004, 0x0004, 0x0002, 0x007B, 0x006F,
+    0x0111, 0x0025, 0x01B1, 0x0000, 0x00A3, 0x0000, 0x0072, 0x014D, 0x0007, 0x01C8, 0x0041, 0x0007,
+    0x0038, 0x004F, 0x00C7, 0x0003, 0x0042, 0x0001, 0x000A, 0x008B, 0x0005, 0x00E5, 0x001B, 0x0110,
+    0x0032, 0x00FE, 0x0017, 0x0087, 0x00DB, 0x0099, 0x00B1, 0x00B1, 0x0331, 0x001E, 0x0001, 0x01D8,
+    0x004E, 0x0000, 0x048A, 0x0005, 0x0149, 0x00D0, 0x09DF, 0x00A5, 0x00BD, 0x0127, 0x009A, 0x00ED,
+    0x0071, 0x001B, 0x0000, 0x00BA, 0x024A, 0x0231, 0x0184, 0x0022, 0x0115, 0x0001, 0x0003, 0x00E2,
+    0x02B1, 0x000A, 0x0052, 0x0002, 0x0001, 0x0000, 0x0136, 0x0009, 0x0191, 0x001E, 0x01C1, 0x001F,
+    0x0180, 0x0000, 0x003B, 0x0272, 0x009E, 0x03D0, 0x0034, 0x00B6, 0x000E, 0x010A, 0x0056, 0x00CE,
+    0x0019, 0x01F3, 0x0036, 0x0004, 0x0046, 0x0288, 0x0037, 0x0015, 0x0003, 0x0012, 0x0099, 0x0006,
+    0x0095, 0x0045, 0x0001, 0x0156, 0x00E7, 0x004E, 0x0108, 0x0004, 0x00AC, 0x0002, 0x0037, 0x00DC,
+    0x0246, 0x000E, 0x0001, 0x005A, 0x0019, 0x000B, 0x0004, 0x0000, 0x011A, 0x0031, 0x0022, 0x00A7,
+    0x0014, 0x0001, 0x0008, 0x0107, 0x0083, 0x02D4, 0x00D6, 0x0261, 0x000C, 0x0001, 0x0026, 0x0401,
+    0x002D, 0x034A, 0x076E, 0x0018, 0x0073, 0x0156, 0x00FD, 0x0051, 0x0119, 0x0029, 0x0000, 0x00C3,
+    0x037B, 0x02DB, 0x0151, 0x04E9, 0x0015, 0x0006, 0x0001, 0x00B7, 0x0028, 0x0136, 0x01A7, 0x0006,
+    0x01D9, 0x040F, 0x03BA, 0x0000, 0x0049, 0x01F8, 0x0001, 0x012B, 0x0034, 0x00BF, 0x026E, 0x0017,
+    0x040E, 0x0010, 0x0019, 0x0089, 0x0009, 0x0097, 0x0001, 0x007F, 0x03AD, 0x0003, 0x0145, 0x0046,
+    0x0065, 0x0332, 0x006B, 0x0001, 0x0023, 0x0006, 0x0001, 0x031F, 0x0033, 0x0004, 0x0020, 0x00D7,
+    0x0686, 0x0000, 0x000C, 0x01BF, 0x05E9, 0x00D5, 0x0BA7, 0x0BC9, 0x0038, 0x00D1, 0x09B8, 0x01C1,
+    0x006D, 0x02B5, 0x000C, 0x010B, 0x0001, 0x0016, 0x0026, 0x0130, 0x002A, 0x0012, 0x02DC, 0x01DB,
+    0x007F, 0x0002, 0x009D, 0x0070, 0x0000, 0x0007, 0x0000, 0x00AC, 0x0523, 0x0010, 0x00DB, 0x0004,
+    0x0004, 0x002A, 0x001A, 0x0254
+};
+
+/* Per slot (mix(hash ^ seed) % ENTITY_SLOTS): the character in bits
+   0-20, a second one as an index into g_entity_second in bits 21-24,
+   whether ';' may be left out in bit 25 and the name length from bit
+   26. 0 for an empty slot. */
+static const unsigned int g_entity_value[2125] = {
+    0x3C0021D3, 0x140002DD, 0x540022E1, 0x4C002950, 0x0C01D510, 0x200029E4,
+    0x1001D4BB, 0x100021B2, 0x3C0003F5, 0x1C002605, 0x3000210B, 0x1C002974,
+    0x18000148, 0x0C0003A7, 0x1A0000BC, 0x100022C1, 0x1C00211B, 0x10002AB7,
+    0x0800211C, 0x18000143, 0x18000160, 0x140022E6, 0x14002565, 0x28A0205F,
+    0x0C000410, 0x20002205, 0x14002294, 0x18002105, 0x200025B5, 0x1400233D,
+    0x4800295F, 0x34002952, 0x14002203, 0x1800017E, 0x08002ABB, 0x100020DB,
+    0x120000AA, 0x2C0029F4, 0x1C002021, 0x0C01D516, 0x18000158, 0x140021AD,
+    0x3C0025BD, 0x140022F0, 0x340027F5, 0x2C0021CF, 0x3C0021AE, 0x1C002A7C,
+    0x14002569, 0x100029F6, 0x10002AAC, 0x20002A49, 0x3C002019, 0x1A0000DD,
+    0x180025AE, 0x0C01D519, 0x3C0021BD, 0x18002AD5, 0x180022D0, 0x1C00000A,
+    0x1800015F, 0x400021C9, 0x10000130, 0x100022D5, 0x10002A56, 0x25002269,
+    0x40002289, 0x20002A36, 0x140003D6, 0x18002A02, 0x1800223C, 0x340027F5,
+    0x10002223, 0x10002298, 0x20002115, 0x080003BD, 0x14002242, 0x140022E7,
+    0x0C0022D2, 0x18000155, 0x1400219A, 0x2C002276, 0x18002020, 0x100022A5,
+    0x2400221D, 0x10002550, 0x18002A80, 0x18002323, 0x140025B8, 0x18002AC8,
+    0x180027E9, 0x2400230A, 0x14000118, 0x1C0003BF, 0x18002A40, 0x380021C7,
+    0x14002713, 0x1400011D, 0x14002AE9, 0x480021CB, 0x1800224F, 0x0C0000F7,
+    0x280021A5, 0x28002237, 0x160000E6, 0x160000A3, 0x1CC02282, 0x200022BA,
+    0x0C002283, 0x18002A5F, 0x1C0022E3, 0x100029A4, 0x0C0003B7, 0x0C01D52A,
+    0x140021B5, 0x18000127, 0x10000426, 0x1000040F, 0x100025B9, 0x10002286,
+    0x18002975, 0x10002273, 0x1800291E, 0x10002606, 0x3800226A, 0x1C0022F5,
+    0x200027FF, 0x0A00003E, 0x1800017D, 0x1A0000C8, 0x1800FB04, 0x14000100,
+    0x100002DA, 0x1400014C, 0x18002021, 0x14000109, 0x140022C0, 0x28002912,
+    0x3C80224E, 0x0C01D52B, 0x1C002948, 0x1400220C, 0x1001D4CE, 0x0C00043F,
+    0x340021A6, 0x14002588, 0x18002254, 0x14000104, 0x0C00041F, 0x14002556,
+    0x1800231D, 0x0800039E, 0x18000129, 0x18002939, 0x28002242, 0x1C002276,
+    0x2000222B, 0x18002A93, 0x10002AC6, 0x100027EB, 0x14002AD1, 0x100027E9,
+    0x14002033, 0x24002234, 0x180022F3, 0x3C002958, 0x140003B8, 0x3000228F,
+    0x160000B8, 0x1A0000FA, 0x120000CB, 0x19002ACB, 0x2C80226A, 0x340022C7,
+    0x30002262, 0x10002962, 0x140021D7, 0x48002957, 0x140002C7, 0x18002009,
+    0x10002002, 0x0800226A, 0x34002249, 0x18000154, 0x10002929, 0x28002ACB,
+    0x140027FA, 0x14002122, 0x14002288, 0x14002322, 0x12000022, 0x18000126,
+    0x0C000442, 0x10002AA6, 0x1001D566, 0x0C0025A1, 0x1C002968, 0x120000A9,
+    0x10002022, 0x1001D540, 0x140021D8, 0x10002299, 0x0C0003C8, 0x28002205,
+    0x1800017A, 0x120000BA, 0x14000124, 0x08002248, 0x48002293, 0x1001D4C7,
+    0x0C000424, 0x0C01D52D, 0x1A0000BE, 0x140025FA, 0x24002193, 0x180021A6,
+    0x100022C3, 0x240022A1, 0x1800010F, 0x0C0003A6, 0x18002112, 0x18002AD3,
+    0x100003B2, 0x1CE02261, 0x20002A06, 0x18002945, 0x1001D55A, 0x1000219F,
+    0x18002A01, 0x1C002920, 0x4800200B, 0x14002280, 0x180022BB, 0x28002131,
+    0x1400040B, 0x18000146, 0x3C00219D, 0x14002563, 0x2000229F, 0x4800295D,
+    0x14002248, 0x3C002198, 0x0C002211, 0x200023E2, 0x24002660, 0x080003A0,
+    0x200022A0, 0x50002226, 0x340021AB, 0x100003D5, 0x14002013, 0x0C000433,
+    0x2000005F, 0x24002193, 0x2C0022DE, 0x140021CA, 0x08002267, 0x1000010A,
+    0x1C00293C, 0x1800203A, 0x14002510, 0x14002224, 0x1800297F, 0x1400252C,
+    0x0C002111, 0x28802AC6, 0x1001D552, 0x18002A94, 0x24002226, 0x0E0000D0,
+    0x140003B3, 0x18000138, 0x1400003A, 0x18002238, 0x18000151, 0x3C00222E,
+    0x1C00203E, 0x100027EA, 0x20002202, 0x1800016D, 0x08002265, 0x1000212C,
+    0x1000042F, 0x3C0021C4, 0x10C0224D, 0x0C00041D, 0x0C0003C6, 0x1C002AC3,
+    0x28002248, 0x14000125, 0x0C002223, 0x24002213, 0x1001D4CB, 0x140021BD,
+    0x1400266F, 0x18000458, 0x140000C5, 0x14002772, 0x200003D1, 0x1A0000CD,
+    0x28002192, 0x24002190, 0x10000447, 0x1C002249, 0x44002291, 0x2C002294,
+    0x14000454, 0x1400015C, 0x140029C5, 0x3C002960, 0x160000A1, 0x1800228D,
+    0x44002758, 0x14000135, 0x14000119, 0x0C01D504, 0x1C002A35, 0x14002226,
+    0x140021C1, 0x18002316, 0x30002265, 0x0800039C, 0x1400FB00, 0x080003BE,
+    0x1C002AD8, 0x400027E8, 0x38002226, 0x1C0029BB, 0x0C002A7D, 0x14002261,
+    0x140027F8, 0x1400225A, 0x0C002AAF, 0x3C0023DC, 0x28002112, 0x1001D557,
+    0x18000106, 0x15002AAD, 0x14002A8E, 0x0C00005E, 0x08002063, 0x140021D6,
+    0x3C0022B2, 0x160000C5, 0x10002285, 0x1800016C, 0x10002194, 0x400021D2,
+    0x18002205, 0x38002AA2, 0x0E000026, 0x2C002248, 0x500021D4, 0x18000179,
+    0x1001D556, 0x1C002979, 0x08002264, 0x10802AAF, 0x340025B4, 0x300023B5,
+    0x180003BB, 0x0C0003A9, 0x200029DD, 0x18002AB0, 0x0C01D51A, 0x280021A7,
+    0x2C00205F, 0x14000153, 0x1800223E, 0x0C01D521, 0x080022D9, 0x0C000411,
+    0x11002269, 0x08002277, 0x1C002ABF, 0x18002A6A, 0x18002305, 0x18002119,
+    0x0C60223E, 0x140022BF, 0x20002225, 0x10000116, 0x08002ABC, 0x1800230C,
+    0x0E0000F0, 0x18000122, 0x1C00298D, 0x1800042A, 0x14002192, 0x14002269,
+    0x1800042C, 0x2800230B, 0x14002243, 0x140022A3, 0x140021CE, 0x1C002A26,
+    0x180029E3, 0x0C00014A, 0x1C0029B0, 0x1C002A14, 0x180029BC, 0x19002ACC,
+    0x10002AB5, 0x1C0029A7, 0x180022AE, 0x180022CC, 0x0C0000A8, 0x24002204,
+    0x28002243, 0x0C0025CB, 0x0C002A70, 0x1001D4CF, 0x180022C3, 0x30002253,
+    0x20002241, 0x0C802266, 0x1C00039F, 0x14002216, 0x140022B3, 0x140021C5,
+    0x38002193, 0x140022D7, 0x24002AC6, 0x10002112, 0x14002196, 0x30002147,
+    0x18002315, 0x0C0029C1, 0x140027ED, 0x180027E8, 0x28002AB7, 0x1C0029B1,
+    0x14000177, 0x1800010D, 0x18002216, 0x18000168, 0x20002910, 0x140021C0,
+    0x14002274, 0x1C002230, 0x60002232, 0x20002A48, 0x4C00200B, 0x1000211B,
+    0x18002218, 0x1001D55D, 0x44002247, 0x10000029, 0x14002190, 0x180003C2,
+    0x14002290, 0x3800220B, 0x100000BD, 0x10000028, 0x1C00220C, 0x2C002281,
+    0x18002210, 0x10000401, 0x10000446, 0x1400FB02, 0x1000007C, 0x180003D1,
+    0x1800297E, 0x18002133, 0x140021BB, 0x160000E5, 0x1C002972, 0x1001D54E,
+    0x1C0022A4, 0x18002993, 0x0C002268, 0x2C002277, 0x120000DC, 0x1C00225F,
+    0x400022DA, 0x0C01D518, 0x1C002966, 0x1C002235, 0x08002146, 0x140003BA,
+    0x14000152, 0x10002A9D, 0x180023B1, 0x3400210C, 0x10002016, 0x100023B5,
+    0x0C01D508, 0x140021CD, 0x480027F7, 0x2000224C, 0x200022E8, 0x18002057,
+    0x240021D3, 0x0C00043B, 0x10002110, 0x0C002207, 0x14000112, 0x14002295,
+    0x18002A2E, 0x1800222E, 0x1A0000CC, 0x15002AAC, 0x1A0000F9, 0x10C0003E,
+    0x1800201E, 0x1400256A, 0x44802A7D, 0x0C01D534, 0x10000448, 0x14002A4D,
+    0x10000452, 0x1A0000EC, 0x140021CF, 0x1000266D, 0x3C002192, 0x0E0000B0,
+    0x14002227, 0x10002271, 0x3C0021C1, 0x0800220B, 0x10002245, 0x200029AA,
+    0x1001D4A6, 0x140002DC, 0x24002A02, 0x20002663, 0x120000AF, 0x28002295,
+    0x140022DF, 0x1C00237C, 0x1A0000D2, 0x2400211A, 0x300021A4, 0x3400296E,
+    0x1400045E, 0x1C002209, 0x14002129, 0x1800230B, 0x280021C8, 0x180003F0,
+    0x240000B7, 0x0C000444, 0x18002A06, 0x1C0022C4, 0x44002961, 0x08002118,
+    0x200029AF, 0x0C01D52C, 0x14000101, 0x1C002031, 0x4000295C, 0x0C000009,
+    0x1A0000E7, 0x0A00003C, 0x35002ACC, 0x0800227A, 0x1400260E, 0x14002198,
+    0x18002273, 0x10002256, 0x1C002A00, 0x1800002A, 0x10002A38, 0x2400228E,
+    0x1C002AC1, 0x18002283, 0x160000E2, 0x0C0022D1, 0x10002A8A, 0x1001D53D,
+    0x1000221A, 0x180022C9, 0x1C002214, 0x14002AAE, 0x0C01D50E, 0x10002284,
+    0x2000294A, 0x1C0022D6, 0x14002564, 0x10002A5A, 0x14002A2F, 0x30002191,
+    0x38002278, 0x200029A8, 0x1400266E, 0x18002904, 0x1400228F, 0x14002248,
+    0x1800015E, 0x1A0000ED, 0x0E0000A8, 0x0C000418, 0x3C002271, 0x180022C2,
+    0x580022E3, 0x14002220, 0x18002200, 0x240022DB, 0x140021CB, 0x18002A25,
+    0x180022AF, 0x400021C1, 0x1C002254, 0x180021A3, 0x14002518, 0x14002231,
+    0x160000D7, 0x28002AB8, 0x380021A3, 0x0C00200F, 0x1C00298E, 0x10002A73,
+    0x1800015B, 0x140025EF, 0x140022A1, 0x18000139, 0x1C002A78, 0x100003B5,
+    0x10002A43, 0x1A0000F2, 0x18002994, 0x10002272, 0x488029CF, 0x1800291A,
+    0x24802A7E, 0x18000163, 0x38002245, 0x160000DE, 0x18002244, 0x208022F5,
+    0x120000EF, 0x10002251, 0x20002233, 0x1001D562, 0x38002062, 0x1400015D,
+    0x1800044C, 0x280023DF, 0x100003F1, 0x1000212F, 0x10002720, 0x4400220C,
+    0x100027E8, 0x40002267, 0x1C0022BE, 0x200027C8, 0x14002018, 0x14802242,
+    0x0C01D512, 0x140022EB, 0x440027E6, 0x3100228B, 0x1480224B, 0x14002580,
+    0x200022B8, 0x080022D8, 0x18002ABD, 0x340021BC, 0x1A0000F1, 0x18002916,
+    0x2000231F, 0x140022F1, 0x14002A3C, 0x10000436, 0x2C002195, 0x0C002A5B,
+    0x18002ABE, 0x140021CC, 0x340021BF, 0x20002216, 0x18000161, 0x0C00002F,
+    0x38002953, 0x200023E7, 0x100020AC, 0x380027F6, 0x180022BA, 0x20002305,
+    0x14002A72, 0x1400255C, 0x1001D561, 0x10002A89, 0x0C01D50A, 0x1C0000B8,
+    0x180003DC, 0x1000005D, 0x0A00003E, 0x2C002130, 0x10000435, 0x18000107,
+    0x140022B5, 0x1C0029A6, 0x1001D53C, 0x3C0022CC, 0x1001D4A5, 0x480027E7,
+    0x10000027, 0x1A0000BF, 0x0C01D511, 0x10000192, 0x188022F9, 0x280021A4,
+    0x20002286, 0x180025A1, 0x0C01D51F, 0x18000170, 0x1C00226E, 0x1800013D,
+    0x14000149, 0x20002AB6, 0x1001D4B3, 0x1001D542, 0x08002260, 0x20002A01,
+    0x10000402, 0x2400228B, 0x18002A47, 0x140027E6, 0x10002270, 0x24002272,
+    0x34802242, 0x1000210A, 0x140025B4, 0x0C002A87, 0x300025BF, 0x10002208,
+    0x28002209, 0x0C000419, 0x0C002AB0, 0x18000164, 0x4C002292, 0x3C0021CE,
+    0x14002AB9, 0x1400290D, 0x240022D4, 0x18002924, 0x14002252, 0x1C0021D1,
+    0x14002555, 0x18002035, 0x18002200, 0x14000391, 0x1C0022F7, 0x18000162,
+    0x20002A17, 0x100022C6, 0x1400211D, 0x1A0000F8, 0x1400229D, 0x1CC022B4,
+    0x400022DB, 0x1C002967, 0x1400251C, 0x140003F5, 0x120000E4, 0x180022E9,
+    0x280023B0, 0x1800291B, 0x18002923, 0x10000428, 0x24002216, 0x0C002A91,
+    0x10002AA7, 0x160000BB, 0x14002AA9, 0x1400226C, 0x14002A71, 0x0C00200D,
+    0x0800039D, 0x18002010, 0x1C002A7B, 0x14002985, 0x1001D567, 0x1000003B,
+    0x1080226A, 0x2000211C, 0x50802A7E, 0x120000B3, 0x180022C1, 0x18000150,
+    0x18002902, 0x1400201A, 0x1001D4C5, 0x400025FB, 0x18002A7F, 0x2400228A,
+    0x10002AB6, 0x0C000421, 0x1800229F, 0x4C8029D0, 0x1800224D, 0x1400255A,
+    0x14002A79, 0x18000141, 0x1001D4A2, 0x1800297C, 0x1000229A, 0x4400200B,
+    0x18002336, 0x1000007B, 0x1400227C, 0x14002237, 0x1000040C, 0x1001D54D,
+    0x28002201, 0x110022DB, 0x14000394, 0x14002986, 0x2000299D, 0x1001D4B2,
+    0x1C0003DD, 0x18002259, 0x1001D558, 0x1001D55B, 0x10802A7E, 0x140021AE,
+    0x1880219D, 0x18002928, 0x14002250, 0x100003C5, 0x18002A4A, 0x0C002A85,
+    0x28002A8B, 0x0CC0226B, 0x14002566, 0x1C002199, 0x1400224C, 0x180022C6,
+    0x1C0029C2, 0x18002A44, 0x0C002AB3, 0x18002039, 0x3C0022B5, 0x1800297D,
+    0x14002246, 0x2C00229A, 0x1A0000E0, 0x2C002666, 0x1800230D, 0x3C0022EC,
+    0x44002959, 0x380022EB, 0x0C002A86, 0x1C00220F, 0x1000005B, 0x180025EC,
+    0x1400012F, 0x10002224, 0x180022CB, 0x440021D5, 0x30002273, 0x1400226E,
+    0x18002A29, 0x18002A33, 0x0C002A88, 0x14002534, 0x1800221D, 0x14002247,
+    0x180001F5, 0x0C000439, 0x1800296D, 0x3400295A, 0x10002287, 0x380021BE,
+    0x0C00043A, 0x2C00219B, 0x0C01D51C, 0x1400219B, 0x10002102, 0x1400012E,
+    0x2C0021DB, 0x1A0000E1, 0x14000404, 0x180025A1, 0x440021CC, 0x140022EF,
+    0x14002289, 0x18000169, 0x0C000420, 0x2C002218, 0x500027F9, 0x25002268,
+    0x10000455, 0x140021D9, 0x1C0029B2, 0x18000137, 0x1C002A27, 0x440025BE,
+    0x14002591, 0x1001D546, 0x540022E0, 0x14002AD9, 0x0C01D513, 0x1C0025EF,
+    0x1800011B, 0x34002252, 0x140027F5, 0x38002190, 0x100025AD, 0x1C002A39,
+    0x10002A9E, 0x1001D4BF, 0x180020DC, 0x20002251, 0x18002640, 0x18002AD4,
+    0x10002928, 0x14802250, 0x1000220F, 0x1C002A22, 0x380002D9, 0x14802266,
+    0x08002A54, 0x1C0027C9, 0x1400039A, 0x100003B9, 0x0800227B, 0x38002018,
+    0x280003F5, 0x0800223E, 0x14002236, 0x14002ACB, 0x10002A88, 0x18002203,
+    0x1000227B, 0x340021D1, 0x14002135, 0x14802202, 0x14002524, 0x08002240,
+    0x10000425, 0x1C0022F6, 0x14002111, 0x1001D4CA, 0x18002118, 0x14002991,
+    0x0C002227, 0x1400227E, 0x1001D4C3, 0x1000017C, 0x1001D539, 0x0C000440,
+    0x0C002127, 0x1A0000F7, 0x14002562, 0x1A0000A4, 0x14002250, 0x0C00226E,
+    0x3000221D, 0x10002225, 0x0C00211C, 0x34002225, 0x1C002A77, 0x0C002AAB,
+    0x20002283, 0x1A0000C3, 0x2C002297, 0x0E0000AC, 0x28002148, 0x200003D1,
+    0x180021AB, 0x14002553, 0x0C0022A5, 0x18002030, 0x140029A5, 0x10002266,
+    0x1000010B, 0x1800201D, 0x180021AA, 0x1001D4B6, 0x180022AD, 0x400023DD,
+    0x180021A2, 0x20002A23, 0x1A0000C0, 0x1001D4B9, 0x0C0022D0, 0x0C002281,
+    0x1400290F, 0x18000142, 0x240000A8, 0x160000FB, 0x1800210F, 0x0C002AAA,
+    0x1000224B, 0x120000F6, 0x34002287, 0x0C000430, 0x18002008, 0x14000456,
+    0x34002221, 0x18002043, 0x20002124, 0x1001D550, 0x0E0000A5, 0x180021B7,
+    0x1C002720, 0x1001D4BD, 0x10002193, 0x14002275, 0x10000451, 0x1C002A24,
+    0x0C000443, 0x1400FB01, 0x0CE0003D, 0x14002567, 0x3080224F, 0x20002A58,
+    0x1800007D, 0x1400221D, 0x200029AD, 0x1A0000F5, 0x100003D2, 0x140022C3,
+    0x1001D568, 0x10002965, 0x14000393, 0x1C002A16, 0x19002293, 0x160000AB,
+    0x180022EC, 0x2C002ABA, 0x40002951, 0x18000166, 0x200022C0, 0x100021D2,
+    0x500022EC, 0x08002276, 0x1800005B, 0x34002146, 0x160000B5, 0x18002026,
+    0x380021B6, 0x200022CE, 0x18000102, 0x1000210B, 0x100022B7, 0x1400227F,
+    0x10002AE7, 0x0C01D51E, 0x0C00002A, 0x1000044E, 0x0C002280, 0x2000224A,
+    0x1400201D, 0x1400016F, 0x1C002272, 0x160000FE, 0x10002551, 0x140029BE,
+    0x18002AF1, 0x0C01D529, 0x160000F4, 0x380021C3, 0x2000231D, 0x3000007C,
+    0x1400229E, 0x1001D49E, 0x3C80228F, 0x1400228E, 0x1001D4AF, 0x1C00297B,
+    0x1000044F, 0x2800229B, 0x10000416, 0x160000DF, 0x3100228A, 0x0C000441,
+    0x1000219E, 0x1400227D, 0x1C002197, 0x300021BF, 0x280023B1, 0x4C0027F8,
+    0x200022E9, 0x160000C6, 0x340021A2, 0x380021D4, 0x1400219D, 0x10000021,
+    0x10000405, 0x0C00042B, 0x1000210D, 0x18002903, 0x1C00229E, 0x280021CD,
+    0x0C00210C, 0x14002209, 0x2000227B, 0x1800225F, 0x28002192, 0x0C002AB4,
+    0x24000311, 0x140021DB, 0x18002A30, 0x0C00014B, 0x140000AF, 0x20002925,
+    0x1001D4CC, 0x100022C5, 0x1800296A, 0x10002136, 0x10002267, 0x1000005C,
+    0x1400223C, 0x20002287, 0x140021C4, 0x0C000434, 0x18002022, 0x140021F5,
+    0x1C000395, 0x1800013E, 0x180022C8, 0x1400298B, 0x140022A9, 0x20002A3A,
+    0x0C002A8C, 0x10002226, 0x2C002286, 0x18002159, 0x0C0021D4, 0x08002111,
+    0x34002216, 0x20002AA1, 0x0C000438, 0x14C02282, 0x18000167, 0x14000131,
+    0x140021E5, 0x0C002270, 0x18002234, 0x14000060, 0x1C002935, 0x1001D4AE,
+    0x1800212C, 0x44002956, 0x100002C6, 0x14002AEE, 0x3800295B, 0x100021B3,
+    0x0C01D533, 0x2C00227D, 0x2400225C, 0x20002A7E, 0x18000159, 0x14000176,
+    0x14002773, 0x18000449, 0x1800296C, 0x14002A00, 0x34002061, 0x1800FB03,
+    0x140001B5, 0x1400296F, 0x0E0000AE, 0x18002291, 0x12000022, 0x18002925,
+    0x18000156, 0x4C802267, 0x0C000412, 0x1C002196, 0x1C002A2A, 0x10000459,
+    0x1C00266E, 0x500022E2, 0x0C01D532, 0x20002A15, 0x140003A3, 0x3400227E,
+    0x18002155, 0x1C00210E, 0x0C00043D, 0x38002224, 0x34002266, 0x1001D4C8,
+    0x1800230E, 0x18002262, 0x0C002220, 0x200003F0, 0x1C002ADA, 0x1800215A,
+    0x0C00044B, 0x1400204F, 0x1400290C, 0x180023B0, 0x240022CD, 0x24002261,
+    0x1C0022A3, 0x14002019, 0x1001D55E, 0x10002AC5, 0x1C0022E2, 0x1C00212D,
+    0x0C002AA5, 0x3C0021C2, 0x2000294B, 0x10C02264, 0x24002299, 0x08002A99,
+    0x3C002275, 0x100022D4, 0x140021BC, 0x18002217, 0x14002199, 0x10802AB0,
+    0x200029CE, 0x140027F6, 0x1001D563, 0x0C002249, 0x1000042E, 0x1C00226C,
+    0x380021AA, 0x2C0025AA, 0x300025C3, 0x0C01D52E, 0x1001D4B7, 0x20002A10,
+    0x140002D8, 0x0E0000AD, 0x14002A11, 0x200029B4, 0x18000110, 0x140003C3,
+    0x18002AC7, 0x1C0003C5, 0x340021A9, 0x1C002990, 0x1001D4A9, 0x1800299C,
+    0x1001D4B0, 0x0C002211, 0x0C00223F, 0x18002292, 0x100002DB, 0x1C0022FD,
+    0x1C002134, 0x440021CB, 0x0C00200E, 0x1000211C, 0x1400045B, 0x300021A7,
+    0x140003C9, 0x1C002204, 0x18002158, 0x0C0000A8, 0x1800224E, 0x14002A4C,
+    0x140022B8, 0x1400256C, 0x10002AD0, 0x1400228A, 0x10000427, 0x1A0000C9,
+    0x0C01D537, 0x340025B3, 0x1001D4C2, 0x1400040E, 0x180029C9, 0x1800200A,
+    0x24002289, 0x30002913, 0x120000CF, 0x140027EC, 0x14002197, 0x14002244,
+    0x14002AFD, 0x5400200B, 0x1400255E, 0x160000CA, 0x4400295E, 0x180022CA,
+    0x0C002A7E, 0x180021B6, 0x24002224, 0x18002919, 0x1001D56B, 0x14002A77,
+    0x14002552, 0x0C002A53, 0x180003DD, 0x14002592, 0x1400003F, 0x18002214,
+    0x11002268, 0x20802A6D, 0x0C002228, 0x0C0029C0, 0x18002248, 0x14002308,
+    0x10002201, 0x14002AA8, 0x2C0021D5, 0x18002019, 0x10002241, 0x14002560,
+    0x24002234, 0x480027F7, 0x0800226B, 0x1000045A, 0x0C00041C, 0x20002AB5,
+    0x18002A4B, 0x0C002265, 0x140027F7, 0x1C002060, 0x280027FC, 0x24002665,
+    0x1001D4AA, 0x18002235, 0x0C002905, 0x24002A86, 0x28802AC5, 0x14002A9F,
+    0x14002ACC, 0x140003D2, 0x180022B0, 0x1001D543, 0x3400200A, 0x14002A8F,
+    0x2000231E, 0x140025B3, 0x10002642, 0x1800013F, 0x18002117, 0x180003C2,
+    0x0C002269, 0x44002A7E, 0x1001D565, 0x14002910, 0x1001D54C, 0x18002AF0,
+    0x0C002A95, 0x380027F9, 0x0C002271, 0x24002288, 0x1C00227E, 0x0C01D509,
+    0x1C002A57, 0x14002971, 0x20002A83, 0x140025BE, 0x14000132, 0x140025F9,
+    0x14002558, 0x300021E4, 0x1001D4BE, 0x1001D4B4, 0x1001D554, 0x1A0000A6,
+    0x18002255, 0x0C002A96, 0x200029B3, 0x4480226B, 0x1400255F, 0x10002134,
+    0x20002926, 0x18000040, 0x1000200C, 0x14002584, 0x1400222D, 0x18002929,
+    0x1C0003B5, 0x28002292, 0x14002568, 0x1001D560, 0x180022AA, 0x1C002191,
+    0x08002213, 0x1C002235, 0x14002A3F, 0x0C01D530, 0x1800215E, 0x14002663,
+    0x1800010E, 0x1800232D, 0x1400255B, 0x34002AB0, 0x1400203E, 0x2C00229D,
+    0x4800227D, 0x38002063, 0x400022ED, 0x440025C2, 0x18002665, 0x14000174,
+    0x1001D4C9, 0x0C002A92, 0x200022A2, 0x14002557, 0x440027E9, 0x1C002AC4,
+    0x10002124, 0x0C01D52F, 0x18000111, 0x18002256, 0x20002313, 0x280021D2,
+    0x400021C2, 0x1001D4B1, 0x120000A2, 0x1001D538, 0x3C002197, 0x0C01D507,
+    0x14002561, 0x10002A87, 0x1A0000B1, 0x20002949, 0x1400253C, 0x3800200B,
+    0x140022D6, 0x1001D4AC, 0x28002A85, 0x1400296E, 0x18000147, 0x38002306,
+    0x100025B5, 0x3000224E, 0x24002133, 0x18002116, 0x18000157, 0x18002A6E,
+    0x18002A6F, 0x0C0003C1, 0x14000237, 0x0C00222B, 0x480027FA, 0x30002274,
+    0x44002225, 0x10002A5C, 0x140021BA, 0x1000040A, 0x1A0000D8, 0x440025FC,
+    0x1C0021DD, 0x200029E5, 0x1C002208, 0x38002199, 0x1C002A3B, 0x1800210B,
+    0x300022B2, 0x38002196, 0x140022A5, 0x14002717, 0x1800291D, 0x140022AB,
+    0x14002AD2, 0x10C02265, 0x3400227F, 0x100025AA, 0x18002221, 0x1C002A82,
+    0x08002148, 0x18000429, 0x380022CB, 0x20002911, 0x1C002AC0, 0x18002A74,
+    0x140003F6, 0x0C000397, 0x120000B6, 0x18000136, 0x34002244, 0x0C0003C7,
+    0x10002242, 0x14000113, 0x0C0003A1, 0x100023B4, 0x38002194, 0x140022B2,
+    0x1C002255, 0x140022CE, 0x18002222, 0x14C02283, 0x18002297, 0x14C0223C,
+    0x24002102, 0x10002195, 0x160000EA, 0x18002240, 0x10002279, 0x0C0003C4,
+    0x380022A8, 0x0C002A8B, 0x100029B6, 0x18000140, 0x540025AA, 0x160000C2,
+    0x0800226A, 0x1C002A50, 0x5400222F, 0x180022ED, 0x2C002223, 0x1800011E,
+    0x0C002113, 0x1001D55F, 0x1000221D, 0x0C01D536, 0x580002DD, 0x14002423,
+    0x10002026, 0x500025AB, 0x280022CF, 0x1400201C, 0x400000B4, 0x100029C3,
+    0x28002291, 0x0C0021B0, 0x20002312, 0x14002293, 0x28002ACC, 0x140021FD,
+    0x08002208, 0x180022E1, 0x0C00222C, 0x340021E5, 0x44802290, 0x10002131,
+    0x28002A96, 0x08002266, 0x2C0003D5, 0x2000231C, 0x340027F8, 0x100029B7,
+    0x0C002128, 0x1800011A, 0x180022A7, 0x380021BD, 0x1400016E, 0x300029EB,
+    0x14002253, 0x1800215B, 0x38002A7D, 0x0C0003D6, 0x10000403, 0x14002014,
+    0x1C802AB0, 0x140003B1, 0x18002996, 0x18002156, 0x180022B6, 0x1000225C,
+    0x1400016A, 0x1001D553, 0x3C0022EA, 0x440022B4, 0x1040223D, 0x2000227A,
+    0x100027FC, 0x0C00041E, 0x10C0003C, 0x100021D3, 0x20002290, 0x400021F5,
+    0x14002212, 0x120000B2, 0x1400221E, 0x0C00043E, 0x140022CD, 0x10000396,
+    0x10002A0C, 0x14000175, 0x1A0000B7, 0x140022A8, 0x1A0000E8, 0x0C000417,
+    0x0C0022FC, 0x080003BC, 0x140021C8, 0x140021C6, 0x0E000026, 0x140029B5,
+    0x1C802AAF, 0x0C00220B, 0x1400255D, 0x24002009, 0x1800231C, 0x19002294,
+    0x10000392, 0x140022EA, 0x120000D6, 0x0C000414, 0x2800226F, 0x1A0000E3,
+    0x140025C2, 0x1001D4CD, 0x10002AED, 0x1000227A, 0x18000144, 0x1000229B,
+    0x1800039B, 0x10802A7D, 0x140021FF, 0x18002213, 0x10002257, 0x2000232E,
+    0x14002281, 0x0C01D517, 0x18000025, 0x1400011C, 0x14002554, 0x1800011F,
+    0x14002007, 0x1C00223D, 0x1880224F, 0x1C00298F, 0x200023B6, 0x140021C9,
+    0x180022BD, 0x380021AC, 0x18002015, 0x140029CD, 0x20002A7D, 0x2CC02283,
+    0x14002A45, 0x30002270, 0x10002936, 0x2C0023B4, 0x10002278, 0x18002005,
+    0x0C01D535, 0x10002963, 0x2400226D, 0x1001D4AB, 0x1480224E, 0x18000131,
+    0x5400201D, 0x18002034, 0x10002310, 0x0C000422, 0x120000FC, 0x10000453,
+    0x1001D4C1, 0x1A0000BD, 0x140025F8, 0x0C0021B1, 0x28002A8C, 0x1400201E,
+    0x10000399, 0x14002AE4, 0x10002502, 0x14802AC6, 0x1001D569, 0x20002A84,
+    0x0C000423, 0x14002137, 0x5000226B, 0x20002A13, 0x160000D4, 0x2C0021C0,
+    0x10002025, 0x14002032, 0x200029AE, 0x0C00044D, 0x180022D1, 0x1CC022B5,
+    0x18002138, 0x160000B4, 0x1400012B, 0x0C002225, 0x080000B1, 0x200024C8,
+    0x100021A1, 0x14002666, 0x18002A0C, 0x180003F1, 0x200000AE, 0x14002A66,
+    0x140025BD, 0x0C0022DA, 0x24002713, 0x0C00222A, 0x140021BF, 0x18002016,
+    0x18002257, 0x14000406, 0x18002A46, 0x34002240, 0x180022C0, 0x10002AAD,
+    0x0C0003A4, 0x0C00043C, 0x140021E4, 0x0C00223C, 0x2000220B, 0x0C01D505,
+    0x0C00226F, 0x1A0000E9, 0x180021AC, 0x0C0022DB, 0x0C01D520, 0x14002309,
+    0x14002605, 0x200029AB, 0x1800215C, 0x40002954, 0x1001D54F, 0x400022B3,
+    0x0A00003C, 0x1001D559, 0x0C0022C1, 0x30002147, 0x140002C7, 0x0C01D50D,
+    0x38002279, 0x0C0022A4, 0x380021CA, 0x10002130, 0x1000007D, 0x1000002B,
+    0x1800223B, 0x340022B3, 0x0C0021B1, 0x140025B1, 0x14002992, 0x2C002A95,
+    0x180022D7, 0x4C0021C4, 0x400000A0, 0x120000C4, 0x1001D53B, 0x18002AEF,
+    0x140021BE, 0x1C00290F, 0x0C01D523, 0x18002AAF, 0x4C0021AD, 0x18002153,
+    0x10002115, 0x1C002135, 0x38002288, 0x140021C7, 0x1001D4C6, 0x14000173,
+    0x18002660, 0x1800201A, 0x18002A2D, 0x180022A5, 0x1001D541, 0x10002AEB,
+    0x0C000023, 0x1000045F, 0x18000171, 0x10002190, 0x1000222E, 0x1A0000DA,
+    0x480022B5, 0x14000105, 0x18002A97, 0x1000210F, 0x380021C0, 0x200029A9,
+    0x14002593, 0x20002A89, 0x14000134, 0x18002157, 0x2C00227C, 0x1000211A,
+    0x2400224F, 0x4080227F, 0x140022F2, 0x1A0000D3, 0x1400002C, 0x38002500,
+    0x0800211E, 0x1C0029DE, 0x20002A0D, 0x120000A7, 0x18002AD6, 0x24002035,
+    0x0C01D525, 0x38002290, 0x24002210, 0x1C0025CA, 0x100025BF, 0x34002AAF,
+    0x0C8022D9, 0x2C00210D, 0x1800044A, 0x1001D4B5, 0x140003A9, 0x5C802AA2,
+    0x2800219A, 0x140022B4, 0x100021A0, 0x2C002195, 0x240022DA, 0x18002154,
+    0x1800291C, 0x380022B4, 0x1A0000C1, 0x180022AC, 0x20002110, 0x11002229,
+    0x10000121, 0x20002A8A, 0x1000266A, 0x0C0003A8, 0x38002194, 0x1800013A,
+    0x0C01D50F, 0x160000DB, 0x100021D4, 0x200021A5, 0x140029BF, 0x1400250C,
+    0x14002A8D, 0x200003C2, 0x18002A98, 0x18802933, 0x14002AF2, 0x44802AA1,
+    0x1001D56A, 0x1800013C, 0x400021BB, 0x120000A0, 0x10002119, 0x1800210F,
+    0x140022A2, 0x14002323, 0x1800005F, 0x24C02282, 0x140002D8, 0x1100222A,
+    0x4800227C, 0x20002250, 0x3C00294E, 0x0C0002D9, 0x14002041, 0x08002A9A,
+    0x2C0003F6, 0x0C01D514, 0x20002111, 0x1C002198, 0x20002A04, 0x1A0000D1,
+    0x10002010, 0x140027E7, 0x10002A42, 0x14802AC5, 0x14002A90, 0x100029EB,
+    0x14002933, 0x20002260, 0x1C0003A5, 0x1001D49C, 0x160000CE, 0x10002191,
+    0x10802A70, 0x140022F4, 0x3C0021C3, 0x2C002280, 0x30002309, 0x0C002264,
+    0x1001D54B, 0x0C01D526, 0x08002062, 0x14000398, 0x1C0021D2, 0x1800230A,
+    0x1400221A, 0x1C00291F, 0x1400224F, 0x0C002229, 0x0C01D51B, 0x200029AC,
+    0x1800290D, 0x10002ACF, 0x18002927, 0x14002208, 0x1800007C, 0x1900228B,
+    0x5000201C, 0x400029D0, 0x08002061, 0x440021A0, 0x18002A04, 0x1000017B,
+    0x1400228B, 0x0C002AEC, 0x14002207, 0x08002228, 0x2000228F, 0x100021D0,
+    0x40802AAF, 0x10002133, 0x18002A37, 0x7C002233, 0x400021C5, 0x18000103,
+    0x08002145, 0x1800013B, 0x300022C2, 0x1C00293D, 0x14802267, 0x1800210F,
+    0x1080226B, 0x20002238, 0x2C0022DF, 0x0C00042D, 0x2000223C, 0x2800212C,
+    0x14002A75, 0x600027FA, 0x2C0021CC, 0x18002128, 0x14002205, 0x0800226B,
+    0x3C0021B7, 0x18002A55, 0x1C002191, 0x1800005D, 0x48002955, 0x10002202,
+    0x400022EB, 0x1C002AC2, 0x10000117, 0x1800215D, 0x1800230F, 0x1A0000C7,
+    0x340025B9, 0x1400256B, 0x180022A0, 0x1800007B, 0x10000409, 0x0C000432,
+    0x140022DE, 0x100025C3, 0x140021C2, 0x3C0021C6, 0x14000108, 0x18002306,
+    0x340022EA, 0x240000B1, 0x0C0025CA, 0x0C00041B, 0x1800292A, 0x080024C8,
+    0x180022E8, 0x1800015A, 0x1001D53E, 0x180029DC, 0x1800003D, 0x0C00041A,
+    0x10000457, 0x18002282, 0x180022C7, 0x24002190, 0x18002AE6, 0x180022EE,
+    0x40000060, 0x18002296, 0x140022F9, 0x0C01D528, 0x0C0021B0, 0x1C002AD7,
+    0x0C002A5D, 0x10002736, 0x180003D5, 0x100022C4, 0x1000223D, 0x1000222D,
+    0x1C002969, 0x140021DA, 0x18002976, 0x0C01D524, 0x400002DC, 0x1C00299A,
+    0x10000407, 0x10C02220, 0x180025AA, 0x10002003, 0x1C002A34, 0x0C000431,
+    0x240023DE, 0x100029C4, 0x1001D4B8, 0x100003B6, 0x1001D564, 0x180022B9,
+    0x1400290E, 0x2C002308, 0x1A0000D5, 0x140029B9, 0x0CC0226A, 0x18002254,
+    0x0C01D531, 0x1000045C, 0x540022ED, 0x1400012A, 0x1001D55C, 0x1C002A6D,
+    0x14200066, 0x0C0021A6, 0x18002995, 0x1900228A, 0x14002AA0, 0x1800002E,
+    0x30002970, 0x10000120, 0x14002A7A, 0x10002243, 0x18002322, 0x0C00212D,
+    0x180022E0, 0x100022FA, 0x35002ACB, 0x08002147, 0x24802A7D, 0x0C0022D3,
+    0x1C002A81, 0x120000FF, 0x0C802267, 0x14002514, 0x10000445, 0x1800231E,
+    0x0C00224A, 0x0E0000AE, 0x140021C3, 0x18002204, 0x4C0021C6, 0x18002004,
+    0x080003C0, 0x240000B7, 0x1400298C, 0x0C000437, 0x0C01D522, 0x1800231F,
+    0x50002145, 0x24002AC5, 0x1C002938, 0x1000224E, 0x1000226F, 0x120000EB,
+    0x5000296F, 0x14002122, 0x20002232, 0x10002192, 0x10000178, 0x1001D544,
+    0x110022DA, 0x14000172, 0x18000128, 0x1800010C, 0x1000211D, 0x140027F9,
+    0x100021D1, 0x1800296B, 0x10002937, 0x18002926, 0x3C0029CF, 0x1CC02283,
+    0x10000415, 0x18002978, 0x100021D5, 0x180021A9, 0x2C002AB9, 0x14002559,
+    0x14000133, 0x1400016B, 0x1001D4C0, 0x1400223A, 0x380027F6, 0x0C002AA4,
+    0x1001D54A, 0x1800233F, 0x1800222F, 0x480025B8, 0x3C0021BA, 0x1001D555,
+    0x1C00224D, 0x1A0000D9, 0x1001D49F, 0x3C0021D0, 0x10002AB8, 0x18000408,
+    0x40802AB0, 0x120000A9, 0x10002964, 0x1C002973, 0x4000219E, 0x1A0000F3,
+    0x240020DB, 0x1400221F, 0x1C002277, 0x14002268, 0x14002ABA, 0x20002A31,
+    0x4400294F, 0x0C002282, 0x14002134, 0x240021D0, 0x1C00227F, 0x120000B9,
+    0x160000EE, 0x1C0022FE, 0x0C000413, 0x1C0022C4, 0x14002044, 0x20002223,
+    0x10002500, 0x280021BC, 0x100022C2, 0x1C002A3C, 0x18000145, 0x18000165,
+    0x18002AF3, 0x18E02AFD, 0x20002A12, 0x10002AE8, 0x100022FB, 0x0C01D527,
+    0x10002ADB, 0x1A0000FD, 0x340021BE, 0x0C8022D8, 0x18000024, 0x2C002296,
+    0x1400014D, 0x140022CF, 0x0C0022D9, 0x140003B4, 0x280021DA, 0x34002AE4,
+    0x140021FE
+};
+
+/* Per slot: where its name starts in g_entity_pool. */
+static const unsigned short g_entity_name[2125] = {
+    0x0659, 0x1662, 0x00F8, 0x01E8, 0x27F7, 0x11D0, 0x25BE, 0x261E, 0x0794, 0x12CB, 0x0AB0, 0x14A7,
+    0x1AA5, 0x27B8, 0x188F, 0x2772, 0x14C3, 0x26CA, 0x01C1, 0x1643, 0x16A9, 0x2159, 0x1F97, 0x02AB,
+    0x251B, 0x10A0, 0x100B, 0x09A4, 0x0326, 0x2267, 0x026D, 0x036B, 0x13DD, 0x1DE7, 0x00D1, 0x1077,
+    0x26AE, 0x0BB2, 0x131F, 0x2821, 0x168B, 0x20B9, 0x06FE, 0x237A, 0x01DB, 0x0C41, 0x0748, 0x1357,
+    0x1F42, 0x1B36, 0x230C, 0x1038, 0x064A, 0x16FD, 0x1A5D, 0x2839, 0x073A, 0x1CBB, 0x01A2, 0x1262,
+    0x1C49, 0x061A, 0x2456, 0x044D, 0x26B6, 0x0EE2, 0x058A, 0x1168, 0x238E, 0x1DC3, 0x1D0F, 0x0A31,
+    0x21FF, 0x26BE, 0x1150, 0x0929, 0x2073, 0x20A0, 0x010D, 0x1BB3, 0x21E0, 0x0825, 0x1320, 0x225E,
+    0x0F57, 0x1F3D, 0x10B8, 0x1CA3, 0x22DA, 0x1CC7, 0x1BB9, 0x0E37, 0x1E2F, 0x1453, 0x1799, 0x08CA,
+    0x0EB5, 0x12BF, 0x2389, 0x02C7, 0x177B, 0x09F0, 0x0D08, 0x0B04, 0x1ED4, 0x2271, 0x0D94, 0x10F8,
+    0x0A64, 0x1DA5, 0x1422, 0x2295, 0x11EA, 0x28BA, 0x1FFB, 0x1937, 0x24E6, 0x240E, 0x063C, 0x141E,
+    0x1BBF, 0x20A5, 0x1BC5, 0x12CE, 0x03F2, 0x1373, 0x1090, 0x290E, 0x1709, 0x15D7, 0x1877, 0x1E02,
+    0x1E0D, 0x1E75, 0x15B3, 0x0BFE, 0x1EC5, 0x0CFE, 0x06C2, 0x28C6, 0x1365, 0x13F8, 0x2782, 0x28DE,
+    0x09C9, 0x1F24, 0x12F5, 0x1E07, 0x2803, 0x1F33, 0x1218, 0x291A, 0x1979, 0x19C1, 0x097E, 0x13A4,
+    0x0017, 0x19F1, 0x2213, 0x24CA, 0x2000, 0x1BB9, 0x1E7F, 0x0E76, 0x1973, 0x0686, 0x11E8, 0x019C,
+    0x15A2, 0x1D39, 0x242A, 0x1D8D, 0x0B91, 0x09F0, 0x0AD4, 0x2612, 0x21B3, 0x027F, 0x159C, 0x1D09,
+    0x259E, 0x2653, 0x0995, 0x167F, 0x2726, 0x0A75, 0x23B1, 0x1E98, 0x220D, 0x1C62, 0x26DE, 0x15FB,
+    0x1C82, 0x2636, 0x273A, 0x0263, 0x14D1, 0x23F6, 0x1775, 0x245A, 0x22F3, 0x12C7, 0x079D, 0x0DEE,
+    0x1DE1, 0x26B2, 0x1E3E, 0x010E, 0x030F, 0x26F2, 0x27CA, 0x26F0, 0x18B3, 0x214F, 0x034D, 0x0D66,
+    0x275E, 0x0EC7, 0x17ED, 0x2809, 0x199D, 0x150D, 0x255E, 0x12D2, 0x1008, 0x1BD7, 0x25EE, 0x0F80,
+    0x1DBD, 0x14A0, 0x02A3, 0x1414, 0x1D7B, 0x0CB8, 0x1E9D, 0x1AAB, 0x025E, 0x1F6A, 0x1020, 0x02EB,
+    0x2320, 0x0695, 0x2824, 0x1208, 0x0F3C, 0x2918, 0x1028, 0x015D, 0x0A3E, 0x1D72, 0x21AE, 0x287E,
+    0x0F88, 0x08B2, 0x0C0A, 0x2032, 0x2300, 0x23FA, 0x1311, 0x1C25, 0x1F8D, 0x21FE, 0x17F3, 0x1FA1,
+    0x27DC, 0x0D9E, 0x254E, 0x18E9, 0x0F18, 0x27C1, 0x1336, 0x198B, 0x12F5, 0x1083, 0x1B2F, 0x0010,
+    0x1277, 0x2486, 0x0F70, 0x1D3F, 0x08AC, 0x23F2, 0x251A, 0x0776, 0x268E, 0x27FA, 0x0C75, 0x14E6,
+    0x0998, 0x20BE, 0x0F27, 0x0E49, 0x274E, 0x1A0A, 0x22F8, 0x197F, 0x1EED, 0x2136, 0x11E8, 0x1601,
+    0x0299, 0x01DF, 0x1C69, 0x0C5B, 0x019C, 0x0BC8, 0x2113, 0x1E89, 0x1FE7, 0x0677, 0x20CD, 0x17D5,
+    0x0444, 0x2109, 0x2064, 0x27A9, 0x14CA, 0x2203, 0x1A2E, 0x1CE5, 0x050A, 0x2912, 0x2078, 0x0E5F,
+    0x1509, 0x051A, 0x0902, 0x144C, 0x0A56, 0x12D4, 0x23BB, 0x2393, 0x0C11, 0x06D1, 0x0CCC, 0x25BA,
+    0x1595, 0x212C, 0x20A5, 0x27D6, 0x0055, 0x2226, 0x07A3, 0x1E0C, 0x0D9E, 0x16D3, 0x1365, 0x04DA,
+    0x110A, 0x0040, 0x27A6, 0x0C8E, 0x0121, 0x1703, 0x25A2, 0x14FB, 0x0023, 0x1414, 0x0321, 0x0B34,
+    0x19A3, 0x28D5, 0x10E8, 0x142A, 0x283C, 0x0D6C, 0x0216, 0x2235, 0x1A87, 0x2869, 0x28C1, 0x27AF,
+    0x25D2, 0x00F0, 0x14F4, 0x1C73, 0x08A6, 0x1B8F, 0x284B, 0x2172, 0x0908, 0x241E, 0x104F, 0x1817,
+    0x17EA, 0x15EF, 0x138F, 0x15F5, 0x14A6, 0x209B, 0x169D, 0x0CEA, 0x0E9E, 0x202D, 0x21CC, 0x147D,
+    0x11D2, 0x27BE, 0x12AF, 0x140D, 0x1B35, 0x1D99, 0x26CE, 0x155D, 0x1A93, 0x1C31, 0x07BD, 0x0E5B,
+    0x098B, 0x05DA, 0x265B, 0x279E, 0x174B, 0x0B64, 0x0411, 0x28CC, 0x1270, 0x1C9E, 0x143F, 0x12FD,
+    0x085A, 0x20B4, 0x0D9F, 0x2492, 0x1445, 0x0AA4, 0x1CF7, 0x28D2, 0x22C1, 0x19A9, 0x0DA8, 0x132D,
+    0x23D9, 0x179F, 0x1C9D, 0x16E5, 0x1088, 0x1C13, 0x21EF, 0x1246, 0x0007, 0x1060, 0x020E, 0x24D2,
+    0x17BD, 0x2626, 0x0411, 0x1C1F, 0x1380, 0x1C6D, 0x0DC6, 0x0403, 0x25D6, 0x11B3, 0x13F8, 0x00F8,
+    0x17C3, 0x2452, 0x272E, 0x1878, 0x0EE3, 0x1D03, 0x1D4B, 0x1B71, 0x2262, 0x1EF7, 0x14DF, 0x250A,
+    0x02F0, 0x1A27, 0x28AE, 0x0817, 0x24FA, 0x1499, 0x053A, 0x2830, 0x13C0, 0x12A8, 0x0C05, 0x1223,
+    0x1E6B, 0x1385, 0x0DB2, 0x09A2, 0x0166, 0x0FF8, 0x27C4, 0x21DB, 0x0025, 0x0FF0, 0x1188, 0x1BA7,
+    0x0E2E, 0x28A5, 0x2462, 0x0BB6, 0x1E2A, 0x1003, 0x1C19, 0x0FEA, 0x1607, 0x230C, 0x1D51, 0x2696,
+    0x19EB, 0x1FBF, 0x03DE, 0x28FC, 0x2335, 0x1FF6, 0x258A, 0x194F, 0x21F9, 0x25B2, 0x06E0, 0x2866,
+    0x08A9, 0x0F06, 0x027F, 0x0BCF, 0x0FF4, 0x0FA8, 0x247E, 0x1584, 0x0EA3, 0x1058, 0x1E03, 0x0CAE,
+    0x2014, 0x129A, 0x1667, 0x0F33, 0x0AC8, 0x01C8, 0x233E, 0x13E3, 0x20D2, 0x1C0D, 0x0DDA, 0x1223,
+    0x0E01, 0x2872, 0x1DC9, 0x0C20, 0x039A, 0x0C56, 0x0FD0, 0x28CF, 0x1EE3, 0x1468, 0x059A, 0x2827,
+    0x17A5, 0x2910, 0x0A7F, 0x0C11, 0x226C, 0x14D8, 0x1901, 0x0BF3, 0x12C4, 0x1A69, 0x26A2, 0x0E88,
+    0x14ED, 0x0A82, 0x1ECF, 0x006D, 0x10C0, 0x242E, 0x24DA, 0x1A4B, 0x133B, 0x1FEC, 0x27E5, 0x0D94,
+    0x1138, 0x139D, 0x1F47, 0x254A, 0x1E16, 0x0B28, 0x0822, 0x0F98, 0x1150, 0x1B05, 0x0DBC, 0x12A1,
+    0x16AF, 0x1949, 0x23E7, 0x251F, 0x06A4, 0x1745, 0x0064, 0x00EE, 0x15DD, 0x0ED9, 0x1A2D, 0x1B83,
+    0x1A8D, 0x060A, 0x12F5, 0x1BDD, 0x1FB5, 0x2028, 0x078F, 0x0DD0, 0x0910, 0x0D57, 0x14AE, 0x2301,
+    0x1C3D, 0x23A7, 0x22EE, 0x161F, 0x1350, 0x079C, 0x2662, 0x1B3B, 0x1C1F, 0x2177, 0x02B5, 0x1BE3,
+    0x0F06, 0x1CF1, 0x0414, 0x1E93, 0x1AED, 0x1160, 0x25F6, 0x0E0F, 0x0FE8, 0x26D6, 0x07EA, 0x12F1,
+    0x1C7F, 0x0CF4, 0x1D78, 0x25A6, 0x13C7, 0x0400, 0x19A9, 0x0224, 0x0FD8, 0x1030, 0x1A39, 0x21BD,
+    0x2800, 0x1AE1, 0x0389, 0x0A7F, 0x21A4, 0x2357, 0x1148, 0x0CD6, 0x1CAF, 0x0A24, 0x1AF3, 0x1685,
+    0x1130, 0x2041, 0x20F5, 0x2796, 0x0C99, 0x28DB, 0x1CC1, 0x1A02, 0x0A65, 0x0A5D, 0x1C43, 0x1031,
+    0x0283, 0x1098, 0x25AE, 0x013B, 0x1967, 0x08A6, 0x206A, 0x1F5B, 0x26C6, 0x1128, 0x27D3, 0x124D,
+    0x15E3, 0x26F6, 0x0700, 0x0C36, 0x25E2, 0x1781, 0x1440, 0x1342, 0x2422, 0x0785, 0x246E, 0x02D9,
+    0x21AA, 0x196D, 0x27FD, 0x25B6, 0x1AC3, 0x0D76, 0x0D95, 0x0067, 0x285D, 0x16D9, 0x03DE, 0x162B,
+    0x21A9, 0x11D8, 0x2516, 0x247A, 0x07DA, 0x1000, 0x2406, 0x0A82, 0x1793, 0x2168, 0x0F0F, 0x0AFB,
+    0x097B, 0x25CA, 0x237F, 0x1AB0, 0x045A, 0x0B65, 0x0CE0, 0x2407, 0x0EAB, 0x16BB, 0x0067, 0x0758,
+    0x2276, 0x229E, 0x0F2A, 0x1AB1, 0x205A, 0x1285, 0x1F83, 0x1769, 0x187D, 0x1DFD, 0x13EA, 0x16C1,
+    0x1100, 0x24E2, 0x22B2, 0x1B4D, 0x2230, 0x1437, 0x050A, 0x1396, 0x1FD8, 0x206E, 0x2556, 0x1C4F,
+    0x0D58, 0x1991, 0x1B1D, 0x1E9E, 0x0DF8, 0x28AB, 0x25CE, 0x2299, 0x2091, 0x2339, 0x2069, 0x290B,
+    0x2914, 0x1943, 0x13B9, 0x216D, 0x274A, 0x13CC, 0x2652, 0x11B0, 0x0171, 0x271E, 0x1751, 0x1661,
+    0x1B11, 0x22DF, 0x1FF9, 0x04FA, 0x1118, 0x0A75, 0x26FE, 0x240B, 0x1023, 0x0234, 0x0E55, 0x1F56,
+    0x2181, 0x163D, 0x2442, 0x19F7, 0x0F84, 0x03BC, 0x1D1B, 0x2616, 0x1AD0, 0x15A7, 0x2476, 0x2502,
+    0x0D1C, 0x18E9, 0x1E20, 0x22D0, 0x0FD8, 0x250E, 0x1334, 0x1DAB, 0x25C6, 0x25FA, 0x266A, 0x21D1,
+    0x1ADB, 0x1AB7, 0x0EC5, 0x1556, 0x17CF, 0x28A2, 0x0D4E, 0x264E, 0x1F3D, 0x153A, 0x1F01, 0x1CA9,
+    0x12EE, 0x1787, 0x28E1, 0x1A33, 0x05FB, 0x1C07, 0x2307, 0x0BF4, 0x171B, 0x0C20, 0x1805, 0x0767,
+    0x03AB, 0x05FA, 0x287B, 0x127E, 0x2632, 0x1D2D, 0x20F0, 0x22BD, 0x1A45, 0x0345, 0x06B6, 0x21EA,
+    0x1A63, 0x1C79, 0x209B, 0x1FA6, 0x0F5A, 0x1158, 0x18DD, 0x258B, 0x1A2D, 0x035A, 0x1425, 0x092C,
+    0x1E59, 0x0C4C, 0x2845, 0x1AD5, 0x23FE, 0x1E52, 0x0BA7, 0x170F, 0x1E61, 0x0BEE, 0x0488, 0x200A,
+    0x2217, 0x1D63, 0x2815, 0x0BBD, 0x0135, 0x0EFD, 0x2596, 0x2316, 0x12E7, 0x1985, 0x1484, 0x0455,
+    0x1F1A, 0x24AA, 0x00CE, 0x2087, 0x2806, 0x12BD, 0x182F, 0x09FD, 0x23C0, 0x0868, 0x1CFA, 0x1548,
+    0x20A2, 0x25FE, 0x15BF, 0x1078, 0x186B, 0x1CCD, 0x2722, 0x21B8, 0x0E15, 0x1476, 0x07B2, 0x21E5,
+    0x2916, 0x1517, 0x1E66, 0x20D3, 0x0EAB, 0x084C, 0x0DE4, 0x0050, 0x0F33, 0x1D8E, 0x209B, 0x0E5E,
+    0x0C1C, 0x0954, 0x1ED9, 0x21F4, 0x1FD3, 0x05E4, 0x2472, 0x13F1, 0x20E1, 0x273E, 0x1DB1, 0x2122,
+    0x0F90, 0x227B, 0x2682, 0x278E, 0x23EE, 0x1616, 0x28BD, 0x09F0, 0x1F79, 0x17DB, 0x1078, 0x1ABD,
+    0x0B04, 0x2204, 0x2818, 0x0903, 0x1326, 0x19CD, 0x006D, 0x1583, 0x0B7B, 0x0DF1, 0x0CC2, 0x1230,
+    0x19BB, 0x1F38, 0x1757, 0x1B6B, 0x2294, 0x21E6, 0x256E, 0x1C01, 0x1BCB, 0x2552, 0x1AFF, 0x05BA,
+    0x19C7, 0x1170, 0x1577, 0x2592, 0x01A2, 0x1AE7, 0x2285, 0x1A3F, 0x0E1C, 0x2343, 0x1931, 0x230C,
+    0x21A5, 0x26C2, 0x006D, 0x2777, 0x1BA1, 0x2104, 0x0A4B, 0x193D, 0x10F0, 0x2526, 0x259D, 0x1311,
+    0x13C7, 0x25DE, 0x12FE, 0x21C7, 0x25EA, 0x1481, 0x2787, 0x1872, 0x12D2, 0x1F4C, 0x0AE0, 0x0F90,
+    0x1BE9, 0x23A2, 0x0FC0, 0x1B53, 0x128C, 0x0BCE, 0x2752, 0x2586, 0x15E3, 0x1492, 0x1C8B, 0x2127,
+    0x1ABD, 0x0C83, 0x052A, 0x16C7, 0x1018, 0x1B19, 0x0185, 0x10BF, 0x19D9, 0x0114, 0x1271, 0x1919,
+    0x0892, 0x1068, 0x1571, 0x244A, 0x25E6, 0x22E9, 0x238A, 0x2851, 0x0D19, 0x2786, 0x1414, 0x0FE0,
+    0x1C01, 0x2370, 0x13AB, 0x2325, 0x1F65, 0x2249, 0x1D21, 0x1882, 0x222B, 0x03AB, 0x1218, 0x0B40,
+    0x1004, 0x2402, 0x0199, 0x1013, 0x24EE, 0x1525, 0x2776, 0x0D12, 0x2532, 0x231B, 0x0A72, 0x2597,
+    0x248A, 0x1AE8, 0x13D5, 0x0686, 0x0DB2, 0x01D5, 0x11E0, 0x1DF3, 0x0A17, 0x0759, 0x1ADC, 0x20CE,
+    0x240A, 0x2842, 0x2446, 0x1B17, 0x12D9, 0x0D80, 0x27D9, 0x1160, 0x00FB, 0x1865, 0x002D, 0x28E7,
+    0x0E25, 0x2280, 0x1D15, 0x0B54, 0x2311, 0x10C8, 0x2756, 0x0EC6, 0x1A03, 0x2562, 0x21C3, 0x1030,
+    0x0414, 0x0D9F, 0x22B7, 0x1916, 0x1775, 0x204B, 0x125B, 0x19DF, 0x175D, 0x213B, 0x16EB, 0x1200,
+    0x2878, 0x0F18, 0x01A2, 0x189B, 0x0115, 0x0B21, 0x0A58, 0x03F8, 0x277B, 0x2398, 0x1D33, 0x20E6,
+    0x14A0, 0x0735, 0x1CFD, 0x1578, 0x1303, 0x24DE, 0x173F, 0x0367, 0x05DA, 0x22BC, 0x0271, 0x113A,
+    0x208B, 0x0C78, 0x0F4E, 0x0F07, 0x1BF5, 0x1ECA, 0x22A3, 0x1C67, 0x1C13, 0x23C5, 0x093A, 0x1871,
+    0x20EB, 0x2050, 0x2812, 0x141C, 0x24BE, 0x1C55, 0x1691, 0x0221, 0x2833, 0x1445, 0x13CE, 0x2622,
+    0x1150, 0x0199, 0x28F6, 0x1178, 0x1E8E, 0x09AF, 0x1895, 0x146F, 0x17E0, 0x083E, 0x0961, 0x270E,
+    0x1D5D, 0x12D3, 0x00EE, 0x1220, 0x1541, 0x18CB, 0x2902, 0x1FDD, 0x2131, 0x0D58, 0x0E9A, 0x0AD7,
+    0x035A, 0x1C2B, 0x2646, 0x2209, 0x141B, 0x123F, 0x288D, 0x02FD, 0x1110, 0x269A, 0x0E0A, 0x0472,
+    0x06B3, 0x0F2F, 0x1A03, 0x1A1B, 0x153A, 0x1C48, 0x11C0, 0x23CF, 0x26EE, 0x0C5B, 0x2522, 0x12B6,
+    0x08BC, 0x0BE9, 0x046B, 0x28E4, 0x256A, 0x1050, 0x1572, 0x28EA, 0x1EFC, 0x1108, 0x15C5, 0x122B,
+    0x1CB5, 0x1556, 0x0A0A, 0x14B5, 0x24A6, 0x1D69, 0x24F6, 0x28ED, 0x284E, 0x1423, 0x1E08, 0x1406,
+    0x145A, 0x0477, 0x28B1, 0x11B0, 0x2334, 0x0A98, 0x2258, 0x13DC, 0x18C5, 0x286C, 0x158F, 0x12E0,
+    0x219A, 0x1F65, 0x2005, 0x1D94, 0x1699, 0x15CB, 0x2908, 0x09E3, 0x264A, 0x1EA7, 0x1763, 0x1907,
+    0x0D9E, 0x0A8C, 0x2466, 0x215E, 0x13D5, 0x1AED, 0x10AB, 0x00B9, 0x1FC9, 0x1E25, 0x0356, 0x1C37,
+    0x10B8, 0x130A, 0x0F21, 0x19CD, 0x279A, 0x2055, 0x1F88, 0x27AC, 0x1336, 0x1F15, 0x1359, 0x1B7D,
+    0x263A, 0x1158, 0x106D, 0x28D8, 0x0C5C, 0x2140, 0x0D1C, 0x2145, 0x0BD3, 0x1C2B, 0x118C, 0x1F6F,
+    0x0F45, 0x0333, 0x1322, 0x2676, 0x27F4, 0x1180, 0x178D, 0x0F07, 0x23B6, 0x1269, 0x0D62, 0x0EEB,
+    0x24AE, 0x12A8, 0x27F1, 0x0ED0, 0x0D94, 0x2302, 0x1D9A, 0x236B, 0x1B9B, 0x248E, 0x00C1, 0x217C,
+    0x1120, 0x23D4, 0x186D, 0x1637, 0x17C9, 0x122B, 0x2893, 0x0174, 0x1541, 0x1E84, 0x24F2, 0x1A6F,
+    0x1847, 0x07F8, 0x0B55, 0x0D94, 0x148B, 0x27CD, 0x1461, 0x1BBE, 0x1118, 0x2046, 0x1E43, 0x2375,
+    0x1FB0, 0x0ABC, 0x25F2, 0x252A, 0x257A, 0x176F, 0x1835, 0x1841, 0x11A8, 0x03CD, 0x1F7E, 0x26BA,
+    0x10D0, 0x17B7, 0x27A2, 0x214A, 0x1956, 0x1C5B, 0x079C, 0x0DC6, 0x1F9C, 0x26AA, 0x16F7, 0x0DDC,
+    0x014A, 0x1238, 0x1EE8, 0x1C61, 0x18D7, 0x1058, 0x15B9, 0x17E1, 0x1FAB, 0x056D, 0x224E, 0x0BFF,
+    0x00FB, 0x07DC, 0x05FA, 0x0466, 0x0EEB, 0x1EC0, 0x272A, 0x288A, 0x0271, 0x1F29, 0x0422, 0x1510,
+    0x253E, 0x11A6, 0x181D, 0x1859, 0x11A0, 0x0C42, 0x05EA, 0x2506, 0x0EAC, 0x23DE, 0x06EF, 0x27BB,
+    0x1FC4, 0x2154, 0x1B89, 0x0F80, 0x1FCE, 0x0884, 0x2186, 0x24C6, 0x0D44, 0x2348, 0x1649, 0x08A0,
+    0x237F, 0x06C5, 0x0E40, 0x1AF9, 0x1BFB, 0x1829, 0x172D, 0x1D78, 0x210E, 0x0E44, 0x0291, 0x0AF8,
+    0x0160, 0x2546, 0x2244, 0x249E, 0x166D, 0x0378, 0x1091, 0x10A8, 0x040A, 0x0806, 0x154F, 0x190D,
+    0x0188, 0x0876, 0x059F, 0x144E, 0x19AF, 0x1A8E, 0x2005, 0x2692, 0x057D, 0x270A, 0x0F98, 0x10B8,
+    0x1955, 0x1697, 0x08D8, 0x0F60, 0x1533, 0x15A7, 0x1F0B, 0x27C7, 0x044E, 0x1619, 0x0988, 0x2863,
+    0x21BE, 0x205F, 0x281B, 0x0FFC, 0x0029, 0x1438, 0x1349, 0x201E, 0x1727, 0x239D, 0x0EA6, 0x2221,
+    0x0EBE, 0x1D75, 0x0BF3, 0x1DB7, 0x2686, 0x28F0, 0x07C0, 0x288B, 0x26A6, 0x1A0F, 0x00A4, 0x1DF8,
+    0x00A6, 0x12E0, 0x008F, 0x1AE1, 0x0166, 0x15E9, 0x0E41, 0x267E, 0x0F5A, 0x2905, 0x004E, 0x1F10,
+    0x2642, 0x0149, 0x0D26, 0x19EB, 0x04AA, 0x2572, 0x0DBC, 0x27EE, 0x1198, 0x1C8B, 0x0A82, 0x2163,
+    0x00C7, 0x1AE7, 0x0017, 0x09BC, 0x0064, 0x2432, 0x0D30, 0x022E, 0x0C6D, 0x1210, 0x096E, 0x08F6,
+    0x2848, 0x15D1, 0x1A81, 0x0367, 0x1EBB, 0x0B4C, 0x0E05, 0x18A1, 0x03E1, 0x2391, 0x2436, 0x2195,
+    0x1429, 0x1EDE, 0x1A57, 0x18AD, 0x1B47, 0x143A, 0x1EB1, 0x2566, 0x0185, 0x0188, 0x0CFA, 0x00D1,
+    0x2762, 0x2453, 0x1437, 0x2582, 0x0DC6, 0x04EA, 0x0A60, 0x271A, 0x10E8, 0x25EB, 0x1FE2, 0x253A,
+    0x26D2, 0x05D9, 0x1A75, 0x1B00, 0x183B, 0x240F, 0x2672, 0x1148, 0x2384, 0x1BDC, 0x2854, 0x223F,
+    0x1414, 0x13FB, 0x1F51, 0x00C5, 0x1210, 0x1C91, 0x23EA, 0x1ABD, 0x24B2, 0x15F8, 0x0171, 0x1733,
+    0x218B, 0x276E, 0x255A, 0x0C11, 0x1A99, 0x269E, 0x1625, 0x21EA, 0x20C3, 0x1A7B, 0x2576, 0x1190,
+    0x1429, 0x282D, 0x1B5F, 0x1E34, 0x1F2E, 0x18E3, 0x221C, 0x0E9A, 0x1A9F, 0x1388, 0x0FF8, 0x22D5,
+    0x1739, 0x08F4, 0x192B, 0x232F, 0x0F10, 0x058A, 0x2019, 0x0AEC, 0x261A, 0x0B9C, 0x268A, 0x1853,
+    0x28FF, 0x2736, 0x0E52, 0x24BA, 0x1A9F, 0x1961, 0x007A, 0x1D27, 0x13F0, 0x16A0, 0x2742, 0x25C2,
+    0x262E, 0x1883, 0x235C, 0x281E, 0x0D3A, 0x1F06, 0x245E, 0x1E1B, 0x1FBF, 0x2212, 0x276A, 0x10B8,
+    0x2523, 0x2096, 0x003A, 0x11C8, 0x1E70, 0x01F0, 0x267A, 0x0E95, 0x0FC8, 0x25E3, 0x16B5, 0x143E,
+    0x17E7, 0x156C, 0x20DC, 0x044E, 0x1147, 0x1048, 0x2412, 0x203C, 0x1955, 0x1D75, 0x1040, 0x1843,
+    0x23AC, 0x28A8, 0x0EB5, 0x100D, 0x234D, 0x16F1, 0x17AB, 0x1E57, 0x1796, 0x09D6, 0x1DD5, 0x212C,
+    0x282A, 0x28B7, 0x137A, 0x0E9E, 0x0F78, 0x27B2, 0x266E, 0x1823, 0x1BD1, 0x2881, 0x2860, 0x22AD,
+    0x1CAA, 0x0FB0, 0x18BF, 0x05AA, 0x2512, 0x063A, 0x114A, 0x25DA, 0x2836, 0x0B58, 0x1E39, 0x27DF,
+    0x0814, 0x1541, 0x08AE, 0x2426, 0x26E6, 0x1004, 0x1925, 0x00E6, 0x22F7, 0x2082, 0x228F, 0x0C2B,
+    0x18FB, 0x0247, 0x054A, 0x23E6, 0x2416, 0x17B1, 0x2352, 0x1318, 0x2875, 0x1415, 0x025A, 0x1889,
+    0x24A2, 0x1293, 0x0830, 0x19C6, 0x26DA, 0x2366, 0x0F3C, 0x1A39, 0x1A15, 0x1757, 0x246A, 0x24FE,
+    0x1AF9, 0x259A, 0x1D45, 0x130C, 0x1179, 0x16CD, 0x00E6, 0x1EF2, 0x1847, 0x2240, 0x091E, 0x0FA0,
+    0x1F1F, 0x1128, 0x1E5C, 0x18B9, 0x0C11, 0x24C2, 0x0AE3, 0x057A, 0x1372, 0x165B, 0x17B7, 0x07CE,
+    0x23B5, 0x1430, 0x10B0, 0x031A, 0x1CD3, 0x0E91, 0x2896, 0x0067, 0x0E13, 0x0B51, 0x2046, 0x055D,
+    0x28C0, 0x0C62, 0x1913, 0x2542, 0x1E7A, 0x0037, 0x0D8A, 0x1439, 0x1685, 0x034B, 0x0EF4, 0x18A7,
+    0x1BAD, 0x0768, 0x156B, 0x1B0B, 0x10D8, 0x1C8D, 0x0A03, 0x10C0, 0x2712, 0x280C, 0x0295, 0x1997,
+    0x27EB, 0x1EAC, 0x21CD, 0x1140, 0x223A, 0x1F92, 0x2177, 0x1228, 0x1841, 0x1AD5, 0x21D6, 0x03EF,
+    0x277E, 0x19E5, 0x05DA, 0x265E, 0x24B6, 0x1B77, 0x16F8, 0x1CA4, 0x1A21, 0x0830, 0x0E29, 0x12E1,
+    0x00D1, 0x0F68, 0x01EC, 0x0A04, 0x1FF1, 0x001A, 0x0BDE, 0x280F, 0x10E0, 0x14D8, 0x1010, 0x1655,
+    0x0C06, 0x22CB, 0x2666, 0x2208, 0x20AA, 0x262A, 0x1AD6, 0x097B, 0x128C, 0x23E2, 0x1E48, 0x204C,
+    0x265A, 0x1973, 0x072B, 0x00CE, 0x0B10, 0x0F10, 0x24EA, 0x2899, 0x0053, 0x1EA2, 0x0B21, 0x19FD,
+    0x228A, 0x137A, 0x177B, 0x0DAB, 0x283F, 0x0FB8, 0x108A, 0x2000, 0x1B23, 0x20FF, 0x1D87, 0x1D9F,
+    0x01AD, 0x0237, 0x0FC6, 0x0499, 0x1DCF, 0x2536, 0x1DA0, 0x0037, 0x219F, 0x01F9, 0x0DBC, 0x1B13,
+    0x055A, 0x249A, 0x1679, 0x0000, 0x05CA, 0x1715, 0x0120, 0x1631, 0x0315, 0x130A, 0x21C2, 0x146F,
+    0x264E, 0x1080, 0x0C15, 0x244F, 0x11F0, 0x0CA4, 0x0075, 0x001F, 0x01CA, 0x1DED, 0x10A0, 0x264F,
+    0x071C, 0x1721, 0x04F3, 0x1BEF, 0x02FD, 0x10B1, 0x00E3, 0x152C, 0x14E9, 0x18D1, 0x1D57, 0x15A1,
+    0x0326, 0x1F74, 0x102B, 0x19D3, 0x2482, 0x28F9, 0x200F, 0x11C4, 0x14BF, 0x0749, 0x1E11, 0x1589,
+    0x0767, 0x0E6D, 0x0B51, 0x27E8, 0x1CDF, 0x291C, 0x1B95, 0x16A3, 0x243E, 0x195B, 0x185F, 0x27E2,
+    0x277A, 0x0A75, 0x17F9, 0x0631, 0x16EB, 0x1D81, 0x04BA, 0x1B41, 0x20FA, 0x289F, 0x28B4, 0x151E,
+    0x145A, 0x2702, 0x1D6F, 0x0C20, 0x1CB7, 0x10B4, 0x14BC, 0x2118, 0x1A51, 0x2884, 0x04CA, 0x1564,
+    0x251E, 0x2656, 0x1C97, 0x184D, 0x13B2, 0x285A, 0x0E64, 0x1C85, 0x257E, 0x2792, 0x2706, 0x191F,
+    0x211D, 0x0B86, 0x1673, 0x225D, 0x2652, 0x157D, 0x28F3, 0x2606, 0x00E3, 0x1E4D, 0x260A, 0x1159,
+    0x207D, 0x0D66, 0x18EF, 0x1D93, 0x22FD, 0x1B65, 0x0B1C, 0x243A, 0x20AF, 0x0E9E, 0x1C61, 0x27B5,
+    0x1ACF, 0x2672, 0x0A72, 0x00FF, 0x0F0F, 0x0E55, 0x1118, 0x278A, 0x28C9, 0x1FBA, 0x2602, 0x17FF,
+    0x2857, 0x0ECE, 0x1399, 0x13DC, 0x01FB, 0x184D, 0x010F, 0x0EAC, 0x22A8, 0x259B, 0x286F, 0x1811,
+    0x010D, 0x0D95, 0x12FC, 0x177B, 0x266E, 0x25AA, 0x01C1, 0x232A, 0x1070, 0x1094, 0x252E, 0x2496,
+    0x18EC, 0x1EB6, 0x160D, 0x159B, 0x24CE, 0x23CA, 0x2732, 0x1A09, 0x26EA, 0x1CD9, 0x02B8, 0x0D9E,
+    0x244E, 0x18F5, 0x2746, 0x19B5, 0x0C57, 0x1F60, 0x20D7, 0x2361, 0x260E, 0x2190, 0x08E6, 0x2890,
+    0x24D6, 0x1C85, 0x15AD, 0x0321, 0x070D, 0x258E, 0x12A1, 0x16DF, 0x241A, 0x0668, 0x26FA, 0x1613,
+    0x056A, 0x17C9, 0x26E2, 0x1381, 0x062A, 0x1B29, 0x0E7F, 0x0FD8, 0x135E, 0x2154, 0x22E4, 0x11F8,
+    0x0433, 0x0A75, 0x145A, 0x0D81, 0x1502, 0x2716, 0x20C8, 0x13FF, 0x27D0, 0x1254, 0x208C, 0x0F22,
+    0x1F97, 0x036B, 0x275A, 0x136C, 0x164F, 0x1CEB, 0x1B59, 0x1AC9, 0x11B8, 0x2389, 0x2766, 0x289C,
+    0x263E, 0x1DDB, 0x05AA, 0x28C3, 0x180B, 0x0B70, 0x2253, 0x2023, 0x2887, 0x2037, 0x0CD6, 0x0947,
+    0x22C6
+};
+
+/* Second characters (index - 1), for the few references that make two. */
+static const unsigned short g_entity_second[8] = {
+    0x006A, 0x0331, 0x0333, 0x0338, 0x200A, 0x20D2, 0x20E5, 0xFE00
+};
+
+/* All names, without '&' or ';'. */
+static const char g_entity_pool[10527] =
+    "CounterClockwiseContourIntegralDoubleLongLeftRightArrowNotNestedGreaterG"
+    "reaterDiacriticalDoubleAcuteNotSquareSupersetEqualCloseCurlyDoubleQuoteD"
+    "oubleContourIntegralFilledVerySmallSquareNegativeVeryThinSpaceNotPrecede"
+    "sSlantEqualNotRightTriangleEqualNotSucceedsSlantEqualCapitalDifferential"
+    "DDoubleLeftRightArrowDoubleLongRightArrowEmptyVerySmallSquareNotDoubleVe"
+    "rticalBarNotGreaterSlantEqualNotLeftTriangleEqualNotSquareSubsetEqualOpe"
+    "nCurlyDoubleQuoteReverseUpEquilibriumDoubleLongLeftArrowDownLeftRightVec"
+    "torLeftArrowRightArrowNegativeMediumSpaceNotGreaterFullEqualNotRightTria"
+    "ngleBarRightArrowLeftArrowleftrightsquigarrowDownRightTeeVectorDownRight"
+    "VectorBarLongleftrightarrowNegativeThickSpaceNotLeftTriangleBarReverseEq"
+    "uilibriumRightDoubleBracketRightDownTeeVectorRightDownVectorBarSquareInt"
+    "ersectionblacktrianglerightlongleftrightarrowDoubleUpDownArrowDownLeftTe"
+    "eVectorDownLeftVectorBarFilledSmallSquareLeftDoubleBracketLeftDownTeeVec"
+    "torLeftDownVectorBarNegativeThinSpaceNotGreaterGreaterNotLessSlantEqualN"
+    "otNestedLessLessNotReverseElementNotTildeFullEqualRightAngleBracketRight"
+    "UpDownVectorVerticalSeparatorblacktriangledownblacktriangleleftleftright"
+    "harpoonsrightleftharpoonstwoheadrightarrowDiacriticalAcuteDiacriticalGra"
+    "veDiacriticalTildeDoubleRightArrowDownArrowUpArrowEmptySmallSquareGreate"
+    "rEqualLessLeftAngleBracketLeftUpDownVectorLessEqualGreaterNonBreakingSpa"
+    "ceNotPrecedesEqualNotSucceedsEqualNotSucceedsTildeNotSupersetEqualRightU"
+    "pTeeVectorRightUpVectorBarUnderParenthesisUpArrowDownArrowcirclearrowrig"
+    "htdownharpoonrightntrianglerighteqrightharpoondownrightrightarrowstwohea"
+    "dleftarrowvartrianglerightCloseCurlyQuoteDoubleDownArrowDoubleLeftArrowL"
+    "eftUpTeeVectorLeftUpVectorBarLowerRightArrowNotGreaterEqualNotGreaterTil"
+    "deNotHumpDownHumpOverParenthesisShortRightArrowUpperRightArrowbigtriangl"
+    "edowncirclearrowleftcurvearrowrightdownharpoonleftleftharpoondownleftrig"
+    "htarrowsnLeftrightarrowntrianglelefteqrightleftarrowsrightthreetimesstra"
+    "ightepsilonvartriangleleftDiacriticalDotDoubleRightTeeHorizontalLineInvi"
+    "sibleCommaInvisibleTimesLongrightarrowLowerLeftArrowNotGreaterLessNotLes"
+    "sGreaterNotSubsetEqualNotVerticalBarOpenCurlyQuoteShortDownArrowShortLef"
+    "tArrowUpperLeftArrowZeroWidthSpacecurvearrowleftdoublebarwedgedowndownar"
+    "rowshookrightarrowleftleftarrowsleftthreetimeslongrightarrowlooparrowrig"
+    "htnshortparallelrightarrowtailrightharpoonupupharpoonrightApplyFunctionD"
+    "oubleLeftTeeDoubleUpArrowLessFullEqualLongleftarrowNotEqualTildeNotTilde"
+    "EqualNotTildeTildePoincareplanePrecedesTildeRightArrowBarRightTeeArrowVe"
+    "rticalTildebigtriangleupdivideontimesfallingdotseqhookleftarrowleftarrow"
+    "tailleftharpoonuplongleftarrowlooparrowleftmeasuredanglesmallsetminusuph"
+    "arpoonleftvarsubsetneqqvarsupsetneqqDownArrowBarDownTeeArrowExponentialE"
+    "HilbertSpaceLeftArrowBarLeftTeeArrowNotCongruentNotHumpEqualNotLessEqual"
+    "NotLessTildeProportionalRightCeilingRoundImpliesShortUpArrowUnderBracket"
+    "VerticalLineblacklozengeexponentialerisingdotseqCircleMinusCircleTimesLe"
+    "ftCeilingNotLessLessOverBracketRrightarrowRuleDelayedSmallCircleSquareUn"
+    "ionUpdownarrowbackepsilonblacksquarecircledcirccircleddashcurlyeqpreccur"
+    "lyeqsuccdiamondsuiteqslantlessexpectationnRightarrownrightarrowprecnappr"
+    "oxquaternionsstraightphisucccurlyeqsuccnapproxthickapproxupdownarrowBern"
+    "oullisCirclePlusFouriertrfImaginaryILaplacetrfLleftarrowNotElementRightF"
+    "loorUnderBraceUpArrowBarUpTeeArrowcircledastcomplementcurlywedgeeqslantg"
+    "trgtreqqlesslessapproxlesseqqgtrlmoustachelongmapstomapstodownmapstoleft"
+    "nLeftarrownleftarrownsubseteqqnsupseteqqprecapproxrmoustachesqsubseteqsq"
+    "supseteqsuccapproxupuparrowsvarepsilonvarnothingBackslashCenterDotCircle"
+    "DotCoproductDoubleDotDownBreveDownarrowLeftFloorMellintrfMinusPlusNotCup"
+    "CapNotExistsOverBracePlusMinusThereforeTripleDotUnionPlusbackprimebacksi"
+    "meqbigotimescenterdotcheckmarkcomplexesdotsquaregtrapproxgtreqlessgvertn"
+    "eqqheartsuitlesseqgtrlvertneqqngeqslantnleqslantnparallelnshortmidpitchf"
+    "orkrationalsspadesuitthereforetriangleqvarproptoDDotrahdDotEqualPartialD"
+    "SuchThatUarrocirUnderBarandslopeangmsdaaangmsdabangmsdacangmsdadangmsdae"
+    "angmsdafangmsdagangmsdahangrtvbdapproxeqawconintbackcongbbrktbrkbigoplus"
+    "bigsqcupbiguplusbigwedgeboxminusboxtimesbsolhsubcapbrcupcircledRcircledS"
+    "cirfnintclubsuitcupbrcapcurlyveecwconintdoteqdotdotminusdrbkarowdzigrarr"
+    "elintersemptyseteqvparslfpartintgesdotolgnapproxhksearowhkswarowimagline"
+    "imagpartinfintieintegersintercalintlarhklaemptyvldrusharlesdotorllcorner"
+    "lnapproxlrcornerlurdsharmapstoupmultimapnaturalsncongdotnotindototimesas"
+    "plusacirpointintprecneqqprecnsimprofalarproflineprofsurfraemptyvrealpart"
+    "rppolintrtriltriscpolintsmeparslsuccneqqsuccnsimthetasymthicksimtimesbar"
+    "triminustrpeziumulcornerurcornervarkappavarsigmavarthetaBecauseCayleysCc"
+    "onintCedillaDiamondEpsilonNewLineNoBreakOmicronOverBarProductUparrowUpsi"
+    "lonalefsymangzarrasympeqbecausebemptyvbetweenbigcircbigodotbigstarbnequi"
+    "vboxplusccupssmcemptyvcirscircoloneqcudarrlcudarrrcularrpcurarrmdbkarowd"
+    "daggerddotseqdemptyvdigammadotplusdwangleeqcolonequivDDgtquestgtrlesshar"
+    "rcirintprodisindotlarrbfslarrsimlbrksldlbrksluldrdharlessdotlessgtrlesss"
+    "imlotimesltquestluruharmalteseminusdunearrownexistsnotinvanotinvbnotinvc"
+    "notnivanotnivbnotnivcnpolintnpreceqnsqsubensqsupensucceqnvinfinnvltrienv"
+    "rtrienwarrowolcrossomicronorderoforslopepertenkplanckhpluscirplussimplus"
+    "twoprecsimquatintquesteqrarrbfsrarrsimrbrksldrbrkslurdldharrealinerotime"
+    "sruluharsearrowsimrarrsubedotsubmultsubplussubrarrsuccsimsupdsubsupedots"
+    "uphsolsuphsubsuplarrsupmultsupplusswarrowtopforktriplustritimeupsilonuwa"
+    "nglevzigzagAacuteAbreveAgraveAssignAtildeBarwedBumpeqCacuteCcaronCcedilC"
+    "oloneConintDaggerDcaronDotDotDstrokEacuteEcaronEgraveForAllGammadGbreveG"
+    "cedilHARDcyHstrokIacuteIgraveItildeJsercyKcedilLacuteLambdaLcaronLcedilL"
+    "midotLstrokNacuteNcaronNcedilNtildeOacuteOdblacOgraveOslashOtildeOtimesR"
+    "acuteRarrtlRcaronRcedilSHCHcySOFTcySacuteScaronScedilSupsetTcaronTcedilT"
+    "strokUacuteUbreveUdblacUgraveUtildeVdashlVerbarVvdashYacuteZacuteZcarona"
+    "acuteabreveagraveandandangsphapaciratildebarveebernoubigcapbigcupbigveeb"
+    "ottombowtieboxboxbprimebrvbarbulletbumpeqcacutecapandcapcapcapcupcapdotc"
+    "caronccedilcirceqcirmidcommatcompfncoprodcopysrcupcupcupdotcurrencylctyd"
+    "alethdcarondfishtdivonxdlcorndlcropdollardrcorndrcropdstrokeacuteeastere"
+    "caronecolonegraveegsdotelsdotemsp13emsp14eqcircequalsequestfemaleffiligf"
+    "flligforallfrac12frac13frac14frac15frac16frac18frac23frac25frac34frac35f"
+    "rac38frac45frac56frac58frac78gacutegbrevegeslesgtlPargtrarrgtrdotgtrsimh"
+    "airsphamilthardcyhellipherconhomththorbarhslashhstrokhybullhypheniacutei"
+    "graveiiiintiinfininodotintcaliquestisinsvitildejsercykcedilkgreenlAtaill"
+    "acutelagranlambdalanglelarrfslarrhklarrlplarrpllarrtllataillbracelbrackl"
+    "caronlcedilldquorlesgeslfishtlfloorlharulllhardlmidotlopluslowastlowbarl"
+    "parltlrhardlsaquolsquorlstroklthreeltimesltlarrltrParmarkermcommamidastm"
+    "idcirmiddotmnplusmodelsmstposnVDashnVdashnacutenbumpencaronncedilnearhkn"
+    "esearnltrienotinEnparslnprcuenrarrcnrarrwnrtriensccuensimeqntildenumeron"
+    "vDashnvHarrnvdashnvlArrnvrArrnwarhknwnearoacuteodblacodsoldograveominuso"
+    "rigofoslashotildeparsimpercntperiodpermilphmmatplankvplusdoplusduplusmnp"
+    "rimesprnsimprurelpuncspqprimerAtailracuteranglerarraprarrfsrarrhkrarrlpr"
+    "arrplrarrtlratailrbracerbrackrcaronrcedilrdquorrfishtrfloorrharulroplusr"
+    "pargtrsaquorsquorrthreertimessacutescaronscedilscnsimsearhkseswarsfrowns"
+    "hchcysigmafsimdotsmashpsoftcysolbarsqcapssqcupssquarfssetmnssmilesstarfs"
+    "ubdotsubsimsubsubsupdotsupsimsupsubsupsupswarhkswnwartargettcarontcedilt"
+    "elrecthere4thetavthinspthksimtimesdtopbottopcirtprimetridottstrokuacuteu"
+    "breveudblacufishtugraveulcropurcroputildevangrtvarphivarrhoveebarvellipv"
+    "erbarvsubnEvsubnevsupnEvsupnewedbarwedgeqweierpwreathxoplusxotimexsqcupx"
+    "uplusxwedgeyacutezacutezcaronzeetrfAEligAcircAlphaAmacrAogonAringCcircCr"
+    "ossDashvDeltaEcircEmacrEogonGcircHacekHcircIJligIcircImacrIogonIukcyJcir"
+    "cJukcyKappaOEligOcircOmacrOmegaPrimeRBarrScircSigmaTHORNTRADETSHcyThetaU"
+    "brcyUcircUmacrUogonUringWcircWedgeYcircacircaeligalephalphaamacramalgang"
+    "staogonaringawintbcongbdquobepsiblankblk12blk14blk34blockboxDLboxDRboxDl"
+    "boxDrboxHDboxHUboxHdboxHuboxULboxURboxUlboxUrboxVHboxVLboxVRboxVhboxVlbo"
+    "xVrboxdLboxdRboxdlboxdrboxhDboxhUboxhdboxhuboxuLboxuRboxulboxurboxvHboxv"
+    "LboxvRboxvhboxvlboxvrbsemibsimebsolbbumpEcaretccapscrarrcsubecsupectdotc"
+    "ueprcuesccuporcuveecuwedcwintdashvddarrdeltadiamsdtdotdtrifduarrduhareDD"
+    "otefDotemacreogoneplusepsiveqsimffligfjligfltnsforkvfraslgesccgimelgneqq"
+    "gnsimgsimegsimlgtcirgtdotharrwhcirchoarricirciexcliiotaijligimacrimageim"
+    "athimpediogoniprodisinEisinviukcyjcircjmathjukcylAarrlBarrlangdlaquolate"
+    "slbarrlbbrklbrkelceillescclhblklltrilneqqlnsimloangloarrlobrkloparlrtril"
+    "simelsimgltcirltdotltrifmDDotmdashmumapnablanapidnaposndashneArrnedotnes"
+    "imngeqqngsimnhArrnharrnhparnlArrnlarrnleqqnlessnlsimnpartnrArrnsmidnspar"
+    "nsubEnsubensupEnsupenumspnvsimnwArrocircodashoeligofcirohbarolarrolcirol"
+    "ineomacromegaoperporarrovbarphonepoundprnapprsimrAarrrBarrradicrangdrang"
+    "eraquorbarrrbbrkrbrkerceilrealsrlarrrnmidroangroarrrobrkroparrrarrrtrifs"
+    "bquoscnapscsimsdotbseArrsharpsimgEsimlEsimnesmtesstrnsswArrszligthkaptho"
+    "rntradetrisbtshcytwixtubrcyucircudharuharluharruhblkultriumacruogonupsih"
+    "uringurtriutdotutrifuuarrvBarvvarpiveeeqvnsubvnsupvpropxcircxdtrixhArrxh"
+    "arrxlArrxlarrxodotxrArrxrarrxutriycircAopfAscrAumlBetaBopfBscrCOPYCdotCo"
+    "pfCscrDJcyDScyDZcyDarrDopfDscrEdotEopfEscrEumlFopfFscrGJcyGdotGopfGscrHo"
+    "pfHscrIEcyIOcyIdotIopfIotaIscrIumlJopfJscrKHcyKJcyKopfKscrLJcyLangLarrLo"
+    "pfLscrMopfMscrNJcyNopfNscrOopfOscrOumlPopfPscrQUOTQopfQscrRangRopfRscrSo"
+    "pfSqrtSscrStarTScyTopfTscrUopfUscrUumlVbarVopfVscrWopfWscrXopfXscrYAcyYI"
+    "cyYUcyYopfYscrYumlZHcyZdotZetaZopfZscranddandvaopfascraumlbNotbetabethbo"
+    "pfbscrcdotcirEcirecopfcscrdArrdHardjcydopfdscrdscydzcyenspeopfescreumleu"
+    "roflatfnoffopffscrgjcygopfgscrgtccgvnEhalfhopfhscriecyimofiocyiopfiscriu"
+    "mljopfjscrkhcykjcykopfkscrlHarlcubldcaldshljcylopflozflscrlsqbltcclvnEml"
+    "cpmldrmopfmscrnGtvnLtvnangnapEnbspncapncupngesngtrnisdnjcynldrnopfnscrnt"
+    "glntlgnvapnvgenvgtnvleoastodivomidoopfordfordmororoscrosoloumlpopfprappr"
+    "nEqintqopfqscrquotrHarrcubrdcaropfrscrrsqbscapscnEsextsopfsqufsscrsungsu"
+    "p1sup2sup3toeatosatscrtscyuArruHaruopfuscruumlvArrvopfvscrwopfwscrxcapxc"
+    "upxmapxnisxopfxscrxveeyacyyicyyopfyscryucyyumlzdotzetazhcyzopfzscrzwnjAM"
+    "PAfrAndBcyBfrCfrChiDfrENGETHEfrEtaFcyFfrGcyGfrHatHfrIfrJfrKcyKfrLcyLfrLs"
+    "hMapMcyMfrNcyNfrOfrPcyPfrPhiPsiQfrREGRcyRfrRhoRshSfrSumTabTauTfrUfrVcyVe"
+    "eVfrWfrXfrYcyYfrZfracEacdaframpapebcybfrcfrchidegdfrdieefrfcyffrgElgapgc"
+    "ygelgfrgggglEglagljgnEhfrifrjfrkfrlaplcyleglgElnElrmlshmcymfrmhonGgnLlnf"
+    "rngEnlEofrogtohmoltorvpcyprEqfrscEshysumtautfrufrvcywfrxfrycyyfrzfrzwjGT"
+    "LTMuNuOrPiXioS";
+
+#endif
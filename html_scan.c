@@ -0,0 +1,280 @@
+#include "html_scan.h"
+#include "scan_kernel.h"
+#include "stats.h"
+
+#include <string.h>
+
+#define C_SPACE  1    /* HTML whitespace */
+#define C_ALPHA  2    /* may start a tag name */
+#define C_NAME   4    /* may continue a tag name */
+#define C_ASTOP  8    /* ends an attribute name */
+
+static const unsigned char g_class[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 9, 0, 9, 9, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 4, 8,
+    4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 0, 0, 8, 8, 0,
+    0, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 0, 0, 0, 0, 4,
+    0, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+#define CLASS(c) (g_class[(unsigned char)(c)])
+
+/* Compares n bytes of s with a lower-case ASCII name. */
+static int html_scan_ieq(const char *s, const char *name, int n)
+{
+    for (int i = 0; i < n; ++i) {
+        char c = s[i];
+        if (c >= 'A' && c <= 'Z') c = (char)(c + ('a' - 'A'));
+        if (c != name[i]) return 0;
+    }
+    return 1;
+}
+
+static int html_scan_span_is(const char *base, page_span_t span, const char *name)
+{
+    int n = (int)strlen(name);
+    return span.len == n && html_scan_ieq(base + span.off, name, n);
+}
+
+int html_scan_is(const html_scan_tag_t *tag, const char *name)
+{
+    return html_scan_span_is(tag->base, tag->name, name);
+}
+
+const html_scan_attr_t *html_scan_attr(const html_scan_tag_t *tag, const char *name)
+{
+    for (int i = 0; i < tag->nattrs; ++i) {
+        if (html_scan_span_is(tag->base, tag->attrs[i].name, name)) {
+            return &tag->attrs[i];
+        }
+    }
+    return NULL;
+}
+
+/* Finds the "</name" that closes a raw text element, or end. */
+static const char *html_scan_raw_end(const char *p, const char *end, const char *close, int n)
+{
+    while ((p = scan_find_any(p, end, "<", 1)) < end) {
+        if (end - p >= n && html_scan_ieq(p, close, n)) return p;
+        p++;
+    }
+    return end;
+}
+
+/*
+ * Parses the tag whose '<' is at p. Returns the byte after its '>', or
+ * NULL if the buffer ends first.
+ */
+static const char *html_scan_tag(const char *base, const char *p, const char *end,
+                                 html_scan_tag_t *tag)
+{
+    const char *q = p + 1;
+
+    tag->base = base;
+    tag->off = (long)(p - base);
+    tag->closing = 0;
+    tag->self_closing = 0;
+    tag->nattrs = 0;
+
+    if (*q == '/') {
+        tag->closing = 1;
+        q++;
+    }
+    tag->name.off = (long)(q - base);
+    while (q < end && (CLASS(*q) & C_NAME)) q++;
+    tag->name.len = (int)(q - base - tag->name.off);
+
+    for (;;) {
+        const char *a;
+        html_scan_attr_t *attr;
+
+        while (q < end && ((CLASS(*q) & C_SPACE) || *q == '/')) {
+            if (*q == '/') tag->self_closing = 1;
+            q++;
+        }
+        if (q >= end) return NULL;
+        if (*q == '>') break;
+        tag->self_closing = 0;
+
+        a = q;
+        while (q < end && !(CLASS(*q) & C_ASTOP)) q++;
+        if (q == a) q++;      /* stray '=': skip it */
+        attr = tag->nattrs < HTML_SCAN_MAX_ATTRS ? &tag->attrs[tag->nattrs++] : NULL;
+        if (attr) {
+            attr->name.off = (long)(a - base);
+            attr->name.len = (int)(q - a);
+            attr->value.off = (long)(q - base);
+            attr->value.len = 0;
+        }
+
+        while (q < end && (CLASS(*q) & C_SPACE)) q++;
+        if (q >= end) return NULL;
+        if (*q != '=') continue;
+        q++;
+        while (q < end && (CLASS(*q) & C_SPACE)) q++;
+        if (q >= end) return NULL;
+
+        if (*q == '"' || *q == '\'') {
+            const char *close = (const char*)memchr(q + 1, *q, end - q - 1);
+            if (!close) return NULL;
+            a = q + 1;
+            q = close + 1;
+            if (attr) attr->value.len = (int)(close - a);
+        } else {
+            a = q;
+            while (q < end && !(CLASS(*q) & C_SPACE) && *q != '>') q++;
+            if (attr) attr->value.len = (int)(q - a);
+        }
+        if (attr) attr->value.off = (long)(a - base);
+    }
+
+    tag->end = (long)(q + 1 - base);
+    return q + 1;
+}
+
+long html_scan_more(const char *buf, long from, long len, int final,
+                    html_scan_tag_fn on_tag, html_scan_text_fn on_text, void *user)
+{
+    const char *p = buf + from;
+    const char *end = buf + len;
+    const char *text = p;
+    const char *held = NULL;  /* start of a construct that needs more bytes */
+    html_scan_tag_t tag;
+
+    while ((p = scan_find_any(p, end, "<", 1)) < end) {
+        const char *next;
+        char c;
+
+        /* Too close to the end to tell a tag or comment from text. */
+        if (!final && end - p < 4) {
+            held = p;
+            break;
+        }
+        c = (p + 1 < end) ? p[1] : '\0';
+
+        if (c == '!' || c == '?') {
+            /* Comment or declaration: nothing to report. */
+            if (c == '!' && end - p >= 4 && p[2] == '-' && p[3] == '-') {
+                const char *q = p + 4;
+                next = NULL;
+                while (q + 2 < end && (q = (const char*)memchr(q, '-', end - q - 2)) != NULL) {
+                    if (q[1] == '-' && q[2] == '>') {
+                        next = q + 3;
+                        break;
+                    }
+                    q++;
+                }
+            } else {
+                next = scan_find_any(p, end, ">", 1);
+                next = (next < end) ? next + 1 : NULL;
+            }
+            if (!next && !final) {
+                held = p;
+                break;
+            }
+            if (on_text && p > text) on_text(user, (long)(text - buf), (int)(p - text));
+            if (!next) return len;
+            p = text = next;
+            continue;
+        }
+        if (!(CLASS(c) & C_ALPHA) && !(c == '/' && p + 2 < end && (CLASS(p[2]) & C_ALPHA))) {
+            p++;              /* a bare '<' is just text */
+            continue;
+        }
+
+        next = html_scan_tag(buf, p, end, &tag);
+        if (!next && !final) {
+            held = p;
+            break;
+        }
+        if (next && !tag.closing && !final) {
+            /* Script and style are reported once their raw text is in. */
+            const char *raw = next;
+            if (html_scan_is(&tag, "script")) raw = html_scan_raw_end(next, end, "</script", 8);
+            else if (html_scan_is(&tag, "style")) raw = html_scan_raw_end(next, end, "</style", 7);
+            if (raw == end) {
+                held = p;
+                break;
+            }
+        }
+        if (on_text && p > text) on_text(user, (long)(text - buf), (int)(p - text));
+        if (!next) return len;
+        if (on_tag) on_tag(user, &tag);
+        p = text = next;
+
+        if (!tag.closing) {
+            if (html_scan_is(&tag, "script")) {
+                p = html_scan_raw_end(p, end, "</script", 8);
+                text = p;
+            } else if (html_scan_is(&tag, "style")) {
+                p = html_scan_raw_end(p, end, "</style", 7);
+                text = p;
+            }
+        }
+    }
+    if (held) {
+        if (on_text && held > text) on_text(user, (long)(text - buf), (int)(held - text));
+        return (long)(held - buf);
+    }
+    if (on_text && end > text) on_text(user, (long)(text - buf), (int)(end - text));
+    return len;
+}
+
+void html_scan(const char *buf, long len,
+               html_scan_tag_fn on_tag, html_scan_text_fn on_text, void *user)
+{
+    html_scan_more(buf, 0, len, 1, on_tag, on_text, user);
+}
+
+long html_scan_safe_end(const char *buf, long from, long len)
+{
+    const char *start = buf + from;
+    const char *p = buf + len;
+
+    /* Back to the last '>', then on to the first '<' after it. */
+    while (p > start && p[-1] != '>') p--;
+    return (long)(scan_find_any(p, buf + len, "<", 1) - buf);
+}
+
+long html_scan_strip(const char *buf, long from, long len, long step,
+                     charset_conv_t *conv, page_arena_t *out)
+{
+    const char *r = buf + from;
+    const char *end = buf + len;
+    const char *stop = (step > 0 && end - r > step) ? r + step : end;
+    stats_time_t t = stats_begin();
+    long text = out->len;
+    long tags = 0;
+
+    /* Alternate between "find the next <" and "find the next >". */
+    while (r < stop) {
+        const char *lt = scan_find_any(r, end, "<", 1);
+        if (lt > r && conv) charset_conv(conv, r, (int)(lt - r), out);
+        else if (lt > r) page_arena_append(out, r, (int)(lt - r));
+        if (lt == end) {
+            r = end;
+            break;
+        }
+        r = scan_find_any(lt + 1, end, ">", 1);
+        if (r < end) r++;
+        tags++;
+    }
+
+    if (t) {
+        stats_end(STATS_STRIP, t);
+        stats_add(STATS_TAGS, tags);
+        stats_add(STATS_BYTES_RENDERED, out->len - text);
+    }
+    return (long)(r - buf);
+}
@@ -0,0 +1,73 @@
+#ifndef HTML_SCAN_H
+#define HTML_SCAN_H
+
+#include "charset.h"
+#include "page_arena.h"
+
+/*
+ * Single-pass tag scanner over a complete page.
+ *
+ * Walks the body once, classifying bytes through a 256-entry table, and
+ * reports tag and text events. A tag event carries its name and attribute
+ * name/value spans as offsets into the caller's buffer; nothing is copied
+ * or lower-cased, and lookups compare case-insensitively in place. Text
+ * between tags comes out as spans too. Comments, <!...>/<?...> and the raw
+ * bodies of script/style are skipped.
+ */
+
+#define HTML_SCAN_MAX_ATTRS 16
+
+typedef struct {
+    page_span_t name;
+    page_span_t value;        /* len 0 when the attribute has no value */
+} html_scan_attr_t;
+
+typedef struct {
+    const char *base;         /* buffer the spans point into */
+    long off;                 /* offset of '<' */
+    long end;                 /* offset just past '>' */
+    page_span_t name;
+    int closing;              /* </name> */
+    int self_closing;         /* <name/> */
+    int nattrs;               /* attributes beyond the cap are skipped */
+    html_scan_attr_t attrs[HTML_SCAN_MAX_ATTRS];
+} html_scan_tag_t;
+
+typedef void (*html_scan_tag_fn)(void *user, const html_scan_tag_t *tag);
+typedef void (*html_scan_text_fn)(void *user, long off, int len);
+
+/* Scans buf[0..len). Either callback may be NULL. */
+void html_scan(const char *buf, long len,
+               html_scan_tag_fn on_tag, html_scan_text_fn on_text, void *user);
+
+/*
+ * Scans buf[from..len) of a page that is still arriving. Unless final is
+ * set, a tag, comment or script/style element cut off by the end of the
+ * buffer is not reported; the return value is its offset, to be passed as
+ * from once more bytes are in (len when nothing was held back). Calls
+ * over growing prefixes report the same events as one html_scan.
+ */
+long html_scan_more(const char *buf, long from, long len, int final,
+                    html_scan_tag_fn on_tag, html_scan_text_fn on_text, void *user);
+
+/*
+ * Naive text render: appends buf[from..len) to out with everything
+ * between '<' and '>' left out, one append per text run, converted
+ * through conv unless it is NULL. Stops after about step input bytes
+ * (step <= 0: at the end) and returns the offset to resume from, len
+ * once the page is done.
+ */
+long html_scan_strip(const char *buf, long from, long len, long step,
+                     charset_conv_t *conv, page_arena_t *out);
+
+/* Where html_scan_strip can stop on a partial page: the '<' of a tag
+   that is not closed yet, or len. */
+long html_scan_safe_end(const char *buf, long from, long len);
+
+/* Case-insensitive compare of the tag name with a lower-case name. */
+int html_scan_is(const html_scan_tag_t *tag, const char *name);
+
+/* Looks up a lower-case attribute name; NULL if the tag does not have it. */
+const html_scan_attr_t *html_scan_attr(const html_scan_tag_t *tag, const char *name);
+
+#endif
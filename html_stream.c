@@ -0,0 +1,208 @@
+#include "html_stream.h"
+#include "scan_kernel.h"
+#include "stats.h"
+
+#include <string.h>
+
+static char html_stream_lower(char c)
+{
+    if (c >= 'A' && c <= 'Z') {
+        return (char)(c + ('a' - 'A'));
+    }
+    return c;
+}
+
+static int html_stream_is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f';
+}
+
+/* A '<' only opens a tag when followed by a name, '/', '!' or '?'. */
+static int html_stream_opens_tag(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           c == '/' || c == '!' || c == '?';
+}
+
+static void html_stream_emit(html_stream_t *s, const char *text, int len)
+{
+    if (len > 0 && s->on_text) {
+        s->on_text(s->user, text, len);
+        s->text_bytes += len;
+    }
+}
+
+static void html_stream_begin_tag(html_stream_t *s)
+{
+    s->state = HTML_STREAM_TAG;
+    s->name_len = 0;
+    s->name_done = 0;
+    s->closing = 0;
+    s->after_eq = 0;
+}
+
+/* Called on the '>' that closes a tag: decide what follows it. */
+static void html_stream_end_tag(html_stream_t *s)
+{
+    s->state = HTML_STREAM_TEXT;
+    s->tags++;
+    if (s->closing) return;
+
+    if (s->name_len == 6 && memcmp(s->name, "script", 6) == 0) {
+        s->raw_close = "</script";
+    } else if (s->name_len == 5 && memcmp(s->name, "style", 5) == 0) {
+        s->raw_close = "</style";
+    } else {
+        return;
+    }
+    s->state = HTML_STREAM_SCRIPT;
+    s->raw_match = 0;
+}
+
+void html_stream_init(html_stream_t *s, int skip_headers,
+                      html_stream_text_fn on_text, void *user)
+{
+    memset(s, 0, sizeof(*s));
+    s->state = skip_headers ? HTML_STREAM_HEADER : HTML_STREAM_TEXT;
+    s->on_text = on_text;
+    s->user = user;
+}
+
+int html_stream_in_body(const html_stream_t *s)
+{
+    return s->state != HTML_STREAM_HEADER;
+}
+
+void html_stream_feed(html_stream_t *s, const char *data, int len)
+{
+    const char *p = data;
+    const char *end = data + len;
+    stats_time_t t = stats_begin();
+    long tags = s->tags;
+    long text_bytes = s->text_bytes;
+
+    while (p < end) {
+        char c = *p;
+
+        switch (s->state) {
+        case HTML_STREAM_HEADER:
+            /* Blank line ends the headers; tolerate bare LF line ends. */
+            if (s->header_match == 0 && c != '\n') {
+                /* Mid-line: nothing matters until the next LF. */
+                p = scan_find_any(p, end, "\n", 1);
+                break;
+            }
+            if (c == '\n') {
+                if (++s->header_match == 2) {
+                    s->state = HTML_STREAM_TEXT;
+                }
+            } else if (c != '\r') {
+                s->header_match = 0;
+            }
+            p++;
+            break;
+
+        case HTML_STREAM_TEXT: {
+            const char *lt = scan_find_any(p, end, "<", 1);
+            html_stream_emit(s, p, (int)(lt - p));
+            if (lt == end) {
+                p = end;
+                break;
+            }
+            html_stream_begin_tag(s);
+            p = lt + 1;
+            break;
+        }
+
+        case HTML_STREAM_TAG:
+            if (!s->name_done) {
+                if (s->name_len == 0 && !s->closing && !html_stream_opens_tag(c)) {
+                    /* "a < b": the '<' was text after all. Reprocess c. */
+                    html_stream_emit(s, "<", 1);
+                    s->state = HTML_STREAM_TEXT;
+                    break;
+                }
+                if (s->name_len == 0 && c == '/' && !s->closing) {
+                    s->closing = 1;
+                    p++;
+                    break;
+                }
+                if (html_stream_is_space(c) || c == '/' || c == '>') {
+                    s->name_done = 1;
+                } else {
+                    if (s->name_len < HTML_STREAM_NAME_MAX) {
+                        s->name[s->name_len] = html_stream_lower(c);
+                    }
+                    s->name_len++;
+                    if (s->name_len == 3 && memcmp(s->name, "!--", 3) == 0) {
+                        s->state = HTML_STREAM_COMMENT;
+                        s->dash_run = 0;
+                    }
+                    p++;
+                    break;
+                }
+            }
+            if (c == '>') {
+                html_stream_end_tag(s);
+            } else if ((c == '"' || c == '\'') && s->after_eq) {
+                s->state = HTML_STREAM_TAG_QUOTE;
+                s->quote = c;
+            } else if (c == '=') {
+                s->after_eq = 1;
+            } else if (!html_stream_is_space(c)) {
+                s->after_eq = 0;
+            }
+            p++;
+            break;
+
+        case HTML_STREAM_TAG_QUOTE:
+            p = scan_find_any(p, end, &s->quote, 1);
+            if (p < end) {
+                s->state = HTML_STREAM_TAG;
+                s->after_eq = 0;
+                p++;
+            }
+            break;
+
+        case HTML_STREAM_COMMENT:
+            if (s->dash_run == 0 && c != '-') {
+                p = scan_find_any(p, end, "-", 1);
+                break;
+            }
+            if (c == '>' && s->dash_run >= 2) {
+                s->state = HTML_STREAM_TEXT;
+            } else if (c == '-') {
+                s->dash_run++;
+            } else {
+                s->dash_run = 0;
+            }
+            p++;
+            break;
+
+        case HTML_STREAM_SCRIPT:
+            if (s->raw_match == 0 && c != '<') {
+                p = scan_find_any(p, end, "<", 1);
+                break;
+            }
+            if (html_stream_lower(c) == s->raw_close[s->raw_match]) {
+                if (s->raw_close[++s->raw_match] == '\0') {
+                    /* Matched the close tag name; swallow the rest of it. */
+                    s->state = HTML_STREAM_TAG;
+                    s->name_done = 1;
+                    s->closing = 1;
+                    s->after_eq = 0;
+                }
+            } else {
+                s->raw_match = (c == '<') ? 1 : 0;
+            }
+            p++;
+            break;
+        }
+    }
+
+    if (t) {
+        stats_end(STATS_STRIP, t);
+        stats_add(STATS_TAGS, s->tags - tags);
+        stats_add(STATS_BYTES_RENDERED, s->text_bytes - text_bytes);
+    }
+}
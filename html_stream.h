@@ -0,0 +1,58 @@
+#ifndef HTML_STREAM_H
+#define HTML_STREAM_H
+
+/*
+ * Resumable single-pass HTML tokenizer.
+ *
+ * Raw response bytes are fed in whatever chunks the transport hands back.
+ * All scanner state (header terminator match, open tag, comment, script)
+ * lives in html_stream_t, so a tag, comment or "\r\n\r\n" split across two
+ * reads is handled the same as one that arrives whole. Text runs are passed
+ * to the callback as pointers into the caller's chunk: nothing is copied
+ * and every byte is looked at once.
+ */
+
+typedef void (*html_stream_text_fn)(void *user, const char *text, int len);
+
+typedef enum {
+    HTML_STREAM_HEADER = 0,   /* skipping HTTP headers up to "\r\n\r\n" */
+    HTML_STREAM_TEXT,         /* body text, emitted */
+    HTML_STREAM_TAG,          /* inside <...>, outside quotes */
+    HTML_STREAM_TAG_QUOTE,    /* inside a quoted attribute value */
+    HTML_STREAM_COMMENT,      /* inside <!-- ... --> */
+    HTML_STREAM_SCRIPT        /* raw text of <script>/<style>, suppressed */
+} html_stream_state_t;
+
+#define HTML_STREAM_NAME_MAX 8
+
+typedef struct {
+    html_stream_state_t state;
+
+    int  header_match;              /* consecutive line ends seen */
+    int  name_len;                  /* tag name bytes seen (capped) */
+    int  name_done;                 /* tag name finished */
+    int  closing;                   /* tag started with '/' */
+    char name[HTML_STREAM_NAME_MAX];/* lower-case tag name prefix */
+    int  after_eq;                  /* last non-space tag byte was '=' */
+    char quote;                     /* active quote in HTML_STREAM_TAG_QUOTE */
+    int  dash_run;                  /* trailing '-' count inside a comment */
+    int  raw_match;                 /* bytes of "</script" or "</style" matched */
+    const char *raw_close;          /* close sequence for HTML_STREAM_SCRIPT */
+
+    long tags;                      /* tags closed so far */
+    long text_bytes;                /* text bytes emitted so far */
+
+    html_stream_text_fn on_text;
+    void *user;
+} html_stream_t;
+
+/* skip_headers != 0 starts in HTML_STREAM_HEADER, otherwise in body text. */
+void html_stream_init(html_stream_t *s, int skip_headers,
+                      html_stream_text_fn on_text, void *user);
+
+void html_stream_feed(html_stream_t *s, const char *data, int len);
+
+/* Returns nonzero once the header terminator has been seen. */
+int html_stream_in_body(const html_stream_t *s);
+
+#endif
@@ -0,0 +1,572 @@
+#include "http_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define HTTP_CACHE_MAGIC       "LYNXCE-CACHE 1"
+#define HTTP_CACHE_INDEX_MAGIC "LYNXCE-CACHE-INDEX 1"
+
+typedef struct {
+    unsigned long key;       /* FNV-1a of the normalized URL */
+    long size;               /* bytes on disk */
+    unsigned long use;       /* LRU stamp, larger = more recent */
+    long expires;            /* unix time; 0 = revalidate before use */
+} http_cache_slot_t;
+
+typedef struct {
+    FILE *file;              /* positioned at the body */
+    char etag[128];
+    char last_modified[64];
+    char content_type[128];
+} http_cache_entry_t;
+
+typedef struct {
+    FILE *file;              /* NULL once a write failed */
+    long written;
+    http_body_fn on_body;
+    void *user;
+} http_cache_tee_t;
+
+static http_cache_slot_t g_slots[HTTP_CACHE_MAX_ENTRIES];
+static int g_count = 0;
+static long g_total = 0;
+static long g_budget = HTTP_CACHE_DEFAULT_BYTES;
+static unsigned long g_use = 0;
+static char g_dir[260];
+static char g_sep = '/';
+static int g_open = 0;
+
+static char http_cache_lower(char c)
+{
+    if (c >= 'A' && c <= 'Z') {
+        return (char)(c + ('a' - 'A'));
+    }
+    return c;
+}
+
+static unsigned long http_cache_hash(const char *s)
+{
+    unsigned long h = 2166136261UL;
+    while (*s) {
+        h ^= (unsigned char)*s++;
+        h = (h * 16777619UL) & 0xffffffffUL;
+    }
+    return h;
+}
+
+static void http_cache_path(unsigned long key, const char *ext, char *out, int out_size)
+{
+    snprintf(out, out_size, "%s%c%08lx.%s", g_dir, g_sep, key, ext);
+}
+
+/* ------------------------------------------------------------------------
+ * Index
+ * ------------------------------------------------------------------------ */
+
+static void http_cache_save_index(void)
+{
+    char path[300];
+    FILE *f;
+
+    snprintf(path, sizeof(path), "%s%cindex.txt", g_dir, g_sep);
+    f = fopen(path, "w");
+    if (!f) return;
+    fprintf(f, "%s\n", HTTP_CACHE_INDEX_MAGIC);
+    for (int i = 0; i < g_count; i++) {
+        fprintf(f, "%08lx %ld %lu %ld\n", g_slots[i].key, g_slots[i].size,
+                g_slots[i].use, g_slots[i].expires);
+    }
+    fclose(f);
+}
+
+static void http_cache_load_index(void)
+{
+    char path[300];
+    char line[128];
+    FILE *f;
+
+    g_count = 0;
+    g_total = 0;
+    g_use = 0;
+
+    snprintf(path, sizeof(path), "%s%cindex.txt", g_dir, g_sep);
+    f = fopen(path, "r");
+    if (!f) return;
+    if (!fgets(line, sizeof(line), f) || strncmp(line, HTTP_CACHE_INDEX_MAGIC, strlen(HTTP_CACHE_INDEX_MAGIC)) != 0) {
+        fclose(f);
+        return;
+    }
+    while (g_count < HTTP_CACHE_MAX_ENTRIES && fgets(line, sizeof(line), f)) {
+        http_cache_slot_t *s = &g_slots[g_count];
+        if (sscanf(line, "%lx %ld %lu %ld", &s->key, &s->size, &s->use, &s->expires) != 4) continue;
+        g_total += s->size;
+        if (s->use > g_use) g_use = s->use;
+        g_count++;
+    }
+    fclose(f);
+}
+
+static http_cache_slot_t *http_cache_find(unsigned long key)
+{
+    for (int i = 0; i < g_count; i++) {
+        if (g_slots[i].key == key) return &g_slots[i];
+    }
+    return NULL;
+}
+
+static void http_cache_remove(http_cache_slot_t *slot)
+{
+    char path[300];
+
+    http_cache_path(slot->key, "htc", path, sizeof(path));
+    remove(path);
+    g_total -= slot->size;
+    *slot = g_slots[--g_count];
+}
+
+/* Drop least recently used entries until under budget, keeping `keep`. */
+static void http_cache_evict(unsigned long keep)
+{
+    while (g_count > 0 && (g_total > g_budget || g_count >= HTTP_CACHE_MAX_ENTRIES)) {
+        http_cache_slot_t *lru = NULL;
+        for (int i = 0; i < g_count; i++) {
+            if (g_slots[i].key == keep) continue;
+            if (!lru || g_slots[i].use < lru->use) lru = &g_slots[i];
+        }
+        if (!lru) break;
+        http_cache_remove(lru);
+    }
+}
+
+/* ------------------------------------------------------------------------
+ * Freshness
+ * ------------------------------------------------------------------------ */
+
+static long http_cache_days_from_civil(int y, int m, int d)
+{
+    /* Howard Hinnant's days-from-civil, valid for the Gregorian calendar. */
+    int era;
+    unsigned yoe, doy, doe;
+
+    y -= m <= 2;
+    era = (y >= 0 ? y : y - 399) / 400;
+    yoe = (unsigned)(y - era * 400);
+    doy = (unsigned)((153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1);
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return (long)era * 146097L + (long)doe - 719468L;
+}
+
+/* RFC 1123 ("Sun, 06 Nov 1994 08:49:37 GMT") and RFC 850
+   ("Sunday, 06-Nov-94 08:49:37 GMT"). Returns 0 if unparsable. */
+static long http_cache_parse_date(const char *s)
+{
+    static const char months[] = "janfebmaraprmayjunjulaugsepoctnovdec";
+    char mon[4] = {0};
+    int day, year, hh, mm, ss, m;
+    const char *comma = strchr(s, ',');
+
+    if (!comma) return 0;
+    if (sscanf(comma + 1, " %d%*[ -]%3s%*[ -]%d %d:%d:%d", &day, mon, &year, &hh, &mm, &ss) != 6) {
+        return 0;
+    }
+    for (m = 0; m < 12; m++) {
+        if (http_cache_lower(mon[0]) == months[m * 3] &&
+            http_cache_lower(mon[1]) == months[m * 3 + 1] &&
+            http_cache_lower(mon[2]) == months[m * 3 + 2]) break;
+    }
+    if (m == 12) return 0;
+    if (year < 100) year += (year < 70) ? 2000 : 1900;
+
+    return http_cache_days_from_civil(year, m + 1, day) * 86400L + hh * 3600L + mm * 60L + ss;
+}
+
+static int http_cache_has_token(const char *value, const char *token)
+{
+    int tlen = (int)strlen(token);
+    for (; *value; value++) {
+        int i = 0;
+        while (i < tlen && http_cache_lower(value[i]) == token[i]) i++;
+        if (i == tlen) return 1;
+    }
+    return 0;
+}
+
+/* Absolute expiry time for resp, 0 if it must be revalidated every use.
+   Clears *storable for no-store and Vary responses. */
+static long http_cache_expiry(const http_response_t *resp, long now, int *storable)
+{
+    char value[256];
+    const char *p;
+
+    *storable = 1;
+    if (http_header(resp, "vary", value, sizeof(value)) == 0 &&
+        !(http_cache_has_token(value, "accept-encoding") && !strchr(value, ','))) {
+        *storable = 0;
+    }
+    if (http_header(resp, "cache-control", value, sizeof(value)) == 0) {
+        if (http_cache_has_token(value, "no-store")) {
+            *storable = 0;
+            return 0;
+        }
+        if (http_cache_has_token(value, "no-cache")) return 0;
+        for (p = value; *p; p++) {
+            if (http_cache_lower(*p) == 'm' && strncmp(p, "max-age=", 8) == 0) {
+                return now + atol(p + 8);
+            }
+        }
+    }
+    if (http_header(resp, "pragma", value, sizeof(value)) == 0 &&
+        http_cache_has_token(value, "no-cache")) {
+        return 0;
+    }
+    if (http_header(resp, "expires", value, sizeof(value)) == 0) {
+        long expires = http_cache_parse_date(value);
+        long date = 0;
+        char date_hdr[64];
+        if (expires == 0) return 0;   /* "0", "-1", garbage: already expired */
+        if (http_header(resp, "date", date_hdr, sizeof(date_hdr)) == 0) {
+            date = http_cache_parse_date(date_hdr);
+        }
+        /* Use the server's own clock to get the lifetime; devices often
+           have the wrong time. */
+        return date ? now + (expires - date) : expires;
+    }
+    return 0;
+}
+
+/* ------------------------------------------------------------------------
+ * Entries
+ * ------------------------------------------------------------------------ */
+
+static void http_cache_chomp(char *s)
+{
+    s[strcspn(s, "\r\n")] = '\0';
+}
+
+static int http_cache_open_entry(unsigned long key, const char *norm, http_cache_entry_t *e)
+{
+    char path[300];
+    char line[1024];
+    char head[HTTP_MAX_HEAD];
+    int head_len;
+
+    memset(e, 0, sizeof(*e));
+    http_cache_path(key, "htc", path, sizeof(path));
+    e->file = fopen(path, "rb");
+    if (!e->file) return -1;
+
+    if (!fgets(line, sizeof(line), e->file) || strncmp(line, HTTP_CACHE_MAGIC, strlen(HTTP_CACHE_MAGIC)) != 0) goto bad;
+    if (!fgets(line, sizeof(line), e->file)) goto bad;
+    http_cache_chomp(line);
+    if (strcmp(line, norm) != 0) goto bad;   /* hash collision */
+    if (!fgets(e->etag, sizeof(e->etag), e->file)) goto bad;
+    http_cache_chomp(e->etag);
+    if (!fgets(e->last_modified, sizeof(e->last_modified), e->file)) goto bad;
+    http_cache_chomp(e->last_modified);
+    if (!fgets(line, sizeof(line), e->file)) goto bad;
+    head_len = atoi(line);
+    if (head_len < 0 || head_len >= HTTP_MAX_HEAD ||
+        fread(head, 1, (size_t)head_len, e->file) != (size_t)head_len) goto bad;
+    head[head_len] = '\0';
+    http_head_header(head, "content-type", e->content_type, sizeof(e->content_type));
+    return 0;
+
+bad:
+    fclose(e->file);
+    e->file = NULL;
+    return -1;
+}
+
+static int http_cache_send_body(http_cache_entry_t *e, http_body_fn on_body, void *user)
+{
+    char buffer[HTTP_RX_BUF];
+    size_t n;
+
+    while ((n = fread(buffer, 1, sizeof(buffer), e->file)) > 0) {
+        if (on_body(user, buffer, (int)n) != 0) break;
+    }
+    fclose(e->file);
+    e->file = NULL;
+    return 0;
+}
+
+static int http_cache_tee(void *user, const char *data, int len)
+{
+    http_cache_tee_t *tee = (http_cache_tee_t*)user;
+
+    if (tee->file) {
+        if (fwrite(data, 1, (size_t)len, tee->file) != (size_t)len) {
+            fclose(tee->file);
+            tee->file = NULL;   /* CF card full: keep browsing, skip caching */
+        } else {
+            tee->written += len;
+        }
+    }
+    return tee->on_body(tee->user, data, len);
+}
+
+static FILE *http_cache_begin_store(unsigned long key, const char *norm,
+                                    const http_response_t *resp, long *written)
+{
+    char path[300];
+    char etag[128], last_modified[64];
+    FILE *f;
+    int n;
+
+    http_cache_path(key, "tmp", path, sizeof(path));
+    f = fopen(path, "wb");
+    if (!f) return NULL;
+
+    http_header(resp, "etag", etag, sizeof(etag));
+    http_header(resp, "last-modified", last_modified, sizeof(last_modified));
+    n = fprintf(f, "%s\n%s\n%s\n%s\n%d\n", HTTP_CACHE_MAGIC, norm, etag, last_modified, resp->head_len);
+    if (n < 0 || fwrite(resp->head, 1, (size_t)resp->head_len, f) != (size_t)resp->head_len) {
+        fclose(f);
+        remove(path);
+        return NULL;
+    }
+    *written = n + resp->head_len;
+    return f;
+}
+
+static void http_cache_commit(unsigned long key, long size, long expires)
+{
+    char tmp[300], final_path[300];
+    http_cache_slot_t *slot = http_cache_find(key);
+
+    http_cache_path(key, "tmp", tmp, sizeof(tmp));
+    http_cache_path(key, "htc", final_path, sizeof(final_path));
+    if (slot) http_cache_remove(slot);
+    remove(final_path);
+    if (rename(tmp, final_path) != 0) {
+        remove(tmp);
+        return;
+    }
+
+    slot = &g_slots[g_count++];
+    slot->key = key;
+    slot->size = size;
+    slot->use = ++g_use;
+    slot->expires = expires;
+    g_total += size;
+
+    http_cache_evict(key);
+    http_cache_save_index();
+}
+
+/* ------------------------------------------------------------------------
+ * Public API
+ * ------------------------------------------------------------------------ */
+
+int http_cache_open(const char *dir, long max_bytes)
+{
+    if (!dir || !*dir) return -1;
+    strncpy(g_dir, dir, sizeof(g_dir) - 1);
+    g_dir[sizeof(g_dir) - 1] = '\0';
+    g_sep = strchr(g_dir, '\\') ? '\\' : '/';
+    {
+        size_t len = strlen(g_dir);
+        if (len > 0 && (g_dir[len - 1] == '/' || g_dir[len - 1] == '\\')) g_dir[len - 1] = '\0';
+    }
+    g_budget = max_bytes > 0 ? max_bytes : HTTP_CACHE_DEFAULT_BYTES;
+    http_cache_load_index();
+    g_open = 1;
+    http_cache_evict(0);
+    return 0;
+}
+
+void http_cache_close(void)
+{
+    if (!g_open) return;
+    http_cache_save_index();
+    g_open = 0;
+}
+
+int http_cache_enabled(void)
+{
+    return g_open;
+}
+
+void http_cache_normalize(const char *url, char *out, int out_size)
+{
+    const char *p = strstr(url, "://");
+    const char *host, *host_end;
+    int n = 0;
+    int https = 0;
+
+    if (out_size <= 0) return;
+    if (!p) {
+        strncpy(out, url, out_size - 1);
+        out[out_size - 1] = '\0';
+        out[strcspn(out, "#")] = '\0';
+        return;
+    }
+
+    for (const char *s = url; s < p && n < out_size - 1; s++) out[n++] = http_cache_lower(*s);
+    https = (n == 5 && strncmp(out, "https", 5) == 0);
+    for (const char *s = "://"; *s && n < out_size - 1; s++) out[n++] = *s;
+
+    host = p + 3;
+    host_end = host + strcspn(host, "/?#");
+    {
+        int hlen = (int)(host_end - host);
+        if (hlen > 3 && !https && strncmp(host_end - 3, ":80", 3) == 0) hlen -= 3;
+        if (hlen > 4 && https && strncmp(host_end - 4, ":443", 4) == 0) hlen -= 4;
+        for (int i = 0; i < hlen && n < out_size - 1; i++) out[n++] = http_cache_lower(host[i]);
+    }
+
+    if (*host_end != '/' && n < out_size - 1) out[n++] = '/';
+    for (const char *s = host_end; *s && *s != '#' && n < out_size - 1; s++) out[n++] = *s;
+    out[n] = '\0';
+}
+
+int http_cached_get(const char *url,
+                    const char *host,
+                    unsigned short port,
+                    net_scheme_t scheme,
+                    const net_tls_options_t *tls_opts,
+                    const char *path,
+                    http_body_fn on_body,
+                    void *user,
+                    int *status,
+                    http_cache_result_t *result,
+                    char *content_type,
+                    int content_type_len)
+{
+    static http_response_t resp;
+    char norm[1024];
+    char validators[256];
+    http_cache_entry_t entry;
+    http_cache_slot_t *slot = NULL;
+    unsigned long key = 0;
+    long now = (long)time(NULL);
+    int have_entry = 0;
+    int rc;
+
+    *result = HTTP_CACHE_MISS;
+    *status = 0;
+    if (content_type && content_type_len > 0) content_type[0] = '\0';
+    validators[0] = '\0';
+    norm[0] = '\0';
+
+    if (g_open) {
+        http_cache_normalize(url, norm, sizeof(norm));
+        key = http_cache_hash(norm);
+        slot = http_cache_find(key);
+        if (slot && http_cache_open_entry(key, norm, &entry) == 0) {
+            have_entry = 1;
+            if (slot->expires > now) {
+                slot->use = ++g_use;
+                *status = 200;
+                *result = HTTP_CACHE_HIT;
+                if (content_type) snprintf(content_type, content_type_len, "%s", entry.content_type);
+                return http_cache_send_body(&entry, on_body, user);
+            }
+            if (entry.etag[0]) {
+                snprintf(validators, sizeof(validators), "If-None-Match: %s\r\n", entry.etag);
+            }
+            if (entry.last_modified[0]) {
+                size_t len = strlen(validators);
+                snprintf(validators + len, sizeof(validators) - len,
+                         "If-Modified-Since: %s\r\n", entry.last_modified);
+            }
+        }
+    }
+
+    if (http_request(&resp, "GET", host, port, scheme, tls_opts, path, NULL, NULL,
+                     validators[0] ? validators : NULL) != 0) {
+        if (have_entry) fclose(entry.file);
+        return NET_TRANSPORT_ERR;
+    }
+    *status = resp.status;
+
+    if (resp.status == 304 && have_entry) {
+        int storable;
+        long expires = http_cache_expiry(&resp, now, &storable);
+        http_finish(&resp);
+        slot->expires = expires;
+        slot->use = ++g_use;
+        http_cache_save_index();
+        *status = 200;
+        *result = HTTP_CACHE_REVALIDATED;
+        if (content_type) snprintf(content_type, content_type_len, "%s", entry.content_type);
+        return http_cache_send_body(&entry, on_body, user);
+    }
+    if (have_entry) fclose(entry.file);
+    if (content_type) http_header(&resp, "content-type", content_type, content_type_len);
+
+    {
+        http_cache_tee_t tee;
+        long expires = 0;
+        int storable = 0;
+
+        memset(&tee, 0, sizeof(tee));
+        tee.on_body = on_body;
+        tee.user = user;
+        if (g_open && resp.status == 200) {
+            char validator[8];
+            expires = http_cache_expiry(&resp, now, &storable);
+            /* Worth keeping only if it can be served fresh or revalidated. */
+            if (storable && expires <= now &&
+                http_header(&resp, "etag", validator, sizeof(validator)) != 0 &&
+                http_header(&resp, "last-modified", validator, sizeof(validator)) != 0) {
+                storable = 0;
+            }
+            if (storable) {
+                tee.file = http_cache_begin_store(key, norm, &resp, &tee.written);
+            }
+        }
+
+        rc = http_read_response(&resp, http_cache_tee, &tee);
+        http_finish(&resp);
+
+        if (tee.file) {
+            fclose(tee.file);
+            if (rc == 0) {
+                http_cache_commit(key, tee.written, expires);
+            } else {
+                char tmp[300];
+                http_cache_path(key, "tmp", tmp, sizeof(tmp));
+                remove(tmp);
+            }
+        }
+    }
+    return rc;
+}
+
+void http_cache_print(void)
+{
+    long now = (long)time(NULL);
+
+    if (!g_open) {
+        printf("HTTP cache is off (start with --cache-dir=<path>).\n");
+        return;
+    }
+    printf("HTTP cache %s: %d entries, %ld of %ld bytes\n", g_dir, g_count, g_total, g_budget);
+    for (int i = 0; i < g_count; i++) {
+        char path[300], line[1024];
+        FILE *f;
+        line[0] = '\0';
+        http_cache_path(g_slots[i].key, "htc", path, sizeof(path));
+        f = fopen(path, "rb");
+        if (f) {
+            /* second line is the URL */
+            if (!fgets(line, sizeof(line), f) || !fgets(line, sizeof(line), f)) line[0] = '\0';
+            fclose(f);
+            http_cache_chomp(line);
+        }
+        printf("  %7ld  %s  %s\n", g_slots[i].size,
+               g_slots[i].expires > now ? "fresh" : "stale", line);
+    }
+}
+
+void http_cache_flush(void)
+{
+    if (!g_open) return;
+    while (g_count > 0) {
+        http_cache_remove(&g_slots[0]);
+    }
+    http_cache_save_index();
+}
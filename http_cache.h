@@ -0,0 +1,61 @@
+#ifndef HTTP_CACHE_H
+#define HTTP_CACHE_H
+
+#include "http_client.h"
+
+/*
+ * Persistent on-disk response cache.
+ *
+ * Entries are keyed by normalized URL and hold the response head, the
+ * validators (ETag / Last-Modified) and the decoded body, one file per
+ * entry in the cache directory. Freshness comes from Cache-Control
+ * max-age or Expires; stale entries with a validator are revalidated with
+ * If-None-Match / If-Modified-Since, so an unchanged page costs one
+ * header round trip (304). An index file tracks sizes and use order, and
+ * least recently used entries are evicted to stay under the byte budget.
+ */
+
+#define HTTP_CACHE_MAX_ENTRIES   256
+#define HTTP_CACHE_DEFAULT_BYTES (2L * 1024 * 1024)
+
+/* Where a cached_get body came from. */
+typedef enum {
+    HTTP_CACHE_MISS = 0,       /* fetched from the network */
+    HTTP_CACHE_HIT,            /* fresh entry, no network */
+    HTTP_CACHE_REVALIDATED     /* stale entry confirmed by a 304 */
+} http_cache_result_t;
+
+/* Enables the cache in dir (which must exist). Returns 0 on success. */
+int http_cache_open(const char *dir, long max_bytes);
+void http_cache_close(void);
+int http_cache_enabled(void);
+
+/* Lower-cases scheme and host, drops the default port and any #fragment. */
+void http_cache_normalize(const char *url, char *out, int out_size);
+
+/*
+ * GET through the cache. Body bytes go to on_body exactly as with
+ * http_read_response. *status receives the HTTP status (200 for hits, 0
+ * if no response arrived) and *result where the body came from. If
+ * content_type is not NULL it receives the Content-Type header ("" if
+ * none), stored with the entry for hits, before on_body sees any body.
+ * Returns 0 on success, NET_TRANSPORT_ERR on failure. Works uncached when
+ * the cache is closed.
+ */
+int http_cached_get(const char *url,
+                    const char *host,
+                    unsigned short port,
+                    net_scheme_t scheme,
+                    const net_tls_options_t *tls_opts,
+                    const char *path,
+                    http_body_fn on_body,
+                    void *user,
+                    int *status,
+                    http_cache_result_t *result,
+                    char *content_type,
+                    int content_type_len);
+
+void http_cache_print(void);
+void http_cache_flush(void);
+
+#endif
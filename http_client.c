@@ -0,0 +1,485 @@
+#include "http_client.h"
+#include "inflate_stream.h"
+#include "scan_kernel.h"
+#include "stats.h"
+#include "url.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+/* chunk_state values while decoding Transfer-Encoding: chunked */
+enum {
+    HTTP_CHUNK_SIZE = 0,   /* hex digits of the chunk size */
+    HTTP_CHUNK_EXT,        /* ";ext" up to end of size line */
+    HTTP_CHUNK_DATA,       /* chunk payload, remaining bytes left */
+    HTTP_CHUNK_DATA_END,   /* CRLF after the payload */
+    HTTP_CHUNK_TRAILER     /* trailer lines after the 0-size chunk */
+};
+
+static char http_lower(char c)
+{
+    if (c >= 'A' && c <= 'Z') {
+        return (char)(c + ('a' - 'A'));
+    }
+    return c;
+}
+
+/* Case-insensitive prefix match of a header line against "name:". */
+static const char *http_header_value(const char *line, const char *name)
+{
+    while (*name) {
+        if (http_lower(*line) != http_lower(*name)) return NULL;
+        line++;
+        name++;
+    }
+    if (*line != ':') return NULL;
+    line++;
+    while (*line == ' ' || *line == '\t') line++;
+    return line;
+}
+
+static int http_value_has(const char *value, const char *token)
+{
+    int tlen = (int)strlen(token);
+
+    for (; *value && *value != '\r' && *value != '\n'; value++) {
+        int i = 0;
+        while (i < tlen && http_lower(value[i]) == token[i]) i++;
+        if (i == tlen) return 1;
+    }
+    return 0;
+}
+
+static void http_parse_head(http_response_t *resp)
+{
+    const char *line = resp->head;
+    int minor = 0;
+
+    resp->status = 0;
+    resp->content_length = -1;
+    resp->chunked = 0;
+
+    if (strncmp(line, "HTTP/1.", 7) == 0) {
+        minor = line[7] - '0';
+        if (line[8] == ' ') {
+            resp->status = atoi(line + 9);
+        }
+    }
+    /* HTTP/1.1 is persistent unless told otherwise; 1.0 only on request. */
+    resp->keep_alive = (minor >= 1);
+
+    while ((line = strchr(line, '\n')) != NULL) {
+        const char *v;
+        line++;
+        if ((v = http_header_value(line, "content-length")) != NULL) {
+            /* One that does not fit a long is no length: read to close. */
+            char *stop;
+            long n;
+            errno = 0;
+            n = strtol(v, &stop, 10);
+            resp->content_length = (errno == 0 && stop != v && n >= 0) ? n : -1;
+        } else if ((v = http_header_value(line, "transfer-encoding")) != NULL) {
+            resp->chunked = http_value_has(v, "chunked");
+        } else if ((v = http_header_value(line, "connection")) != NULL) {
+            if (http_value_has(v, "close")) resp->keep_alive = 0;
+            else if (http_value_has(v, "keep-alive")) resp->keep_alive = 1;
+        }
+    }
+
+    resp->done = 0;
+    if (resp->status == 204 || resp->status == 304 || resp->no_body) {
+        resp->done = 1;
+    } else if (resp->chunked) {
+        resp->chunk_state = HTTP_CHUNK_SIZE;
+        resp->remaining = 0;
+    } else if (resp->content_length >= 0) {
+        resp->remaining = resp->content_length;
+        resp->done = (resp->remaining == 0);
+    } else {
+        /* Close-delimited body: the connection cannot be reused. */
+        resp->keep_alive = 0;
+    }
+}
+
+/* Reads up to the blank line; body bytes past it stay buffered. */
+static int http_read_head(http_response_t *resp)
+{
+    int line_start = 0;       /* offset in head of the line being copied */
+
+    resp->head_len = 0;
+
+    for (;;) {
+        const char *buf, *from, *end;
+        stats_time_t t;
+        int avail = net_transport_peek(&resp->conn, &buf);
+        if (avail <= 0) return NET_TRANSPORT_ERR;
+
+        t = stats_begin();
+        from = buf;
+        end = buf + avail;
+        while (from < end) {
+            /* Copy up to and including the next LF in one go. */
+            const char *lf = scan_find_any(from, end, "\n", 1);
+            int n = (int)(lf - from) + (lf < end);
+            if (resp->head_len + n >= (int)sizeof(resp->head)) {
+                return NET_TRANSPORT_ERR;
+            }
+            memcpy(resp->head + resp->head_len, from, n);
+            resp->head_len += n;
+            from += n;
+            if (from[-1] == '\n') {
+                /* Blank is "\n" or "\r\n"; a CR from the last peek is in
+                   head already. One before the status line is dropped. */
+                int len = resp->head_len - line_start;
+                int blank = len == 1 || (len == 2 && resp->head[line_start] == '\r');
+                line_start = resp->head_len;
+                if (blank && line_start == len) {
+                    resp->head_len = 0;
+                    line_start = 0;
+                } else if (blank) {
+                    resp->head[resp->head_len] = '\0';
+                    http_parse_head(resp);
+                    if (resp->status >= 100 && resp->status < 200) {
+                        /* Interim response (100 Continue etc.): the real
+                           head follows on the same connection. */
+                        resp->head_len = 0;
+                        line_start = 0;
+                        continue;
+                    }
+                    net_transport_consume(&resp->conn, (int)(from - buf));
+                    stats_end(STATS_HEADERS, t);
+                    return 0;
+                }
+            }
+        }
+        net_transport_consume(&resp->conn, avail);
+        stats_end(STATS_HEADERS, t);
+    }
+}
+
+int http_request(http_response_t *resp,
+                 const char *method,
+                 const char *host,
+                 unsigned short port,
+                 net_scheme_t scheme,
+                 const net_tls_options_t *tls_opts,
+                 const char *path,
+                 const char *content_type,
+                 const char *body,
+                 const char *extra_headers)
+{
+    char request[2048];
+    char host_hdr[300];
+    unsigned short default_port = (scheme == NET_SCHEME_HTTPS) ? 443 : 80;
+    net_iovec_t iov[2];
+    int len, idempotent;
+
+    if (port == default_port) {
+        snprintf(host_hdr, sizeof(host_hdr), "%s", host);
+    } else {
+        snprintf(host_hdr, sizeof(host_hdr), "%s:%u", host, (unsigned)port);
+    }
+
+    len = snprintf(request, sizeof(request),
+                   "%s %s HTTP/1.1\r\n"
+                   "Host: %s\r\n"
+                   "User-Agent: " HTTP_USER_AGENT "\r\n"
+                   "Connection: keep-alive\r\n"
+                   "Accept-Encoding: gzip, deflate\r\n"
+                   "%s",
+                   method, path, host_hdr, extra_headers ? extra_headers : "");
+    if (len > 0 && len < (int)sizeof(request)) {
+        if (body) {
+            len += snprintf(request + len, sizeof(request) - len,
+                            "Content-Type: %s\r\n"
+                            "Content-Length: %d\r\n"
+                            "\r\n",
+                            content_type ? content_type : "application/x-www-form-urlencoded",
+                            (int)strlen(body));
+        } else {
+            len += snprintf(request + len, sizeof(request) - len, "\r\n");
+        }
+    }
+    if (len <= 0 || len >= (int)sizeof(request)) {
+        return NET_TRANSPORT_ERR;
+    }
+    /* The body is sent from the caller's buffer, after the head. */
+    iov[0].data = request;
+    iov[0].len = len;
+    iov[1].data = body;
+    iov[1].len = body ? (int)strlen(body) : 0;
+
+    /* A pooled connection may have been closed by the server in the
+       meantime; that shows up as a send error or EOF before the head.
+       Retry once on a fresh connection in that case -- but once the
+       request went out, only if sending it twice is harmless: the server
+       may have acted on a POST before the connection dropped. */
+    idempotent = strcmp(method, "GET") == 0 || strcmp(method, "HEAD") == 0;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        int sent;
+
+        memset(resp, 0, sizeof(*resp));
+        if (net_transport_acquire(&resp->conn, host, port, scheme, tls_opts, &resp->reused) != 0) {
+            return NET_TRANSPORT_ERR;
+        }
+        resp->no_body = (strcmp(method, "HEAD") == 0);
+        sent = net_transport_sendv(&resp->conn, iov, 2) == 0;
+        if (sent && http_read_head(resp) == 0) {
+            return 0;
+        }
+        net_transport_close(&resp->conn);
+        if (!resp->reused || net_transport_last_failure() == NET_FAIL_CANCELLED) break;
+        if (sent && !idempotent) break;
+    }
+    return NET_TRANSPORT_ERR;
+}
+
+/* Consume chunk framing bytes until payload is available or the body ends. */
+static int http_chunk_advance(http_response_t *resp)
+{
+    while (resp->chunk_state != HTTP_CHUNK_DATA && !resp->done) {
+        const char *buf;
+        int used = 0;
+        int avail = net_transport_peek(&resp->conn, &buf);
+        if (avail <= 0) return NET_TRANSPORT_ERR;
+
+        while (used < avail && resp->chunk_state != HTTP_CHUNK_DATA && !resp->done) {
+            char c = buf[used++];
+
+            switch (resp->chunk_state) {
+            case HTTP_CHUNK_SIZE: {
+                int digit = -1;
+                if (c >= '0' && c <= '9') {
+                    digit = c - '0';
+                } else if (http_lower(c) >= 'a' && http_lower(c) <= 'f') {
+                    digit = http_lower(c) - 'a' + 10;
+                }
+                if (digit >= 0) {
+                    /* A size past a long is no real chunk: the body ends here. */
+                    if (resp->remaining > (LONG_MAX - digit) / 16) {
+                        net_transport_consume(&resp->conn, used);
+                        return NET_TRANSPORT_ERR;
+                    }
+                    resp->remaining = resp->remaining * 16 + digit;
+                } else if (c == '\n') {
+                    if (resp->remaining == 0) {
+                        resp->chunk_state = HTTP_CHUNK_TRAILER;
+                    } else {
+                        resp->chunk_state = HTTP_CHUNK_DATA;
+                    }
+                } else if (c != '\r') {
+                    resp->chunk_state = HTTP_CHUNK_EXT;
+                }
+                break;
+            }
+            case HTTP_CHUNK_EXT:
+                if (c == '\n') {
+                    resp->chunk_state = resp->remaining ? HTTP_CHUNK_DATA : HTTP_CHUNK_TRAILER;
+                }
+                break;
+            case HTTP_CHUNK_DATA_END:
+                if (c == '\n') {
+                    resp->chunk_state = HTTP_CHUNK_SIZE;
+                    resp->remaining = 0;
+                }
+                break;
+            case HTTP_CHUNK_TRAILER:
+                /* remaining counts bytes on the current trailer line */
+                if (c == '\n') {
+                    if (resp->remaining == 0) {
+                        resp->done = 1;
+                        break;
+                    }
+                    resp->remaining = 0;
+                } else if (c != '\r') {
+                    resp->remaining++;
+                }
+                break;
+            }
+        }
+        net_transport_consume(&resp->conn, used);
+    }
+    return 0;
+}
+
+/* Points *data at the next run of body bytes in the receive buffer, past
+   any chunk framing and no further than the framed end. Returns its
+   length, 0 at end of body, NET_TRANSPORT_ERR on error or truncation. */
+static int http_body_peek(http_response_t *resp, const char **data)
+{
+    int n;
+
+    if (resp->done) return 0;
+
+    if (resp->chunked) {
+        if (http_chunk_advance(resp) != 0) {
+            resp->done = 1;
+            resp->truncated = 1;
+            resp->keep_alive = 0;
+            return NET_TRANSPORT_ERR;
+        }
+        if (resp->done) return 0;
+    }
+
+    n = net_transport_peek(&resp->conn, data);
+    if (n <= 0) {
+        /* Close before the framed end means a truncated message. */
+        resp->done = 1;
+        if (resp->chunked || resp->content_length >= 0) {
+            resp->truncated = 1;
+            resp->keep_alive = 0;
+        }
+        return n < 0 ? NET_TRANSPORT_ERR : 0;
+    }
+    if ((resp->chunked || resp->content_length >= 0) && n > resp->remaining) {
+        n = (int)resp->remaining;      /* 0 <= remaining < n, so it fits */
+    }
+    return n;
+}
+
+/* Marks n peeked body bytes as read. */
+static void http_body_consume(http_response_t *resp, int n)
+{
+    net_transport_consume(&resp->conn, n);
+    if (resp->chunked || resp->content_length >= 0) {
+        resp->remaining -= n;
+        if (resp->remaining == 0) {
+            if (resp->chunked) resp->chunk_state = HTTP_CHUNK_DATA_END;
+            else resp->done = 1;
+        }
+    }
+}
+
+int http_read_body(http_response_t *resp, char *buffer, int len)
+{
+    const char *data;
+    int n = http_body_peek(resp, &data);
+
+    if (n <= 0) return n;
+    if (n > len) n = len;
+    memcpy(buffer, data, n);
+    http_body_consume(resp, n);
+    return n;
+}
+
+int http_read_response(http_response_t *resp, http_body_fn on_body, void *user)
+{
+    const char *data;
+    char encoding[32];
+    inflate_stream_t *z = NULL;
+    int stopped = 0;
+    int n;
+
+    /* Compressed bodies go through a fixed-window inflater on their way to
+       the consumer; only the current recv chunk is ever held compressed. */
+    if (http_header(resp, "content-encoding", encoding, sizeof(encoding)) == 0) {
+        inflate_format_t format;
+        int known = 1;
+        if (http_value_has(encoding, "gzip")) format = INFLATE_FORMAT_GZIP;
+        else if (http_value_has(encoding, "deflate")) format = INFLATE_FORMAT_ZLIB;
+        else known = 0;
+        if (known) {
+            z = (inflate_stream_t*)malloc(sizeof(*z));
+            if (!z) {
+                resp->keep_alive = 0;
+                return NET_TRANSPORT_ERR;
+            }
+            inflate_stream_init(z, format, on_body, user);
+        }
+    }
+
+    while ((n = http_body_peek(resp, &data)) > 0) {
+        if (z) {
+            stopped = inflate_stream_feed(z, data, n) != INFLATE_OK;
+        } else {
+            stopped = on_body(user, data, n) != 0;
+        }
+        http_body_consume(resp, n);
+        if (stopped) {
+            /* Unread body left on the wire: not reusable. */
+            resp->keep_alive = 0;
+            break;
+        }
+    }
+    /* A compressed body is whole only if its stream, trailer included,
+       ended too; a close can look like the end of the body. */
+    if (z && !stopped && n == 0 && !inflate_stream_done(z)) stopped = 1;
+    free(z);
+    return (stopped || n < 0 || resp->truncated) ? NET_TRANSPORT_ERR : 0;
+}
+
+int http_header(const http_response_t *resp, const char *name, char *out, int out_len)
+{
+    return http_head_header(resp->head, name, out, out_len);
+}
+
+int http_head_header(const char *head, const char *name, char *out, int out_len)
+{
+    const char *line = head;
+
+    if (out_len <= 0) return -1;
+    while ((line = strchr(line, '\n')) != NULL) {
+        const char *v;
+        int len = 0;
+        line++;
+        if ((v = http_header_value(line, name)) == NULL) continue;
+        while (v[len] && v[len] != '\r' && v[len] != '\n') len++;
+        while (len > 0 && (v[len - 1] == ' ' || v[len - 1] == '\t')) len--;
+        if (len >= out_len) len = out_len - 1;
+        memcpy(out, v, len);
+        out[len] = '\0';
+        return 0;
+    }
+    out[0] = '\0';
+    return -1;
+}
+
+void http_finish(http_response_t *resp)
+{
+    net_transport_release(&resp->conn, resp->done && resp->keep_alive);
+}
+
+static int http_is_redirect(int status)
+{
+    return status == 301 || status == 302 || status == 303 || status == 307 || status == 308;
+}
+
+int http_get(http_response_t *resp, const char *url, const net_tls_options_t *tls,
+             page_arena_t *page, char *final, int final_len)
+{
+    char host[256], path[512], location[512], next[512];
+    unsigned short port = 0;
+    net_scheme_t scheme;
+    net_tls_options_t opts = *tls;
+    int rc;
+
+    snprintf(final, final_len, "%s", url);
+    final[strcspn(final, "#")] = '\0';         /* fragments are not sent */
+    for (int hop = 0; ; ++hop) {
+        page_arena_reset(page);
+        if (url_parse(final, &scheme, host, sizeof(host), path, sizeof(path), &port) != 0) {
+            return HTTP_GET_BAD_URL;
+        }
+        opts.server_name = host;
+        if (http_request(resp, "GET", host, port, scheme, &opts, path, NULL, NULL, NULL) != 0) {
+            return HTTP_GET_NO_REPLY;
+        }
+        if (resp->content_length > 0 && resp->content_length <= page->limit) {
+            page_arena_reserve(page, resp->content_length);
+        }
+        /* A redirect's body is read too, so the connection can be reused. */
+        rc = http_read_response(resp, page_arena_sink, page);
+        http_finish(resp);
+
+        if (!http_is_redirect(resp->status) || hop == HTTP_MAX_REDIRECTS ||
+            http_header(resp, "Location", location, sizeof(location)) != 0 ||
+            url_resolve(final, location, next, sizeof(next)) != 0) {
+            return rc;
+        }
+        next[strcspn(next, "#")] = '\0';
+        snprintf(final, final_len, "%s", next);
+    }
+}
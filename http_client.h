@@ -0,0 +1,100 @@
+#ifndef HTTP_CLIENT_H
+#define HTTP_CLIENT_H
+
+#include "net_transport.h"
+#include "page_arena.h"
+
+/*
+ * HTTP/1.1 request path on top of the net_transport keep-alive pool.
+ *
+ * http_request acquires a (possibly pooled) connection, sends the request
+ * and reads the response head. The body is then pulled with
+ * http_read_body, which stops at the framed end of the message
+ * (Content-Length, last chunk, or close), or pushed to a consumer with
+ * http_read_response as it arrives. http_finish parks the connection for
+ * reuse when the whole body was consumed and the server allows it.
+ *
+ * Everything is read through the connection's receive buffer
+ * (net_transport_peek): the head is parsed and body bytes are handed to
+ * consumers where they landed, so http_read_response copies nothing.
+ */
+
+#define HTTP_MAX_HEAD     4096
+#define HTTP_RX_BUF       1024   /* read size for bodies replayed from files */
+#define HTTP_USER_AGENT   "CE-Lynx/1.0"
+#define HTTP_MAX_REDIRECTS 5
+
+#define HTTP_GET_BAD_URL  -2     /* not http(s)://, or a redirect went there */
+#define HTTP_GET_NO_REPLY -3     /* no response head; see net_transport_last_failure */
+
+typedef struct {
+    net_transport_t conn;
+    int reused;              /* connection came from the pool */
+
+    int status;              /* e.g. 200; 0 if the status line was bad */
+    long content_length;     /* -1 when not sent */
+    int chunked;             /* Transfer-Encoding: chunked */
+    int keep_alive;          /* server permits reuse after this message */
+    int no_body;             /* HEAD request: head only */
+
+    int done;                /* end of body reached */
+    int truncated;           /* peer closed before the framed end */
+    long remaining;          /* bytes left in body (or current chunk) */
+    int chunk_state;         /* see http_client.c */
+
+    char head[HTTP_MAX_HEAD];/* status line + headers, NUL-terminated */
+    int head_len;
+} http_response_t;
+
+/* method is "GET" or "POST"; body/content_type may be NULL. extra_headers,
+   if not NULL, is a block of complete "Name: value\r\n" lines. A pooled
+   connection the server dropped is replaced once; a POST already sent on
+   it is not sent again. Returns 0 once the response head is in,
+   NET_TRANSPORT_ERR otherwise. */
+int http_request(http_response_t *resp,
+                 const char *method,
+                 const char *host,
+                 unsigned short port,
+                 net_scheme_t scheme,
+                 const net_tls_options_t *tls_opts,
+                 const char *path,
+                 const char *content_type,
+                 const char *body,
+                 const char *extra_headers);
+
+/* Returns body bytes read (>0), 0 at end of body, NET_TRANSPORT_ERR on error.
+   Bytes are as sent, i.e. still gzip/deflate-encoded if Content-Encoding
+   says so; use http_read_response to get them decoded. */
+int http_read_body(http_response_t *resp, char *buffer, int len);
+
+/* Body consumer: return 0 to keep reading, nonzero to stop early. */
+typedef int (*http_body_fn)(void *user, const char *data, int len);
+
+/* Feeds the whole body to on_body as it arrives, inflating gzip/deflate
+   Content-Encoding on the way. Plain bodies are passed as pointers into
+   the receive buffer. Returns 0 when the framed end was reached,
+   NET_TRANSPORT_ERR on error, truncation or early stop. */
+int http_read_response(http_response_t *resp, http_body_fn on_body, void *user);
+
+/* Copies the value of header `name` (case-insensitive) into out.
+   Returns 0 if found, -1 otherwise. */
+int http_header(const http_response_t *resp, const char *name, char *out, int out_len);
+
+/* The same over a NUL-terminated response head kept elsewhere (e.g. in
+   the cache). */
+int http_head_header(const char *head, const char *name, char *out, int out_len);
+
+void http_finish(http_response_t *resp);
+
+/*
+ * GETs url into page (reset first), following up to HTTP_MAX_REDIRECTS
+ * 301/302/303/307/308 redirects. final gets the URL the page came from,
+ * without a #fragment. tls->server_name is set to each host in turn.
+ * Returns http_read_response's result for the last response, whose head
+ * is left in resp (a redirect past the limit is returned as it is), or
+ * HTTP_GET_BAD_URL / HTTP_GET_NO_REPLY with nothing in page.
+ */
+int http_get(http_response_t *resp, const char *url, const net_tls_options_t *tls,
+             page_arena_t *page, char *final, int final_len);
+
+#endif
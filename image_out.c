@@ -0,0 +1,219 @@
+#include "image_out.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BMP_FILE_HEADER 14
+#define BMP_INFO_HEADER 40
+
+/* 4x4 ordered-dither thresholds, 0..15. */
+static const unsigned char g_bayer[4][4] = {
+    {  0,  8,  2, 10 },
+    { 12,  4, 14,  6 },
+    {  3, 11,  1,  9 },
+    { 15,  7, 13,  5 }
+};
+
+static void put16(unsigned char *p, unsigned v)
+{
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+}
+
+static void put32(unsigned char *p, unsigned long v)
+{
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+int image_out_open(image_out_t *o, const char *path, image_out_format_t format,
+                   int max_width, int max_height)
+{
+    memset(o, 0, sizeof(*o));
+    o->format = format;
+    o->max_width = max_width > 0 ? max_width : 1;
+    o->max_height = max_height > 0 ? max_height : 1;
+    o->f = fopen(path, "wb");
+    return o->f ? 0 : -1;
+}
+
+const char *image_out_extension(image_out_format_t format)
+{
+    return format == IMAGE_OUT_RAW565 ? "raw" : "bmp";
+}
+
+static int image_out_bits(image_out_format_t format)
+{
+    switch (format) {
+    case IMAGE_OUT_BMP24: return 24;
+    case IMAGE_OUT_BMP8: return 8;
+    default: return 16;
+    }
+}
+
+/* Picks the output size and writes the header, once the input size is
+   known from the first row. */
+static int image_out_start(image_out_t *o, int width, int height)
+{
+    unsigned char head[BMP_FILE_HEADER + BMP_INFO_HEADER + 12];
+    int bits = image_out_bits(o->format);
+    int masks = o->format == IMAGE_OUT_BMP16 ? 12 : 0;
+    int colours = o->format == IMAGE_OUT_BMP8 ? 256 : 0;
+
+    o->in_width = width;
+    o->in_height = height;
+    if (width <= o->max_width && height <= o->max_height) {
+        o->width = width;
+        o->height = height;
+    } else if ((long)width * o->max_height > (long)height * o->max_width) {
+        o->width = o->max_width;
+        o->height = (int)((long)height * o->max_width / width);
+    } else {
+        o->height = o->max_height;
+        o->width = (int)((long)width * o->max_height / height);
+    }
+    if (o->width < 1) o->width = 1;
+    if (o->height < 1) o->height = 1;
+
+    o->line_bytes = o->format == IMAGE_OUT_RAW565 ? o->width * 2
+                                                  : (o->width * bits / 8 + 3) & ~3;
+    o->sum = (unsigned long*)calloc((size_t)o->width * 3, sizeof(*o->sum));
+    o->line = (unsigned char*)calloc((size_t)o->line_bytes, 1);
+    if (!o->sum || !o->line) return -1;
+    if (o->format == IMAGE_OUT_RAW565) return 0;
+
+    o->data_offset = BMP_FILE_HEADER + BMP_INFO_HEADER + masks + 4L * colours;
+    memset(head, 0, sizeof(head));
+    head[0] = 'B';
+    head[1] = 'M';
+    put32(head + 2, (unsigned long)(o->data_offset + (long)o->line_bytes * o->height));
+    put32(head + 10, (unsigned long)o->data_offset);
+    put32(head + 14, BMP_INFO_HEADER);
+    put32(head + 18, (unsigned long)o->width);
+    put32(head + 22, (unsigned long)o->height);      /* positive: bottom-up */
+    put16(head + 26, 1);
+    put16(head + 28, (unsigned)bits);
+    put32(head + 30, masks ? 3 : 0);                 /* BI_BITFIELDS : BI_RGB */
+    put32(head + 34, (unsigned long)o->line_bytes * o->height);
+    put32(head + 38, 2835);                          /* 72 dpi */
+    put32(head + 42, 2835);
+    put32(head + 46, (unsigned long)colours);
+    if (masks) {
+        put32(head + 54, 0xF800);
+        put32(head + 58, 0x07E0);
+        put32(head + 62, 0x001F);
+    }
+    if (fwrite(head, 1, BMP_FILE_HEADER + BMP_INFO_HEADER + masks, o->f) !=
+        (size_t)(BMP_FILE_HEADER + BMP_INFO_HEADER + masks)) return -1;
+    for (int i = 0; i < colours; ++i) {
+        unsigned char entry[4];
+        entry[0] = entry[1] = entry[2] = (unsigned char)i;
+        entry[3] = 0;
+        if (fwrite(entry, 1, 4, o->f) != 4) return -1;
+    }
+    return 0;
+}
+
+/* Encodes the averaged band as output row out_y and writes it. */
+static int image_out_emit(image_out_t *o)
+{
+    const int y = o->out_y;
+    unsigned char *p = o->line;
+
+    for (int x = 0; x < o->width; ++x) {
+        int x0 = (int)((long)x * o->in_width / o->width);
+        int x1 = (int)((long)(x + 1) * o->in_width / o->width);
+        unsigned long n = (unsigned long)(x1 - x0) * o->band_rows;
+        int r = (int)((o->sum[3 * x] + n / 2) / n);
+        int g = (int)((o->sum[3 * x + 1] + n / 2) / n);
+        int b = (int)((o->sum[3 * x + 2] + n / 2) / n);
+
+        switch (o->format) {
+        case IMAGE_OUT_BMP24:
+            *p++ = (unsigned char)b;
+            *p++ = (unsigned char)g;
+            *p++ = (unsigned char)r;
+            break;
+        case IMAGE_OUT_BMP8:
+            *p++ = (unsigned char)((77 * r + 150 * g + 29 * b + 128) >> 8);
+            break;
+        default: {
+            /* Threshold below one 565 step, so flat areas do not band. */
+            int d = g_bayer[y & 3][x & 3];
+            int r5 = (r + (d >> 1)) > 255 ? 31 : (r + (d >> 1)) >> 3;
+            int g6 = (g + (d >> 2)) > 255 ? 63 : (g + (d >> 2)) >> 2;
+            int b5 = (b + (d >> 1)) > 255 ? 31 : (b + (d >> 1)) >> 3;
+            put16(p, (unsigned)(r5 << 11 | g6 << 5 | b5));
+            p += 2;
+            break;
+        }
+        }
+    }
+
+    if (o->format != IMAGE_OUT_RAW565 &&
+        fseek(o->f, o->data_offset + (long)(o->height - 1 - y) * o->line_bytes, SEEK_SET) != 0) {
+        return -1;
+    }
+    if (fwrite(o->line, 1, (size_t)o->line_bytes, o->f) != (size_t)o->line_bytes) return -1;
+    memset(o->sum, 0, (size_t)o->width * 3 * sizeof(*o->sum));
+    o->band_rows = 0;
+    o->out_y++;
+    return 0;
+}
+
+int image_out_row(void *user, const unsigned char *rgb, int y, int width, int height)
+{
+    image_out_t *o = (image_out_t*)user;
+
+    if (o->failed) return -1;
+    if (!o->in_width && image_out_start(o, width, height) != 0) {
+        o->failed = 1;
+        return -1;
+    }
+    if (width != o->in_width || height != o->in_height || o->out_y >= o->height) {
+        o->failed = 1;
+        return -1;
+    }
+
+    for (int x = 0; x < o->width; ++x) {
+        int x0 = (int)((long)x * width / o->width);
+        int x1 = (int)((long)(x + 1) * width / o->width);
+        unsigned long *s = o->sum + 3 * x;
+        for (const unsigned char *p = rgb + 3 * x0; p < rgb + 3 * x1; p += 3) {
+            s[0] += p[0];
+            s[1] += p[1];
+            s[2] += p[2];
+        }
+    }
+    o->band_rows++;
+
+    /* Last input row of this output row's band? */
+    if (y + 1 == (int)((long)(o->out_y + 1) * height / o->height) && image_out_emit(o) != 0) {
+        o->failed = 1;
+        return -1;
+    }
+    return 0;
+}
+
+int image_out_close(image_out_t *o)
+{
+    int ok = !o->failed && o->in_width && o->out_y == o->height;
+
+    /* A framebuffer dump is still the full size when the picture stopped
+       short; a BMP already is, its last row having been written first. */
+    if (!o->failed && o->format == IMAGE_OUT_RAW565 && o->line) {
+        memset(o->line, 0, (size_t)o->line_bytes);
+        for (; o->out_y < o->height; o->out_y++) {
+            if (fwrite(o->line, 1, (size_t)o->line_bytes, o->f) != (size_t)o->line_bytes) break;
+        }
+    }
+    if (o->f && fclose(o->f) != 0) ok = 0;
+    o->f = NULL;
+    free(o->sum);
+    free(o->line);
+    o->sum = NULL;
+    o->line = NULL;
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,58 @@
+#ifndef IMAGE_OUT_H
+#define IMAGE_OUT_H
+
+#include <stdio.h>
+
+/*
+ * Writes a picture that arrives one RGB row at a time (jpeg_stream's
+ * on_row) to a file in the device's format, boxing it down to fit a
+ * maximum size on the way.
+ *
+ * jpeg_stream only scales by powers of two in the DCT, so its output can
+ * still be up to twice the target in each direction; the box filter here
+ * takes it the rest of the way, keeping the aspect ratio. It holds one
+ * row of column sums and one encoded output row, so memory depends on
+ * the target width only. BMP rows are stored bottom-up; they are written
+ * in place with a seek as the top-down picture comes in, instead of the
+ * whole picture being kept until the end.
+ */
+
+typedef enum {
+    IMAGE_OUT_BMP24 = 0,      /* 24-bit BGR */
+    IMAGE_OUT_BMP16,          /* 16-bit RGB565 (BI_BITFIELDS), ordered dither */
+    IMAGE_OUT_BMP8,           /* 8-bit, 256-entry grey palette */
+    IMAGE_OUT_RAW565          /* headerless little-endian RGB565, top-down,
+                                 no row padding: a framebuffer dump */
+} image_out_format_t;
+
+typedef struct {
+    FILE *f;
+    image_out_format_t format;
+    int max_width, max_height;
+    int in_width, in_height;  /* rows as they arrive; 0 before the first */
+    int width, height;        /* as written */
+    unsigned long *sum;       /* width * 3 column sums of the current band */
+    int band_rows;            /* input rows summed into it */
+    int out_y;                /* next output row */
+    unsigned char *line;      /* one encoded row, padded */
+    int line_bytes;
+    long data_offset;         /* where the pixel rows start in the file */
+    int failed;               /* allocation or write error */
+} image_out_t;
+
+/* Returns 0, or -1 if path cannot be created. */
+int image_out_open(image_out_t *o, const char *path, image_out_format_t format,
+                   int max_width, int max_height);
+
+/* jpeg_row_fn: user is the image_out_t. Rows must come in order, y from
+   0, all with the same width and height. Returns nonzero on failure. */
+int image_out_row(void *user, const unsigned char *rgb, int y, int width, int height);
+
+/* Closes the file. Returns 0 if every output row was written, -1 if the
+   picture stopped short (the rest is left black) or a write failed. */
+int image_out_close(image_out_t *o);
+
+/* "bmp" or "raw", for naming files. */
+const char *image_out_extension(image_out_format_t format);
+
+#endif
@@ -0,0 +1,534 @@
+#include "inflate_stream.h"
+
+#include <string.h>
+
+/*
+ * Decoder modelled on the canonical-Huffman approach of zlib's puff.c:
+ * codes are decoded bit by bit against per-length counts, which keeps the
+ * tables to a few hundred bytes. Every state can stop when input runs out
+ * and resume on the next feed with nothing re-read.
+ */
+
+enum {
+    Z_GZ_HEAD = 0,    /* 10-byte gzip member header */
+    Z_GZ_XLEN,        /* FEXTRA length */
+    Z_GZ_EXTRA,       /* FEXTRA payload */
+    Z_GZ_NAME,        /* FNAME, NUL-terminated */
+    Z_GZ_COMMENT,     /* FCOMMENT, NUL-terminated */
+    Z_GZ_HCRC,        /* FHCRC */
+    Z_ZLIB_HEAD,      /* CMF/FLG */
+    Z_BLOCK,          /* 3-bit block header */
+    Z_STORED_LEN,     /* LEN of a stored block */
+    Z_STORED_NLEN,    /* NLEN of a stored block */
+    Z_STORED,         /* stored block payload */
+    Z_TABLE,          /* HLIT/HDIST/HCLEN */
+    Z_CODELENS,       /* code length code lengths */
+    Z_LENLENS,        /* literal/length + distance code lengths */
+    Z_CODES,          /* literal/length symbol */
+    Z_LENEXT,         /* length extra bits */
+    Z_DIST,           /* distance symbol */
+    Z_DISTEXT,        /* distance extra bits */
+    Z_TRAILER,        /* CRC/ISIZE or Adler-32 */
+    Z_DONE,
+    Z_BAD
+};
+
+#define GZ_FHCRC    0x02
+#define GZ_FEXTRA   0x04
+#define GZ_FNAME    0x08
+#define GZ_FCOMMENT 0x10
+
+#define WINDOW_MASK (INFLATE_WINDOW_SIZE - 1)
+
+static const short lbase[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const short lext[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const short dbase[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577 };
+static const short dext[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+static const short clen_order[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+typedef struct {
+    const unsigned char *next;
+    const unsigned char *end;
+} inflate_in_t;
+
+/* Pull input bytes into the bit buffer until it holds n bits (n <= 24). */
+static int need(inflate_stream_t *z, inflate_in_t *in, int n)
+{
+    while (z->bitcnt < n) {
+        if (in->next == in->end) return 0;
+        z->bitbuf |= (unsigned long)*in->next++ << z->bitcnt;
+        z->bitcnt += 8;
+    }
+    return 1;
+}
+
+static int bits(inflate_stream_t *z, int n)
+{
+    int v = (int)(z->bitbuf & ((1UL << n) - 1));
+    z->bitbuf >>= n;
+    z->bitcnt -= n;
+    return v;
+}
+
+/* Build canonical decoding tables. Returns 0 for a complete code,
+   >0 for an incomplete one, <0 for an over-subscribed one. */
+static int construct(inflate_huff_t *h, const short *length, int n)
+{
+    short offs[16];
+    int left = 1;
+
+    for (int len = 0; len <= 15; len++) h->count[len] = 0;
+    for (int sym = 0; sym < n; sym++) h->count[length[sym]]++;
+    if (h->count[0] == n) return 0;
+
+    for (int len = 1; len <= 15; len++) {
+        left <<= 1;
+        left -= h->count[len];
+        if (left < 0) return left;
+    }
+
+    offs[1] = 0;
+    for (int len = 1; len < 15; len++) offs[len + 1] = offs[len] + h->count[len];
+    for (int sym = 0; sym < n; sym++) {
+        if (length[sym] != 0) h->symbol[offs[length[sym]]++] = (short)sym;
+    }
+    return left;
+}
+
+/* Returns a symbol, -1 if more input is needed (nothing consumed),
+   or -2 for an invalid code. */
+static int decode(inflate_stream_t *z, inflate_in_t *in, const inflate_huff_t *h)
+{
+    int code = 0, first = 0, index = 0;
+
+    for (int len = 1; len <= 15; len++) {
+        int count;
+        if (!need(z, in, len)) return -1;
+        code |= (int)((z->bitbuf >> (len - 1)) & 1);
+        count = h->count[len];
+        if (code - count < first) {
+            bits(z, len);
+            return h->symbol[index + (code - first)];
+        }
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+    return -2;
+}
+
+static void fixed_tables(inflate_stream_t *z)
+{
+    short *l = z->lengths;
+    int sym = 0;
+
+    for (; sym < 144; sym++) l[sym] = 8;
+    for (; sym < 256; sym++) l[sym] = 9;
+    for (; sym < 280; sym++) l[sym] = 7;
+    for (; sym < 288; sym++) l[sym] = 8;
+    construct(&z->lencode, l, 288);
+    for (sym = 0; sym < 30; sym++) l[sym] = 5;
+    construct(&z->distcode, l, 30);
+}
+
+/* CRC-32 four bits at a time: a 64-byte table instead of zlib's 1 KB. */
+static const unsigned long crc_nibble[16] = {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL };
+
+/* Adds output bytes to the running CRC-32 or Adler-32. */
+static void check_update(inflate_stream_t *z, const unsigned char *p, int n)
+{
+    if (z->format == INFLATE_FORMAT_GZIP) {
+        unsigned long c = ~z->check & 0xFFFFFFFFUL;
+        for (int i = 0; i < n; i++) {
+            c ^= p[i];
+            c = (c >> 4) ^ crc_nibble[c & 15];
+            c = (c >> 4) ^ crc_nibble[c & 15];
+        }
+        z->check = ~c & 0xFFFFFFFFUL;
+    } else if (z->format == INFLATE_FORMAT_ZLIB) {
+        unsigned long a = z->check & 0xFFFF, b = z->check >> 16;
+        while (n > 0) {
+            /* 5552 bytes is the most before b can pass 32 bits. */
+            int k = n < 5552 ? n : 5552;
+            n -= k;
+            while (k-- > 0) {
+                a += *p++;
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+        }
+        z->check = b << 16 | a;
+    }
+}
+
+static unsigned long le32(const unsigned char *p)
+{
+    return (unsigned long)p[0] | (unsigned long)p[1] << 8 |
+           (unsigned long)p[2] << 16 | (unsigned long)p[3] << 24;
+}
+
+/* Does the trailer match the output? gzip: CRC-32 then the length mod
+   2^32, little-endian; zlib: Adler-32, big-endian. */
+static int trailer_ok(const inflate_stream_t *z)
+{
+    const unsigned char *t = z->trailer;
+
+    if (z->format == INFLATE_FORMAT_GZIP) {
+        return le32(t) == z->check && le32(t + 4) == (z->total_out & 0xFFFFFFFFUL);
+    }
+    return ((unsigned long)t[0] << 24 | (unsigned long)t[1] << 16 |
+            (unsigned long)t[2] << 8 | t[3]) == z->check;
+}
+
+/* Hand [wflush, wpos) to the consumer; wrap the window when full. */
+static int emit(inflate_stream_t *z)
+{
+    if (z->wpos > z->wflush) {
+        int r;
+        check_update(z, z->window + z->wflush, (int)(z->wpos - z->wflush));
+        r = z->out ? z->out(z->user, (const char*)z->window + z->wflush,
+                            (int)(z->wpos - z->wflush)) : 0;
+        z->wflush = z->wpos;
+        if (r != 0) return INFLATE_ERR;
+    }
+    if (z->wpos == INFLATE_WINDOW_SIZE) {
+        z->wpos = 0;
+        z->wflush = 0;
+    }
+    return INFLATE_OK;
+}
+
+static int put_byte(inflate_stream_t *z, unsigned char c)
+{
+    z->window[z->wpos++] = c;
+    z->total_out++;
+    return z->wpos == INFLATE_WINDOW_SIZE ? emit(z) : INFLATE_OK;
+}
+
+static int copy_match(inflate_stream_t *z, int len, int dist)
+{
+    while (len > 0) {
+        unsigned int src = (z->wpos - (unsigned int)dist) & WINDOW_MASK;
+        int n = len;
+
+        if (n > (int)(INFLATE_WINDOW_SIZE - z->wpos)) n = (int)(INFLATE_WINDOW_SIZE - z->wpos);
+        if (n > (int)(INFLATE_WINDOW_SIZE - src)) n = (int)(INFLATE_WINDOW_SIZE - src);
+
+        if (dist >= n && dist + n <= INFLATE_WINDOW_SIZE) {
+            memcpy(z->window + z->wpos, z->window + src, (size_t)n);
+        } else {
+            /* Overlapping run (e.g. dist 1 = repeat last byte). */
+            for (int i = 0; i < n; i++) {
+                z->window[z->wpos + i] = z->window[(src + i) & WINDOW_MASK];
+            }
+        }
+        z->wpos += n;
+        z->total_out += n;
+        len -= n;
+        if (z->wpos == INFLATE_WINDOW_SIZE && emit(z) != INFLATE_OK) return INFLATE_ERR;
+    }
+    return INFLATE_OK;
+}
+
+void inflate_stream_init(inflate_stream_t *z, inflate_format_t format,
+                         inflate_out_fn out, void *user)
+{
+    /* The window does not need clearing; everything else does. */
+    memset(z, 0, (size_t)((char*)z->window - (char*)z));
+    z->format = format;
+    z->wpos = 0;
+    z->wflush = 0;
+    z->total_out = 0;
+    z->check = (format == INFLATE_FORMAT_ZLIB) ? 1 : 0;
+    z->out = out;
+    z->user = user;
+    switch (format) {
+    case INFLATE_FORMAT_GZIP: z->state = Z_GZ_HEAD; z->header_left = 10; break;
+    case INFLATE_FORMAT_ZLIB: z->state = Z_ZLIB_HEAD; break;
+    default:                  z->state = Z_BLOCK; break;
+    }
+}
+
+int inflate_stream_done(const inflate_stream_t *z)
+{
+    return z->state == Z_DONE;
+}
+
+static void begin_trailer(inflate_stream_t *z)
+{
+    bits(z, z->bitcnt & 7);
+    z->header_left = (z->format == INFLATE_FORMAT_GZIP) ? 8 :
+                     (z->format == INFLATE_FORMAT_ZLIB) ? 4 : 0;
+    z->state = z->header_left ? Z_TRAILER : Z_DONE;
+}
+
+int inflate_stream_feed(inflate_stream_t *z, const char *data, int len)
+{
+    inflate_in_t in;
+    int sym;
+
+    in.next = (const unsigned char*)data;
+    in.end = in.next + len;
+
+    for (;;) {
+        switch (z->state) {
+        case Z_GZ_HEAD:
+            if (!need(z, &in, 8)) goto out;
+            sym = bits(z, 8);
+            switch (10 - z->header_left) {
+            case 0: if (sym != 0x1f) goto bad; break;
+            case 1: if (sym != 0x8b) goto bad; break;
+            case 2: if (sym != 8) goto bad; break;
+            case 3: z->flags = sym; break;
+            }
+            if (--z->header_left > 0) break;
+            z->header_left = 2;
+            z->state = Z_GZ_XLEN;
+            z->stored_left = 0;
+            break;
+
+        case Z_GZ_XLEN:
+            if (!(z->flags & GZ_FEXTRA)) { z->state = Z_GZ_NAME; break; }
+            if (!need(z, &in, 8)) goto out;
+            z->stored_left |= (long)bits(z, 8) << (8 * (2 - z->header_left));
+            if (--z->header_left == 0) z->state = Z_GZ_EXTRA;
+            break;
+
+        case Z_GZ_EXTRA:
+            if (z->stored_left == 0) { z->state = Z_GZ_NAME; break; }
+            if (!need(z, &in, 8)) goto out;
+            bits(z, 8);
+            z->stored_left--;
+            break;
+
+        case Z_GZ_NAME:
+        case Z_GZ_COMMENT: {
+            int flag = (z->state == Z_GZ_NAME) ? GZ_FNAME : GZ_FCOMMENT;
+            int next = (z->state == Z_GZ_NAME) ? Z_GZ_COMMENT : Z_GZ_HCRC;
+            if (!(z->flags & flag)) { z->state = next; z->header_left = 2; break; }
+            if (!need(z, &in, 8)) goto out;
+            if (bits(z, 8) == 0) { z->state = next; z->header_left = 2; }
+            break;
+        }
+
+        case Z_GZ_HCRC:
+            if (!(z->flags & GZ_FHCRC) || z->header_left == 0) { z->state = Z_BLOCK; break; }
+            if (!need(z, &in, 8)) goto out;
+            bits(z, 8);
+            z->header_left--;
+            break;
+
+        case Z_ZLIB_HEAD: {
+            int cmf, flg;
+            if (!need(z, &in, 16)) goto out;
+            cmf = (int)(z->bitbuf & 0xff);
+            flg = (int)((z->bitbuf >> 8) & 0xff);
+            if ((cmf & 0x0f) == 8 && ((cmf << 8) | flg) % 31 == 0 && !(flg & 0x20)) {
+                bits(z, 16);
+            } else {
+                /* Some servers send raw deflate for "deflate"; accept it. */
+                z->format = INFLATE_FORMAT_RAW;
+            }
+            z->state = Z_BLOCK;
+            break;
+        }
+
+        case Z_BLOCK:
+            if (!need(z, &in, 3)) goto out;
+            z->last_block = bits(z, 1);
+            switch (bits(z, 2)) {
+            case 0:
+                bits(z, z->bitcnt & 7);
+                z->state = Z_STORED_LEN;
+                break;
+            case 1:
+                fixed_tables(z);
+                z->state = Z_CODES;
+                break;
+            case 2:
+                z->state = Z_TABLE;
+                break;
+            default:
+                goto bad;
+            }
+            break;
+
+        case Z_STORED_LEN:
+            if (!need(z, &in, 16)) goto out;
+            z->stored_left = bits(z, 16);
+            z->state = Z_STORED_NLEN;
+            break;
+
+        case Z_STORED_NLEN:
+            if (!need(z, &in, 16)) goto out;
+            if (bits(z, 16) != (int)(~z->stored_left & 0xffff)) goto bad;
+            z->state = Z_STORED;
+            break;
+
+        case Z_STORED:
+            if (z->stored_left == 0) {
+                if (z->last_block) begin_trailer(z);
+                else z->state = Z_BLOCK;
+                break;
+            }
+            if (z->bitcnt >= 8) {
+                if (put_byte(z, (unsigned char)bits(z, 8)) != INFLATE_OK) goto bad;
+                z->stored_left--;
+            } else {
+                int n = (int)(in.end - in.next);
+                if (n == 0) goto out;
+                if (n > z->stored_left) n = (int)z->stored_left;
+                if (n > (int)(INFLATE_WINDOW_SIZE - z->wpos)) n = (int)(INFLATE_WINDOW_SIZE - z->wpos);
+                memcpy(z->window + z->wpos, in.next, (size_t)n);
+                in.next += n;
+                z->wpos += n;
+                z->total_out += n;
+                z->stored_left -= n;
+                if (z->wpos == INFLATE_WINDOW_SIZE && emit(z) != INFLATE_OK) goto bad;
+            }
+            break;
+
+        case Z_TABLE:
+            if (!need(z, &in, 14)) goto out;
+            z->nlen = bits(z, 5) + 257;
+            z->ndist = bits(z, 5) + 1;
+            z->ncode = bits(z, 4) + 4;
+            if (z->nlen > 286 || z->ndist > 30) goto bad;
+            z->index = 0;
+            z->state = Z_CODELENS;
+            break;
+
+        case Z_CODELENS:
+            while (z->index < z->ncode) {
+                if (!need(z, &in, 3)) goto out;
+                z->lengths[clen_order[z->index++]] = (short)bits(z, 3);
+            }
+            for (; z->index < 19; z->index++) z->lengths[clen_order[z->index]] = 0;
+            if (construct(&z->lencode, z->lengths, 19) != 0) goto bad;
+            z->index = 0;
+            z->sym = -1;
+            z->state = Z_LENLENS;
+            break;
+
+        case Z_LENLENS: {
+            int total = z->nlen + z->ndist;
+            while (z->index < total) {
+                int len = 0, rep;
+                if (z->sym < 0) {
+                    z->sym = decode(z, &in, &z->lencode);
+                    if (z->sym == -1) goto out;
+                    if (z->sym < 0) goto bad;
+                }
+                if (z->sym < 16) {
+                    z->lengths[z->index++] = (short)z->sym;
+                    z->sym = -1;
+                    continue;
+                }
+                if (z->sym == 16) {
+                    if (z->index == 0) goto bad;
+                    len = z->lengths[z->index - 1];
+                    if (!need(z, &in, 2)) goto out;
+                    rep = 3 + bits(z, 2);
+                } else if (z->sym == 17) {
+                    if (!need(z, &in, 3)) goto out;
+                    rep = 3 + bits(z, 3);
+                } else {
+                    if (!need(z, &in, 7)) goto out;
+                    rep = 11 + bits(z, 7);
+                }
+                if (z->index + rep > total) goto bad;
+                while (rep--) z->lengths[z->index++] = (short)len;
+                z->sym = -1;
+            }
+            if (z->lengths[256] == 0) goto bad;
+            sym = construct(&z->lencode, z->lengths, z->nlen);
+            if (sym < 0 || (sym > 0 && z->nlen != z->lencode.count[0] + z->lencode.count[1])) goto bad;
+            sym = construct(&z->distcode, z->lengths + z->nlen, z->ndist);
+            if (sym < 0 || (sym > 0 && z->ndist != z->distcode.count[0] + z->distcode.count[1])) goto bad;
+            z->state = Z_CODES;
+            break;
+        }
+
+        case Z_CODES:
+            sym = decode(z, &in, &z->lencode);
+            if (sym == -1) goto out;
+            if (sym < 0) goto bad;
+            if (sym < 256) {
+                if (put_byte(z, (unsigned char)sym) != INFLATE_OK) goto bad;
+            } else if (sym == 256) {
+                if (z->last_block) begin_trailer(z);
+                else z->state = Z_BLOCK;
+            } else {
+                sym -= 257;
+                if (sym >= 29) goto bad;
+                z->sym = sym;
+                z->state = Z_LENEXT;
+            }
+            break;
+
+        case Z_LENEXT:
+            if (!need(z, &in, lext[z->sym])) goto out;
+            z->copy_len = lbase[z->sym] + bits(z, lext[z->sym]);
+            z->state = Z_DIST;
+            break;
+
+        case Z_DIST:
+            sym = decode(z, &in, &z->distcode);
+            if (sym == -1) goto out;
+            if (sym < 0 || sym >= 30) goto bad;
+            z->sym = sym;
+            z->state = Z_DISTEXT;
+            break;
+
+        case Z_DISTEXT:
+            if (!need(z, &in, dext[z->sym])) goto out;
+            z->copy_dist = dbase[z->sym] + bits(z, dext[z->sym]);
+            if ((unsigned long)z->copy_dist > z->total_out) goto bad;
+            if (copy_match(z, z->copy_len, z->copy_dist) != INFLATE_OK) goto bad;
+            z->state = Z_CODES;
+            break;
+
+        case Z_TRAILER: {
+            int size = (z->format == INFLATE_FORMAT_GZIP) ? 8 : 4;
+            if (!need(z, &in, 8)) goto out;
+            z->trailer[size - z->header_left] = (unsigned char)bits(z, 8);
+            if (--z->header_left > 0) break;
+            /* The last block's output is still in the window. */
+            if (emit(z) != INFLATE_OK || !trailer_ok(z)) goto bad;
+            z->state = Z_DONE;
+            break;
+        }
+
+        case Z_DONE:
+            /* Anything after the stream (padding, extra gzip members) is ignored. */
+            goto out;
+
+        default:
+            goto bad;
+        }
+    }
+
+out:
+    if (emit(z) != INFLATE_OK) goto bad;
+    return INFLATE_OK;
+
+bad:
+    z->state = Z_BAD;
+    return INFLATE_ERR;
+}
@@ -0,0 +1,82 @@
+#ifndef INFLATE_STREAM_H
+#define INFLATE_STREAM_H
+
+/*
+ * Streaming inflate for Content-Encoding: gzip / deflate.
+ *
+ * Compressed bytes are fed in whatever chunks arrive off the wire; all
+ * decoder state is kept here, so no call ever needs more than the bytes
+ * it was given. Memory is fixed: the 32 KB deflate history window (the
+ * format's maximum back-reference distance) plus the Huffman tables,
+ * regardless of body size. Output is handed to the callback as runs
+ * straight out of the window. The gzip CRC-32 and length, or the zlib
+ * Adler-32, are checked against that output at the end of the stream.
+ */
+
+#define INFLATE_WINDOW_SIZE 32768
+
+#define INFLATE_OK     0
+#define INFLATE_ERR   -1
+
+typedef enum {
+    INFLATE_FORMAT_GZIP = 0,   /* RFC 1952 */
+    INFLATE_FORMAT_ZLIB,       /* RFC 1950; "deflate" per HTTP */
+    INFLATE_FORMAT_RAW         /* bare RFC 1951 stream */
+} inflate_format_t;
+
+/* Return 0 to continue, nonzero to stop decoding. */
+typedef int (*inflate_out_fn)(void *user, const char *data, int len);
+
+typedef struct {
+    short count[16];           /* codes per bit length */
+    short symbol[288];         /* symbols ordered by code */
+} inflate_huff_t;
+
+typedef struct {
+    inflate_format_t format;
+    int state;
+    int last_block;
+
+    unsigned long bitbuf;      /* pending input bits, LSB first */
+    int bitcnt;
+
+    /* gzip header / stored block / trailer bookkeeping */
+    int flags;
+    int header_left;
+    long stored_left;
+    unsigned long check;       /* CRC-32 (gzip) or Adler-32 (zlib) so far */
+    unsigned char trailer[8];
+
+    /* dynamic table construction */
+    int nlen, ndist, ncode, index;
+    short lengths[320];
+
+    /* length/distance decoding in progress */
+    int sym;
+    int copy_len;
+    int copy_dist;
+
+    inflate_huff_t lencode;
+    inflate_huff_t distcode;
+
+    unsigned char window[INFLATE_WINDOW_SIZE];
+    unsigned int wpos;         /* next write position */
+    unsigned int wflush;       /* start of not-yet-emitted output */
+    unsigned long total_out;
+
+    inflate_out_fn out;
+    void *user;
+} inflate_stream_t;
+
+void inflate_stream_init(inflate_stream_t *z, inflate_format_t format,
+                         inflate_out_fn out, void *user);
+
+/* Returns INFLATE_OK (more input welcome or stream finished) or INFLATE_ERR
+   on corrupt data, a trailer that does not match the output, or consumer
+   stop. */
+int inflate_stream_feed(inflate_stream_t *z, const char *data, int len);
+
+/* Nonzero once the final block (and trailer) has been consumed. */
+int inflate_stream_done(const inflate_stream_t *z);
+
+#endif
@@ -0,0 +1,637 @@
+#include "jpeg_stream.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Entropy-coded data is never decoded part way: an MCU is started only
+ * when the buffer holds the most bytes it could possibly take (or the
+ * input has ended), so the Huffman decoder needs no way to stop in the
+ * middle of a block and resume later. Segments before the scan are
+ * parsed once they are whole in the buffer; ones we do not need are
+ * skipped as they stream past.
+ */
+
+enum {
+    J_MARKER = 0,     /* looking for the next marker */
+    J_LENGTH,         /* 2-byte segment length */
+    J_SEGMENT,        /* waiting for a whole segment we parse */
+    J_SKIP,           /* skipping a segment we do not need */
+    J_SCAN,           /* entropy-coded data */
+    J_DONE,
+    J_BAD
+};
+
+/* Markers */
+#define M_SOF0  0xC0
+#define M_SOF1  0xC1
+#define M_DHT   0xC4
+#define M_RST0  0xD0
+#define M_SOI   0xD8
+#define M_EOI   0xD9
+#define M_SOS   0xDA
+#define M_DQT   0xDB
+#define M_DRI   0xDD
+
+/* Zigzag position -> natural (row-major) position. */
+static const unsigned char g_zigzag[64] = {
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/* round(2048 * cos(k * pi / 16)), k = 0..8 */
+static const int g_cos[9] = { 2048, 2009, 1892, 1703, 1448, 1138, 784, 400, 0 };
+
+static int jpeg_cos(int k)
+{
+    k &= 31;
+    if (k > 16) k = 32 - k;
+    return k <= 8 ? g_cos[k] : -g_cos[16 - k];
+}
+
+static int jpeg_fail(jpeg_stream_t *j, const char *why)
+{
+    if (!j->error) j->error = why;
+    j->state = J_BAD;
+    return JPEG_ERR;
+}
+
+void jpeg_stream_init(jpeg_stream_t *j, int max_width, int max_height,
+                      jpeg_row_fn on_row, void *user)
+{
+    memset(j, 0, sizeof(*j));
+    j->state = J_MARKER;
+    j->max_width = max_width;
+    j->max_height = max_height;
+    j->on_row = on_row;
+    j->user = user;
+}
+
+void jpeg_stream_free(jpeg_stream_t *j)
+{
+    for (int c = 0; c < 3; ++c) {
+        free(j->comp[c].plane);
+        j->comp[c].plane = NULL;
+    }
+    free(j->rgb);
+    j->rgb = NULL;
+}
+
+int jpeg_stream_has_header(const jpeg_stream_t *j)
+{
+    return j->out_width > 0;
+}
+
+/* ------------------------------------------------------------------------
+ * Segments
+ * ------------------------------------------------------------------------ */
+
+static int jpeg_read_dqt(jpeg_stream_t *j, const unsigned char *p, long len)
+{
+    while (len > 0) {
+        int pq = p[0] >> 4, tq = p[0] & 15;
+        int size = 1 + 64 * (pq ? 2 : 1);
+        if (tq > 3 || len < size) return jpeg_fail(j, "bad quantisation table");
+        for (int k = 0; k < 64; ++k) {
+            j->qt[tq][g_zigzag[k]] = pq ? (unsigned short)(p[1 + 2 * k] << 8 | p[2 + 2 * k])
+                                        : p[1 + k];
+        }
+        j->qt_defined[tq] = 1;
+        p += size;
+        len -= size;
+    }
+    return JPEG_OK;
+}
+
+static int jpeg_build_huff(jpeg_huff_t *h, const unsigned char *counts, const unsigned char *syms, int total)
+{
+    int code = 0, k = 0;
+
+    memset(h->fast, 0, sizeof(h->fast));
+    memcpy(h->huffval, syms, total);
+    for (int len = 1; len <= 16; ++len) {
+        h->valptr[len] = k;
+        h->mincode[len] = code;
+        for (int i = 0; i < counts[len - 1]; ++i, ++k, ++code) {
+            if (len <= JPEG_FAST_BITS) {
+                int shift = JPEG_FAST_BITS - len;
+                for (int f = 0; f < (1 << shift); ++f) {
+                    h->fast[(code << shift) | f] = (unsigned short)(len << 8 | syms[k]);
+                }
+            }
+        }
+        h->maxcode[len] = counts[len - 1] ? code - 1 : -1;
+        if (code > (1 << len)) return -1;     /* over-subscribed */
+        code <<= 1;
+    }
+    h->defined = 1;
+    return 0;
+}
+
+static int jpeg_read_dht(jpeg_stream_t *j, const unsigned char *p, long len)
+{
+    while (len > 17) {
+        int tc = p[0] >> 4, th = p[0] & 15;
+        int total = 0;
+        for (int i = 0; i < 16; ++i) total += p[1 + i];
+        if (tc > 1 || th > 3 || total > 256 || len < 17 + total) {
+            return jpeg_fail(j, "bad Huffman table");
+        }
+        if (jpeg_build_huff(tc ? &j->ac[th] : &j->dc[th], p + 1, p + 17, total) != 0) {
+            return jpeg_fail(j, "bad Huffman table");
+        }
+        p += 17 + total;
+        len -= 17 + total;
+    }
+    return JPEG_OK;
+}
+
+static int jpeg_log2(int n)
+{
+    switch (n) {
+    case 1: return 0;
+    case 2: return 1;
+    case 4: return 2;
+    default: return -1;
+    }
+}
+
+static int jpeg_read_sof(jpeg_stream_t *j, const unsigned char *p, long len)
+{
+    if (j->out_width) return jpeg_fail(j, "more than one frame");
+    if (len < 6 || p[0] != 8) return jpeg_fail(j, "only 8-bit JPEG is supported");
+    j->height = p[1] << 8 | p[2];
+    j->width = p[3] << 8 | p[4];
+    j->ncomp = p[5];
+    if (j->width == 0 || j->height == 0) return jpeg_fail(j, "bad image size");
+    if (j->ncomp != 1 && j->ncomp != 3) return jpeg_fail(j, "only greyscale and YCbCr JPEG are supported");
+    if (len < 6 + 3 * j->ncomp) return jpeg_fail(j, "bad frame header");
+
+    j->hmax = j->vmax = 1;
+    for (int c = 0; c < j->ncomp; ++c) {
+        jpeg_component_t *k = &j->comp[c];
+        k->id = p[6 + 3 * c];
+        k->h = p[7 + 3 * c] >> 4;
+        k->v = p[7 + 3 * c] & 15;
+        k->tq = p[8 + 3 * c] & 3;
+        if (j->ncomp == 1) k->h = k->v = 1;   /* one block per MCU regardless */
+        if (k->h < 1 || k->h > 4 || k->v < 1 || k->v > 4) return jpeg_fail(j, "bad sampling factors");
+        if (k->h > j->hmax) j->hmax = k->h;
+        if (k->v > j->vmax) j->vmax = k->v;
+    }
+    for (int c = 0; c < j->ncomp; ++c) {
+        jpeg_component_t *k = &j->comp[c];
+        if (j->hmax % k->h || j->vmax % k->v) return jpeg_fail(j, "unsupported sampling factors");
+        k->shift_x = jpeg_log2(j->hmax / k->h);
+        k->shift_y = jpeg_log2(j->vmax / k->v);
+        if (k->shift_x < 0 || k->shift_y < 0) return jpeg_fail(j, "unsupported sampling factors");
+    }
+
+    /* Smallest block size that still leaves the image no smaller than
+       it would be fitted into max_width x max_height; the caller's own
+       filter covers the last factor of less than 2. */
+    for (j->scale = 1; j->scale < 8; j->scale <<= 1) {
+        if ((long)j->width * j->scale >= 8L * j->max_width ||
+            (long)j->height * j->scale >= 8L * j->max_height) break;
+    }
+    j->out_width = (j->width * j->scale + 7) / 8;
+    j->out_height = (j->height * j->scale + 7) / 8;
+    if (j->out_width > JPEG_MAX_WIDTH) return jpeg_fail(j, "image too wide");
+
+    j->mcus_x = (j->width + 8 * j->hmax - 1) / (8 * j->hmax);
+    j->mcus_y = (j->height + 8 * j->vmax - 1) / (8 * j->vmax);
+
+    /* N-point basis, C(0) = 1/sqrt(2) folded in: cos((2i + 1) u pi / 2N). */
+    for (int i = 0; i < j->scale; ++i) {
+        for (int u = 0; u < j->scale; ++u) {
+            int c = jpeg_cos((2 * i + 1) * u * (8 / j->scale));
+            j->idct[i * j->scale + u] = u ? c : (c * 1448 + 1024) >> 11;
+        }
+    }
+    return JPEG_OK;
+}
+
+static int jpeg_read_sos(jpeg_stream_t *j, const unsigned char *p, long len)
+{
+    int ns = len > 0 ? p[0] : 0;
+    int blocks = 0;
+
+    if (!j->out_width) return jpeg_fail(j, "scan before frame header");
+    if (ns != j->ncomp || len < 1 + 2 * ns) {
+        return jpeg_fail(j, "scans with some of the components are not supported");
+    }
+    for (int s = 0; s < ns; ++s) {
+        jpeg_component_t *k = NULL;
+        for (int c = 0; c < j->ncomp; ++c) {
+            if (j->comp[c].id == p[1 + 2 * s]) k = &j->comp[c];
+        }
+        if (!k) return jpeg_fail(j, "bad scan header");
+        k->td = p[2 + 2 * s] >> 4 & 3;
+        k->ta = p[2 + 2 * s] & 3;
+        if (!j->dc[k->td].defined || !j->ac[k->ta].defined || !j->qt_defined[k->tq]) {
+            return jpeg_fail(j, "missing table");
+        }
+        blocks += k->h * k->v;
+    }
+
+    /* Per block: 64 coefficients of at most a 16-bit code plus 11 bits,
+       all of it possibly byte-stuffed. */
+    j->mcu_bytes = blocks * 64 * 27 / 8 * 2 + 8;
+    if (j->mcu_bytes > JPEG_IN_BUF / 2) return jpeg_fail(j, "MCU too large");
+
+    for (int c = 0; c < j->ncomp; ++c) {
+        jpeg_component_t *k = &j->comp[c];
+        k->plane_w = j->mcus_x * k->h * j->scale;
+        k->plane = (unsigned char*)malloc((size_t)k->plane_w * k->v * j->scale);
+        if (!k->plane) return jpeg_fail(j, "out of memory");
+        k->dc_pred = 0;
+    }
+    j->rgb = (unsigned char*)malloc((size_t)j->out_width * 3);
+    if (!j->rgb) return jpeg_fail(j, "out of memory");
+
+    j->mcu_x = j->mcu_y = 0;
+    j->restarts_left = j->restart_interval;
+    j->bitbuf = 0;
+    j->bitcnt = 0;
+    j->marker_hit = 0;
+    j->state = J_SCAN;
+    return JPEG_OK;
+}
+
+/* A whole segment is at in[in_pos]: parse it. */
+static int jpeg_segment(jpeg_stream_t *j, const unsigned char *p, long len)
+{
+    switch (j->marker) {
+    case M_DQT: return jpeg_read_dqt(j, p, len);
+    case M_DHT: return jpeg_read_dht(j, p, len);
+    case M_SOF0:
+    case M_SOF1: return jpeg_read_sof(j, p, len);
+    case M_SOS: return jpeg_read_sos(j, p, len);
+    case M_DRI:
+        if (len < 2) return jpeg_fail(j, "bad restart interval");
+        j->restart_interval = p[0] << 8 | p[1];
+        return JPEG_OK;
+    }
+    return JPEG_OK;
+}
+
+/* ------------------------------------------------------------------------
+ * Entropy-coded data
+ * ------------------------------------------------------------------------ */
+
+/* Tops the bit buffer up to more than 24 bits. Past a marker, or past the
+   end of the last input, the data is padded with zeros; short of the end
+   of input that is merely not here yet, it stops (the MCU size check
+   keeps decoding from running into that). */
+static void jpeg_fill(jpeg_stream_t *j)
+{
+    while (j->bitcnt <= 24) {
+        unsigned long c = 0;
+
+        if (!j->marker_hit) {
+            if (j->in_pos >= j->in_len) {
+                if (!j->final) return;
+                j->marker_hit = 1;
+                j->at_end = 1;
+            } else if (j->in[j->in_pos] != 0xFF) {
+                c = j->in[j->in_pos++];
+            } else if (j->in_pos + 1 >= j->in_len) {
+                if (!j->final) return;
+                j->marker_hit = 1;
+                j->at_end = 1;
+            } else if (j->in[j->in_pos + 1] == 0) {
+                c = 0xFF;               /* stuffed byte */
+                j->in_pos += 2;
+            } else {
+                j->marker_hit = 1;      /* left in place for the caller */
+            }
+        }
+        j->bitbuf |= c << (24 - j->bitcnt);
+        j->bitcnt += 8;
+        if (j->at_end) j->pad_bits += 8;
+    }
+}
+
+static int jpeg_bits(jpeg_stream_t *j, int n)
+{
+    int v;
+    if (n == 0) return 0;
+    if (j->bitcnt < n) jpeg_fill(j);
+    v = (int)((j->bitbuf >> (32 - n)) & ((1UL << n) - 1));
+    j->bitbuf = (j->bitbuf << n) & 0xFFFFFFFFUL;
+    j->bitcnt -= n;
+    return v;
+}
+
+/* Value of an n-bit magnitude category (JPEG's EXTEND). */
+static int jpeg_extend(int v, int n)
+{
+    return (n && v < (1 << (n - 1))) ? v - (1 << n) + 1 : v;
+}
+
+static int jpeg_huff(jpeg_stream_t *j, const jpeg_huff_t *h)
+{
+    unsigned long look;
+    int e;
+
+    if (j->bitcnt < 16) jpeg_fill(j);
+    look = (j->bitbuf >> (32 - JPEG_FAST_BITS)) & ((1 << JPEG_FAST_BITS) - 1);
+    e = h->fast[look];
+    if (e) {
+        int len = e >> 8;
+        j->bitbuf = (j->bitbuf << len) & 0xFFFFFFFFUL;
+        j->bitcnt -= len;
+        return e & 0xFF;
+    }
+    for (int len = JPEG_FAST_BITS + 1; len <= 16; ++len) {
+        int code = (int)(j->bitbuf >> (32 - len));
+        if (code <= h->maxcode[len]) {
+            j->bitbuf = (j->bitbuf << len) & 0xFFFFFFFFUL;
+            j->bitcnt -= len;
+            return h->huffval[(h->valptr[len] + code - h->mincode[len]) & 0xFF];
+        }
+    }
+    return -1;
+}
+
+/*
+ * Decodes one block and writes its N x N pixels at out. Coefficients
+ * outside the lowest N x N frequencies are read past but not kept.
+ */
+static int jpeg_block(jpeg_stream_t *j, jpeg_component_t *k, unsigned char *out, int stride)
+{
+    const unsigned short *q = j->qt[k->tq];
+    const int n = j->scale;
+    const int *t = j->idct;
+    int coef[64];
+    int tmp[64];
+    int ac = 0;
+    int s, v;
+
+    s = jpeg_huff(j, &j->dc[k->td]);
+    if (s < 0 || s > 11) return -1;
+    k->dc_pred += jpeg_extend(jpeg_bits(j, s), s);
+    memset(coef, 0, sizeof(int) * n * n);
+    v = k->dc_pred * q[0];
+    coef[0] = v > 2047 ? 2047 : v < -2048 ? -2048 : v;
+
+    for (int i = 1; i < 64; ) {
+        int rs = jpeg_huff(j, &j->ac[k->ta]);
+        int pos, row, col;
+        if (rs < 0) return -1;
+        s = rs & 15;
+        if (s == 0) {
+            if (rs != 0xF0) break;      /* end of block */
+            i += 16;
+            continue;
+        }
+        i += rs >> 4;
+        if (i > 63) return -1;
+        v = jpeg_extend(jpeg_bits(j, s), s);
+        pos = g_zigzag[i++];
+        row = pos >> 3;
+        col = pos & 7;
+        if (row < n && col < n) {
+            v *= q[pos];
+            /* Valid data stays well inside this; garbage must not overflow. */
+            if (v > 2047) v = 2047;
+            if (v < -2048) v = -2048;
+            coef[row * n + col] = v;
+            ac = 1;
+        }
+    }
+
+    if (!ac) {
+        /* Flat block: the same arithmetic as below with only DC. */
+        int p = ((((coef[0] * t[0] + 256) >> 9) * t[0] + 16384) >> 15) + 128;
+        if (p < 0) p = 0;
+        if (p > 255) p = 255;
+        for (int y = 0; y < n; ++y) memset(out + y * stride, p, n);
+        return 0;
+    }
+
+    /* Rows (horizontal frequencies), then columns; 2 fraction bits kept
+       in between, 1/4 and both 11-bit constants taken out at the end. */
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            int sum = 0;
+            for (int u = 0; u < n; ++u) sum += coef[y * n + u] * t[x * n + u];
+            tmp[y * n + x] = (sum + 256) >> 9;
+        }
+    }
+    for (int x = 0; x < n; ++x) {
+        for (int y = 0; y < n; ++y) {
+            int sum = 0, p;
+            for (int u = 0; u < n; ++u) sum += tmp[u * n + x] * t[y * n + u];
+            p = ((sum + 16384) >> 15) + 128;
+            if (p < 0) p = 0;
+            if (p > 255) p = 255;
+            out[y * stride + x] = (unsigned char)p;
+        }
+    }
+    return 0;
+}
+
+static unsigned char jpeg_clamp(int v)
+{
+    return (unsigned char)(v < 0 ? 0 : v > 255 ? 255 : v);
+}
+
+/* Colour-converts the finished MCU row and hands its lines out. */
+static int jpeg_emit_rows(jpeg_stream_t *j)
+{
+    int band = j->vmax * j->scale;
+    int y0 = j->mcu_y * band;
+
+    for (int y = 0; y < band && y0 + y < j->out_height; ++y) {
+        const jpeg_component_t *k = j->comp;
+        const unsigned char *ly = k[0].plane + (y >> k[0].shift_y) * k[0].plane_w;
+        unsigned char *o = j->rgb;
+
+        if (j->ncomp == 1) {
+            for (int x = 0; x < j->out_width; ++x, o += 3) o[0] = o[1] = o[2] = ly[x];
+        } else {
+            const unsigned char *lb = k[1].plane + (y >> k[1].shift_y) * k[1].plane_w;
+            const unsigned char *lr = k[2].plane + (y >> k[2].shift_y) * k[2].plane_w;
+            for (int x = 0; x < j->out_width; ++x, o += 3) {
+                int yy = ly[x >> k[0].shift_x] << 16;
+                int cb = lb[x >> k[1].shift_x] - 128;
+                int cr = lr[x >> k[2].shift_x] - 128;
+                /* JFIF: 1.402, 0.344136, 0.714136, 1.772 in 16.16 */
+                o[0] = jpeg_clamp((yy + 91881 * cr + 32768) >> 16);
+                o[1] = jpeg_clamp((yy - 22554 * cb - 46802 * cr + 32768) >> 16);
+                o[2] = jpeg_clamp((yy + 116130 * cb + 32768) >> 16);
+            }
+        }
+        if (j->on_row(j->user, j->rgb, y0 + y, j->out_width, j->out_height) != 0) {
+            return jpeg_fail(j, "stopped");
+        }
+    }
+    return JPEG_OK;
+}
+
+/* Expects RSTn at the input position; resets the predictors either way. */
+static int jpeg_restart(jpeg_stream_t *j)
+{
+    int p = j->in_pos;
+
+    while (p < j->in_len && j->in[p] == 0xFF && p + 1 < j->in_len && j->in[p + 1] == 0xFF) p++;
+    if (p + 2 > j->in_len && !j->final) return 0;       /* marker not here yet */
+    if (p + 2 <= j->in_len && j->in[p] == 0xFF &&
+        j->in[p + 1] >= M_RST0 && j->in[p + 1] <= M_RST0 + 7) {
+        j->in_pos = p + 2;
+    }
+    j->bitbuf = 0;
+    j->bitcnt = 0;
+    j->pad_bits = 0;
+    j->marker_hit = 0;
+    for (int c = 0; c < j->ncomp; ++c) j->comp[c].dc_pred = 0;
+    j->restarts_left = j->restart_interval;
+    return 1;
+}
+
+static int jpeg_scan(jpeg_stream_t *j)
+{
+    while (j->mcu_y < j->mcus_y) {
+        if (j->restart_interval && j->restarts_left == 0 && !jpeg_restart(j)) return JPEG_OK;
+        if (!j->final && !j->marker_hit && j->in_len - j->in_pos < j->mcu_bytes) return JPEG_OK;
+
+        for (int c = 0; c < j->ncomp; ++c) {
+            jpeg_component_t *k = &j->comp[c];
+            int n = j->scale;
+            for (int by = 0; by < k->v; ++by) {
+                for (int bx = 0; bx < k->h; ++bx) {
+                    unsigned char *out = k->plane + by * n * k->plane_w +
+                                         (j->mcu_x * k->h + bx) * n;
+                    if (jpeg_block(j, k, out, k->plane_w) != 0) {
+                        return jpeg_fail(j, "corrupt image data");
+                    }
+                }
+            }
+        }
+        /* The padding sits below the real bits: once fewer bits are
+           left than were padded, this MCU was made up. */
+        if (j->pad_bits > j->bitcnt) j->truncated = 1;
+        if (j->restart_interval) j->restarts_left--;
+        if (++j->mcu_x == j->mcus_x) {
+            if (jpeg_emit_rows(j) != JPEG_OK) return JPEG_ERR;
+            j->mcu_x = 0;
+            j->mcu_y++;
+        }
+    }
+    j->state = J_DONE;
+    return JPEG_OK;
+}
+
+/* ------------------------------------------------------------------------
+ * Driver
+ * ------------------------------------------------------------------------ */
+
+/* Runs the state machine over the buffered input. */
+static int jpeg_process(jpeg_stream_t *j)
+{
+    for (;;) {
+        int avail = j->in_len - j->in_pos;
+        const unsigned char *p = j->in + j->in_pos;
+
+        switch (j->state) {
+        case J_MARKER:
+            /* Any bytes before 0xFF, and fill 0xFFs, are skipped. */
+            while (avail > 0 && *p != 0xFF) { p++; avail--; j->in_pos++; }
+            while (avail > 1 && p[1] == 0xFF) { p++; avail--; j->in_pos++; }
+            if (avail < 2) return JPEG_OK;
+            j->marker = p[1];
+            j->in_pos += 2;
+            if (j->marker == M_EOI) {
+                j->state = J_DONE;
+            } else if (j->marker == M_SOI || (j->marker >= M_RST0 && j->marker <= M_RST0 + 7) ||
+                       j->marker == 0x01) {
+                /* no payload */
+            } else if ((j->marker >= 0xC2 && j->marker <= 0xCF && j->marker != M_DHT &&
+                        j->marker != 0xC8 && j->marker != 0xCC)) {
+                return jpeg_fail(j, (j->marker == 0xC2 || j->marker == 0xC6 ||
+                                     j->marker == 0xCA || j->marker == 0xCE)
+                                        ? "progressive JPEG is not supported"
+                                        : "this kind of JPEG is not supported");
+            } else {
+                j->state = J_LENGTH;
+            }
+            break;
+
+        case J_LENGTH:
+            if (avail < 2) return JPEG_OK;
+            j->seg_left = (long)(p[0] << 8 | p[1]) - 2;
+            j->in_pos += 2;
+            if (j->seg_left < 0) return jpeg_fail(j, "bad segment length");
+            if (j->marker == M_DQT || j->marker == M_DHT || j->marker == M_SOF0 ||
+                j->marker == M_SOF1 || j->marker == M_SOS || j->marker == M_DRI) {
+                if (j->seg_left > JPEG_IN_BUF) return jpeg_fail(j, "segment too large");
+                j->state = J_SEGMENT;
+            } else {
+                j->state = J_SKIP;
+            }
+            break;
+
+        case J_SEGMENT:
+            if (avail < j->seg_left) return JPEG_OK;
+            j->in_pos += (int)j->seg_left;
+            j->state = J_MARKER;      /* SOS moves on to J_SCAN */
+            if (jpeg_segment(j, p, j->seg_left) != JPEG_OK) return JPEG_ERR;
+            break;
+
+        case J_SKIP:
+            if (avail > j->seg_left) avail = (int)j->seg_left;
+            j->in_pos += avail;
+            j->seg_left -= avail;
+            if (j->seg_left > 0) return JPEG_OK;
+            j->state = J_MARKER;
+            break;
+
+        case J_SCAN:
+            if (jpeg_scan(j) != JPEG_OK) return JPEG_ERR;
+            if (j->state == J_SCAN) return JPEG_OK;
+            break;
+
+        case J_DONE:
+            j->in_pos = j->in_len;    /* anything after the image is ignored */
+            return JPEG_OK;
+
+        default:
+            return JPEG_ERR;
+        }
+    }
+}
+
+int jpeg_stream_feed(jpeg_stream_t *j, const char *data, int len)
+{
+    while (len > 0) {
+        int n = JPEG_IN_BUF - j->in_len;
+
+        if (j->state == J_BAD) return JPEG_ERR;
+        if (n > len) n = len;
+        memcpy(j->in + j->in_len, data, n);
+        j->in_len += n;
+        data += n;
+        len -= n;
+
+        if (jpeg_process(j) != JPEG_OK) return JPEG_ERR;
+        if (j->in_pos == 0 && j->in_len == JPEG_IN_BUF) {
+            return jpeg_fail(j, "segment too large");
+        }
+        memmove(j->in, j->in + j->in_pos, j->in_len - j->in_pos);
+        j->in_len -= j->in_pos;
+        j->in_pos = 0;
+    }
+    return j->state == J_BAD ? JPEG_ERR : JPEG_OK;
+}
+
+int jpeg_stream_finish(jpeg_stream_t *j)
+{
+    if (j->state == J_BAD) return JPEG_ERR;
+    j->final = 1;
+    if (jpeg_process(j) != JPEG_OK) return JPEG_ERR;
+    if (j->state != J_DONE || j->truncated) return jpeg_fail(j, "image data ends early");
+    return JPEG_OK;
+}
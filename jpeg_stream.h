@@ -0,0 +1,124 @@
+#ifndef JPEG_STREAM_H
+#define JPEG_STREAM_H
+
+/*
+ * Streaming baseline JPEG decoder with DCT-domain downscaling.
+ *
+ * Bytes are fed in whatever chunks arrive off the wire, as with
+ * inflate_stream. Entropy-coded data is decoded one MCU (the 8x8 or 16x16
+ * tile the encoder works in) at a time, as soon as enough bytes for the
+ * largest possible MCU are buffered, and each finished row of MCUs is
+ * colour-converted and handed out as RGB rows. Memory is the decoder
+ * itself (input buffer and tables, under 30 KB) plus one row of MCUs per
+ * component at the output scale, so a photo costs the same whether it is
+ * 640 or 4000 pixels tall.
+ *
+ * Scaling happens inside the inverse DCT: each 8x8 block becomes N x N
+ * pixels (N = 8, 4, 2 or 1) by an N-point transform over its lowest N x N
+ * frequencies. 1/2, 1/4 and 1/8 are therefore cheaper than full size,
+ * and 1/8 needs only the DC term. The scale is picked from the frame
+ * header: the smallest N that leaves the image at least as large as it
+ * would be when fitted into max_width x max_height (1/8 at most), so the
+ * caller has less than a factor of 2 left to scale down itself.
+ *
+ * Supported: baseline and extended sequential Huffman (SOF0/SOF1), 8-bit
+ * samples, greyscale or YCbCr with power-of-two sampling factors, restart
+ * intervals. Progressive files keep every coefficient of the image until
+ * their last scan, which bounded memory cannot do; they are refused, as
+ * are arithmetic coding, 12-bit samples and CMYK.
+ */
+
+#define JPEG_IN_BUF      16384
+#define JPEG_MAX_WIDTH   4096      /* output pixels per row */
+#define JPEG_FAST_BITS   9         /* Huffman codes resolved by one lookup */
+
+#define JPEG_OK   0
+#define JPEG_ERR -1
+
+/* One output row of width RGB triples; y counts from 0 at the top.
+   Return 0 to continue, nonzero to stop decoding. */
+typedef int (*jpeg_row_fn)(void *user, const unsigned char *rgb, int y,
+                           int width, int height);
+
+typedef struct {
+    unsigned short fast[1 << JPEG_FAST_BITS];  /* (length << 8) | symbol, 0 = longer */
+    int maxcode[17];          /* largest code of each length, -1 if none */
+    int valptr[17];           /* index of the first symbol of each length */
+    int mincode[17];
+    unsigned char huffval[256];
+    int defined;
+} jpeg_huff_t;
+
+typedef struct {
+    int id;
+    int h, v;                 /* sampling factors */
+    int tq;                   /* quantisation table */
+    int td, ta;               /* DC and AC Huffman tables */
+    int shift_x, shift_y;     /* log2(max factor / own factor) */
+    int dc_pred;
+    unsigned char *plane;     /* one MCU row at the output scale */
+    int plane_w;              /* bytes per plane row */
+} jpeg_component_t;
+
+typedef struct {
+    int state;
+    const char *error;        /* why decoding stopped, or NULL */
+
+    unsigned char in[JPEG_IN_BUF];
+    int in_len;
+    int in_pos;
+    int final;                /* no more input is coming */
+    int marker;               /* segment being read */
+    long seg_left;            /* bytes of it still to skip */
+
+    unsigned short qt[4][64]; /* natural order */
+    int qt_defined[4];
+    jpeg_huff_t dc[4];
+    jpeg_huff_t ac[4];
+
+    int width, height;        /* of the image */
+    int ncomp;
+    jpeg_component_t comp[3];
+    int hmax, vmax;
+    int mcus_x, mcus_y;
+    int mcu_x, mcu_y;         /* next MCU to decode */
+    int mcu_bytes;            /* worst-case entropy bytes of one MCU */
+    int restart_interval;
+    int restarts_left;
+
+    unsigned long bitbuf;     /* MSB-first, left aligned in 32 bits */
+    int bitcnt;
+    int marker_hit;           /* entropy data ended at a marker */
+    int at_end;               /* ... or at the end of the input */
+    int pad_bits;             /* zero bits made up past that end */
+    int truncated;            /* an MCU used some of them */
+
+    int scale;                /* N: pixels per block edge, 8 = full size */
+    int out_width, out_height;
+    int idct[64];             /* N x N basis, 11-bit fixed point */
+    unsigned char *rgb;       /* one output row */
+
+    int max_width, max_height;
+    jpeg_row_fn on_row;
+    void *user;
+} jpeg_stream_t;
+
+/* max_width x max_height is the box the picture is headed for. */
+void jpeg_stream_init(jpeg_stream_t *j, int max_width, int max_height,
+                      jpeg_row_fn on_row, void *user);
+void jpeg_stream_free(jpeg_stream_t *j);
+
+/* Returns JPEG_OK or JPEG_ERR (unsupported or corrupt file, consumer stop;
+   j->error says which). */
+int jpeg_stream_feed(jpeg_stream_t *j, const char *data, int len);
+
+/* Call at the end of input: decodes what is still buffered. A truncated
+   image still has all its rows handed out, the missing part flat, but
+   returns JPEG_ERR ("image data ends early"). */
+int jpeg_stream_finish(jpeg_stream_t *j);
+
+/* Nonzero once the frame header has been read (width, height, scale and
+   out_width/out_height are then valid). */
+int jpeg_stream_has_header(const jpeg_stream_t *j);
+
+#endif
@@ -1,8 +1,19 @@
+#include <windows.h>
 #include "net_transport.h"
+#include "stats.h"
+#include "sys_thread.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+/* A peer that has hung up makes send fail, not raise SIGPIPE. */
+#ifdef MSG_NOSIGNAL
+#define NET_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define NET_SEND_FLAGS 0
+#endif
+
 #ifdef USE_POLARSSL
 #include "polarssl/net.h"
 #include "polarssl/ssl.h"
@@ -10,15 +21,591 @@
 #include "polarssl/havege.h"
 #endif
 
-static int tcp_connect_socket(const char *host, unsigned short port)
+/* ------------------------------------------------------------------------
+ * Threads: one lock for the shared caches, per-thread cancel/failure
+ * ------------------------------------------------------------------------ */
+
+typedef struct {
+    net_cancel_fn cancel_fn;
+    void *cancel_user;
+    net_event_fn event_fn;
+    void *event_user;
+    net_fail_t last_failure;
+} net_thread_state_t;
+
+static int g_net_threads = 0;          /* set once by net_transport_enable_threads */
+static sys_mutex_t g_net_lock;         /* DNS cache, pool, TLS session cache/RNG */
+static sys_mutex_t g_dns_lookup_lock;  /* gethostbyname itself */
+static sys_tls_t g_net_state_key;
+static net_thread_state_t g_net_main_state;
+
+static void net_lock(void)
 {
-    struct hostent *he = gethostbyname(host);
-    if (!he) {
-        return INVALID_SOCKET;
+    if (g_net_threads) sys_mutex_lock(&g_net_lock);
+}
+
+static void net_unlock(void)
+{
+    if (g_net_threads) sys_mutex_unlock(&g_net_lock);
+}
+
+static net_thread_state_t *net_state(void)
+{
+    net_thread_state_t *st;
+
+    if (!g_net_threads) return &g_net_main_state;
+    st = (net_thread_state_t*)sys_tls_get(g_net_state_key);
+    if (!st) {
+        st = (net_thread_state_t*)calloc(1, sizeof(*st));
+        if (!st) return &g_net_main_state;
+        sys_tls_set(g_net_state_key, st);
     }
+    return st;
+}
+
+static int net_fail(net_fail_t why)
+{
+    net_state()->last_failure = why;
+    return NET_TRANSPORT_ERR;
+}
+
+static void net_event(net_event_t ev)
+{
+    const net_thread_state_t *st = net_state();
+    if (st->event_fn) st->event_fn(st->event_user, ev);
+}
+
+void net_transport_enable_threads(void)
+{
+    if (g_net_threads) return;
+    if (sys_tls_create(&g_net_state_key) != 0) return;
+    sys_mutex_init(&g_net_lock);
+    sys_mutex_init(&g_dns_lookup_lock);
+    /* The calling thread keeps the hook it may already have set. */
+    sys_tls_set(g_net_state_key, &g_net_main_state);
+    g_net_threads = 1;
+}
+
+void net_transport_thread_exit(void)
+{
+    net_thread_state_t *st;
+
+    if (!g_net_threads) return;
+    st = (net_thread_state_t*)sys_tls_get(g_net_state_key);
+    if (st && st != &g_net_main_state) free(st);
+    sys_tls_set(g_net_state_key, NULL);
+}
+
+/* ------------------------------------------------------------------------
+ * Resolver cache
+ * ------------------------------------------------------------------------ */
+
+typedef struct {
+    char host[256];
+    u_long addr;
+    int ok;              /* 0 = cached failure */
+    DWORD stamp;         /* GetTickCount() at lookup */
+} net_dns_entry_t;
+
+static net_dns_entry_t g_dns[NET_DNS_CACHE_SIZE];
+static DWORD g_dns_ttl_ms = NET_DNS_DEFAULT_TTL_MS;
+static DWORD g_dns_neg_ttl_ms = NET_DNS_NEGATIVE_TTL_MS;
+
+static int net_dns_fresh(const net_dns_entry_t *e, DWORD now)
+{
+    return now - e->stamp <= (e->ok ? g_dns_ttl_ms : g_dns_neg_ttl_ms);
+}
+
+/* Under g_net_lock: 1 with *ret set if host has a fresh entry, else 0. */
+static int net_dns_cached(const char *host, u_long *addr, int *ret)
+{
+    DWORD now = GetTickCount();
+
+    for (int i = 0; i < NET_DNS_CACHE_SIZE; ++i) {
+        const net_dns_entry_t *e = &g_dns[i];
+        if (e->host[0] && strcmp(e->host, host) == 0 && net_dns_fresh(e, now)) {
+            *addr = e->addr;
+            *ret = e->ok ? 0 : NET_TRANSPORT_ERR;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Under g_net_lock: records a lookup in host's slot, else an empty one,
+   else the oldest. */
+static void net_dns_store(const char *host, u_long addr, int ok)
+{
+    DWORD now = GetTickCount();
+    net_dns_entry_t *victim = &g_dns[0];
+
+    for (int i = 0; i < NET_DNS_CACHE_SIZE; ++i) {
+        net_dns_entry_t *e = &g_dns[i];
+        if (e->host[0] && strcmp(e->host, host) == 0) {
+            victim = e;
+            break;
+        }
+        if (!e->host[0]) {
+            if (victim->host[0]) victim = e;
+        } else if (victim->host[0] && now - e->stamp > now - victim->stamp) {
+            victim = e;
+        }
+    }
+    memset(victim, 0, sizeof(*victim));
+    strncpy(victim->host, host, sizeof(victim->host) - 1);
+    victim->stamp = now;
+    victim->ok = ok;
+    victim->addr = addr;
+}
+
+/* The cache is checked and updated under g_net_lock, but the lookup
+   itself runs without it so a slow resolver does not hold up the pool,
+   the TLS cache or other hosts' cache hits. gethostbyname returns static
+   storage on some stacks, so lookups still take turns on g_dns_lookup_lock.
+   A blocking lookup cannot be interrupted; cancelling is checked before
+   and after it. */
+int net_dns_resolve(const char *host, u_long *addr)
+{
+    const net_thread_state_t *st = net_state();
+    struct hostent *he;
+    u_long found;
+    int ok = 0;
+    int ret;
+
+    /* Dotted-quad literals never need a lookup. */
+    found = inet_addr(host);
+    if (found != INADDR_NONE) {
+        *addr = found;
+        return 0;
+    }
+
+    net_lock();
+    if (net_dns_cached(host, addr, &ret)) {
+        net_unlock();
+        return ret == 0 ? 0 : net_fail(NET_FAIL_DNS);
+    }
+    net_unlock();
+
+    if (st->cancel_fn && st->cancel_fn(st->cancel_user)) return net_fail(NET_FAIL_CANCELLED);
+    if (g_net_threads) sys_mutex_lock(&g_dns_lookup_lock);
+    he = gethostbyname(host);
+    found = 0;
+    if (he && he->h_addr) {
+        ok = 1;
+        found = *((u_long*)he->h_addr);
+    }
+    if (g_net_threads) sys_mutex_unlock(&g_dns_lookup_lock);
+
+    net_lock();
+    net_dns_store(host, found, ok);
+    net_unlock();
+
+    if (st->cancel_fn && st->cancel_fn(st->cancel_user)) return net_fail(NET_FAIL_CANCELLED);
+    *addr = found;
+    return ok ? 0 : net_fail(NET_FAIL_DNS);
+}
+
+void net_dns_config(unsigned long ttl_ms, unsigned long negative_ttl_ms)
+{
+    net_lock();
+    g_dns_ttl_ms = (DWORD)ttl_ms;
+    g_dns_neg_ttl_ms = (DWORD)negative_ttl_ms;
+    net_unlock();
+}
+
+void net_dns_flush(void)
+{
+    net_lock();
+    memset(g_dns, 0, sizeof(g_dns));
+    net_unlock();
+}
+
+void net_dns_print(void)
+{
+    DWORD now = GetTickCount();
+    int shown = 0;
+
+    net_lock();
+    printf("DNS cache (ttl %lus, negative ttl %lus):\n",
+           (unsigned long)(g_dns_ttl_ms / 1000), (unsigned long)(g_dns_neg_ttl_ms / 1000));
+    for (int i = 0; i < NET_DNS_CACHE_SIZE; ++i) {
+        const net_dns_entry_t *e = &g_dns[i];
+        unsigned char *ip = (unsigned char*)&e->addr;
+        if (!e->host[0]) continue;
+        if (e->ok) {
+            printf("  %-32s %u.%u.%u.%u", e->host, ip[0], ip[1], ip[2], ip[3]);
+        } else {
+            printf("  %-32s (not found)", e->host);
+        }
+        printf("  age %lus%s\n", (unsigned long)((now - e->stamp) / 1000),
+               net_dns_fresh(e, now) ? "" : " (expired)");
+        shown++;
+    }
+    if (!shown) printf("  (empty)\n");
+    net_unlock();
+}
+
+/* ------------------------------------------------------------------------
+ * Deadlines and cancellation
+ * ------------------------------------------------------------------------ */
+
+static DWORD g_connect_ms = NET_DEFAULT_CONNECT_MS;
+static DWORD g_first_byte_ms = NET_DEFAULT_FIRST_BYTE_MS;
+static DWORD g_idle_ms = NET_DEFAULT_IDLE_MS;
+
+static int net_would_block(void)
+{
+    int err = WSAGetLastError();
+    return err == WSAEWOULDBLOCK || err == WSAEINPROGRESS;
+}
+
+/*
+ * Waits for fd to become readable (for_write == 0) or writable, until
+ * budget_ms after start (0 = no deadline). Error conditions count as
+ * ready so the following call reports them. Returns 0 or
+ * NET_TRANSPORT_ERR with the reason recorded.
+ */
+static int net_wait(SOCKET fd, int for_write, DWORD start, DWORD budget_ms)
+{
+    const net_thread_state_t *st = net_state();
+
+    for (;;) {
+        fd_set ready, failed;
+        struct timeval tv;
+        DWORD slice = NET_POLL_SLICE_MS;
+        int r;
+
+        if (st->cancel_fn && st->cancel_fn(st->cancel_user)) {
+            return net_fail(NET_FAIL_CANCELLED);
+        }
+        if (budget_ms) {
+            DWORD spent = GetTickCount() - start;
+            if (spent >= budget_ms) return net_fail(NET_FAIL_TIMEOUT);
+            if (budget_ms - spent < slice) slice = budget_ms - spent;
+        }
+
+        FD_ZERO(&ready);
+        FD_SET(fd, &ready);
+        FD_ZERO(&failed);
+        FD_SET(fd, &failed);   /* WinSock reports a failed connect here */
+        tv.tv_sec = 0;
+        tv.tv_usec = (long)slice * 1000L;
+        r = select((int)fd + 1, for_write ? NULL : &ready, for_write ? &ready : NULL,
+                   &failed, &tv);
+        if (r > 0) return 0;
+        if (r < 0) return net_fail(NET_FAIL_IO);
+    }
+}
+
+static int net_sock_send(SOCKET fd, const char *data, int len, DWORD start, DWORD budget_ms)
+{
+    for (;;) {
+        int r = send(fd, data, len, NET_SEND_FLAGS);
+        if (r >= 0) return r;
+        if (!net_would_block()) return net_fail(NET_FAIL_IO);
+        if (net_wait(fd, 1, start, budget_ms) != 0) return NET_TRANSPORT_ERR;
+    }
+}
+
+static int net_sock_recv(SOCKET fd, char *buf, int len, DWORD start, DWORD budget_ms)
+{
+    for (;;) {
+        int r = recv(fd, buf, len, 0);
+        if (r >= 0) return r;
+        if (!net_would_block()) return net_fail(NET_FAIL_IO);
+        if (net_wait(fd, 0, start, budget_ms) != 0) return NET_TRANSPORT_ERR;
+    }
+}
+
+void net_transport_timeouts(unsigned long connect_ms,
+                            unsigned long first_byte_ms,
+                            unsigned long idle_ms)
+{
+    g_connect_ms = (DWORD)connect_ms;
+    g_first_byte_ms = (DWORD)first_byte_ms;
+    g_idle_ms = (DWORD)idle_ms;
+}
+
+void net_transport_set_cancel(net_cancel_fn fn, void *user)
+{
+    net_thread_state_t *st = net_state();
+    st->cancel_fn = fn;
+    st->cancel_user = user;
+}
+
+void net_transport_set_events(net_event_fn fn, void *user)
+{
+    net_thread_state_t *st = net_state();
+    st->event_fn = fn;
+    st->event_user = user;
+}
+
+net_fail_t net_transport_last_failure(void)
+{
+    return net_state()->last_failure;
+}
+
+const char *net_transport_failure_text(net_fail_t why)
+{
+    switch (why) {
+    case NET_FAIL_DNS:       return "host not found";
+    case NET_FAIL_CONNECT:   return "connection refused or unreachable";
+    case NET_FAIL_TLS:       return "TLS handshake failed";
+    case NET_FAIL_TIMEOUT:   return "timed out";
+    case NET_FAIL_CANCELLED: return "cancelled";
+    case NET_FAIL_IO:        return "connection lost";
+    default:                 return "no response";
+    }
+}
+
+#ifdef USE_POLARSSL
+/* ------------------------------------------------------------------------
+ * PolarSSL backend
+ * ------------------------------------------------------------------------ */
+
+/* Per-connection TLS state. Heap-allocated so net_transport_t can be copied
+   (e.g. into and out of the keep-alive pool) without moving the
+   ssl_context the BIO callbacks point at. */
+typedef struct {
+    ssl_context ssl;
+    SOCKET fd;
+    DWORD phase_start;    /* deadline for the BIO callbacks' waits */
+    DWORD phase_ms;
+} net_tls_conn_t;
+
+/* Client-side session cache: a repeat connection to the same host:port
+   offers the saved session and gets an abbreviated handshake (no RSA key
+   exchange) when the server still has it. */
+typedef struct {
+    char host[256];
+    unsigned short port;
+    int valid;
+    DWORD stamp;
+    ssl_session session;
+} net_tls_session_t;
+
+static net_tls_session_t g_tls_sessions[NET_TLS_SESSION_CACHE_SIZE];
+
+static havege_state g_tls_rng;
+static int g_tls_rng_ready = 0;
+
+static x509_crt g_tls_ca;
+static char g_tls_ca_path[260];
+static int g_tls_ca_ready = 0;
+
+static int net_tls_bio_send(void *ctx, const unsigned char *buf, size_t len)
+{
+    net_tls_conn_t *tc = (net_tls_conn_t*)ctx;
+    int r = net_sock_send(tc->fd, (const char*)buf, (int)len, tc->phase_start, tc->phase_ms);
+    return r < 0 ? POLARSSL_ERR_NET_SEND_FAILED : r;
+}
+
+static int net_tls_bio_recv(void *ctx, unsigned char *buf, size_t len)
+{
+    net_tls_conn_t *tc = (net_tls_conn_t*)ctx;
+    int r = net_sock_recv(tc->fd, (char*)buf, (int)len, tc->phase_start, tc->phase_ms);
+    return r < 0 ? POLARSSL_ERR_NET_RECV_FAILED : r;
+}
+
+/* The shared generator is not reentrant; connections on other threads
+   draw from it under the lock. */
+static int net_tls_random(void *p_rng, unsigned char *output, size_t len)
+{
+    int ret;
+    net_lock();
+    ret = havege_random(p_rng, output, len);
+    net_unlock();
+    return ret;
+}
+
+/* The CA chain is parsed once per path; parsing a bundle costs more than a
+   handshake on the slower devices. */
+static x509_crt *net_tls_ca_chain(const char *path)
+{
+    if (!path || !*path) return NULL;
+    if (g_tls_ca_ready && strcmp(g_tls_ca_path, path) == 0) return &g_tls_ca;
+
+    if (g_tls_ca_ready) x509_crt_free(&g_tls_ca);
+    x509_crt_init(&g_tls_ca);
+    g_tls_ca_ready = 1;
+    strncpy(g_tls_ca_path, path, sizeof(g_tls_ca_path) - 1);
+    g_tls_ca_path[sizeof(g_tls_ca_path) - 1] = '\0';
+
+    int ret = x509_crt_parse_file(&g_tls_ca, path);
+    if (ret < 0) {
+        printf("Failed to load CA bundle: %s (ret=-0x%04x)\n", path, -ret);
+    }
+    return &g_tls_ca;
+}
+
+static net_tls_session_t *net_tls_session_find(const char *host, unsigned short port)
+{
+    for (int i = 0; i < NET_TLS_SESSION_CACHE_SIZE; ++i) {
+        net_tls_session_t *e = &g_tls_sessions[i];
+        if (e->valid && e->port == port && strcmp(e->host, host) == 0) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+static void net_tls_session_store(const ssl_context *ssl, const char *host, unsigned short port)
+{
+    net_tls_session_t *slot = net_tls_session_find(host, port);
+
+    if (!slot) {
+        DWORD now = GetTickCount();
+        slot = &g_tls_sessions[0];
+        for (int i = 0; i < NET_TLS_SESSION_CACHE_SIZE; ++i) {
+            net_tls_session_t *e = &g_tls_sessions[i];
+            if (!e->valid) { slot = e; break; }
+            if (now - e->stamp > now - slot->stamp) slot = e;
+        }
+    }
+    if (slot->valid) ssl_session_free(&slot->session);
+
+    memset(slot, 0, sizeof(*slot));
+    ssl_session_init(&slot->session);
+    if (ssl_get_session(ssl, &slot->session) != 0) {
+        ssl_session_free(&slot->session);
+        return;
+    }
+    strncpy(slot->host, host, sizeof(slot->host) - 1);
+    slot->port = port;
+    slot->stamp = GetTickCount();
+    slot->valid = 1;
+}
+
+/* The handshake shares the connect deadline that started at start. */
+static int net_tls_handshake(net_transport_t *transport, const net_tls_options_t *tls_opts,
+                             DWORD start)
+{
+    const char *server_name = (tls_opts && tls_opts->server_name) ? tls_opts->server_name
+                                                                 : transport->host;
+    int insecure = tls_opts && tls_opts->tls_insecure;
+    net_tls_conn_t *tc;
+    net_tls_session_t *cached;
+    int ret;
+
+    tc = (net_tls_conn_t*)calloc(1, sizeof(*tc));
+    if (!tc) return NET_TRANSPORT_ERR;
+    tc->fd = transport->socket_fd;
+    tc->phase_start = start;
+    tc->phase_ms = g_connect_ms;
+
+    if (ssl_init(&tc->ssl) != 0) {
+        free(tc);
+        return NET_TRANSPORT_ERR;
+    }
+    ssl_set_endpoint(&tc->ssl, SSL_IS_CLIENT);
+    ssl_set_rng(&tc->ssl, net_tls_random, &g_tls_rng);
+    ssl_set_bio(&tc->ssl, net_tls_bio_recv, tc, net_tls_bio_send, tc);
+    ssl_set_ciphersuites(&tc->ssl, ssl_list_ciphersuites());
+    ssl_set_authmode(&tc->ssl, insecure ? SSL_VERIFY_OPTIONAL : SSL_VERIFY_REQUIRED);
+
+    /* Shared state (RNG seed, CA chain, session cache) is set up and read
+       under the lock; the handshake itself runs unlocked. */
+    net_lock();
+    if (!g_tls_rng_ready) {
+        havege_init(&g_tls_rng);
+        g_tls_rng_ready = 1;
+    }
+    ssl_set_ca_chain(&tc->ssl, net_tls_ca_chain(tls_opts ? tls_opts->ca_bundle_path : NULL),
+                     NULL, server_name);
+    cached = net_tls_session_find(transport->host, transport->port);
+    if (cached) {
+        ssl_set_session(&tc->ssl, &cached->session);
+    }
+    net_unlock();
+
+    while ((ret = ssl_handshake(&tc->ssl)) != 0) {
+        if (ret != POLARSSL_ERR_NET_WANT_READ && ret != POLARSSL_ERR_NET_WANT_WRITE) {
+            net_thread_state_t *st = net_state();
+            if (st->last_failure != NET_FAIL_TIMEOUT && st->last_failure != NET_FAIL_CANCELLED) {
+                printf("ssl_handshake() failed: -0x%04x\n", -ret);
+                st->last_failure = NET_FAIL_TLS;
+            }
+            ssl_free(&tc->ssl);
+            free(tc);
+            return NET_TRANSPORT_ERR;
+        }
+    }
+
+    if (!insecure) {
+        int flags = ssl_get_verify_result(&tc->ssl);
+        if (flags != 0) {
+            printf("Certificate verification failed (flags=0x%08x)\n", flags);
+            ssl_close_notify(&tc->ssl);
+            ssl_free(&tc->ssl);
+            free(tc);
+            return net_fail(NET_FAIL_TLS);
+        }
+    }
+
+    /* Refresh the cache from every full or resumed handshake so the
+       entry carries the server's latest ticket/ID. */
+    net_lock();
+    net_tls_session_store(&tc->ssl, transport->host, transport->port);
+    net_unlock();
+
+    transport->tls_ctx = tc;
+    transport->use_tls = 1;
+    return 0;
+}
+
+static void net_tls_close(net_transport_t *transport)
+{
+    net_tls_conn_t *tc = (net_tls_conn_t*)transport->tls_ctx;
+    if (!tc) return;
+    /* Best effort: don't stall a close on a dead link. */
+    tc->phase_start = GetTickCount();
+    tc->phase_ms = NET_POLL_SLICE_MS;
+    ssl_close_notify(&tc->ssl);
+    ssl_free(&tc->ssl);
+    free(tc);
+    transport->tls_ctx = NULL;
+}
+
+void net_tls_session_flush(void)
+{
+    net_lock();
+    for (int i = 0; i < NET_TLS_SESSION_CACHE_SIZE; ++i) {
+        if (g_tls_sessions[i].valid) {
+            ssl_session_free(&g_tls_sessions[i].session);
+        }
+    }
+    memset(g_tls_sessions, 0, sizeof(g_tls_sessions));
+    net_unlock();
+}
+#else
+void net_tls_session_flush(void)
+{
+}
+#endif
+
+/* ------------------------------------------------------------------------
+ * Connections
+ * ------------------------------------------------------------------------ */
+
+/* Non-blocking connect bounded by the connect deadline from start. */
+static SOCKET tcp_connect_socket(const char *host, unsigned short port, DWORD start)
+{
+    u_long addr;
+    u_long nonblocking = 1;
+    stats_time_t t = stats_begin();
+    if (net_dns_resolve(host, &addr) != 0) return INVALID_SOCKET;
+    stats_end(STATS_DNS, t);
+    net_event(NET_EV_RESOLVED);
+    t = stats_begin();
 
     SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
     if (s == INVALID_SOCKET) {
+        net_fail(NET_FAIL_IO);
+        return INVALID_SOCKET;
+    }
+    if (ioctlsocket(s, FIONBIO, &nonblocking) != 0) {
+        closesocket(s);
+        net_fail(NET_FAIL_IO);
         return INVALID_SOCKET;
     }
 
@@ -26,13 +613,31 @@ static int tcp_connect_socket(const char *host, unsigned short port)
     memset(&server, 0, sizeof(server));
     server.sin_family = AF_INET;
     server.sin_port = htons(port);
-    server.sin_addr.s_addr = *((u_long*)he->h_addr);
+    server.sin_addr.s_addr = addr;
 
     if (connect(s, (struct sockaddr*)&server, sizeof(server)) != 0) {
-        closesocket(s);
-        return INVALID_SOCKET;
+        int err = 0;
+        int err_len = sizeof(err);
+
+        if (!net_would_block()) {
+            closesocket(s);
+            net_fail(NET_FAIL_CONNECT);
+            return INVALID_SOCKET;
+        }
+        if (net_wait(s, 1, start, g_connect_ms) != 0) {
+            closesocket(s);
+            return INVALID_SOCKET;
+        }
+        if (getsockopt(s, SOL_SOCKET, SO_ERROR, (char*)&err, (void*)&err_len) != 0 || err != 0) {
+            closesocket(s);
+            net_fail(NET_FAIL_CONNECT);
+            return INVALID_SOCKET;
+        }
     }
 
+    stats_end(STATS_CONNECT, t);
+    stats_add(STATS_CONNECTIONS, 1);
+    net_event(NET_EV_CONNECTED);
     return s;
 }
 
@@ -42,8 +647,14 @@ int net_transport_connect(net_transport_t *transport,
                           net_scheme_t scheme,
                           const net_tls_options_t *tls_opts)
 {
+    DWORD start = GetTickCount();
+
+    net_state()->last_failure = NET_FAIL_NONE;
     memset(transport, 0, sizeof(*transport));
-    transport->socket_fd = tcp_connect_socket(host, port);
+    strncpy(transport->host, host, sizeof(transport->host) - 1);
+    transport->port = port;
+    transport->scheme = scheme;
+    transport->socket_fd = tcp_connect_socket(host, port, start);
     if (transport->socket_fd == INVALID_SOCKET) {
         return NET_TRANSPORT_ERR;
     }
@@ -58,46 +669,334 @@ int net_transport_connect(net_transport_t *transport,
     printf("TLS requested, but this build has no PolarSSL/MbedTLS backend.\n");
     closesocket(transport->socket_fd);
     transport->socket_fd = INVALID_SOCKET;
-    return NET_TRANSPORT_ERR;
+    return net_fail(NET_FAIL_TLS);
 #else
-    /* Placeholder TLS backend hook:
-       For WinCE builds with PolarSSL/MbedTLS, initialize contexts here and set:
-       - verification REQUIRED by default
-       - verification OPTIONAL only when tls_opts && tls_opts->tls_insecure
-       - CA chain loading from tls_opts->ca_bundle_path
-       - hostname verification using tls_opts->server_name
-    */
-    (void)tls_opts;
-    transport->use_tls = 1;
-    return NET_TRANSPORT_ERR;
+    stats_time_t t = stats_begin();
+    if (net_tls_handshake(transport, tls_opts, start) != 0) {
+        closesocket(transport->socket_fd);
+        transport->socket_fd = INVALID_SOCKET;
+        return NET_TRANSPORT_ERR;
+    }
+    stats_end(STATS_TLS, t);
+    net_event(NET_EV_SECURED);
+    return 0;
 #endif
 }
 
 int net_transport_send(net_transport_t *transport, const void *data, int len)
 {
+    DWORD start = GetTickCount();
+
+    net_state()->last_failure = NET_FAIL_NONE;
+    transport->awaiting_reply = 1;
 #ifdef USE_POLARSSL
     if (transport->use_tls) {
-        return NET_TRANSPORT_ERR;
+        net_tls_conn_t *tc = (net_tls_conn_t*)transport->tls_ctx;
+        int ret;
+        tc->phase_start = start;
+        tc->phase_ms = g_idle_ms;
+        while ((ret = ssl_write(&tc->ssl, (const unsigned char*)data, (size_t)len)) < 0) {
+            if (ret != POLARSSL_ERR_NET_WANT_READ && ret != POLARSSL_ERR_NET_WANT_WRITE) {
+                if (net_state()->last_failure == NET_FAIL_NONE) net_fail(NET_FAIL_IO);
+                return NET_TRANSPORT_ERR;
+            }
+        }
+        return ret;
     }
 #endif
-    return send(transport->socket_fd, (const char*)data, len, 0);
+    return net_sock_send(transport->socket_fd, (const char*)data, len, start, g_idle_ms);
 }
 
-int net_transport_recv(net_transport_t *transport, void *buffer, int len)
+/* Books a finished read: waiting for a reply or streaming one. */
+static int net_recv_done(net_transport_t *transport, int ret, stats_time_t t)
+{
+    stats_end(transport->awaiting_reply ? STATS_WAIT : STATS_RECV, t);
+    if (ret > 0) {
+        stats_add(STATS_BYTES_RECEIVED, ret);
+        if (transport->awaiting_reply) {
+            transport->awaiting_reply = 0;
+            net_event(NET_EV_FIRST_BYTE);
+        }
+    }
+    return ret;
+}
+
+/* One read from the network. Waits at most the first-byte deadline for
+   the start of a reply, then the idle deadline between later reads. */
+static int net_read(net_transport_t *transport, void *buffer, int len)
 {
+    DWORD start = GetTickCount();
+    DWORD budget = transport->awaiting_reply ? g_first_byte_ms : g_idle_ms;
+    stats_time_t t = stats_begin();
+    int ret;
+
+    net_state()->last_failure = NET_FAIL_NONE;
 #ifdef USE_POLARSSL
     if (transport->use_tls) {
-        return NET_TRANSPORT_ERR;
+        net_tls_conn_t *tc = (net_tls_conn_t*)transport->tls_ctx;
+        tc->phase_start = start;
+        tc->phase_ms = budget;
+        while ((ret = ssl_read(&tc->ssl, (unsigned char*)buffer, (size_t)len)) < 0) {
+            if (ret == POLARSSL_ERR_SSL_PEER_CLOSE_NOTIFY) return 0;
+            if (ret != POLARSSL_ERR_NET_WANT_READ && ret != POLARSSL_ERR_NET_WANT_WRITE) {
+                if (net_state()->last_failure == NET_FAIL_NONE) net_fail(NET_FAIL_IO);
+                return NET_TRANSPORT_ERR;
+            }
+        }
+        return net_recv_done(transport, ret, t);
     }
 #endif
-    return recv(transport->socket_fd, (char*)buffer, len, 0);
+    ret = net_sock_recv(transport->socket_fd, (char*)buffer, len, start, budget);
+    return net_recv_done(transport, ret, t);
+}
+
+int net_transport_recv(net_transport_t *transport, void *buffer, int len)
+{
+    int n = transport->rx_tail - transport->rx_head;
+
+    if (n == 0) return net_read(transport, buffer, len);
+    if (n > len) n = len;
+    memcpy(buffer, transport->rx + transport->rx_head, n);
+    net_transport_consume(transport, n);
+    return n;
+}
+
+int net_transport_peek(net_transport_t *transport, const char **data)
+{
+    int n;
+
+    if (transport->rx_head == transport->rx_tail) {
+        if (!transport->rx) {
+            transport->rx = (char*)malloc(NET_RX_BUF);
+            if (!transport->rx) return net_fail(NET_FAIL_IO);
+        }
+        n = net_read(transport, transport->rx, NET_RX_BUF);
+        if (n <= 0) return n;
+        transport->rx_head = 0;
+        transport->rx_tail = n;
+    }
+    *data = transport->rx + transport->rx_head;
+    return transport->rx_tail - transport->rx_head;
+}
+
+void net_transport_consume(net_transport_t *transport, int len)
+{
+    transport->rx_head += len;
+    if (transport->rx_head >= transport->rx_tail) {
+        /* Drained: the next read starts at the front again. */
+        transport->rx_head = 0;
+        transport->rx_tail = 0;
+    }
+}
+
+static int net_send_all(net_transport_t *transport, const char *data, int len)
+{
+    while (len > 0) {
+        int sent = net_transport_send(transport, data, len);
+        if (sent <= 0) return NET_TRANSPORT_ERR;
+        data += sent;
+        len -= sent;
+    }
+    return 0;
+}
+
+int net_transport_sendv(net_transport_t *transport, const net_iovec_t *iov, int count)
+{
+    char segment[NET_SEND_GATHER];
+    int used = 0;
+
+    for (int i = 0; i < count; ++i) {
+        const char *p = (const char*)iov[i].data;
+        int len = iov[i].len;
+
+        while (len > 0) {
+            int n;
+            if (used == 0 && len >= (int)sizeof(segment)) {
+                /* Nothing to gather it with: send it where it lies. */
+                if (net_send_all(transport, p, len) != 0) return NET_TRANSPORT_ERR;
+                break;
+            }
+            n = (int)sizeof(segment) - used;
+            if (n > len) n = len;
+            memcpy(segment + used, p, n);
+            used += n;
+            p += n;
+            len -= n;
+            if (used == (int)sizeof(segment)) {
+                if (net_send_all(transport, segment, used) != 0) return NET_TRANSPORT_ERR;
+                used = 0;
+            }
+        }
+    }
+    return used ? net_send_all(transport, segment, used) : 0;
 }
 
 void net_transport_close(net_transport_t *transport)
 {
     if (!transport) return;
+#ifdef USE_POLARSSL
+    if (transport->use_tls) {
+        net_tls_close(transport);
+        transport->use_tls = 0;
+    }
+#endif
     if (transport->socket_fd != INVALID_SOCKET) {
         closesocket(transport->socket_fd);
         transport->socket_fd = INVALID_SOCKET;
     }
+    free(transport->rx);
+    transport->rx = NULL;
+    transport->rx_head = 0;
+    transport->rx_tail = 0;
+}
+
+/* ------------------------------------------------------------------------
+ * Keep-alive pool
+ * ------------------------------------------------------------------------ */
+
+typedef struct {
+    int used;
+    DWORD idle_since;
+    net_transport_t conn;
+} net_pool_slot_t;
+
+static net_pool_slot_t g_pool[NET_POOL_MAX_SLOTS];
+static int g_pool_max = NET_POOL_DEFAULT_SOCKETS;
+static DWORD g_pool_idle_ms = NET_POOL_DEFAULT_IDLE_MS;
+
+/* An idle keep-alive socket must have nothing to read: readable means the
+   server closed it (EOF/RST) or sent bytes we never asked for. */
+static int net_pool_is_alive(const net_transport_t *conn)
+{
+    fd_set rd;
+    struct timeval tv;
+
+    FD_ZERO(&rd);
+    FD_SET(conn->socket_fd, &rd);
+    tv.tv_sec = 0;
+    tv.tv_usec = 0;
+    return select((int)conn->socket_fd + 1, &rd, NULL, NULL, &tv) == 0;
+}
+
+static void net_pool_drop(net_pool_slot_t *slot)
+{
+    net_transport_close(&slot->conn);
+    slot->used = 0;
+}
+
+static void net_pool_expire(DWORD now)
+{
+    for (int i = 0; i < NET_POOL_MAX_SLOTS; ++i) {
+        if (g_pool[i].used && now - g_pool[i].idle_since > g_pool_idle_ms) {
+            net_pool_drop(&g_pool[i]);
+        }
+    }
+}
+
+int net_transport_acquire(net_transport_t *transport,
+                          const char *host,
+                          unsigned short port,
+                          net_scheme_t scheme,
+                          const net_tls_options_t *tls_opts,
+                          int *reused)
+{
+    net_lock();
+    net_pool_expire(GetTickCount());
+
+    for (int i = 0; i < NET_POOL_MAX_SLOTS; ++i) {
+        net_pool_slot_t *slot = &g_pool[i];
+        if (!slot->used || slot->conn.port != port || slot->conn.scheme != scheme ||
+            strcmp(slot->conn.host, host) != 0) {
+            continue;
+        }
+        if (!net_pool_is_alive(&slot->conn)) {
+            net_pool_drop(slot);
+            continue;
+        }
+        *transport = slot->conn;
+        slot->used = 0;
+        net_unlock();
+        if (reused) *reused = 1;
+        stats_add(STATS_REUSED, 1);
+        net_event(NET_EV_REUSED);
+        return 0;
+    }
+    net_unlock();
+
+    if (reused) *reused = 0;
+    return net_transport_connect(transport, host, port, scheme, tls_opts);
+}
+
+void net_transport_release(net_transport_t *transport, int reusable)
+{
+    net_pool_slot_t *slot = NULL;
+    DWORD now = GetTickCount();
+    int in_pool = 0;
+
+    if (!transport || transport->socket_fd == INVALID_SOCKET) return;
+    /* Bytes past the end of the reply would be read as the next one. */
+    if (!reusable || g_pool_max <= 0 || transport->rx_head != transport->rx_tail) {
+        net_transport_close(transport);
+        return;
+    }
+
+    net_lock();
+    net_pool_expire(now);
+    for (int i = 0; i < NET_POOL_MAX_SLOTS; ++i) {
+        if (g_pool[i].used) {
+            in_pool++;
+        } else if (!slot) {
+            slot = &g_pool[i];
+        }
+    }
+
+    /* At the socket cap: evict the connection that has been idle longest. */
+    if (in_pool >= g_pool_max || !slot) {
+        net_pool_slot_t *oldest = NULL;
+        for (int i = 0; i < NET_POOL_MAX_SLOTS; ++i) {
+            if (g_pool[i].used &&
+                (!oldest || now - g_pool[i].idle_since > now - oldest->idle_since)) {
+                oldest = &g_pool[i];
+            }
+        }
+        if (oldest) {
+            net_pool_drop(oldest);
+            slot = oldest;
+        }
+    }
+
+    slot->conn = *transport;
+    slot->idle_since = now;
+    slot->used = 1;
+    net_unlock();
+    /* The slot owns the socket, buffer and TLS state now: a later close
+       of this struct must not free them under it. */
+    transport->socket_fd = INVALID_SOCKET;
+    transport->rx = NULL;
+    transport->use_tls = 0;
+#ifdef USE_POLARSSL
+    transport->tls_ctx = NULL;
+#endif
+}
+
+void net_transport_pool_config(int max_sockets, unsigned long idle_timeout_ms)
+{
+    if (max_sockets < 0) max_sockets = 0;
+    if (max_sockets > NET_POOL_MAX_SLOTS) max_sockets = NET_POOL_MAX_SLOTS;
+    net_lock();
+    g_pool_max = max_sockets;
+    g_pool_idle_ms = (DWORD)idle_timeout_ms;
+    net_unlock();
+    net_transport_pool_flush();
+}
+
+void net_transport_pool_flush(void)
+{
+    net_lock();
+    for (int i = 0; i < NET_POOL_MAX_SLOTS; ++i) {
+        if (g_pool[i].used) {
+            net_pool_drop(&g_pool[i]);
+        }
+    }
+    net_unlock();
 }
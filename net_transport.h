@@ -5,6 +5,29 @@
 
 #define NET_TRANSPORT_ERR -1
 
+/* Idle keep-alive pool limits. NET_POOL_MAX_SLOTS is the compile-time
+   ceiling; the runtime cap can be lowered with net_transport_pool_config. */
+#define NET_POOL_MAX_SLOTS        8
+#define NET_POOL_DEFAULT_SOCKETS  4
+#define NET_POOL_DEFAULT_IDLE_MS  15000UL
+
+/* Resolver cache: gethostbyname gives no TTL, so entries live for a
+   configurable time. Failed lookups are cached too, for a shorter time. */
+#define NET_DNS_CACHE_SIZE        16
+#define NET_DNS_DEFAULT_TTL_MS    300000UL
+#define NET_DNS_NEGATIVE_TTL_MS   30000UL
+
+/* Per-phase deadlines (0 = wait forever). Sockets are non-blocking and
+   every wait is a select() in NET_POLL_SLICE_MS steps so the cancel hook
+   is checked a few times a second. */
+#define NET_DEFAULT_CONNECT_MS    15000UL   /* TCP connect + TLS handshake */
+#define NET_DEFAULT_FIRST_BYTE_MS 30000UL   /* request sent -> first byte back */
+#define NET_DEFAULT_IDLE_MS       20000UL   /* silence in the middle of a body */
+#define NET_POLL_SLICE_MS         100
+
+/* Saved TLS sessions (USE_POLARSSL builds) for abbreviated handshakes. */
+#define NET_TLS_SESSION_CACHE_SIZE 4
+
 typedef enum {
     NET_SCHEME_HTTP = 0,
     NET_SCHEME_HTTPS = 1
@@ -16,13 +39,57 @@ typedef struct {
     const char *server_name;
 } net_tls_options_t;
 
+typedef enum {
+    NET_FAIL_NONE = 0,
+    NET_FAIL_DNS,
+    NET_FAIL_CONNECT,
+    NET_FAIL_TLS,
+    NET_FAIL_TIMEOUT,
+    NET_FAIL_CANCELLED,
+    NET_FAIL_IO
+} net_fail_t;
+
+/* Polled while waiting on the network; return nonzero to abort. */
+typedef int (*net_cancel_fn)(void *user);
+
+/* Milestones of a fetch, for timing where it spends its time. */
+typedef enum {
+    NET_EV_RESOLVED = 0,   /* host address known (cache hit or lookup) */
+    NET_EV_CONNECTED,      /* TCP connection established */
+    NET_EV_SECURED,        /* TLS handshake finished */
+    NET_EV_REUSED,         /* idle pooled connection taken instead */
+    NET_EV_FIRST_BYTE      /* first byte of a reply received */
+} net_event_t;
+
+typedef void (*net_event_fn)(void *user, net_event_t ev);
+
+/* Receive buffer per connection, allocated on the first peek. */
+#define NET_RX_BUF 4096
+
+/* Requests smaller than this go out as one send; see net_transport_sendv. */
+#define NET_SEND_GATHER 1460
+
+typedef struct {
+    const void *data;
+    int len;
+} net_iovec_t;
+
 typedef struct {
     SOCKET socket_fd;
     int use_tls;
+    int awaiting_reply;   /* sent a request, no byte back yet */
+
+    char *rx;             /* received bytes not yet consumed: rx[rx_head, rx_tail) */
+    int rx_head;
+    int rx_tail;
+
+    /* Pool key: where this connection goes. */
+    char host[256];
+    unsigned short port;
+    net_scheme_t scheme;
 
 #ifdef USE_POLARSSL
-    void *tls_ctx;
-    void *tls_ssl;
+    void *tls_ctx;        /* net_tls_conn_t, owned by whoever holds the socket */
 #endif
 } net_transport_t;
 
@@ -33,7 +100,79 @@ int net_transport_connect(net_transport_t *transport,
                           const net_tls_options_t *tls_opts);
 
 int net_transport_send(net_transport_t *transport, const void *data, int len);
+/* Copies out buffered bytes first; otherwise reads straight into buffer. */
 int net_transport_recv(net_transport_t *transport, void *buffer, int len);
 void net_transport_close(net_transport_t *transport);
 
+/*
+ * Zero-copy receive. peek points *data at the received bytes not yet
+ * consumed, one contiguous run in the connection's own buffer, and reads
+ * from the network only when there are none. It returns the run length,
+ * 0 at end of stream or NET_TRANSPORT_ERR. The bytes stay valid and in
+ * place until consume, which may take fewer than were peeked; the buffer
+ * is only refilled once it has been drained, so a run never wraps.
+ */
+int net_transport_peek(net_transport_t *transport, const char **data);
+void net_transport_consume(net_transport_t *transport, int len);
+
+/*
+ * Sends count buffers back to back. Pieces are gathered into one
+ * NET_SEND_GATHER segment (so a request head and a small body leave in a
+ * single packet); whatever of a large piece does not fit is sent from
+ * where it lies, without being copied. Returns 0 once everything is sent.
+ */
+int net_transport_sendv(net_transport_t *transport, const net_iovec_t *iov, int count);
+
+void net_transport_timeouts(unsigned long connect_ms,
+                            unsigned long first_byte_ms,
+                            unsigned long idle_ms);
+void net_transport_set_cancel(net_cancel_fn fn, void *user);
+
+/* Called at each milestone on this thread; NULL turns it off. */
+void net_transport_set_events(net_event_fn fn, void *user);
+
+/*
+ * Threads. Until net_transport_enable_threads is called (once, from the
+ * main thread, before starting others) nothing is locked. After it, the
+ * DNS cache, keep-alive pool and TLS session cache are shared under one
+ * lock, and the cancel/event hooks and last failure are per thread. Each worker
+ * thread calls net_transport_thread_exit before it returns.
+ */
+void net_transport_enable_threads(void);
+void net_transport_thread_exit(void);
+
+/* Reason for the most recent NET_TRANSPORT_ERR on this thread, and a
+   short description. */
+net_fail_t net_transport_last_failure(void);
+const char *net_transport_failure_text(net_fail_t why);
+
+/*
+ * Keep-alive pool. acquire hands back an idle connection to the same
+ * scheme/host/port when one passes a health check (sets *reused = 1),
+ * otherwise connects fresh. release parks the connection for reuse when
+ * reusable is nonzero and nothing unread is left in its buffer, and
+ * closes it otherwise; either way the caller's transport no longer owns a
+ * socket afterwards.
+ */
+int net_transport_acquire(net_transport_t *transport,
+                          const char *host,
+                          unsigned short port,
+                          net_scheme_t scheme,
+                          const net_tls_options_t *tls_opts,
+                          int *reused);
+void net_transport_release(net_transport_t *transport, int reusable);
+void net_transport_pool_config(int max_sockets, unsigned long idle_timeout_ms);
+void net_transport_pool_flush(void);
+
+/* Returns 0 and fills *addr (network order) on success, NET_TRANSPORT_ERR
+   if the host does not resolve or the thread's cancel hook fires (see
+   net_transport_last_failure). Served from the cache when fresh. */
+int net_dns_resolve(const char *host, u_long *addr);
+void net_dns_config(unsigned long ttl_ms, unsigned long negative_ttl_ms);
+void net_dns_flush(void);
+void net_dns_print(void);
+
+/* Forget saved TLS sessions; next connections do a full handshake. */
+void net_tls_session_flush(void);
+
 #endif
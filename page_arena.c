@@ -0,0 +1,115 @@
+#include "page_arena.h"
+#include "stats.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* A reset keeps at most this much so one huge page does not pin memory. */
+#define PAGE_ARENA_KEEP_BYTES (4L * PAGE_ARENA_CHUNK)
+
+void page_arena_init(page_arena_t *a, long limit)
+{
+    memset(a, 0, sizeof(*a));
+    a->limit = limit > 0 ? limit : PAGE_ARENA_MAX_BYTES;
+}
+
+void page_arena_free(page_arena_t *a)
+{
+    free(a->data);
+    a->data = NULL;
+    a->len = 0;
+    a->cap = 0;
+    a->dropped = 0;
+}
+
+void page_arena_reset(page_arena_t *a)
+{
+    if (a->cap > PAGE_ARENA_KEEP_BYTES) {
+        free(a->data);
+        a->data = NULL;
+        a->cap = 0;
+    }
+    a->len = 0;
+    a->dropped = 0;
+}
+
+void page_arena_trim(page_arena_t *a)
+{
+    char *p;
+
+    if (!a->data || a->cap <= a->len + 1) return;
+    p = (char*)realloc(a->data, a->len + 1);
+    if (p) {
+        a->data = p;
+        a->cap = a->len + 1;
+    }
+}
+
+int page_arena_reserve(page_arena_t *a, long extra)
+{
+    long need = a->len + extra + 1;     /* +1 for page_arena_cstr */
+    long cap;
+    char *p;
+
+    if (need <= a->cap) return 0;
+
+    cap = a->cap ? a->cap : PAGE_ARENA_CHUNK;
+    while (cap < need) {
+        /* Chunk steps for small pages, doubling past 4 chunks. */
+        cap += (cap < PAGE_ARENA_KEEP_BYTES) ? PAGE_ARENA_CHUNK : cap;
+    }
+    if (cap > a->limit + 1) cap = a->limit + 1;
+    if (cap < need) return -1;
+
+    p = (char*)realloc(a->data, cap);
+    if (!p) return -1;
+    a->data = p;
+    a->cap = cap;
+    stats_peak(STATS_PEAK_BUFFER, cap);
+    return 0;
+}
+
+int page_arena_append(page_arena_t *a, const char *data, int len)
+{
+    long room;
+    int n = len;
+
+    if (len <= 0) return 0;
+    if (a->len + n > a->limit) n = (int)(a->limit - a->len);
+    if (n > 0 && page_arena_reserve(a, n) != 0) {
+        /* Could not grow by n; take whatever already fits. */
+        room = a->cap - a->len - 1;
+        n = room > 0 ? (int)(room < n ? room : n) : 0;
+    }
+    if (n > 0) {
+        memcpy(a->data + a->len, data, n);
+        a->len += n;
+    }
+    a->dropped += len - n;
+    return n;
+}
+
+char *page_arena_cstr(page_arena_t *a)
+{
+    if (!a->data && page_arena_reserve(a, 0) != 0) return (char*)"";
+    a->data[a->len] = '\0';
+    return a->data;
+}
+
+void page_arena_copy(const page_arena_t *a, page_span_t span, char *out, int out_size)
+{
+    int n = span.len;
+
+    if (out_size <= 0) return;
+    if (span.off < 0 || span.off > a->len) n = 0;
+    else if (span.off + n > a->len) n = (int)(a->len - span.off);
+    if (n > out_size - 1) n = out_size - 1;
+    if (n > 0) memcpy(out, a->data + span.off, n);
+    out[n > 0 ? n : 0] = '\0';
+}
+
+int page_arena_sink(void *user, const char *data, int len)
+{
+    page_arena_append((page_arena_t*)user, data, len);
+    return 0;
+}
@@ -0,0 +1,64 @@
+#ifndef PAGE_ARENA_H
+#define PAGE_ARENA_H
+
+/*
+ * Per-page body buffer.
+ *
+ * The response body is appended once, as it arrives, into a single block
+ * that grows in PAGE_ARENA_CHUNK steps (doubling once it is large, so big
+ * pages cost a handful of reallocs rather than one per chunk). Everything
+ * downstream -- link/form extraction, rendering -- reads the same bytes
+ * and refers to pieces of them by page_span_t offsets, so no second copy
+ * of the page is ever made. Offsets stay valid across growth; pointers
+ * from page_arena_at do not.
+ *
+ * The block is kept between pages (reset just rewinds it) and only given
+ * back to the heap when a page left it much larger than the chunk size.
+ */
+
+#define PAGE_ARENA_CHUNK     16384
+#define PAGE_ARENA_MAX_BYTES (4L * 1024 * 1024)
+
+typedef struct {
+    long off;
+    int  len;
+} page_span_t;
+
+typedef struct {
+    char *data;
+    long  len;
+    long  cap;
+    long  limit;      /* body bytes accepted before the rest is dropped */
+    long  dropped;    /* bytes refused by the limit or a failed grow */
+} page_arena_t;
+
+void page_arena_init(page_arena_t *a, long limit);
+void page_arena_free(page_arena_t *a);
+
+/* Empties the arena for a new page, releasing an oversized block. */
+void page_arena_reset(page_arena_t *a);
+
+/* Shrinks the block to the contents, for a page that is being kept. */
+void page_arena_trim(page_arena_t *a);
+
+/* Makes room for at least extra more bytes. Returns 0 on success. */
+int page_arena_reserve(page_arena_t *a, long extra);
+
+/* Appends len bytes, counting anything that does not fit in dropped.
+   Returns the number of bytes stored. */
+int page_arena_append(page_arena_t *a, const char *data, int len);
+
+/* NUL-terminates the contents (not counted in len) so C string helpers
+   can run over the page. Returns the start of the data. */
+char *page_arena_cstr(page_arena_t *a);
+
+/* Pointer to byte off. Invalidated by the next append/reserve. */
+#define page_arena_at(a, off) ((a)->data + (off))
+
+/* Copies a span out as a NUL-terminated string, clipped to out_size. */
+void page_arena_copy(const page_arena_t *a, page_span_t span, char *out, int out_size);
+
+/* http_body_fn-compatible sink: user is the page_arena_t. */
+int page_arena_sink(void *user, const char *data, int len);
+
+#endif
@@ -0,0 +1,176 @@
+#include "page_history.h"
+
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    char url[512];
+    int post;
+    int cached;
+    unsigned long last_used;   /* LRU stamp, from g_clock */
+    long bytes;                /* charged against g_budget while cached */
+    page_view_t view;
+} page_history_entry_t;
+
+static page_history_entry_t g_entries[PAGE_HISTORY_MAX];
+static int g_count = 0;
+static int g_pos = -1;          /* current entry, -1 before the first page */
+static long g_budget = PAGE_HISTORY_DEFAULT_BUDGET;
+static long g_bytes = 0;
+static unsigned long g_clock = 0;
+
+static long page_history_cost(const page_view_t *v)
+{
+    return (long)sizeof(*v) + v->page.cap + v->doc.bytes + v->text.cap;
+}
+
+static void page_history_drop(page_history_entry_t *e)
+{
+    if (!e->cached) return;
+    page_arena_free(&e->view.page);
+    html_doc_free(&e->view.doc);
+    page_arena_free(&e->view.text);
+    g_bytes -= e->bytes;
+    e->bytes = 0;
+    e->cached = 0;
+}
+
+/* Evicts least recently shown entries until `extra` more bytes fit. */
+static void page_history_evict(long extra)
+{
+    while (g_bytes + extra > g_budget) {
+        page_history_entry_t *lru = NULL;
+        for (int i = 0; i < g_count; ++i) {
+            page_history_entry_t *e = &g_entries[i];
+            if (e->cached && (!lru || e->last_used < lru->last_used)) lru = e;
+        }
+        if (!lru) break;
+        page_history_drop(lru);
+    }
+}
+
+void page_history_init(long budget_bytes)
+{
+    page_history_free();
+    g_budget = budget_bytes > 0 ? budget_bytes : 0;
+}
+
+void page_history_free(void)
+{
+    for (int i = 0; i < g_count; ++i) {
+        page_history_drop(&g_entries[i]);
+    }
+    g_count = 0;
+    g_pos = -1;
+    g_bytes = 0;
+}
+
+void page_history_push(const char *url, int post)
+{
+    page_history_entry_t *e;
+
+    /* A new page cuts off the forward history. */
+    for (int i = g_pos + 1; i < g_count; ++i) {
+        page_history_drop(&g_entries[i]);
+    }
+    g_count = g_pos + 1;
+
+    if (g_count == PAGE_HISTORY_MAX) {
+        page_history_drop(&g_entries[0]);
+        memmove(&g_entries[0], &g_entries[1], (PAGE_HISTORY_MAX - 1) * sizeof(g_entries[0]));
+        g_count--;
+    }
+
+    e = &g_entries[g_count];
+    memset(e, 0, sizeof(*e));
+    strncpy(e->url, url, sizeof(e->url) - 1);
+    e->post = post;
+    g_pos = g_count++;
+}
+
+void page_history_stash(page_view_t *view)
+{
+    page_history_entry_t *e;
+    long cost;
+
+    if (g_pos < 0 || view->page.len == 0) goto reset;
+    e = &g_entries[g_pos];
+    page_history_drop(e);
+
+    page_arena_trim(&view->page);
+    page_arena_trim(&view->text);
+    cost = page_history_cost(view);
+    if (cost > g_budget) goto reset;
+    page_history_evict(cost);
+
+    e->view = *view;
+    e->cached = 1;
+    e->bytes = cost;
+    e->last_used = ++g_clock;
+    g_bytes += cost;
+
+    page_arena_init(&view->page, e->view.page.limit);
+    html_doc_init(&view->doc);
+    page_arena_init(&view->text, e->view.text.limit);
+    view->rendered = 0;
+    return;
+
+reset:
+    html_doc_reset(&view->doc);
+    page_arena_reset(&view->page);
+    page_arena_reset(&view->text);
+    view->rendered = 0;
+}
+
+const char *page_history_go(int delta, page_view_t *view, int *cached)
+{
+    int step = delta < 0 ? -1 : 1;
+    int pos = g_pos;
+    page_history_entry_t *e;
+    page_view_t restored;
+
+    *cached = 0;
+    if (g_pos < 0) return NULL;
+    for (int n = delta < 0 ? -delta : delta; n > 0; --n) {
+        pos += step;
+        /* Form results are only shown again from the cache. */
+        while (pos >= 0 && pos < g_count && g_entries[pos].post && !g_entries[pos].cached) {
+            pos += step;
+        }
+        if (pos < 0 || pos >= g_count) return NULL;
+    }
+
+    /* Take the target out first so stashing the page being left cannot
+       evict it. */
+    e = &g_entries[pos];
+    if (e->cached) {
+        restored = e->view;
+        g_bytes -= e->bytes;
+        e->bytes = 0;
+        e->cached = 0;
+        *cached = 1;
+    }
+    page_history_stash(view);
+    g_pos = pos;
+
+    if (*cached) {
+        long limit = view->page.limit;
+        page_arena_free(&view->page);
+        html_doc_free(&view->doc);
+        page_arena_free(&view->text);
+        *view = restored;
+        view->page.limit = limit;
+    }
+    return e->url;
+}
+
+void page_history_print(void)
+{
+    printf("History: %d page(s), %ld of %ld KB cached\n",
+           g_count, g_bytes / 1024, g_budget / 1024);
+    for (int i = 0; i < g_count; ++i) {
+        const page_history_entry_t *e = &g_entries[i];
+        printf("%s %2d %-6s %s%s\n", i == g_pos ? ">" : " ", i + 1,
+               e->cached ? "cached" : "", e->url, e->post ? " (form result)" : "");
+    }
+}
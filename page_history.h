@@ -0,0 +1,60 @@
+#ifndef PAGE_HISTORY_H
+#define PAGE_HISTORY_H
+
+#include "charset.h"
+#include "page_arena.h"
+#include "html_doc.h"
+
+/*
+ * Back/forward history with an in-memory cache of recent pages.
+ *
+ * The history is a stack of URLs with a current position; visiting a new
+ * page drops everything forward of it. When the user leaves a page its
+ * state -- body, parsed document and rendered text -- is moved (not
+ * copied) into the entry with page_history_stash, and moved back out by
+ * page_history_go, so returning to it needs no fetch, parse or render.
+ * Cached entries share one byte budget; the least recently shown ones
+ * lose their state first but keep their place in the history and are
+ * refetched if revisited.
+ */
+
+#define PAGE_HISTORY_MAX            32
+#define PAGE_HISTORY_DEFAULT_BUDGET (1024L * 1024)
+
+/* One page's state. doc spans point into page. */
+typedef struct {
+    page_arena_t page;
+    html_doc_t   doc;
+    page_arena_t text;     /* rendered output, ready to print */
+    long rendered;         /* body bytes rendered into text so far */
+    charset_conv_t conv;   /* body charset -> display charset, mid-render */
+} page_view_t;
+
+/* budget_bytes 0 keeps URLs only (nothing is cached). */
+void page_history_init(long budget_bytes);
+void page_history_free(void);
+
+/* Records url as the current page. post marks a form submission, which
+   is never silently resent. */
+void page_history_push(const char *url, int post);
+
+/*
+ * Moves the current page's state into its history entry and leaves view
+ * empty (same limits) for the next page. Pages too big for the budget, or
+ * empty ones, are simply reset.
+ */
+void page_history_stash(page_view_t *view);
+
+/*
+ * Steps delta entries back (<0) or forward (>0), skipping form results
+ * that are no longer cached. Returns the URL of the new current entry, or
+ * NULL (view untouched) if there is none that way. The page being left is
+ * stashed first. If the new entry's state was cached it is moved into
+ * view and *cached is set; otherwise view is empty and the caller
+ * refetches the URL.
+ */
+const char *page_history_go(int delta, page_view_t *view, int *cached);
+
+void page_history_print(void);
+
+#endif
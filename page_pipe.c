@@ -0,0 +1,129 @@
+#include "page_pipe.h"
+#include "stats.h"
+#include "sys_thread.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    int len;
+    char data[PAGE_PIPE_BUF];
+} page_pipe_slot_t;
+
+typedef struct {
+    page_pipe_slot_t slots[PAGE_PIPE_SLOTS];
+    volatile sys_atomic_t head;   /* buffers filled; only the network thread writes it */
+    volatile sys_atomic_t tail;   /* buffers consumed; only the parser writes it */
+    volatile sys_atomic_t done;   /* fetch returned; result and failure are set */
+
+    page_pipe_fetch_fn fetch;
+    void *arg;
+    int result;
+    net_fail_t failure;
+} page_pipe_t;
+
+/* Body sink on the network thread: one buffer per read, waiting for a
+   free one when the parser is PAGE_PIPE_SLOTS behind. */
+static int page_pipe_push(void *user, const char *data, int len)
+{
+    page_pipe_t *pipe = (page_pipe_t*)user;
+
+    while (len > 0) {
+        long head = pipe->head;
+        page_pipe_slot_t *slot;
+        int n = len < PAGE_PIPE_BUF ? len : PAGE_PIPE_BUF;
+
+        while (head - sys_atomic_load(&pipe->tail) == PAGE_PIPE_SLOTS) {
+            sys_sleep_ms(1);
+        }
+        slot = &pipe->slots[head % PAGE_PIPE_SLOTS];
+        memcpy(slot->data, data, n);
+        slot->len = n;
+        sys_atomic_store(&pipe->head, head + 1);
+        data += n;
+        len -= n;
+    }
+    return 0;
+}
+
+static void page_pipe_network(void *arg)
+{
+    page_pipe_t *pipe = (page_pipe_t*)arg;
+
+    pipe->result = pipe->fetch(pipe->arg, page_pipe_push, pipe);
+    pipe->failure = net_transport_last_failure();
+    sys_atomic_store(&pipe->done, 1);
+    net_transport_thread_exit();
+}
+
+/* No thread: the fetch's sink hands bytes straight to the parser. */
+typedef struct {
+    page_pipe_chunk_fn on_chunk;
+    void *user;
+} page_pipe_direct_t;
+
+static int page_pipe_direct(void *user, const char *data, int len)
+{
+    page_pipe_direct_t *d = (page_pipe_direct_t*)user;
+    d->on_chunk(d->user, data, len);
+    return 0;
+}
+
+int page_pipe_run(page_pipe_fetch_fn fetch, void *arg,
+                  page_pipe_chunk_fn on_chunk, void *user, net_fail_t *failure)
+{
+    /* Off the stack: the ring is PAGE_PIPE_SLOTS * PAGE_PIPE_BUF bytes. */
+    page_pipe_t *pipe = (page_pipe_t*)malloc(sizeof(*pipe));
+    sys_thread_t thread;
+    stats_time_t idle = 0;
+    long tail = 0;
+    int result;
+
+    if (pipe) {
+        pipe->fetch = fetch;
+        pipe->arg = arg;
+        pipe->head = 0;
+        pipe->tail = 0;
+        pipe->done = 0;
+        if (sys_thread_start(&thread, page_pipe_network, pipe, 0) != 0) {
+            free(pipe);
+            pipe = NULL;
+        }
+    }
+    if (!pipe) {
+        page_pipe_direct_t d;
+        d.on_chunk = on_chunk;
+        d.user = user;
+        result = fetch(arg, page_pipe_direct, &d);
+        *failure = net_transport_last_failure();
+        return result;
+    }
+
+    for (;;) {
+        page_pipe_slot_t *slot;
+
+        if (tail == sys_atomic_load(&pipe->head)) {
+            /* done is stored after the last head, so one more look at
+               head after seeing it set finds every buffer. */
+            if (sys_atomic_load(&pipe->done) && tail == sys_atomic_load(&pipe->head)) break;
+            if (!idle) idle = stats_begin();
+            sys_sleep_ms(1);
+            continue;
+        }
+        if (idle) {
+            stats_end(STATS_WAIT, idle);
+            idle = 0;
+        }
+        slot = &pipe->slots[tail % PAGE_PIPE_SLOTS];
+        stats_add(STATS_BYTES_RECEIVED, slot->len);
+        on_chunk(user, slot->data, slot->len);
+        sys_atomic_store(&pipe->tail, ++tail);
+    }
+    if (idle) stats_end(STATS_WAIT, idle);
+
+    sys_thread_join(&thread);
+    result = pipe->result;
+    *failure = pipe->failure;
+    free(pipe);
+    return result;
+}
@@ -0,0 +1,44 @@
+#ifndef PAGE_PIPE_H
+#define PAGE_PIPE_H
+
+#include "http_client.h"
+
+/*
+ * Receive/parse pipeline for one page load.
+ *
+ * The fetch runs on a network thread. Its body sink copies each read into
+ * the next free buffer of a ring of PAGE_PIPE_SLOTS, and the calling
+ * thread takes filled buffers out in order and parses or renders them
+ * while later bytes are still on the wire. One thread only ever advances
+ * the ring's head and the other only its tail, so the data path needs no
+ * lock: each side publishes its index with a release store and reads the
+ * other's with an acquire load. A side that finds the ring full (network
+ * ahead of the parser) or empty (parser ahead of the network) sleeps a
+ * millisecond and looks again. Memory is bounded at PAGE_PIPE_SLOTS *
+ * PAGE_PIPE_BUF whatever the page size.
+ *
+ * net_transport_enable_threads must have been called. The network thread
+ * has its own net_transport state: its cancel hook is whatever fetch
+ * sets, and its last failure is handed back through page_pipe_run.
+ */
+
+#define PAGE_PIPE_SLOTS 8
+#define PAGE_PIPE_BUF   4096
+
+/* Runs on the network thread: performs the request and pushes the body
+   through sink(sink_user, ...). Its return value is page_pipe_run's. */
+typedef int (*page_pipe_fetch_fn)(void *arg, http_body_fn sink, void *sink_user);
+
+/* Runs on the calling thread, once per buffer, in body order. */
+typedef void (*page_pipe_chunk_fn)(void *user, const char *data, int len);
+
+/*
+ * Runs fetch(arg, ...) on a network thread, feeding on_chunk(user, ...)
+ * as the body arrives, and returns once both are done. *failure gets
+ * net_transport_last_failure() as the network thread saw it. Without a
+ * thread the fetch runs here and on_chunk is called from its sink.
+ */
+int page_pipe_run(page_pipe_fetch_fn fetch, void *arg,
+                  page_pipe_chunk_fn on_chunk, void *user, net_fail_t *failure);
+
+#endif
@@ -0,0 +1,217 @@
+#include "pager.h"
+#include "stats.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void pager_init(pager_t *p, int rows, int cols)
+{
+    memset(p, 0, sizeof(*p));
+    p->rows = rows > 0 ? rows : 0;
+    p->cols = cols > 0 ? cols : 0;
+    p->out = stdout;
+    p->charset = CHARSET_UTF8;
+}
+
+void pager_free(pager_t *p)
+{
+    free(p->lines);
+    p->lines = NULL;
+    p->num_lines = 0;
+    p->cap_lines = 0;
+}
+
+static int pager_add_line(pager_t *p, long off)
+{
+    if (p->num_lines == p->cap_lines) {
+        int cap = p->cap_lines ? p->cap_lines * 2 : 256;
+        long *lines = (long*)realloc(p->lines, cap * sizeof(long));
+        if (!lines) return -1;
+        p->lines = lines;
+        p->cap_lines = cap;
+    }
+    p->lines[p->num_lines++] = off;
+    return 0;
+}
+
+void pager_open(pager_t *p, const page_arena_t *text, pager_fill_fn fill, void *user)
+{
+    p->text = text;
+    p->fill = fill;
+    p->fill_user = user;
+    p->num_lines = 0;
+    p->scanned = 0;
+    p->col = 0;
+    p->complete = 0;
+    p->top = 0;
+    pager_add_line(p, 0);
+}
+
+/* Columns taken by the character starting at s[0], at most len bytes
+   long. Bytes it has past s[0] that take no column of their own are
+   added to *skip (Shift_JIS and EUC-JP trail bytes; UTF-8 continuation bytes are
+   skipped as they come). */
+static int pager_width(const pager_t *p, const unsigned char *s, long len, long *skip)
+{
+    unsigned char c = s[0];
+
+    if (p->charset == CHARSET_SHIFT_JIS) {
+        if (((c >= 0x81 && c <= 0x9F) || (c >= 0xE0 && c <= 0xFC)) && len > 1) {
+            (*skip)++;
+            return 2;
+        }
+    } else if (p->charset == CHARSET_EUC_JP) {
+        /* 0x8E: half-width kana; 0x8F: three-byte JIS X 0212. */
+        if (c == 0x8E && len > 1) {
+            (*skip)++;
+            return 1;
+        }
+        if (c == 0x8F && len > 2) {
+            *skip += 2;
+            return 2;
+        }
+        if (c >= 0xA1 && c <= 0xFE && len > 1) {
+            (*skip)++;
+            return 2;
+        }
+    } else if (p->charset == CHARSET_UTF8) {
+        /* U+3000-U+D7FF: CJK, kana, Hangul; U+FF01-U+FF60: full-width forms. */
+        if (c >= 0xE3 && c <= 0xED) return 2;
+        if (c == 0xEF && len > 2 && (s[1] == 0xBC || (s[1] == 0xBD && s[2] <= 0xA0))) return 2;
+    }
+    return 1;
+}
+
+/* Indexes (rendering more when needed) until line `want` has a known
+   end, i.e. line want+1 has started, or the text runs out. */
+static void pager_index(pager_t *p, int want)
+{
+    while (p->num_lines <= want + 1 && !p->complete) {
+        const char *s = p->text->data;
+        long len = p->text->len;
+
+        if (p->scanned >= len) {
+            if (p->fill) {
+                /* The last fill may still have added text. */
+                if (!p->fill(p->fill_user)) p->fill = NULL;
+                continue;
+            }
+            p->complete = 1;
+            /* A final newline does not open another, empty line. */
+            if (p->num_lines > 1 && p->lines[p->num_lines - 1] == len) p->num_lines--;
+            break;
+        }
+        while (p->scanned < len && p->num_lines <= want + 1) {
+            unsigned char c = (unsigned char)s[p->scanned++];
+            if (c == '\n') {
+                if (pager_add_line(p, p->scanned) != 0) {
+                    p->complete = 1;
+                    break;
+                }
+                p->col = 0;
+            } else if (c == '\r' || (p->charset == CHARSET_UTF8 && (c & 0xC0) == 0x80)) {
+                /* no column: CR of CRLF, UTF-8 continuation byte */
+            } else {
+                long start = p->scanned - 1;
+                int w = pager_width(p, (const unsigned char*)s + start, len - start, &p->scanned);
+                if (p->cols && p->col > 0 && p->col + w > p->cols) {
+                    if (pager_add_line(p, start) != 0) {
+                        p->complete = 1;
+                        break;
+                    }
+                    p->col = w;
+                } else {
+                    p->col += w;
+                }
+            }
+        }
+    }
+}
+
+/* Writes one screen line without its line end or carriage returns. */
+static void pager_draw_line(const pager_t *p, int i)
+{
+    const char *s = p->text->data;
+    long from = p->lines[i];
+    long to = (i + 1 < p->num_lines) ? p->lines[i + 1] : p->text->len;
+    long run = from;
+
+    for (long k = from; k < to; ++k) {
+        if (s[k] == '\r' || s[k] == '\n') {
+            if (k > run) fwrite(s + run, 1, k - run, p->out);
+            run = k + 1;
+        }
+    }
+    if (to > run) fwrite(s + run, 1, to - run, p->out);
+    putc('\n', p->out);
+}
+
+int pager_show(pager_t *p, int top)
+{
+    int last;
+    stats_time_t t;
+
+    if (!p->text) return 0;       /* nothing opened yet */
+    if (p->rows == 0) {
+        /* No paging: render everything and write it in one go. */
+        while (p->fill && p->fill(p->fill_user)) { /* render the rest */ }
+        t = stats_begin();
+        fwrite(p->text->data, 1, p->text->len, p->out);
+        putc('\n', p->out);
+        stats_end(STATS_OUTPUT, t);
+        p->complete = 1;
+        return 0;
+    }
+
+    if (top < 0) top = 0;
+    pager_index(p, top + p->rows - 1);
+    if (top >= p->num_lines) top = p->num_lines > p->rows ? p->num_lines - p->rows : 0;
+    p->top = top;
+
+    /* Output only; rendering and indexing are timed by whoever does them. */
+    t = stats_begin();
+
+    last = top + p->rows;
+    if (last > p->num_lines) last = p->num_lines;
+    for (int i = top; i < last; ++i) {
+        pager_draw_line(p, i);
+    }
+
+    fprintf(p->out, "-- lines %d-%d of %d%s --\n", top + 1, last, p->num_lines,
+           p->complete ? "" : "+");
+    stats_end(STATS_OUTPUT, t);
+    return top;
+}
+
+int pager_count_lines(pager_t *p)
+{
+    if (!p->text) return 0;
+    while (!p->complete) {
+        pager_index(p, p->num_lines + 1024);
+    }
+    return p->num_lines;
+}
+
+int pager_at_end(const pager_t *p)
+{
+    return p->rows == 0 || (p->complete && p->top + p->rows >= p->num_lines);
+}
+
+int pager_next(pager_t *p)
+{
+    if (pager_at_end(p)) {
+        fprintf(p->out, "-- end of page --\n");
+        return p->top;
+    }
+    return pager_show(p, p->top + p->rows);
+}
+
+int pager_prev(pager_t *p)
+{
+    if (p->rows && p->top == 0) {
+        fprintf(p->out, "-- top of page --\n");
+        return 0;
+    }
+    return pager_show(p, p->top - p->rows);
+}
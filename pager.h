@@ -0,0 +1,73 @@
+#ifndef PAGER_H
+#define PAGER_H
+
+#include "charset.h"
+#include "page_arena.h"
+
+#include <stdio.h>
+
+/*
+ * One-screen-at-a-time viewer over rendered page text.
+ *
+ * The pager keeps an index of where every screen line starts (after
+ * wrapping at the console width), so drawing any screen, paging up and
+ * down or jumping to a line is an array lookup plus one screen of output.
+ * The index is only extended as far as the lines being drawn: text past
+ * the visible region is neither indexed nor, if the caller supplies a
+ * fill callback, even rendered until the user pages down to it.
+ *
+ * Columns are counted per character of the text's charset: CJK and other
+ * full-width characters take two, and a line is never wrapped inside a
+ * multibyte character.
+ */
+
+#define PAGER_DEFAULT_ROWS 22     /* leaves room for status and prompt */
+#define PAGER_DEFAULT_COLS 80
+
+/* Appends more text to the pager's arena. Returns 0 once there is none. */
+typedef int (*pager_fill_fn)(void *user);
+
+typedef struct {
+    const page_arena_t *text;
+    pager_fill_fn fill;           /* NULL when the text is already complete */
+    void *fill_user;
+
+    long *lines;                  /* start offset of each screen line */
+    int   num_lines;
+    int   cap_lines;
+    long  scanned;                /* text bytes indexed so far */
+    int   col;                    /* column reached at scanned */
+    int   complete;               /* all text rendered and indexed */
+
+    int   rows;                   /* lines per screen, 0 = no paging */
+    int   cols;                   /* wrap width, 0 = no wrapping */
+    int   top;                    /* first line on screen */
+    FILE *out;                    /* stdout unless changed after init */
+    charset_t charset;            /* of the text; UTF-8 unless changed after init */
+} pager_t;
+
+void pager_init(pager_t *p, int rows, int cols);
+void pager_free(pager_t *p);
+
+/* Starts paging text from the top. fill may be NULL. */
+void pager_open(pager_t *p, const page_arena_t *text, pager_fill_fn fill, void *user);
+
+/*
+ * Draws the screen starting at line top (0-based, clamped) followed by a
+ * status line. With rows 0 the whole text is written instead. Returns the
+ * line actually shown first.
+ */
+int pager_show(pager_t *p, int top);
+
+/* Screen movement relative to the last pager_show. */
+int pager_next(pager_t *p);
+int pager_prev(pager_t *p);
+
+/* Indexes (and renders) the rest of the text without drawing anything;
+   returns the total number of screen lines. */
+int pager_count_lines(pager_t *p);
+
+/* Whether the last screen shown reached the end of the text. */
+int pager_at_end(const pager_t *p);
+
+#endif
@@ -0,0 +1,248 @@
+#include "prefetch.h"
+#include "http_client.h"
+#include "sys_thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    PREFETCH_EMPTY = 0,
+    PREFETCH_QUEUED,
+    PREFETCH_RUNNING,
+    PREFETCH_DONE,
+    PREFETCH_FAILED,
+    PREFETCH_TAKEN
+} prefetch_state_t;
+
+typedef struct {
+    prefetch_state_t state;
+    char url[512];
+    char host[256];
+    unsigned short port;
+    char path[512];
+    int status;
+    page_arena_t body;        /* owned by the worker while RUNNING */
+} prefetch_slot_t;
+
+static prefetch_slot_t g_slots[PREFETCH_MAX_LINKS];
+static int g_nslots = 0;
+
+static int g_max_links = 0;
+static int g_workers = PREFETCH_DEFAULT_WORKERS;
+static long g_budget = PREFETCH_DEFAULT_BUDGET;
+static long g_bytes = 0;                /* held by RUNNING and DONE slots */
+
+static sys_thread_t g_threads[PREFETCH_MAX_WORKERS];
+static int g_nthreads = 0;
+static int g_cancel = 0;                /* under g_lock once workers run */
+
+static sys_mutex_t g_lock;              /* slot states and g_bytes */
+static int g_lock_ready = 0;
+
+void prefetch_config(int max_links, int workers, long budget_bytes)
+{
+    if (max_links > PREFETCH_MAX_LINKS) max_links = PREFETCH_MAX_LINKS;
+    if (workers < 1) workers = 1;
+    if (workers > PREFETCH_MAX_WORKERS) workers = PREFETCH_MAX_WORKERS;
+
+    prefetch_clear();
+    g_max_links = max_links > 0 ? max_links : 0;
+    g_workers = workers;
+    g_budget = budget_bytes > 0 ? budget_bytes : PREFETCH_DEFAULT_BUDGET;
+
+    if (g_max_links && !g_lock_ready) {
+        net_transport_enable_threads();
+        sys_mutex_init(&g_lock);
+        g_lock_ready = 1;
+    }
+}
+
+int prefetch_enabled(void)
+{
+    return g_max_links > 0;
+}
+
+int prefetch_room(void)
+{
+    return g_max_links - g_nslots;
+}
+
+int prefetch_add(const char *url, const char *host, unsigned short port, const char *path)
+{
+    prefetch_slot_t *slot;
+
+    if (g_nthreads > 0 || g_nslots >= g_max_links) return -1;
+    for (int i = 0; i < g_nslots; ++i) {
+        if (strcmp(g_slots[i].url, url) == 0) return -1;
+    }
+
+    slot = &g_slots[g_nslots++];
+    memset(slot, 0, sizeof(*slot));
+    strncpy(slot->url, url, sizeof(slot->url) - 1);
+    strncpy(slot->host, host, sizeof(slot->host) - 1);
+    strncpy(slot->path, path, sizeof(slot->path) - 1);
+    slot->port = port;
+    page_arena_init(&slot->body, g_budget);
+    slot->state = PREFETCH_QUEUED;
+    return 0;
+}
+
+static int prefetch_cancelled(void *user)
+{
+    int cancel;
+    (void)user;
+    sys_mutex_lock(&g_lock);
+    cancel = g_cancel;
+    sys_mutex_unlock(&g_lock);
+    return cancel;
+}
+
+/* Body sink: charges every byte against the shared budget first. */
+static int prefetch_sink(void *user, const char *data, int len)
+{
+    prefetch_slot_t *slot = (prefetch_slot_t*)user;
+    int over;
+
+    sys_mutex_lock(&g_lock);
+    over = g_cancel || g_bytes + len > g_budget;
+    if (!over) g_bytes += len;
+    sys_mutex_unlock(&g_lock);
+    if (over) return 1;
+
+    page_arena_append(&slot->body, data, len);
+    return slot->body.dropped ? 1 : 0;
+}
+
+static int prefetch_fetch(prefetch_slot_t *slot)
+{
+    /* Off the stack: worker threads get small stacks on CE. */
+    http_response_t *resp = (http_response_t*)malloc(sizeof(*resp));
+    net_tls_options_t tls_opts;
+    int ok = 0;
+
+    if (!resp) return 0;
+    memset(&tls_opts, 0, sizeof(tls_opts));
+    if (http_request(resp, "GET", slot->host, slot->port, NET_SCHEME_HTTP,
+                     &tls_opts, slot->path, NULL, NULL, NULL) == 0) {
+        slot->status = resp->status;
+        ok = resp->status == 200 &&
+             http_read_response(resp, prefetch_sink, slot) == 0;
+        http_finish(resp);
+    }
+    free(resp);
+    return ok;
+}
+
+static void prefetch_worker(void *arg)
+{
+    (void)arg;
+    net_transport_set_cancel(prefetch_cancelled, NULL);
+
+    for (;;) {
+        prefetch_slot_t *slot = NULL;
+        int ok;
+
+        sys_mutex_lock(&g_lock);
+        for (int i = 0; i < g_nslots && !g_cancel; ++i) {
+            if (g_slots[i].state == PREFETCH_QUEUED) {
+                slot = &g_slots[i];
+                slot->state = PREFETCH_RUNNING;
+                break;
+            }
+        }
+        sys_mutex_unlock(&g_lock);
+        if (!slot) break;
+
+        ok = prefetch_fetch(slot);
+
+        sys_mutex_lock(&g_lock);
+        if (ok) {
+            slot->state = PREFETCH_DONE;
+        } else {
+            g_bytes -= slot->body.len;
+            page_arena_free(&slot->body);
+            slot->state = PREFETCH_FAILED;
+        }
+        sys_mutex_unlock(&g_lock);
+    }
+
+    net_transport_thread_exit();
+}
+
+void prefetch_start(void)
+{
+    int queued = 0;
+
+    if (!g_max_links || g_nthreads > 0) return;
+    for (int i = 0; i < g_nslots; ++i) {
+        if (g_slots[i].state == PREFETCH_QUEUED) queued++;
+    }
+    g_cancel = 0;
+    while (g_nthreads < g_workers && g_nthreads < queued) {
+        if (sys_thread_start(&g_threads[g_nthreads], prefetch_worker, NULL, 1) != 0) break;
+        g_nthreads++;
+    }
+}
+
+int prefetch_take(const char *url, page_arena_t *page, int *status)
+{
+    int found = 0;
+
+    if (!g_max_links) return 0;
+    sys_mutex_lock(&g_lock);
+    for (int i = 0; i < g_nslots; ++i) {
+        prefetch_slot_t *slot = &g_slots[i];
+        if (slot->state == PREFETCH_DONE && strcmp(slot->url, url) == 0) {
+            page_arena_t old = *page;
+            *page = slot->body;
+            page->limit = old.limit;   /* the page keeps its own cap */
+            slot->body = old;          /* freed by prefetch_clear */
+            g_bytes -= page->len;
+            *status = slot->status;
+            slot->state = PREFETCH_TAKEN;
+            found = 1;
+            break;
+        }
+    }
+    sys_mutex_unlock(&g_lock);
+    return found;
+}
+
+void prefetch_clear(void)
+{
+    if (g_nthreads > 0) {
+        sys_mutex_lock(&g_lock);
+        g_cancel = 1;
+        sys_mutex_unlock(&g_lock);
+    }
+    for (int i = 0; i < g_nthreads; ++i) {
+        sys_thread_join(&g_threads[i]);
+    }
+    g_nthreads = 0;
+    g_cancel = 0;
+
+    for (int i = 0; i < g_nslots; ++i) {
+        page_arena_free(&g_slots[i].body);
+    }
+    g_nslots = 0;
+    g_bytes = 0;
+}
+
+void prefetch_print(void)
+{
+    static const char *names[] = { "", "queued", "fetching", "ready", "failed", "used" };
+
+    if (!g_max_links) {
+        printf("Prefetch is off (--prefetch=<links> enables it).\n");
+        return;
+    }
+    sys_mutex_lock(&g_lock);
+    printf("Prefetch: %d link(s), %d worker(s), %ld of %ld KB used\n",
+           g_nslots, g_nthreads, g_bytes / 1024, g_budget / 1024);
+    for (int i = 0; i < g_nslots; ++i) {
+        const prefetch_slot_t *slot = &g_slots[i];
+        printf("  %-8s %6ld  %s\n", names[slot->state], slot->body.len, slot->url);
+    }
+    sys_mutex_unlock(&g_lock);
+}
@@ -0,0 +1,47 @@
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#include "page_arena.h"
+
+/*
+ * Background link prefetch into memory.
+ *
+ * After a page loads the caller queues the links it wants warmed (e.g.
+ * the first N on the same host) and calls prefetch_start. Up to
+ * `workers` low-priority threads fetch them over the shared keep-alive
+ * pool while the user reads; bodies are kept in memory under one byte
+ * budget shared by all entries (a fetch that would exceed it is dropped).
+ * On navigation the caller first tries prefetch_take for the chosen URL,
+ * then prefetch_clear: in-flight fetches are cancelled through the
+ * net_transport cancel hook and everything left is freed.
+ *
+ * Plain GET, 200 responses only. All calls come from the main thread.
+ */
+
+#define PREFETCH_MAX_LINKS        32    /* queue slots per page */
+#define PREFETCH_MAX_WORKERS      4
+#define PREFETCH_DEFAULT_WORKERS  2
+#define PREFETCH_DEFAULT_BUDGET   (512L * 1024)
+
+/* max_links 0 disables prefetch (the default). */
+void prefetch_config(int max_links, int workers, long budget_bytes);
+int prefetch_enabled(void);
+
+/* Links still wanted for the current page (max_links minus queued). */
+int prefetch_room(void);
+
+/* Queues a URL (duplicates are ignored). Returns 0 if queued. */
+int prefetch_add(const char *url, const char *host, unsigned short port, const char *path);
+
+void prefetch_start(void);
+
+/* If url has been fetched, swaps its body into page (no copy), sets
+   *status and returns 1. Otherwise returns 0 and page is untouched. */
+int prefetch_take(const char *url, page_arena_t *page, int *status);
+
+/* Cancels in-flight fetches, waits for the workers and drops all entries. */
+void prefetch_clear(void);
+
+void prefetch_print(void);
+
+#endif
@@ -0,0 +1,311 @@
+#include "prerender.h"
+#include "html_entity.h"
+#include "html_scan.h"
+#include "url.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* ------------------------------------------------------------------------
+ * Gateway side: page -> format
+ * ------------------------------------------------------------------------ */
+
+typedef struct {
+    const char *page;
+    const char *url;
+    page_arena_t *head;       /* link lines */
+    page_arena_t *text;
+    int links;
+    int pre;                  /* inside <pre>: whitespace kept */
+    int space;                /* whitespace seen since the last word */
+    int newlines;             /* newlines ending the text so far */
+    int in_title;
+    char title[256];
+    int title_len;
+} prerender_t;
+
+static int is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f';
+}
+
+static void prerender_put(prerender_t *r, const char *s, int len)
+{
+    if (r->space && r->newlines == 0 && r->text->len > 0) page_arena_append(r->text, " ", 1);
+    page_arena_append(r->text, s, len);
+    r->space = 0;
+    r->newlines = 0;
+}
+
+/* Ends the line and adds blank ones until count newlines end the text
+   (none at the very start). */
+static void prerender_break(prerender_t *r, int count)
+{
+    r->space = 0;
+    if (r->text->len == 0) return;
+    while (r->newlines < count) {
+        page_arena_append(r->text, "\n", 1);
+        r->newlines++;
+    }
+}
+
+/* Copies a span with whitespace runs made single spaces (no line breaks:
+   it becomes a head line). Returns the new length. */
+static int prerender_squeeze(const char *s, int len, char *out, int at, int out_size)
+{
+    for (int i = 0; i < len && at < out_size - 1; ++i) {
+        if (!is_space(s[i])) {
+            out[at++] = s[i];
+        } else if (at > 0 && out[at - 1] != ' ') {
+            out[at++] = ' ';
+        }
+    }
+    out[at] = '\0';
+    return at;
+}
+
+static void prerender_on_text(void *user, long off, int len)
+{
+    prerender_t *r = (prerender_t*)user;
+    const char *s = r->page + off;
+    const char *end = s + len;
+
+    if (r->in_title) {
+        r->title_len = prerender_squeeze(s, len, r->title, r->title_len, sizeof(r->title));
+        return;
+    }
+    if (r->pre) {
+        prerender_put(r, s, len);
+        if (len > 0 && s[len - 1] == '\n') r->newlines = 1;
+        return;
+    }
+    while (s < end) {
+        const char *word = s;
+        while (s < end && !is_space(*s)) s++;
+        if (s > word) prerender_put(r, word, (int)(s - word));
+        if (s < end) r->space = 1;
+        while (s < end && is_space(*s)) s++;
+    }
+}
+
+/* A link: its line goes in the head, its number in the text. */
+static void prerender_link_tag(prerender_t *r, const html_scan_tag_t *tag)
+{
+    const html_scan_attr_t *href = html_scan_attr(tag, "href");
+    char raw[PRERENDER_MAX_LINE], link[PRERENDER_MAX_LINE], abs[PRERENDER_MAX_LINE], mark[16];
+    const char *s, *e;
+    int n = 0;
+
+    if (!href) return;
+    /* Tabs and line breaks are not part of a URL; surrounding blanks
+       are not either. "&amp;" and the like are. */
+    s = r->page + href->value.off;
+    e = s + href->value.len;
+    while (s < e && is_space(*s)) s++;
+    while (e > s && is_space(e[-1])) e--;
+    for (; s < e && n < (int)sizeof(raw) - 1; ++s) {
+        if (*s != '\t' && *s != '\r' && *s != '\n') raw[n++] = *s;
+    }
+    n = html_entity_unescape(raw, n, link, sizeof(link));
+
+    page_arena_append(r->head, "L ", 2);
+    if (url_resolve(r->url, link, abs, sizeof(abs)) == 0) {
+        page_arena_append(r->head, abs, (int)strlen(abs));
+    } else {
+        page_arena_append(r->head, link, n);
+    }
+    page_arena_append(r->head, "\n", 1);
+
+    n = snprintf(mark, sizeof(mark), "[%d]", ++r->links);
+    prerender_put(r, mark, n);
+}
+
+static void prerender_on_tag(void *user, const html_scan_tag_t *tag)
+{
+    prerender_t *r = (prerender_t*)user;
+    char c = (char)(r->page[tag->name.off] | 0x20);
+
+    if (c == 'a' && tag->name.len == 1) {
+        if (!tag->closing) prerender_link_tag(r, tag);
+    } else if (html_scan_is(tag, "title")) {
+        /* Only the first title counts. */
+        r->in_title = !tag->closing && r->title_len == 0;
+    } else if (html_scan_is(tag, "br")) {
+        r->space = 0;
+        if (r->newlines < 2) {
+            page_arena_append(r->text, "\n", 1);
+            r->newlines++;
+        }
+    } else if (html_scan_is(tag, "pre")) {
+        prerender_break(r, 2);
+        r->pre = !tag->closing;
+    } else if (html_scan_is(tag, "p") || html_scan_is(tag, "table") ||
+               html_scan_is(tag, "ul") || html_scan_is(tag, "ol") ||
+               html_scan_is(tag, "blockquote") || html_scan_is(tag, "hr") ||
+               (c == 'h' && tag->name.len == 2 &&
+                r->page[tag->name.off + 1] >= '1' && r->page[tag->name.off + 1] <= '6')) {
+        prerender_break(r, 2);
+    } else if (html_scan_is(tag, "li")) {
+        prerender_break(r, 1);
+        if (!tag->closing) prerender_put(r, "  * ", 4);
+    } else if (html_scan_is(tag, "div") || html_scan_is(tag, "tr") ||
+               html_scan_is(tag, "dt") || html_scan_is(tag, "dd") ||
+               html_scan_is(tag, "form") || html_scan_is(tag, "section") ||
+               html_scan_is(tag, "article") || html_scan_is(tag, "header") ||
+               html_scan_is(tag, "footer") || html_scan_is(tag, "nav")) {
+        prerender_break(r, 1);
+    } else if (html_scan_is(tag, "td") || html_scan_is(tag, "th")) {
+        r->space = 1;
+    }
+}
+
+int prerender_page(const char *page, long len, int html, const char *url,
+                   int status, charset_t from, charset_t to,
+                   page_arena_t *out, page_arena_t *scratch)
+{
+    prerender_t r;
+    charset_conv_t conv;
+    char line[PRERENDER_MAX_LINE];
+    int n;
+
+    page_arena_reset(out);
+    page_arena_reset(scratch);
+    n = snprintf(line, sizeof(line), "%s %d\nU %s\n", PRERENDER_MAGIC, status, url);
+    if (n >= (int)sizeof(line)) {
+        n = (int)sizeof(line) - 1;     /* cut URL, line still ended */
+        line[n - 1] = '\n';
+    }
+    page_arena_append(out, line, n);
+
+    charset_conv_init(&conv, from, to);
+    if (!html || status == 0) {
+        page_arena_append(out, "\n", 1);
+        charset_conv(&conv, page, (int)len, out);
+        charset_conv_finish(&conv, out);
+        return out->dropped ? -1 : 0;
+    }
+    conv.entities = 1;
+
+    memset(&r, 0, sizeof(r));
+    r.page = page;
+    r.url = url;
+    r.text = scratch;
+    r.head = out;
+    html_scan(page, len, prerender_on_tag, prerender_on_text, &r);
+    prerender_break(&r, 1);
+
+    if (r.title_len > 0 && r.title[r.title_len - 1] == ' ') r.title[--r.title_len] = '\0';
+    if (r.title_len > 0) {
+        /* The link lines went out as the scan found them; the title is
+           slotted in front of them. */
+        long links = out->len - n;
+        int tlen = charset_convert(from, to, r.title, r.title_len, 1, line + 2, sizeof(line) - 3);
+        line[0] = 'T';
+        line[1] = ' ';
+        line[tlen + 2] = '\n';
+        tlen += 3;
+        if (page_arena_reserve(out, tlen) == 0) {
+            out->len += tlen;
+            memmove(out->data + n + tlen, out->data + n, links);
+            memcpy(out->data + n, line, tlen);
+        }
+    }
+    page_arena_append(out, "\n", 1);
+    charset_conv(&conv, scratch->data, (int)scratch->len, out);
+    charset_conv_finish(&conv, out);
+    return out->dropped || scratch->dropped ? -1 : 0;
+}
+
+/* ------------------------------------------------------------------------
+ * Client side: format -> text and links
+ * ------------------------------------------------------------------------ */
+
+enum {
+    R_MAGIC = 0,              /* first line */
+    R_HEAD,                   /* U, T and L lines */
+    R_TEXT,                   /* everything else */
+    R_BAD
+};
+
+void prerender_reader_init(prerender_reader_t *r, page_arena_t *text, page_arena_t *links,
+                           charset_t from, charset_t to)
+{
+    memset(r, 0, sizeof(*r));
+    r->text = text;
+    r->links = links;
+    charset_conv_init(&r->conv, from, to);
+}
+
+/* One complete head line (without its '\n'). */
+static void prerender_line(prerender_reader_t *r, const char *s, int len)
+{
+    if (r->state == R_MAGIC) {
+        int magic = (int)strlen(PRERENDER_MAGIC);
+        if (len <= magic || strncmp(s, PRERENDER_MAGIC " ", magic + 1) != 0) {
+            r->state = R_BAD;
+            return;
+        }
+        r->status = 0;
+        for (s += magic + 1, len -= magic + 1; len > 0 && *s >= '0' && *s <= '9'; ++s, --len) {
+            r->status = r->status * 10 + (*s - '0');
+        }
+        r->state = R_HEAD;
+    } else if (len == 0) {
+        r->state = R_TEXT;
+    } else if (len >= 2 && s[0] == 'U' && s[1] == ' ') {
+        int n = len - 2 < (int)sizeof(r->url) - 1 ? len - 2 : (int)sizeof(r->url) - 1;
+        memcpy(r->url, s + 2, n);
+        r->url[n] = '\0';
+    } else if (len >= 2 && s[0] == 'T' && s[1] == ' ') {
+        charset_convert(r->conv.from, r->conv.to, s + 2, len - 2, 0, r->title, sizeof(r->title));
+    } else if (len >= 2 && s[0] == 'L' && s[1] == ' ') {
+        page_arena_append(r->links, s + 2, len - 2);
+        page_arena_append(r->links, "\n", 1);
+        r->num_links++;
+    }
+    /* Unknown line types are for later versions: skipped. */
+}
+
+int prerender_read(void *user, const char *data, int len)
+{
+    prerender_reader_t *r = (prerender_reader_t*)user;
+    const char *end = data + len;
+
+    while (data < end && r->state != R_TEXT) {
+        const char *nl = (const char*)memchr(data, '\n', end - data);
+        const char *stop = nl ? nl : end;
+        int n = (int)(stop - data);
+
+        if (r->state == R_BAD) return 1;
+        /* A line that runs past the buffer is cut, not split. */
+        if (n > (int)sizeof(r->line) - r->line_len) n = (int)sizeof(r->line) - r->line_len;
+        memcpy(r->line + r->line_len, data, n);
+        r->line_len += n;
+        data = stop;
+        if (nl) {
+            data = nl + 1;
+            prerender_line(r, r->line, r->line_len);
+            r->line_len = 0;
+        }
+    }
+    if (r->state == R_BAD) return 1;
+    if (data < end) charset_conv(&r->conv, data, (int)(end - data), r->text);
+    return 0;
+}
+
+int prerender_link(const prerender_reader_t *r, int n, char *out, int out_len)
+{
+    const char *s = r->links->data;
+    const char *end = s + r->links->len;
+    const char *nl;
+
+    if (n < 1 || n > r->num_links || !s) return -1;
+    /* Lines past a full arena may be missing or cut: no '\n', no link. */
+    while ((nl = (const char*)memchr(s, '\n', end - s)) != NULL && --n > 0) s = nl + 1;
+    if (!nl) return -1;
+    n = (int)(nl - s);
+    if (n > out_len - 1) n = out_len - 1;
+    memcpy(out, s, n);
+    out[n] = '\0';
+    return 0;
+}
@@ -0,0 +1,72 @@
+#ifndef PRERENDER_H
+#define PRERENDER_H
+
+#include "charset.h"
+#include "page_arena.h"
+
+/*
+ * Pre-rendered page format, spoken between the gateway (proxy.c) and the
+ * CE browser over plain HTTP as Content-Type: text/x-celynx.
+ *
+ *   CELYNX/1 <status>\n      status of the origin server's reply, 0 if
+ *                            there was none (the text says why)
+ *   U <url>\n                where the page came from, after redirects
+ *   T <title>\n              at most once
+ *   L <absolute url>\n       one per link, numbered from 1 in this order
+ *   \n
+ *   <text>                   everything up to the end of the body
+ *
+ * The text is the page with its tags gone: whitespace runs collapsed
+ * outside <pre>, line breaks at block elements, "[n]" in front of link
+ * n. Links are already made absolute, so following one is a single
+ * lookup. The client needs no TLS, inflate or HTML tokenizer; it copies
+ * the text out as it arrives and splits a few short lines off the front.
+ * The text and title are in the charset the client named in
+ * Accept-Charset (UTF-8 if it did not), and the reply's Content-Type says
+ * which: "text/x-celynx; charset=Shift_JIS". Character references in
+ * the text, title and links are already decoded.
+ */
+
+#define PRERENDER_CONTENT_TYPE "text/x-celynx"
+#define PRERENDER_MAGIC        "CELYNX/1"
+#define PRERENDER_MAX_LINE     1024   /* head lines past this are cut */
+
+/* Renders a whole page into out: HTML if html is set, else plain text
+   passed through. Relative links are resolved against url. The text is
+   built in scratch while the link lines go to out, and then joined,
+   converted from the page's charset to the client's.
+   A status of 0 means the fetch failed: page is then the reason, shown
+   as text.
+   Returns 0, or -1 if out hit its limit. */
+int prerender_page(const char *page, long len, int html, const char *url,
+                   int status, charset_t from, charset_t to,
+                   page_arena_t *out, page_arena_t *scratch);
+
+/* Client side: takes the body as it arrives. */
+typedef struct {
+    int state;
+    int status;               /* origin status; 0 until the first line is in */
+    char url[512];            /* from the U line, "" if none */
+    char title[256];
+    int num_links;
+    page_arena_t *text;       /* the text is appended here */
+    page_arena_t *links;      /* and each link URL, '\n'-terminated, here */
+    charset_conv_t conv;      /* reply charset -> display charset */
+    char line[PRERENDER_MAX_LINE];
+    int line_len;
+} prerender_reader_t;
+
+/* from is the charset=... of the reply's Content-Type, to the one text
+   and title are wanted in. */
+void prerender_reader_init(prerender_reader_t *r, page_arena_t *text, page_arena_t *links,
+                           charset_t from, charset_t to);
+
+/* http_body_fn: user is the reader. Returns nonzero (stop) if the body
+   does not start with PRERENDER_MAGIC. Once the body is in, ends the text
+   with charset_conv_finish(&r->conv, r->text). */
+int prerender_read(void *user, const char *data, int len);
+
+/* Copies link n (from 1) into out. Returns 0, or -1 if there is none. */
+int prerender_link(const prerender_reader_t *r, int n, char *out, int out_len);
+
+#endif
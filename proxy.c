@@ -0,0 +1,360 @@
+#include <windows.h>
+#include "proxy.h"
+#include "charset.h"
+#include "http_client.h"
+#include "page_arena.h"
+#include "prerender.h"
+#include "scan_kernel.h"
+#include "sys_thread.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <signal.h>
+#endif
+
+#ifdef MSG_NOSIGNAL
+#define PROXY_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define PROXY_SEND_FLAGS 0
+#endif
+
+/* Per-worker buffers, reused from request to request. */
+typedef struct {
+    sys_thread_t thread;
+    http_response_t resp;
+    page_arena_t page;        /* origin body, or why there is none */
+    page_arena_t out;         /* reply body */
+    page_arena_t scratch;     /* rendered text before it is joined to out */
+    char req[PROXY_MAX_REQUEST];
+    int req_len;              /* bytes in req, maybe past the current head */
+} proxy_worker_t;
+
+static const proxy_options_t *g_opts;
+static SOCKET g_listen = INVALID_SOCKET;
+static sys_mutex_t g_accept_lock;     /* one worker in accept at a time */
+static sys_mutex_t g_free_lock;
+static int g_free_workers;            /* waiting to accept; under g_free_lock */
+
+/* ------------------------------------------------------------------------
+ * Client connection
+ * ------------------------------------------------------------------------ */
+
+static int proxy_free_workers(void)
+{
+    int n;
+    sys_mutex_lock(&g_free_lock);
+    n = g_free_workers;
+    sys_mutex_unlock(&g_free_lock);
+    return n;
+}
+
+/* Reads until req holds a whole request head. Returns its length, or -1
+   when the client closed, went idle or sent more than fits. Between
+   requests it also gives the client up if another one is waiting to be
+   accepted and no other worker is free to take it. */
+static int proxy_read_head(proxy_worker_t *w, SOCKET fd)
+{
+    DWORD start = GetTickCount();
+
+    for (;;) {
+        fd_set rd;
+        struct timeval tv;
+        DWORD spent = GetTickCount() - start;
+        int between = w->req_len == 0;
+        int n;
+
+        for (int i = 3; i < w->req_len; ++i) {
+            if (memcmp(w->req + i - 3, "\r\n\r\n", 4) == 0) return i + 1;
+        }
+        if (w->req_len == PROXY_MAX_REQUEST || spent >= PROXY_CLIENT_IDLE_MS) return -1;
+
+        FD_ZERO(&rd);
+        FD_SET(fd, &rd);
+        if (between) FD_SET(g_listen, &rd);
+        tv.tv_sec = (PROXY_CLIENT_IDLE_MS - spent) / 1000;
+        tv.tv_usec = (PROXY_CLIENT_IDLE_MS - spent) % 1000 * 1000L;
+        if (select((int)(fd > g_listen ? fd : g_listen) + 1, &rd, NULL, NULL, &tv) <= 0) return -1;
+        if (!FD_ISSET(fd, &rd)) {
+            /* Only the listener: a free worker is about to accept. */
+            if (proxy_free_workers() == 0) return -1;
+            sys_sleep_ms(1);
+            continue;
+        }
+        n = recv(fd, w->req + w->req_len, PROXY_MAX_REQUEST - w->req_len, 0);
+        if (n <= 0) return -1;
+        w->req_len += n;
+    }
+}
+
+static int proxy_send(SOCKET fd, const char *data, long len)
+{
+    while (len > 0) {
+        int n = send(fd, data, len > 65536 ? 65536 : (int)len, PROXY_SEND_FLAGS);
+        if (n <= 0) return -1;
+        data += n;
+        len -= n;
+    }
+    return 0;
+}
+
+static int proxy_reply(SOCKET fd, int code, const char *reason, const char *type,
+                       const char *body, long len, int keep, int head_only)
+{
+    char head[256];
+    int n = snprintf(head, sizeof(head),
+                     "HTTP/1.1 %d %s\r\nContent-Type: %s\r\nContent-Length: %ld\r\n"
+                     "Cache-Control: no-cache\r\nConnection: %s\r\n\r\n",
+                     code, reason, type, len, keep ? "keep-alive" : "close");
+    if (proxy_send(fd, head, n) != 0) return -1;
+    return head_only ? 0 : proxy_send(fd, body, len);
+}
+
+static int proxy_error(SOCKET fd, int code, const char *reason, const char *text)
+{
+    return proxy_reply(fd, code, reason, "text/plain", text, (long)strlen(text), 0, 0);
+}
+
+/* Finds header name (lower case) in a request head. Returns 0 and its
+   value in out, or -1. */
+static int proxy_header(const char *head, int len, const char *name, char *out, int out_len)
+{
+    const char *end = head + len;
+    int nlen = (int)strlen(name);
+    const char *line = (const char*)memchr(head, '\n', len);
+
+    while (line && ++line < end) {
+        const char *eol = (const char*)memchr(line, '\n', end - line);
+        int i = 0;
+        if (!eol) break;
+        while (i < nlen && line + i < eol && tolower((unsigned char)line[i]) == name[i]) i++;
+        if (i == nlen && line[i] == ':') {
+            const char *v = line + i + 1;
+            const char *e = eol;
+            int n;
+            while (v < e && (*v == ' ' || *v == '\t')) v++;
+            while (e > v && (e[-1] == '\r' || e[-1] == ' ' || e[-1] == '\t')) e--;
+            n = (int)(e - v) < out_len - 1 ? (int)(e - v) : out_len - 1;
+            memcpy(out, v, n);
+            out[n] = '\0';
+            return 0;
+        }
+        line = eol;
+    }
+    return -1;
+}
+
+/* ------------------------------------------------------------------------
+ * Origin side
+ * ------------------------------------------------------------------------ */
+
+static void proxy_fail(proxy_worker_t *w, const char *why)
+{
+    page_arena_reset(&w->page);
+    page_arena_append(&w->page, why, (int)strlen(why));
+    page_arena_append(&w->page, "\n", 1);
+}
+
+/*
+ * Fetches url into w->page, following redirects; final gets the URL the
+ * page came from. Returns the origin status, with *html set for pages to
+ * render and *charset to the page's, or 0 with the reason in w->page.
+ */
+static int proxy_fetch(proxy_worker_t *w, const char *url, char *final, int final_len, int *html,
+                       charset_t *charset)
+{
+    char value[512];
+    int rc;
+
+    *html = 0;
+    *charset = CHARSET_UTF8;                   /* of the reasons given */
+    rc = http_get(&w->resp, url, g_opts->tls, &w->page, final, final_len);
+    if (rc == HTTP_GET_BAD_URL) {
+        proxy_fail(w, "Malformed or unsupported URL.");
+        return 0;
+    }
+    if (rc == HTTP_GET_NO_REPLY) {
+        proxy_fail(w, net_transport_failure_text(net_transport_last_failure()));
+        return 0;
+    }
+
+    if (http_header(&w->resp, "Content-Type", value, sizeof(value)) != 0) {
+        *html = 1;                      /* unlabelled: most likely a page */
+        *charset = charset_detect(NULL, w->page.data, (int)w->page.len, CHARSET_UTF8);
+    } else {
+        *charset = charset_detect(value, w->page.data, (int)w->page.len, CHARSET_UTF8);
+        for (char *p = value; *p; ++p) *p = (char)tolower((unsigned char)*p);
+        *html = strstr(value, "html") != NULL;
+        if (!*html && strncmp(value, "text/", 5) != 0) {
+            /* Nothing a text browser can show: say what it was. */
+            char what[600];
+            snprintf(what, sizeof(what), "[%s, %ld bytes, not shown]", value, w->page.len);
+            proxy_fail(w, what);
+            *charset = CHARSET_UTF8;
+        }
+    }
+    if (rc != 0) {
+        page_arena_append(&w->page, "\n[transfer interrupted]\n", 24);
+    }
+    return w->resp.status;
+}
+
+/* ------------------------------------------------------------------------
+ * Workers
+ * ------------------------------------------------------------------------ */
+
+/* Answers requests on one client connection until it closes. */
+static void proxy_serve(proxy_worker_t *w, SOCKET fd)
+{
+    w->req_len = 0;
+    for (;;) {
+        char method[16], target[1024], version[16], value[64], final[1024], type[64];
+        int head = proxy_read_head(w, fd);
+        int keep, html, status, head_only;
+        charset_t from, to = CHARSET_UTF8;
+
+        if (head < 0) return;
+        w->req[head - 1] = '\0';
+        if (sscanf(w->req, "%15s %1023s %15s", method, target, version) != 3) {
+            proxy_error(fd, 400, "Bad Request", "Malformed request line.\n");
+            return;
+        }
+        keep = strcmp(version, "HTTP/1.1") == 0;
+        if (proxy_header(w->req, head, "connection", value, sizeof(value)) == 0) {
+            for (char *p = value; *p; ++p) *p = (char)tolower((unsigned char)*p);
+            if (strstr(value, "close")) keep = 0;
+            if (strstr(value, "keep-alive")) keep = 1;
+        }
+        /* The client's charset: the first one it accepts, if known here. */
+        if (proxy_header(w->req, head, "accept-charset", value, sizeof(value)) == 0) {
+            charset_t cs = charset_from_name(value, (int)strcspn(value, ",;"));
+            if (cs != CHARSET_UNKNOWN && cs != CHARSET_UTF16LE) to = cs;
+        }
+        head_only = strcmp(method, "HEAD") == 0;
+        if (strcmp(method, "GET") != 0 && !head_only) {
+            /* Request bodies are not read, so the connection is done. */
+            proxy_error(fd, 405, "Method Not Allowed", "Only GET is proxied.\n");
+            return;
+        }
+        if (strncmp(target, "http://", 7) != 0 && strncmp(target, "https://", 8) != 0) {
+            proxy_error(fd, 400, "Bad Request",
+                        "Send the page URL as the request target: GET http://host/path HTTP/1.1\n");
+            return;
+        }
+
+        status = proxy_fetch(w, target, final, sizeof(final), &html, &from);
+        prerender_page(w->page.data, w->page.len, html, final, status, from, to,
+                       &w->out, &w->scratch);
+        snprintf(type, sizeof(type), "%s; charset=%s", PRERENDER_CONTENT_TYPE, charset_name(to));
+        printf("%3d %s %ld -> %ld bytes\n", status, final, w->page.len, w->out.len);
+        fflush(stdout);
+        if (proxy_reply(fd, status ? 200 : 502, status ? "OK" : "Bad Gateway",
+                        type, w->out.data, w->out.len, keep, head_only) != 0 ||
+            !keep) {
+            return;
+        }
+
+        /* Keep whatever followed the head (a pipelined request). */
+        w->req_len -= head;
+        memmove(w->req, w->req + head, w->req_len);
+    }
+}
+
+static void proxy_drain(proxy_worker_t *w)
+{
+    for (;;) {
+        SOCKET fd;
+        int one = 1;
+
+        sys_mutex_lock(&g_free_lock);
+        g_free_workers++;
+        sys_mutex_unlock(&g_free_lock);
+        sys_mutex_lock(&g_accept_lock);
+        fd = accept(g_listen, NULL, NULL);
+        sys_mutex_unlock(&g_accept_lock);
+        sys_mutex_lock(&g_free_lock);
+        g_free_workers--;
+        sys_mutex_unlock(&g_free_lock);
+        if (fd == INVALID_SOCKET) {
+            sys_sleep_ms(10);           /* out of descriptors: let some close */
+            continue;
+        }
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (const char*)&one, sizeof(one));
+        proxy_serve(w, fd);
+        closesocket(fd);
+    }
+}
+
+static void proxy_worker(void *arg)
+{
+    proxy_drain((proxy_worker_t*)arg);
+    net_transport_thread_exit();
+}
+
+int proxy_run(const proxy_options_t *opts)
+{
+    struct sockaddr_in addr;
+    proxy_worker_t *workers;
+    int jobs = opts->jobs;
+    int started = 0;
+    int one = 1;
+
+    if (jobs < 1) jobs = 1;
+    if (jobs > PROXY_MAX_JOBS) jobs = PROXY_MAX_JOBS;
+    g_opts = opts;
+
+#ifndef _WIN32
+    /* A client that hangs up mid-reply is a failed send, not a signal. */
+    signal(SIGPIPE, SIG_IGN);
+#endif
+    g_listen = socket(AF_INET, SOCK_STREAM, 0);
+    if (g_listen == INVALID_SOCKET) return -1;
+    setsockopt(g_listen, SOL_SOCKET, SO_REUSEADDR, (const char*)&one, sizeof(one));
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(opts->port);
+    addr.sin_addr.s_addr = opts->bind_addr ? inet_addr(opts->bind_addr) : htonl(INADDR_ANY);
+    if (bind(g_listen, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(g_listen, 16) != 0) {
+        closesocket(g_listen);
+        g_listen = INVALID_SOCKET;
+        return -1;
+    }
+
+    /* Off the stack: each one holds a response head, a request buffer
+       and three arenas. */
+    workers = (proxy_worker_t*)calloc(jobs, sizeof(*workers));
+    if (!workers) {
+        closesocket(g_listen);
+        g_listen = INVALID_SOCKET;
+        return -1;
+    }
+    net_transport_enable_threads();
+    net_transport_pool_config(jobs < NET_POOL_MAX_SLOTS ? jobs : NET_POOL_MAX_SLOTS,
+                              NET_POOL_DEFAULT_IDLE_MS);
+    scan_kernel_active();     /* pick the scanner before threads race to */
+    sys_mutex_init(&g_accept_lock);
+    sys_mutex_init(&g_free_lock);
+
+    for (int j = 0; j < jobs; ++j) {
+        page_arena_init(&workers[j].page, PAGE_ARENA_MAX_BYTES);
+        page_arena_init(&workers[j].out, PAGE_ARENA_MAX_BYTES);
+        page_arena_init(&workers[j].scratch, PAGE_ARENA_MAX_BYTES);
+    }
+    printf("Gateway listening on %s:%u, %d workers\n",
+           opts->bind_addr ? opts->bind_addr : "*", opts->port, jobs);
+    fflush(stdout);
+    for (int j = 0; j < jobs; ++j) {
+        if (sys_thread_start(&workers[j].thread, proxy_worker, &workers[j], 0) != 0) break;
+        started++;
+    }
+    if (started == 0) {
+        /* No threads to be had: serve one client at a time here. */
+        proxy_drain(&workers[0]);
+    }
+    for (int j = 0; j < started; ++j) {
+        sys_thread_join(&workers[j].thread);
+    }
+    return 0;
+}
@@ -0,0 +1,46 @@
+#ifndef PROXY_H
+#define PROXY_H
+
+#include "net_transport.h"
+
+/*
+ * Pre-rendering gateway: browser -gateway.
+ *
+ * Listens for plain HTTP requests from CE clients and answers each with
+ * the page already fetched and rendered (prerender.h). The client sends
+ * the page URL as an absolute request target, as to any HTTP proxy:
+ *
+ *   GET https://example.com/ HTTP/1.1
+ *
+ * The gateway does the DNS lookup, TLS, inflate, redirects (up to
+ * HTTP_MAX_REDIRECTS, see http_get) and HTML parsing, and sends back a few lines of
+ * links and the text, converted to the first charset the client lists in
+ * Accept-Charset (UTF-8 if none is known here). Client connections are
+ * kept alive between pages, for PROXY_CLIENT_IDLE_MS or until a new
+ * client is waiting with every worker busy.
+ * Worker threads each take one client connection at a time; origin
+ * connections go through the shared keep-alive pool.
+ *
+ * It fetches whatever it is asked to, so listen on a trusted network
+ * only; --gateway-bind=127.0.0.1 keeps it to this machine.
+ */
+
+#define PROXY_DEFAULT_PORT   8080
+#define PROXY_DEFAULT_JOBS   4
+#define PROXY_MAX_JOBS       16
+#define PROXY_MAX_REQUEST    8192      /* request head bytes */
+#define PROXY_CLIENT_IDLE_MS 5000      /* kept-alive client, < the client pool's 15 s */
+
+typedef struct {
+    const char *bind_addr;             /* NULL: every interface */
+    unsigned short port;
+    int jobs;                          /* worker threads */
+    const net_tls_options_t *tls;      /* for https origins */
+} proxy_options_t;
+
+/* Serves until the process is stopped, printing a line per page (origin
+   status, URL, page bytes -> reply bytes). Returns nonzero if the
+   listening socket cannot be set up. */
+int proxy_run(const proxy_options_t *opts);
+
+#endif
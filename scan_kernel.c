@@ -0,0 +1,375 @@
+#include "scan_kernel.h"
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCAN_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(SCAN_HAVE_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCAN_HAVE_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SCAN_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+typedef const char *(*scan_find_fn)(const char *p, const char *end, const char *set, int nset);
+typedef const char *(*scan_high_fn)(const char *p, const char *end, const char *set, int nset);
+
+static scan_find_fn g_scan_find = NULL;
+static scan_high_fn g_scan_high = NULL;
+static scan_kernel_t g_scan_kernel = SCAN_KERNEL_SCALAR;
+
+static int scan_in_set(char c, const char *set, int nset)
+{
+    for (int i = 0; i < nset; ++i) {
+        if (c == set[i]) return 1;
+    }
+    return 0;
+}
+
+static const char *scan_find_scalar(const char *p, const char *end, const char *set, int nset)
+{
+    if (nset == 1) {
+        const char *hit = (const char*)memchr(p, set[0], (size_t)(end - p));
+        return hit ? hit : end;
+    }
+    for (; p < end; ++p) {
+        if (scan_in_set(*p, set, nset)) return p;
+    }
+    return end;
+}
+
+static const char *scan_high_scalar(const char *p, const char *end, const char *set, int nset)
+{
+    for (; p < end; ++p) {
+        if ((*p & 0x80) || scan_in_set(*p, set, nset)) return p;
+    }
+    return end;
+}
+
+/* ------------------------------------------------------------------------
+ * SWAR: 32-bit words, "has zero byte" on word ^ broadcast(set[i])
+ * ------------------------------------------------------------------------ */
+
+#define SCAN_ONES  0x01010101UL
+#define SCAN_HIGHS 0x80808080UL
+
+static const char *scan_find_swar(const char *p, const char *end, const char *set, int nset)
+{
+    unsigned long bcast[SCAN_MAX_SET];
+
+    for (int i = 0; i < nset; ++i) {
+        bcast[i] = (unsigned char)set[i] * SCAN_ONES;
+    }
+
+    /* Byte steps up to a word boundary so loads are aligned on ARM. */
+    while (p < end && ((unsigned long)p & 3) != 0) {
+        if (scan_in_set(*p, set, nset)) return p;
+        p++;
+    }
+    while (end - p >= 4) {
+        unsigned int word;
+        unsigned long w, hit = 0;
+        memcpy(&word, p, 4);  /* aligned, so this is a single load */
+        w = word;
+        for (int i = 0; i < nset; ++i) {
+            unsigned long x = (w ^ bcast[i]) & 0xFFFFFFFFUL;
+            hit |= (x - SCAN_ONES) & ~x & SCAN_HIGHS;
+        }
+        if (hit) break;       /* pinpoint below */
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        if (scan_in_set(*p, set, nset)) return p;
+    }
+    return end;
+}
+
+static const char *scan_high_swar(const char *p, const char *end, const char *set, int nset)
+{
+    unsigned long bcast[SCAN_MAX_SET];
+
+    for (int i = 0; i < nset; ++i) {
+        bcast[i] = (unsigned char)set[i] * SCAN_ONES;
+    }
+    while (p < end && ((unsigned long)p & 3) != 0) {
+        if ((*p & 0x80) || scan_in_set(*p, set, nset)) return p;
+        p++;
+    }
+    while (end - p >= 4) {
+        unsigned int word;
+        unsigned long w, hit;
+        memcpy(&word, p, 4);
+        w = word;
+        hit = w & SCAN_HIGHS;
+        for (int i = 0; i < nset; ++i) {
+            unsigned long x = (w ^ bcast[i]) & 0xFFFFFFFFUL;
+            hit |= (x - SCAN_ONES) & ~x & SCAN_HIGHS;
+        }
+        if (hit) break;
+        p += 4;
+    }
+    return scan_high_scalar(p, end, set, nset);
+}
+
+/* ------------------------------------------------------------------------
+ * SSE2 / AVX2: compare 16/32 bytes per set byte, OR, movemask
+ * ------------------------------------------------------------------------ */
+
+#ifdef SCAN_HAVE_SSE2
+static int scan_ctz(unsigned int m)
+{
+#ifdef __GNUC__
+    return __builtin_ctz(m);
+#else
+    int n = 0;
+    while (!(m & 1)) {
+        m >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static const char *scan_find_sse2(const char *p, const char *end, const char *set, int nset)
+{
+    __m128i needle[SCAN_MAX_SET];
+
+    for (int i = 0; i < nset; ++i) {
+        needle[i] = _mm_set1_epi8(set[i]);
+    }
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i eq = _mm_cmpeq_epi8(v, needle[0]);
+        unsigned int m;
+        for (int i = 1; i < nset; ++i) {
+            eq = _mm_or_si128(eq, _mm_cmpeq_epi8(v, needle[i]));
+        }
+        m = (unsigned int)_mm_movemask_epi8(eq);
+        if (m) return p + scan_ctz(m);
+        p += 16;
+    }
+    for (; p < end; ++p) {
+        if (scan_in_set(*p, set, nset)) return p;
+    }
+    return end;
+}
+
+/* movemask takes the top bit of each byte: exactly the test wanted, and
+   a set byte's all-ones compare result OR'd in sets it too. */
+static const char *scan_high_sse2(const char *p, const char *end, const char *set, int nset)
+{
+    __m128i needle[SCAN_MAX_SET];
+
+    for (int i = 0; i < nset; ++i) {
+        needle[i] = _mm_set1_epi8(set[i]);
+    }
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i eq = v;
+        unsigned int m;
+        for (int i = 0; i < nset; ++i) {
+            eq = _mm_or_si128(eq, _mm_cmpeq_epi8(v, needle[i]));
+        }
+        m = (unsigned int)_mm_movemask_epi8(eq);
+        if (m) return p + scan_ctz(m);
+        p += 16;
+    }
+    return scan_high_scalar(p, end, set, nset);
+}
+#endif
+
+#ifdef SCAN_HAVE_AVX2
+__attribute__((target("avx2")))
+static const char *scan_find_avx2(const char *p, const char *end, const char *set, int nset)
+{
+    __m256i needle[SCAN_MAX_SET];
+
+    for (int i = 0; i < nset; ++i) {
+        needle[i] = _mm256_set1_epi8(set[i]);
+    }
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i eq = _mm256_cmpeq_epi8(v, needle[0]);
+        unsigned int m;
+        for (int i = 1; i < nset; ++i) {
+            eq = _mm256_or_si256(eq, _mm256_cmpeq_epi8(v, needle[i]));
+        }
+        m = (unsigned int)_mm256_movemask_epi8(eq);
+        if (m) return p + scan_ctz(m);
+        p += 32;
+    }
+    return scan_find_sse2(p, end, set, nset);
+}
+
+__attribute__((target("avx2")))
+static const char *scan_high_avx2(const char *p, const char *end, const char *set, int nset)
+{
+    __m256i needle[SCAN_MAX_SET];
+
+    for (int i = 0; i < nset; ++i) {
+        needle[i] = _mm256_set1_epi8(set[i]);
+    }
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i eq = v;
+        unsigned int m;
+        for (int i = 0; i < nset; ++i) {
+            eq = _mm256_or_si256(eq, _mm256_cmpeq_epi8(v, needle[i]));
+        }
+        m = (unsigned int)_mm256_movemask_epi8(eq);
+        if (m) return p + scan_ctz(m);
+        p += 32;
+    }
+    return scan_high_sse2(p, end, set, nset);
+}
+#endif
+
+/* ------------------------------------------------------------------------
+ * NEON: compare 16 bytes, test the two 64-bit halves, pinpoint bytewise
+ * ------------------------------------------------------------------------ */
+
+#ifdef SCAN_HAVE_NEON
+static const char *scan_find_neon(const char *p, const char *end, const char *set, int nset)
+{
+    uint8x16_t needle[SCAN_MAX_SET];
+
+    for (int i = 0; i < nset; ++i) {
+        needle[i] = vdupq_n_u8((uint8_t)set[i]);
+    }
+    while (end - p >= 16) {
+        uint8x16_t v = vld1q_u8((const uint8_t*)p);
+        uint8x16_t eq = vceqq_u8(v, needle[0]);
+        uint64x2_t halves;
+        for (int i = 1; i < nset; ++i) {
+            eq = vorrq_u8(eq, vceqq_u8(v, needle[i]));
+        }
+        halves = vreinterpretq_u64_u8(eq);
+        if (vgetq_lane_u64(halves, 0) | vgetq_lane_u64(halves, 1)) break;
+        p += 16;
+    }
+    for (; p < end; ++p) {
+        if (scan_in_set(*p, set, nset)) return p;
+    }
+    return end;
+}
+
+static const char *scan_high_neon(const char *p, const char *end, const char *set, int nset)
+{
+    uint8x16_t needle[SCAN_MAX_SET];
+
+    for (int i = 0; i < nset; ++i) {
+        needle[i] = vdupq_n_u8((uint8_t)set[i]);
+    }
+    while (end - p >= 16) {
+        uint8x16_t v = vld1q_u8((const uint8_t*)p);
+        uint8x16_t eq = v;
+        uint64x2_t halves;
+        for (int i = 0; i < nset; ++i) {
+            eq = vorrq_u8(eq, vceqq_u8(v, needle[i]));
+        }
+        halves = vreinterpretq_u64_u8(eq);
+        if ((vgetq_lane_u64(halves, 0) | vgetq_lane_u64(halves, 1)) & 0x8080808080808080ULL) break;
+        p += 16;
+    }
+    return scan_high_scalar(p, end, set, nset);
+}
+#endif
+
+/* ------------------------------------------------------------------------
+ * Dispatch
+ * ------------------------------------------------------------------------ */
+
+static scan_kernel_t scan_kernel_best(void)
+{
+#ifdef SCAN_HAVE_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SCAN_KERNEL_AVX2;
+#endif
+#if defined(SCAN_HAVE_SSE2)
+    return SCAN_KERNEL_SSE2;
+#elif defined(SCAN_HAVE_NEON)
+    return SCAN_KERNEL_NEON;
+#else
+    return SCAN_KERNEL_SWAR;
+#endif
+}
+
+scan_kernel_t scan_kernel_force(scan_kernel_t k)
+{
+    switch (k) {
+#ifdef SCAN_HAVE_AVX2
+    case SCAN_KERNEL_AVX2:
+        if (!__builtin_cpu_supports("avx2")) return scan_kernel_force(SCAN_KERNEL_SSE2);
+        g_scan_find = scan_find_avx2;
+        g_scan_high = scan_high_avx2;
+        break;
+#endif
+#ifdef SCAN_HAVE_SSE2
+    case SCAN_KERNEL_SSE2:
+        g_scan_find = scan_find_sse2;
+        g_scan_high = scan_high_sse2;
+        break;
+#endif
+#ifdef SCAN_HAVE_NEON
+    case SCAN_KERNEL_NEON:
+        g_scan_find = scan_find_neon;
+        g_scan_high = scan_high_neon;
+        break;
+#endif
+    case SCAN_KERNEL_SWAR:
+        g_scan_find = scan_find_swar;
+        g_scan_high = scan_high_swar;
+        break;
+    default:
+        k = SCAN_KERNEL_SCALAR;
+        g_scan_find = scan_find_scalar;
+        g_scan_high = scan_high_scalar;
+        break;
+    }
+    g_scan_kernel = k;
+    return k;
+}
+
+scan_kernel_t scan_kernel_active(void)
+{
+    if (!g_scan_find) scan_kernel_force(scan_kernel_best());
+    return g_scan_kernel;
+}
+
+const char *scan_kernel_name(scan_kernel_t k)
+{
+    switch (k) {
+    case SCAN_KERNEL_SWAR: return "swar";
+    case SCAN_KERNEL_SSE2: return "sse2";
+    case SCAN_KERNEL_AVX2: return "avx2";
+    case SCAN_KERNEL_NEON: return "neon";
+    default:               return "scalar";
+    }
+}
+
+const char *scan_find_any(const char *p, const char *end, const char *set, int nset)
+{
+    if (p >= end) return end;
+    if (!g_scan_find) scan_kernel_force(scan_kernel_best());
+    return g_scan_find(p, end, set, nset);
+}
+
+const char *scan_find_high(const char *p, const char *end)
+{
+    if (p >= end) return end;
+    if (!g_scan_high) scan_kernel_force(scan_kernel_best());
+    return g_scan_high(p, end, NULL, 0);
+}
+
+const char *scan_find_high_any(const char *p, const char *end, const char *set, int nset)
+{
+    if (p >= end) return end;
+    if (!g_scan_high) scan_kernel_force(scan_kernel_best());
+    return g_scan_high(p, end, set, nset);
+}
@@ -0,0 +1,52 @@
+#ifndef SCAN_KERNEL_H
+#define SCAN_KERNEL_H
+
+/*
+ * Byte-set search kernels.
+ *
+ * scan_find_any returns the first byte in [p, end) that equals any of up
+ * to SCAN_MAX_SET bytes (usually just one, such as '<' or '\n'), so callers
+ * can hand the runs in between to fwrite/memcpy in one piece.
+ * scan_find_high_any also stops at any byte >= 0x80, which ends a run of
+ * ASCII and a run of text in the same pass (charset.c looks for '&' that
+ * way). The work is done by whichever kernel suits the machine:
+ *
+ *   AVX2    x86 with GCC/Clang, chosen at run time when the CPU has it
+ *   SSE2    x86-64 and SSE2-enabled 32-bit x86 builds
+ *   NEON    ARM builds with NEON enabled
+ *   SWAR    everything else, 4 bytes per step (StrongARM/XScale devices)
+ *   SCALAR  byte at a time; reference and fallback
+ *
+ * The choice is made once, on first use. scan_kernel_force pins a kernel
+ * (falling back to SCALAR if it was not compiled in) for testing and
+ * benchmarks.
+ */
+
+#define SCAN_MAX_SET 4
+
+typedef enum {
+    SCAN_KERNEL_SCALAR = 0,
+    SCAN_KERNEL_SWAR,
+    SCAN_KERNEL_SSE2,
+    SCAN_KERNEL_AVX2,
+    SCAN_KERNEL_NEON
+} scan_kernel_t;
+
+/* set holds nset bytes, 1 <= nset <= SCAN_MAX_SET. Returns end if none. */
+const char *scan_find_any(const char *p, const char *end, const char *set, int nset);
+
+/* First byte in [p, end) with the top bit set, i.e. the end of a run of
+   ASCII; end if none. Same kernel as scan_find_any. */
+const char *scan_find_high(const char *p, const char *end);
+
+/* First byte in [p, end) with the top bit set or in set (0 <= nset <=
+   SCAN_MAX_SET); end if none. */
+const char *scan_find_high_any(const char *p, const char *end, const char *set, int nset);
+
+scan_kernel_t scan_kernel_active(void);
+const char *scan_kernel_name(scan_kernel_t k);
+
+/* Returns the kernel actually selected. */
+scan_kernel_t scan_kernel_force(scan_kernel_t k);
+
+#endif
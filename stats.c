@@ -0,0 +1,143 @@
+#include "stats.h"
+#include "sys_thread.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+typedef struct {
+    long calls;
+    unsigned long total_us;
+    unsigned long max_us;
+} stats_span_data_t;
+
+typedef struct {
+    stats_span_data_t spans[STATS_NUM_SPANS];
+    long counters[STATS_NUM_COUNTERS];
+} stats_data_t;
+
+static const char *g_span_names[STATS_NUM_SPANS] = {
+    "dns", "connect", "tls", "wait", "recv", "headers", "strip", "doc", "output"
+};
+
+static const char *g_counter_names[STATS_NUM_COUNTERS] = {
+    "bytes received", "bytes rendered", "tags", "connections", "reused",
+    "peak buffer"
+};
+
+static int g_stats_ready = 0;          /* set once by stats_init */
+static sys_tls_t g_stats_key;
+static stats_data_t g_stats;
+
+static stats_time_t stats_now(void)
+{
+    stats_time_t t;
+#ifdef _WIN32
+    /* Not every CE device has a performance counter; fall back to ticks. */
+    LARGE_INTEGER freq, count;
+    if (QueryPerformanceFrequency(&freq) && freq.QuadPart > 0 &&
+        QueryPerformanceCounter(&count)) {
+        t = (stats_time_t)((count.QuadPart / freq.QuadPart) * 1000000 +
+                           (count.QuadPart % freq.QuadPart) * 1000000 / freq.QuadPart);
+    } else {
+        t = (stats_time_t)GetTickCount() * 1000UL;
+    }
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    t = (stats_time_t)ts.tv_sec * 1000000UL + (stats_time_t)(ts.tv_nsec / 1000);
+#endif
+    return t ? t : 1;                  /* 0 is reserved for "off" */
+}
+
+/* The calling thread's data, or NULL when it is not being measured. */
+static stats_data_t *stats_here(void)
+{
+    if (!g_stats_ready) return NULL;
+    return (stats_data_t*)sys_tls_get(g_stats_key);
+}
+
+void stats_init(void)
+{
+    if (g_stats_ready) return;
+    if (sys_tls_create(&g_stats_key) != 0) return;
+    g_stats_ready = 1;
+}
+
+void stats_enable(int on)
+{
+    if (!g_stats_ready) return;
+    sys_tls_set(g_stats_key, on ? &g_stats : NULL);
+}
+
+int stats_enabled(void)
+{
+    return stats_here() != NULL;
+}
+
+void stats_reset(void)
+{
+    stats_data_t *st = stats_here();
+    if (!st) return;
+    memset(st, 0, sizeof(*st));
+}
+
+stats_time_t stats_begin(void)
+{
+    return stats_here() ? stats_now() : 0;
+}
+
+void stats_end(stats_span_t span, stats_time_t start)
+{
+    stats_data_t *st;
+    stats_span_data_t *sp;
+    unsigned long us;
+
+    if (!start || (st = stats_here()) == NULL) return;
+    sp = &st->spans[span];
+    us = stats_now() - start;
+    sp->calls++;
+    sp->total_us += us;
+    if (us > sp->max_us) sp->max_us = us;
+}
+
+void stats_add(stats_counter_t counter, long n)
+{
+    stats_data_t *st = stats_here();
+    if (st) st->counters[counter] += n;
+}
+
+void stats_peak(stats_counter_t counter, long value)
+{
+    stats_data_t *st = stats_here();
+    if (st && value > st->counters[counter]) st->counters[counter] = value;
+}
+
+void stats_print(void)
+{
+    const stats_data_t *st = stats_here();
+    unsigned long all_us = 0;
+
+    if (!st) {
+        printf("Stats are off (start with --stats).\n");
+        return;
+    }
+    printf("Stats for the last page:\n");
+    printf("  %-16s %8s %10s %10s\n", "span", "calls", "total ms", "max ms");
+    for (int i = 0; i < STATS_NUM_SPANS; ++i) {
+        const stats_span_data_t *sp = &st->spans[i];
+        if (!sp->calls) continue;
+        printf("  %-16s %8ld %10.1f %10.1f\n", g_span_names[i], sp->calls,
+               sp->total_us / 1000.0, sp->max_us / 1000.0);
+        all_us += sp->total_us;
+    }
+    /* Anything well short of the time the user waited went unmeasured:
+       the request upload, decompression, the cache or the UI. */
+    printf("  %-16s %8s %10.1f\n", "all spans", "", all_us / 1000.0);
+    for (int i = 0; i < STATS_NUM_COUNTERS; ++i) {
+        printf("  %-16s %8ld\n", g_counter_names[i], st->counters[i]);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef STATS_H
+#define STATS_H
+
+/*
+ * Hot-path timings and counters for one page load.
+ *
+ * The transport, HTTP head parser, tokenizers, page arena and pager wrap
+ * their work in stats_begin/stats_end and report byte and tag counts with
+ * stats_add. Only a thread that called stats_enable(1) is measured (the
+ * prefetch workers never are), so the numbers describe the page the user
+ * is waiting for. Disabled, each call is one thread-local lookup.
+ */
+
+typedef enum {
+    STATS_DNS = 0,          /* host lookup, cache hits included */
+    STATS_CONNECT,          /* TCP connect */
+    STATS_TLS,              /* TLS handshake */
+    STATS_WAIT,             /* reads until the first byte of a reply */
+    STATS_RECV,             /* later reads */
+    STATS_HEADERS,          /* scanning and parsing response heads */
+    STATS_STRIP,            /* tag stripping (html_stream, html_scan_strip) */
+    STATS_DOC,              /* link/form/table extraction (html_doc) */
+    STATS_OUTPUT,           /* drawing pager screens */
+    STATS_NUM_SPANS
+} stats_span_t;
+
+typedef enum {
+    STATS_BYTES_RECEIVED = 0,
+    STATS_BYTES_RENDERED,   /* text left after stripping tags */
+    STATS_TAGS,
+    STATS_CONNECTIONS,      /* new connections */
+    STATS_REUSED,           /* pooled connections taken instead */
+    STATS_PEAK_BUFFER,      /* largest page arena allocation, bytes */
+    STATS_NUM_COUNTERS
+} stats_counter_t;
+
+/* Microseconds on a monotonic clock; 0 means "not measuring". */
+typedef unsigned long stats_time_t;
+
+/* Once, from the main thread, before any other thread starts. */
+void stats_init(void);
+
+/* Turns measuring on or off for the calling thread. */
+void stats_enable(int on);
+int stats_enabled(void);
+
+/* Clears everything; called as a page load starts. */
+void stats_reset(void);
+
+stats_time_t stats_begin(void);
+void stats_end(stats_span_t span, stats_time_t start);
+
+void stats_add(stats_counter_t counter, long n);
+/* Raises counter to value if it is below it. */
+void stats_peak(stats_counter_t counter, long value);
+
+void stats_print(void);
+
+#endif
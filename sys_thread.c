@@ -0,0 +1,151 @@
+#if !defined(_WIN32) && !defined(_XOPEN_SOURCE)
+#define _XOPEN_SOURCE 600     /* recursive mutexes, nanosleep */
+#endif
+
+#include "sys_thread.h"
+
+#include <stdlib.h>
+
+#ifdef _WIN32
+
+typedef struct {
+    sys_thread_fn fn;
+    void *arg;
+} sys_thread_start_t;
+
+static DWORD WINAPI sys_thread_main(LPVOID param)
+{
+    sys_thread_start_t start = *(sys_thread_start_t*)param;
+    free(param);
+    start.fn(start.arg);
+    return 0;
+}
+
+int sys_thread_start(sys_thread_t *thread, sys_thread_fn fn, void *arg, int low_priority)
+{
+    sys_thread_start_t *start = (sys_thread_start_t*)malloc(sizeof(*start));
+    if (!start) return -1;
+    start->fn = fn;
+    start->arg = arg;
+    *thread = CreateThread(NULL, 0, sys_thread_main, start, 0, NULL);
+    if (!*thread) {
+        free(start);
+        return -1;
+    }
+    if (low_priority) {
+        SetThreadPriority(*thread, THREAD_PRIORITY_BELOW_NORMAL);
+    }
+    return 0;
+}
+
+void sys_thread_join(sys_thread_t *thread)
+{
+    WaitForSingleObject(*thread, INFINITE);
+    CloseHandle(*thread);
+    *thread = NULL;
+}
+
+void sys_mutex_init(sys_mutex_t *m)    { InitializeCriticalSection(m); }
+void sys_mutex_destroy(sys_mutex_t *m) { DeleteCriticalSection(m); }
+void sys_mutex_lock(sys_mutex_t *m)    { EnterCriticalSection(m); }
+void sys_mutex_unlock(sys_mutex_t *m)  { LeaveCriticalSection(m); }
+
+int sys_tls_create(sys_tls_t *key)
+{
+    *key = TlsAlloc();
+    return *key == 0xFFFFFFFF ? -1 : 0;
+}
+
+void *sys_tls_get(sys_tls_t key)              { return TlsGetValue(key); }
+void sys_tls_set(sys_tls_t key, void *value)  { TlsSetValue(key, value); }
+
+void sys_sleep_ms(unsigned int ms)            { Sleep(ms); }
+
+/* Interlocked calls are full barriers; CE has no plain acquire load. */
+long sys_atomic_load(volatile sys_atomic_t *a)
+{
+    return InterlockedExchangeAdd((LONG*)a, 0);
+}
+
+void sys_atomic_store(volatile sys_atomic_t *a, long value)
+{
+    InterlockedExchange((LONG*)a, value);
+}
+
+#else
+
+#include <time.h>
+
+typedef struct {
+    sys_thread_fn fn;
+    void *arg;
+} sys_thread_start_t;
+
+static void *sys_thread_main(void *param)
+{
+    sys_thread_start_t start = *(sys_thread_start_t*)param;
+    free(param);
+    start.fn(start.arg);
+    return NULL;
+}
+
+int sys_thread_start(sys_thread_t *thread, sys_thread_fn fn, void *arg, int low_priority)
+{
+    sys_thread_start_t *start = (sys_thread_start_t*)malloc(sizeof(*start));
+    (void)low_priority;       /* no portable per-thread priority */
+    if (!start) return -1;
+    start->fn = fn;
+    start->arg = arg;
+    if (pthread_create(thread, NULL, sys_thread_main, start) != 0) {
+        free(start);
+        return -1;
+    }
+    return 0;
+}
+
+void sys_thread_join(sys_thread_t *thread)
+{
+    pthread_join(*thread, NULL);
+}
+
+/* Recursive, to match CRITICAL_SECTION. */
+void sys_mutex_init(sys_mutex_t *m)
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(m, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+void sys_mutex_destroy(sys_mutex_t *m) { pthread_mutex_destroy(m); }
+void sys_mutex_lock(sys_mutex_t *m)    { pthread_mutex_lock(m); }
+void sys_mutex_unlock(sys_mutex_t *m)  { pthread_mutex_unlock(m); }
+
+int sys_tls_create(sys_tls_t *key)
+{
+    return pthread_key_create(key, NULL) == 0 ? 0 : -1;
+}
+
+void *sys_tls_get(sys_tls_t key)              { return pthread_getspecific(key); }
+void sys_tls_set(sys_tls_t key, void *value)  { pthread_setspecific(key, value); }
+
+void sys_sleep_ms(unsigned int ms)
+{
+    struct timespec ts;
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+}
+
+long sys_atomic_load(volatile sys_atomic_t *a)
+{
+    return __atomic_load_n(a, __ATOMIC_ACQUIRE);
+}
+
+void sys_atomic_store(volatile sys_atomic_t *a, long value)
+{
+    __atomic_store_n(a, value, __ATOMIC_RELEASE);
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef SYS_THREAD_H
+#define SYS_THREAD_H
+
+/*
+ * Minimal threads, mutexes, thread-local slots and atomic counters:
+ * Win32/WinCE (CreateThread, CRITICAL_SECTION, TlsAlloc, Interlocked*) or
+ * POSIX threads and GCC atomics elsewhere.
+ */
+
+#ifdef _WIN32
+#include <windows.h>
+typedef HANDLE sys_thread_t;
+typedef CRITICAL_SECTION sys_mutex_t;
+typedef DWORD sys_tls_t;
+typedef LONG sys_atomic_t;
+#else
+#include <pthread.h>
+typedef pthread_t sys_thread_t;
+typedef pthread_mutex_t sys_mutex_t;
+typedef pthread_key_t sys_tls_t;
+typedef long sys_atomic_t;
+#endif
+
+typedef void (*sys_thread_fn)(void *arg);
+
+/* low_priority != 0 runs the thread below normal priority where the
+   platform allows it. Returns 0 on success. */
+int sys_thread_start(sys_thread_t *thread, sys_thread_fn fn, void *arg, int low_priority);
+void sys_thread_join(sys_thread_t *thread);
+
+/* Mutexes are recursive on every platform. */
+void sys_mutex_init(sys_mutex_t *m);
+void sys_mutex_destroy(sys_mutex_t *m);
+void sys_mutex_lock(sys_mutex_t *m);
+void sys_mutex_unlock(sys_mutex_t *m);
+
+/* Returns 0 on success. Slots start out NULL in every thread. */
+int sys_tls_create(sys_tls_t *key);
+void *sys_tls_get(sys_tls_t key);
+void sys_tls_set(sys_tls_t key, void *value);
+
+void sys_sleep_ms(unsigned int ms);
+
+/* A load that sees everything the storing thread wrote before its
+   sys_atomic_store (acquire), and that store (release). Enough for a
+   ring index that one thread writes and one other thread reads. */
+long sys_atomic_load(volatile sys_atomic_t *a);
+void sys_atomic_store(volatile sys_atomic_t *a, long value);
+
+#endif
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+"""Compares charset conversion in build/check with Python's codecs and
+html.unescape.
+
+    python3 tools/check_codecs.py build/check bench/corpus
+
+Run by `make check`. The JIS tables are generated from Python's cp932
+codec (tools/gen_charset_tables.py), so it is the reference for
+Shift_JIS; an EUC-JP code is the same JIS pointer as a Shift_JIS one, so
+EUC-JP is checked through the Shift_JIS bytes of each pointer. Each
+conversion is fed in pieces of 1, 7 and 1460 bytes:
+
+  - every double-byte code cp932 defines, Shift_JIS and EUC-JP -> UTF-8
+  - every BMP character, UTF-8 -> Shift_JIS and EUC-JP
+  - each page of the corpus, UTF-8 -> Shift_JIS
+  - every named reference in html.entities.html5, with and without its
+    ';' and followed by a letter, and numeric references over the BMP
+    edges, U+0000-U+3000 and past U+10FFFF, UTF-8 -> UTF-8 (also fed in
+    33- and 4096-byte pieces)
+
+The encoders are checked against cp932's decoding table, not its encoder:
+cp932 also encodes many characters by best fit, which charset.c sends as
+'?'. What charset.c adds is listed in SINGLE and FOLD below. As in the
+Encoding Standard, the NEC-selected IBM rows (89-92) are never chosen
+when encoding Shift_JIS; EUC-JP uses them for the IBM extensions.
+
+html.unescape drops numeric references to noncharacters and most
+controls (&#1;, &#xFFFF;); the HTML parser keeps them, and so does
+html_entity.c, so that list is emptied first.
+"""
+
+import html
+import html.entities
+import os
+import subprocess
+import sys
+
+CUTS = (1, 7, 1460)
+ENTITY_CUTS = (1, 7, 33, 1460, 4096)
+PUA_FIRST, PUA_LAST = 8836, 10715
+NEC_IBM_FIRST, NEC_IBM_LAST = 8272, 8835
+
+# As charset.c: what has no code of its own is sent as its look-alike.
+SINGLE = {"\u00a0": b" ", "\u00a5": b"\\", "\u203e": b"~"}
+FOLD = {"\u00a2": "\uffe0", "\u00a3": "\uffe1", "\u00ac": "\uffe2", "\u2014": "\u2015",
+        "\u2016": "\u2225", "\u2212": "\uff0d", "\u301c": "\uff5e"}
+
+
+def sjis_bytes(pointer):
+    lead, trail = divmod(pointer, 188)
+    lead += 0x81 if lead < 0x1F else 0xC1
+    trail += 0x40 if trail < 0x3F else 0x41
+    return bytes((lead, trail))
+
+
+def sjis_pointer(b):
+    lead, trail = b
+    return ((lead - (0x81 if lead < 0xA0 else 0xC1)) * 188
+            + trail - (0x40 if trail < 0x7F else 0x41))
+
+
+def euc_bytes(pointer):
+    return bytes((pointer // 94 + 0xA1, pointer % 94 + 0xA1))
+
+
+def cp932_char(pointer):
+    try:
+        s = sjis_bytes(pointer).decode("cp932")
+    except UnicodeDecodeError:
+        return None
+    return s if len(s) == 1 else None
+
+
+class Checker:
+    def __init__(self, exe):
+        self.exe = exe
+        self.failed = 0
+
+    def run(self, name, src, dst, data, want, cuts=CUTS, flags=()):
+        for cut in cuts:
+            args = [self.exe, "--convert=%s,%s" % (src, dst), "--chunk=%d" % cut] + list(flags)
+            got = subprocess.run(args, input=data, stdout=subprocess.PIPE, check=True).stdout
+            if got != want:
+                at = next((i for i, (a, b) in enumerate(zip(got, want)) if a != b),
+                          min(len(got), len(want)))
+                print("FAIL  codecs    %-28s %s -> %s, %d-byte pieces: differs at byte %d "
+                      "(%r vs %r)" % (name, src, dst, cut, at, want[at:at + 8], got[at:at + 8]))
+                self.failed += 1
+                return
+        print("ok    codecs    %-28s %s -> %s" % (name, src, dst))
+
+
+def main():
+    exe = sys.argv[1] if len(sys.argv) > 1 else "build/check"
+    corpus = sys.argv[2] if len(sys.argv) > 2 else "bench/corpus"
+    ck = Checker(exe)
+
+    # Decoding: every pointer cp932 maps to one character, each on a line.
+    sjis, euc, text, euc_text = [], [], [], []
+    for pointer in range(120 * 94):
+        ch = cp932_char(pointer)
+        if ch is None:
+            continue
+        sjis.append(sjis_bytes(pointer) + b"\n")
+        text.append(ch + "\n")
+        if pointer < 94 * 94:
+            euc.append(euc_bytes(pointer) + b"\n")
+            euc_text.append(ch + "\n")
+    ck.run("(every JIS code)", "shift_jis", "utf-8", b"".join(sjis), "".join(text).encode("utf-8"))
+    ck.run("(every JIS code)", "euc-jp", "utf-8", b"".join(euc), "".join(euc_text).encode("utf-8"))
+
+    # Encoding: every BMP character, each on a line.
+    first, nec_ibm = {}, {}
+    for pointer in range(120 * 94):
+        ch = cp932_char(pointer)
+        if ch is None or PUA_FIRST <= pointer <= PUA_LAST:
+            continue
+        if NEC_IBM_FIRST <= pointer <= NEC_IBM_LAST:
+            nec_ibm.setdefault(ch, pointer)
+        else:
+            first.setdefault(ch, pointer)
+    chars = [chr(cp) for cp in range(0x20, 0x10000) if not 0xD800 <= cp <= 0xDFFF]
+    data = "".join(ch + "\n" for ch in chars).encode("utf-8")
+    ck.run("(every BMP character)", "utf-8", "shift_jis", data,
+           b"".join(sjis_want(ch, first) + b"\n" for ch in chars))
+    ck.run("(every BMP character)", "utf-8", "euc-jp", data,
+           b"".join(euc_want(ch, first, nec_ibm) + b"\n" for ch in chars))
+
+    # Whole pages: what Shift_JIS cannot encode becomes '?'.
+    for name in sorted(os.listdir(corpus)):
+        if not name.endswith((".html", ".htm")):
+            continue
+        with open(os.path.join(corpus, name), "rb") as f:
+            page = f.read()
+        text = page.decode("utf-8", errors="replace")
+        want = b"".join(sjis_want(ch, first) for ch in text)
+        ck.run(name, "utf-8", "shift_jis", page, want)
+
+    # Character references, each on a line.
+    html._invalid_codepoints.clear()
+    refs = []
+    for name in sorted(html.entities.html5):
+        refs += ["&" + name, "&" + name + "x", "&" + name.rstrip(";"), "&" + name.rstrip(";") + ";x"]
+    numbers = list(range(0x3000)) + [0xD7FF, 0xD800, 0xDFFF, 0xE000, 0xFFFD, 0xFFFE, 0xFFFF,
+                                     0x10000, 0x10FFFF, 0x110000, 10 ** 20]
+    for n in numbers:
+        refs += ["&#%d;" % n, "&#x%X;" % n, "&#x%x" % n, "&#%d" % n + "x", "&#0%d;" % n]
+    refs += ["&", "&;", "&#;", "&#x;", "&#xg;", "&#", "&#a", "&&amp;", "&" + "a" * 40 + ";"]
+    text = "".join(r + "\n" for r in refs)
+    ck.run("(every reference)", "utf-8", "utf-8", text.encode("utf-8"),
+           html.unescape(text).encode("utf-8"),
+           cuts=ENTITY_CUTS, flags=("--entities",))
+
+    if ck.failed:
+        print("%d codec check(s) failed" % ck.failed)
+        sys.exit(1)
+    print("all codec checks passed")
+
+
+def single_byte(ch):
+    """The one byte both encoders send for ch, or None."""
+    cp = ord(ch)
+    if cp < 0x80:
+        return bytes((cp,))
+    return SINGLE.get(ch)
+
+
+def sjis_want(ch, first):
+    """Shift_JIS bytes for one character, as charset.c picks them."""
+    cp = ord(ch)
+    b = single_byte(ch)
+    if b is not None:
+        return b
+    if 0xFF61 <= cp <= 0xFF9F:
+        return bytes((cp - 0xFF61 + 0xA1,))
+    if 0xE000 <= cp <= 0xE000 + PUA_LAST - PUA_FIRST:
+        return sjis_bytes(cp - 0xE000 + PUA_FIRST)
+    pointer = first.get(ch, first.get(FOLD.get(ch)))
+    return b"?" if pointer is None else sjis_bytes(pointer)
+
+
+def euc_want(ch, first, nec_ibm):
+    """EUC-JP bytes for one character: the Shift_JIS pointer if it is in
+    the 94 rows, else the NEC-selected copy; no private use area."""
+    cp = ord(ch)
+    b = single_byte(ch)
+    if b is not None:
+        return b
+    if 0xFF61 <= cp <= 0xFF9F:
+        return bytes((0x8E, cp - 0xFF61 + 0xA1))
+    pointer = first.get(ch, first.get(FOLD.get(ch)))
+    if pointer is not None and pointer < 94 * 94:
+        return euc_bytes(pointer)
+    return euc_bytes(nec_ibm[ch]) if ch in nec_ibm else b"?"
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""Writes charset_tables.h: the JIS X 0208 tables used by charset.c.
+
+    python3 tools/gen_charset_tables.py > charset_tables.h
+
+The mapping is Windows-31J (CP932), which is what the WHATWG Encoding
+Standard's index-jis0208 holds and what browsers use for both Shift_JIS
+and EUC-JP pages. It is taken from Python's cp932 codec, so no data file
+is needed.
+
+A JIS "pointer" numbers the double-byte codes 94 to a row, in the order
+of their Shift_JIS bytes (188 trail bytes per lead byte, i.e. two rows):
+
+    pointer = (lead - (0x81 if lead < 0xA0 else 0xC1)) * 188
+              + trail - (0x40 if trail < 0x7F else 0x41)
+
+For EUC-JP it is (lead - 0xA1) * 94 + trail - 0xA1, the same numbering.
+Rows 94-113 are the user-defined area (U+E000...) and are computed, not
+stored. Empty rows take no space.
+"""
+
+ROWS = 120               # Shift_JIS leads 0x81-0x9F and 0xE0-0xFC
+PUA_FIRST, PUA_LAST = 8836, 10715
+NEC_IBM_FIRST, NEC_IBM_LAST = 8272, 8835   # never chosen when encoding
+
+
+def sjis_bytes(pointer):
+    lead, trail = divmod(pointer, 188)
+    lead += 0x81 if lead < 0x1F else 0xC1
+    trail += 0x40 if trail < 0x3F else 0x41
+    return bytes((lead, trail))
+
+
+def decode(pointer):
+    if PUA_FIRST <= pointer <= PUA_LAST:
+        return 0
+    try:
+        s = sjis_bytes(pointer).decode("cp932")
+    except UnicodeDecodeError:
+        return 0
+    return ord(s) if len(s) == 1 else 0
+
+
+def emit(name, ctype, values, per_line=12):
+    print("static const %s %s[%d] = {" % (ctype, name, len(values)))
+    width = 8 if max(values) > 0xFFFF else 4 if max(values) > 0xFF else 2
+    for i in range(0, len(values), per_line):
+        line = ", ".join("0x%0*X" % (width, v) for v in values[i:i + per_line])
+        print("    " + line + ("," if i + per_line < len(values) else ""))
+    print("};")
+    print()
+
+
+def main():
+    table = [decode(p) for p in range(ROWS * 94)]
+
+    row_map = []
+    cells = []
+    for row in range(ROWS):
+        chunk = table[row * 94:(row + 1) * 94]
+        if any(chunk):
+            row_map.append(len(cells) // 94)
+            cells.extend(chunk)
+        else:
+            row_map.append(0xFF)
+
+    # Encoder: for each character the pointer to use, ordered by character.
+    best = {}
+    for p, u in enumerate(table):
+        if not u or NEC_IBM_FIRST <= p <= NEC_IBM_LAST:
+            continue
+        best.setdefault(u, p)
+    by_char = sorted(best.items())
+    assert all(u <= 0xFFFF for u, _ in by_char)
+    bucket = []
+    k = 0
+    for hi in range(257):
+        while k < len(by_char) and by_char[k][0] >> 8 < hi:
+            k += 1
+        bucket.append(k)
+
+    # Which characters of each 256-character block are encodable, as a
+    # bitmap for the blocks that have any.
+    block = [0xFF] * 256
+    bits = []
+    for u, _ in by_char:
+        hi = u >> 8
+        if block[hi] == 0xFF:
+            block[hi] = len(bits) // 8
+            bits.extend([0] * 8)
+        bits[block[hi] * 8 + (u & 0xFF) // 32] |= 1 << (u & 31)
+
+    print("/* Generated by tools/gen_charset_tables.py; do not edit. */")
+    print()
+    print("#ifndef CHARSET_TABLES_H")
+    print("#define CHARSET_TABLES_H")
+    print()
+    print("#define JIS_ROWS     %d" % ROWS)
+    print("#define JIS_NO_ROW   0xFF")
+    print("#define JIS_PUA_FIRST %d" % PUA_FIRST)
+    print("#define JIS_PUA_LAST  %d" % PUA_LAST)
+    print("#define JIS_NEC_IBM_FIRST %d" % NEC_IBM_FIRST)
+    print("#define JIS_NEC_IBM_LAST  %d" % NEC_IBM_LAST)
+    print("#define JIS_ENCODABLE %d" % len(by_char))
+    print()
+    print("/* Row of a pointer (pointer / 94) -> row in g_jis_cells, or JIS_NO_ROW. */")
+    emit("g_jis_row", "unsigned char", row_map, 20)
+    print("/* Character for each pointer of the stored rows, 0 where there is none. */")
+    emit("g_jis_cells", "unsigned short", cells)
+    print("/* Pointers to encode with, sorted by character. */")
+    emit("g_jis_by_char", "unsigned short", [p for _, p in by_char])
+    print("/* g_jis_by_char index of the first character >= hi << 8, for hi 0..255. */")
+    emit("g_jis_bucket", "unsigned short", bucket[:256])
+    print("/* Block (character >> 8) -> its bitmap in g_jis_bits, or JIS_NO_ROW. */")
+    emit("g_jis_block", "unsigned char", block, 16)
+    print("/* One bit per encodable character, 8 words per block; counting the")
+    print("   bits below a character gives its place in g_jis_by_char. */")
+    emit("g_jis_bits", "unsigned int", bits, 4)
+    print("#endif")
+
+
+if __name__ == "__main__":
+    main()
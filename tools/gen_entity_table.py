@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""Writes html_entity_table.h: the named character references used by
+html_entity.c.
+
+    python3 tools/gen_entity_table.py > html_entity_table.h
+
+The names are the WHATWG HTML list (2125 names, 106 of which may also be
+written without the ';'), taken from Python's html.entities.html5, so no
+data file is needed.
+
+Lookup is a two-level perfect hash. A name's 32-bit FNV-1a hash picks a
+bucket; the bucket's seed, mixed into the same hash, picks the slot. Seeds
+are found here, largest buckets first, so that every name lands in a slot
+of its own: a lookup is one pass over the name, a few multiplies and one
+compare. Names are stored once in a pool, a name that is part of a longer
+one sharing its bytes.
+"""
+
+import html.entities
+
+NAME_MAX = 31            # "CounterClockwiseContourIntegral"
+BUCKET_KEYS = 4          # names per bucket, on average
+MASK = 0xFFFFFFFF
+
+
+def fnv(name):
+    h = 2166136261
+    for c in name.encode("ascii"):
+        h = ((h ^ c) * 16777619) & MASK
+    return h
+
+
+def mix(h):
+    h ^= h >> 16
+    h = (h * 0x7FEB352D) & MASK
+    h ^= h >> 15
+    h = (h * 0x846CA68B) & MASK
+    h ^= h >> 16
+    return h
+
+
+def place(hashes, size):
+    """Seeds per bucket so that mix(h ^ seed) % size is one-to-one."""
+    nbuckets = (len(hashes) + BUCKET_KEYS - 1) // BUCKET_KEYS
+    buckets = [[] for _ in range(nbuckets)]
+    for i, h in enumerate(hashes):
+        buckets[h % nbuckets].append(i)
+    slots = [None] * size
+    seeds = [0] * nbuckets
+    for b in sorted(range(nbuckets), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            continue
+        for seed in range(0x10000):
+            want = [mix(hashes[i] ^ seed) % size for i in buckets[b]]
+            if len(set(want)) == len(want) and all(slots[s] is None for s in want):
+                break
+        else:
+            return None
+        seeds[b] = seed
+        for i, s in zip(buckets[b], want):
+            slots[s] = i
+    return seeds, slots
+
+
+def emit(name, ctype, values, per_line=12):
+    print("static const %s %s[%d] = {" % (ctype, name, len(values)))
+    width = 8 if max(values) > 0xFFFF else 4 if max(values) > 0xFF else 2
+    for i in range(0, len(values), per_line):
+        line = ", ".join("0x%0*X" % (width, v) for v in values[i:i + per_line])
+        print("    " + line + ("," if i + per_line < len(values) else ""))
+    print("};")
+    print()
+
+
+def main():
+    table = html.entities.html5
+    names = sorted(k[:-1] for k in table if k.endswith(";"))
+    legacy = {k for k in table if not k.endswith(";")}
+    assert all(n + ";" in table for n in legacy)
+    assert max(len(n) for n in names) <= NAME_MAX
+
+    seconds = sorted({ord(v[1]) for v in table.values() if len(v) > 1})
+    assert len(seconds) < 16
+
+    hashes = [fnv(n) for n in names]
+    assert len(set(hashes)) == len(hashes)
+    size = len(names)
+    while True:
+        placed = place(hashes, size)
+        if placed:
+            break
+        size += 1
+    seeds, slots = placed
+
+    # Longest first, so that shorter names are found inside longer ones.
+    pool = ""
+    offset = {}
+    for n in sorted(names, key=lambda n: (-len(n), n)):
+        at = pool.find(n)
+        if at < 0:
+            at = len(pool)
+            pool += n
+        offset[n] = at
+    assert len(pool) < 0x10000
+
+    name_at = []
+    value = []
+    for i in slots:
+        if i is None:
+            name_at.append(0)
+            value.append(0)
+            continue
+        n = names[i]
+        chars = table[n + ";"]
+        second = seconds.index(ord(chars[1])) + 1 if len(chars) > 1 else 0
+        name_at.append(offset[n])
+        value.append(ord(chars[0]) | second << 21 | (n in legacy) << 25 | len(n) << 26)
+
+    print("/* Generated by tools/gen_entity_table.py; do not edit. */")
+    print()
+    print("#ifndef HTML_ENTITY_TABLE_H")
+    print("#define HTML_ENTITY_TABLE_H")
+    print()
+    print("#define ENTITY_NAMES   %d" % len(names))
+    print("#define ENTITY_SLOTS   %d" % size)
+    print("#define ENTITY_BUCKETS %d" % len(seeds))
+    print()
+    print("/* Seed of each bucket (FNV-1a hash % ENTITY_BUCKETS). */")
+    emit("g_entity_seed", "unsigned short", seeds)
+    print("/* Per slot (mix(hash ^ seed) % ENTITY_SLOTS): the character in bits")
+    print("   0-20, a second one as an index into g_entity_second in bits 21-24,")
+    print("   whether ';' may be left out in bit 25 and the name length from bit")
+    print("   26. 0 for an empty slot. */")
+    emit("g_entity_value", "unsigned int", value, 6)
+    print("/* Per slot: where its name starts in g_entity_pool. */")
+    emit("g_entity_name", "unsigned short", name_at)
+    print("/* Second characters (index - 1), for the few references that make two. */")
+    emit("g_entity_second", "unsigned short", seconds)
+    print("/* All names, without '&' or ';'. */")
+    print("static const char g_entity_pool[%d] =" % (len(pool) + 1))
+    for i in range(0, len(pool), 72):
+        print('    "%s"%s' % (pool[i:i + 72], ";" if i + 72 >= len(pool) else ""))
+    print()
+    print("#endif")
+
+
+if __name__ == "__main__":
+    main()
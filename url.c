@@ -0,0 +1,138 @@
+#include "url.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int url_parse(const char *url, net_scheme_t *scheme, char *host, int hostLen,
+              char *path, int pathLen, unsigned short *port)
+{
+    const char *p = NULL;
+    const char *slash = NULL;
+    const char *colon = NULL;
+    char hostport[256] = {0};
+
+    if (strncmp(url, "https://", 8) == 0) {
+        *scheme = NET_SCHEME_HTTPS;
+        *port = 443;
+        p = url + 8;
+    } else if (strncmp(url, "http://", 7) == 0) {
+        *scheme = NET_SCHEME_HTTP;
+        *port = 80;
+        p = url + 7;
+    } else {
+        return -1;
+    }
+
+    slash = strchr(p, '/');
+    if (!slash) {
+        strncpy(hostport, p, sizeof(hostport) - 1);
+        strcpy(path, "/");
+    } else {
+        int hpLen = (int)(slash - p);
+        if (hpLen <= 0 || hpLen >= (int)sizeof(hostport)) return -1;
+        strncpy(hostport, p, hpLen);
+        hostport[hpLen] = '\0';
+        strncpy(path, slash, pathLen - 1);
+        path[pathLen - 1] = '\0';
+    }
+
+    colon = strchr(hostport, ':');
+    if (colon) {
+        int hLen = (int)(colon - hostport);
+        if (hLen <= 0 || hLen >= hostLen) return -1;
+        strncpy(host, hostport, hLen);
+        host[hLen] = '\0';
+        *port = (unsigned short)atoi(colon + 1);
+    } else {
+        strncpy(host, hostport, hostLen - 1);
+        host[hostLen - 1] = '\0';
+    }
+
+    return 0;
+}
+
+/* Removes "." and ".." segments from the absolute path path[0, len) in
+   place. Returns the new length. */
+static int url_remove_dots(char *path, int len)
+{
+    int r = 0, w = 0;
+
+    while (r < len) {
+        int s = r + 1;            /* path[r] is a '/' */
+        int e = s;
+        while (e < len && path[e] != '/') e++;
+
+        if (e - s == 1 && path[s] == '.') {
+            if (e == len) path[w++] = '/';
+        } else if (e - s == 2 && path[s] == '.' && path[s + 1] == '.') {
+            /* Back up over the last segment written, to its '/'. */
+            while (w > 0 && path[--w] != '/') { }
+            if (e == len) path[w++] = '/';
+        } else {
+            memmove(path + w, path + r, e - r);
+            w += e - r;
+        }
+        r = e;
+    }
+    if (w == 0) path[w++] = '/';
+    return w;
+}
+
+int url_resolve(const char *base, const char *link, char *out, int outLen)
+{
+    const char *p = link;
+    const char *auth, *authEnd, *pathEnd;
+    char rest[1024];
+    int n, pathLen;
+
+    /* A scheme of its own: letters, digits, '+', '-', '.' then ':'. */
+    while (isalnum((unsigned char)*p) || *p == '+' || *p == '-' || *p == '.') p++;
+    if (*p == ':' && p > link) {
+        n = snprintf(out, outLen, "%s", link);
+        return (n < 0 || n >= outLen) ? -1 : 0;
+    }
+
+    auth = strstr(base, "://");
+    if (!auth) return -1;
+    auth += 3;
+    authEnd = auth + strcspn(auth, "/?#");
+    pathEnd = authEnd + strcspn(authEnd, "?#");
+
+    if (link[0] == '/' && link[1] == '/') {
+        /* Network-path reference: only the scheme comes from base. */
+        n = snprintf(out, outLen, "%.*s%s", (int)(auth - 2 - base), base, link);
+        return (n < 0 || n >= outLen) ? -1 : 0;
+    }
+
+    /* Path, query and fragment of the result, before dot removal. A base
+       with an empty path ("http://host", "http://host?x") has path "/". */
+    if (link[0] == '/') {
+        n = snprintf(rest, sizeof(rest), "%s", link);
+    } else if (link[0] == '?') {
+        n = snprintf(rest, sizeof(rest), "%s%.*s%s", pathEnd > authEnd ? "" : "/",
+                     (int)(pathEnd - authEnd), authEnd, link);
+    } else if (link[0] == '#' || link[0] == '\0') {
+        const char *hash = strchr(authEnd, '#');
+        int keep = hash ? (int)(hash - authEnd) : (int)strlen(authEnd);
+        n = snprintf(rest, sizeof(rest), "%s%.*s%s", pathEnd > authEnd ? "" : "/",
+                     keep, authEnd, link);
+    } else {
+        /* Relative path: replaces everything after the base's last '/'. */
+        const char *dir = pathEnd;
+        while (dir > authEnd && dir[-1] != '/') dir--;
+        n = snprintf(rest, sizeof(rest), "%s%.*s%s", dir > authEnd ? "" : "/",
+                     (int)(dir - authEnd), authEnd, link);
+    }
+    if (n < 0 || n >= (int)sizeof(rest)) return -1;
+
+    pathLen = (int)strcspn(rest, "?#");
+    if (pathLen > 0) {
+        n = url_remove_dots(rest, pathLen);
+        memmove(rest + n, rest + pathLen, strlen(rest + pathLen) + 1);
+    }
+
+    n = snprintf(out, outLen, "%.*s%s", (int)(authEnd - base), base, rest);
+    return (n < 0 || n >= outLen) ? -1 : 0;
+}
@@ -0,0 +1,23 @@
+#ifndef URL_H
+#define URL_H
+
+#include "net_transport.h"
+
+/*
+ * Splits an http:// or https:// URL into scheme, host, path and port
+ * (80/443 unless the URL gives one). A URL with no path gets "/".
+ * Returns 0 on success, -1 for other schemes or a host that does not fit.
+ */
+int url_parse(const char *url, net_scheme_t *scheme, char *host, int hostLen,
+              char *path, int pathLen, unsigned short *port);
+
+/*
+ * Makes link (as found in an href) absolute against the http(s) URL base:
+ * "//host/...", "/path", "?query", "#fragment" and relative paths, with
+ * "." and ".." segments removed. Links with a scheme of their own
+ * (https:, mailto:, ...) are copied as they are. Returns 0 on success,
+ * -1 if base has no "scheme://" or the result does not fit in out.
+ */
+int url_resolve(const char *base, const char *link, char *out, int outLen);
+
+#endif